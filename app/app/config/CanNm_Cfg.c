@@ -26,6 +26,7 @@
 #define CANNM_RemoteSleepIndTime CANNM_CONVERT_MS_TO_MAIN_CYCLES(1500)
 #define CANNM_NODE_ID 0
 #define CANNM_ImmediateNmTransmissions 10
+#define CANNM_PnResetTime CANNM_CONVERT_MS_TO_MAIN_CYCLES(2500)
 
 #ifdef _WIN32
 #define L_CONST
@@ -35,8 +36,10 @@
 /* ================================ [ TYPES     ] ============================================== */
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
-#ifdef CANNM_GLOBAL_PN_SUPPORT
 static const uint8_t nm0PnFilterMaskByte[2] = {0x55, 0xAA};
+
+#ifdef CANNM_GLOBAL_PN_SUPPORT
+NMCORE_PN_AGGREGATION_DEF(CanNm_Eira, sizeof(nm0PnFilterMaskByte));
 #endif
 static L_CONST CanNm_ChannelConfigType CanNm_ChannelConfigs[] = {
   {
@@ -48,9 +51,7 @@ static L_CONST CanNm_ChannelConfigType CanNm_ChannelConfigs[] = {
     CANNM_RepeatMessageTime,
     CANNM_NmTimeoutTime,
     CANNM_WaitBusSleepTime,
-#ifdef CANNM_REMOTE_SLEEP_IND_ENABLED
     CANNM_RemoteSleepIndTime,
-#endif
 #ifdef USE_CANIF
     CANIF_CANNM_TX, /* TxPdu */
 #else
@@ -59,29 +60,42 @@ static L_CONST CanNm_ChannelConfigType CanNm_ChannelConfigs[] = {
     CANNM_NODE_ID,
     0, /* nmNetworkHandle */
     CANNM_ImmediateNmTransmissions,
+    8,                /* PduLength */
     CANNM_PDU_BYTE_1, /* PduCbvPosition */
     CANNM_PDU_BYTE_0, /* PduNidPosition */
     TRUE,             /* ActiveWakeupBitEnabled */
     FALSE,            /* PassiveModeEnabled */
     TRUE,             /* RepeatMsgIndEnabled */
     TRUE,             /* NodeDetectionEnabled */
-#ifdef CANNM_GLOBAL_PN_SUPPORT
     TRUE,                        /* PnEnabled */
     TRUE,                        /* AllNmMessagesKeepAwake */
+    FALSE,                       /* PnHandleMultipleNetworkRequests */
     4,                           /* PnInfoOffset */
     sizeof(nm0PnFilterMaskByte), /* PnInfoLength */
     nm0PnFilterMaskByte,
-#endif
+    NULL,                        /* Era */
   },
 };
 
 static CanNm_ChannelContextType CanNm_ChannelContexts[ARRAY_SIZE(CanNm_ChannelConfigs)];
 
-const CanNm_ConfigType CanNm_Config = {
+const CanNm_ConfigType CanNm_Config = {{
   CanNm_ChannelConfigs,
   CanNm_ChannelContexts,
   ARRAY_SIZE(CanNm_ChannelConfigs),
-};
+  CANNM_FEATURES,
+  CANNM_MAIN_FUNCTION_PERIOD,
+  CanIf_Transmit,
+  CANNM_PnResetTime,
+  sizeof(nm0PnFilterMaskByte), /* PnInfoLength */
+#ifdef CANNM_GLOBAL_PN_SUPPORT
+  &CanNm_Eira,
+#else
+  NULL,
+#endif
+  NULL, /* EiraIndication */
+  NULL, /* EraIndication */
+}};
 /* ================================ [ LOCALS    ] ============================================== */
 #ifdef _WIN32
 static void __attribute__((constructor)) _cannm_start(void) {
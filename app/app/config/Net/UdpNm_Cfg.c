@@ -16,6 +16,7 @@
 #define UDPNM_ImmediateNmCycleTime UDPNM_CONVERT_MS_TO_MAIN_CYCLES(100)
 #define UDPNM_MsgCycleOffset UDPNM_CONVERT_MS_TO_MAIN_CYCLES(100)
 #define UDPNM_MsgCycleTime UDPNM_CONVERT_MS_TO_MAIN_CYCLES(1000)
+#define UDPNM_MsgReducedTime 0 /* no bus load reduction */
 #define UDPNM_MsgTimeoutTime UDPNM_CONVERT_MS_TO_MAIN_CYCLES(10)
 #define UDPNM_RepeatMessageTime UDPNM_CONVERT_MS_TO_MAIN_CYCLES(2000)
 #define UDPNM_NmTimeoutTime UDPNM_CONVERT_MS_TO_MAIN_CYCLES(2000)
@@ -23,6 +24,7 @@
 #define UDPNM_RemoteSleepIndTime UDPNM_CONVERT_MS_TO_MAIN_CYCLES(1500)
 #define UDPNM_NODE_ID 0
 #define UDPNM_ImmediateNmTransmissions 10
+#define UDPNM_PnResetTime UDPNM_CONVERT_MS_TO_MAIN_CYCLES(2500)
 
 #ifdef _WIN32
 #define L_CONST
@@ -32,48 +34,62 @@
 /* ================================ [ TYPES     ] ============================================== */
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
-#ifdef UDPNM_GLOBAL_PN_SUPPORT
 static const uint8_t nm0PnFilterMaskByte[2] = {0x55, 0xAA};
+
+#ifdef UDPNM_GLOBAL_PN_SUPPORT
+NMCORE_PN_AGGREGATION_DEF(UdpNm_Eira, sizeof(nm0PnFilterMaskByte));
 #endif
 static L_CONST UdpNm_ChannelConfigType UdpNm_ChannelConfigs[] = {
   {
     UDPNM_ImmediateNmCycleTime,
     UDPNM_MsgCycleOffset,
     UDPNM_MsgCycleTime,
+    UDPNM_MsgReducedTime,
     UDPNM_MsgTimeoutTime,
     UDPNM_RepeatMessageTime,
     UDPNM_NmTimeoutTime,
     UDPNM_WaitBusSleepTime,
-#ifdef UDPNM_REMOTE_SLEEP_IND_ENABLED
     UDPNM_RemoteSleepIndTime,
-#endif
     SOAD_TX_PID_UDPNM_CHL0, /* TxPdu */
     UDPNM_NODE_ID,
     0, /* nmNetworkHandle */
     UDPNM_ImmediateNmTransmissions,
+    UDPNM_PDU_LENGTH, /* PduLength */
     UDPNM_PDU_BYTE_1, /* PduCbvPosition */
     UDPNM_PDU_BYTE_0, /* PduNidPosition */
     TRUE,             /* ActiveWakeupBitEnabled */
     FALSE,            /* PassiveModeEnabled */
     TRUE,             /* RepeatMsgIndEnabled */
     TRUE,             /* NodeDetectionEnabled */
-#ifdef UDPNM_GLOBAL_PN_SUPPORT
     TRUE,                        /* PnEnabled */
     TRUE,                        /* AllNmMessagesKeepAwake */
+    FALSE,                       /* PnHandleMultipleNetworkRequests */
     4,                           /* PnInfoOffset */
     sizeof(nm0PnFilterMaskByte), /* PnInfoLength */
     nm0PnFilterMaskByte,
-#endif
+    NULL,                        /* Era */
   },
 };
 
 static UdpNm_ChannelContextType UdpNm_ChannelContexts[ARRAY_SIZE(UdpNm_ChannelConfigs)];
 
-const UdpNm_ConfigType UdpNm_Config = {
+const UdpNm_ConfigType UdpNm_Config = {{
   UdpNm_ChannelConfigs,
   UdpNm_ChannelContexts,
   ARRAY_SIZE(UdpNm_ChannelConfigs),
-};
+  UDPNM_FEATURES,
+  UDPNM_MAIN_FUNCTION_PERIOD,
+  SoAd_IfTransmit,
+  UDPNM_PnResetTime,
+  sizeof(nm0PnFilterMaskByte), /* PnInfoLength */
+#ifdef UDPNM_GLOBAL_PN_SUPPORT
+  &UdpNm_Eira,
+#else
+  NULL,
+#endif
+  NULL, /* EiraIndication */
+  NULL, /* EraIndication */
+}};
 /* ================================ [ LOCALS    ] ============================================== */
 #ifdef _WIN32
 static void __attribute__((constructor)) _udpnm_start(void) {
@@ -7,11 +7,23 @@
 /* ================================ [ INCLUDES  ] ============================================== */
 #include "Std_Types.h"
 /* ================================ [ MACROS    ] ============================================== */
+/* the partitions of the main functions, see main.c */
+#define APP_PARTITION_COMMS 0
+#define APP_PARTITION_MEMORY 1
+#define APP_PARTITION_DIAG 2
+#define APP_PARTITION_ETH 3
 /* ================================ [ TYPES     ] ============================================== */
+typedef void (*App_PartitionJobType)(void *arg);
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
 /* ================================ [ FUNCTIONS ] ============================================== */
 void App_Init(void);
 void App_MainFunction(void);
+
+#ifdef APP_USE_PARTITION
+/* queue a job to be run by the thread of the partition at the start of its next cycle, it is the
+ * way for one partition to hand work to another one */
+Std_ReturnType App_PartitionPost(uint8_t partition, App_PartitionJobType job, void *arg);
+#endif
 #endif /* APP_H */
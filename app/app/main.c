@@ -119,7 +119,71 @@
 #define STD_TRACE_APP_MAIN()
 #endif
 /* ================================ [ MACROS    ] ============================================== */
+#ifndef APP_PARTITION_COMMS_PERIOD
+#define APP_PARTITION_COMMS_PERIOD 10000
+#endif
+#ifndef APP_PARTITION_MEMORY_PERIOD
+#define APP_PARTITION_MEMORY_PERIOD 10000
+#endif
+#ifndef APP_PARTITION_DIAG_PERIOD
+#define APP_PARTITION_DIAG_PERIOD 10000
+#endif
+#ifndef APP_PARTITION_ETH_PERIOD
+#define APP_PARTITION_ETH_PERIOD 10000
+#endif
+
+#ifdef APP_USE_PARTITION
+#ifndef USE_OSAL
+#error "APP_USE_PARTITION needs the OSAL threads"
+#endif
+#ifndef APP_PARTITION_QUEUE_SIZE
+#define APP_PARTITION_QUEUE_SIZE 8
+#endif
+/* The BSW modules are not reentrant, so one main function or one round of the fast loop is run
+ * at a time, the partitions only interleave between the main functions. */
+#define APP_BSW_LOCK() OSAL_MutexLock(lAppBswLock)
+#define APP_BSW_UNLOCK() OSAL_MutexUnlock(lAppBswLock)
+/* the drops are counted by any poster and reset by the partition itself */
+#define APP_PARTITION_INC(v) (void)__atomic_fetch_add(&(v), 1, __ATOMIC_RELAXED)
+#define APP_PARTITION_LOAD(v) __atomic_load_n(&(v), __ATOMIC_RELAXED)
+#define APP_PARTITION_STORE(v, x) __atomic_store_n(&(v), (x), __ATOMIC_RELAXED)
+#else
+#define APP_BSW_LOCK()
+#define APP_BSW_UNLOCK()
+#endif
 /* ================================ [ TYPES     ] ============================================== */
+typedef void (*App_MainFunctionType)(void);
+
+typedef struct {
+  const char *name;
+  const App_MainFunctionType *mains; /* NULL terminated */
+  std_time_t period;                 /* us */
+} App_PartitionType;
+
+#ifdef APP_USE_PARTITION
+typedef struct {
+  App_PartitionJobType job;
+  void *arg;
+} App_PartitionJobEntryType;
+
+typedef struct {
+  uint32_t cycles;
+  uint32_t overruns; /* the cycle is not done before the start of the next period */
+  uint32_t drops;    /* the jobs lost as the queue is full or the partition has no thread */
+  std_time_t sumJitter;
+  std_time_t maxJitter;
+  std_time_t sumExec;
+  std_time_t maxExec;
+} App_PartitionStatsType;
+
+typedef struct {
+  OSAL_MutexType lock;
+  App_PartitionJobEntryType jobs[APP_PARTITION_QUEUE_SIZE];
+  uint16_t head;
+  uint16_t count;
+  App_PartitionStatsType stats;
+} App_PartitionContextType;
+#endif
 /* ================================ [ DECLARES  ] ============================================== */
 extern void App_AliveIndicate(void);
 #ifdef USE_STDIO_CAN
@@ -128,76 +192,263 @@ extern void stdio_main_function(void);
 /* ================================ [ DATAS     ] ============================================== */
 static Std_TimerType timer10ms;
 static Std_TimerType timer100ms;
-/* ================================ [ LOCALS    ] ============================================== */
-static void MemoryTask(void) {
-#ifdef USE_EEP
-  Eep_MainFunction();
-#endif
-#ifdef USE_EA
-  Ea_MainFunction();
-#endif
-#ifdef USE_FLS
-  Fls_MainFunction();
-#endif
-#ifdef USE_FEE
-  Fee_MainFunction();
-#endif
-#ifdef USE_NVM
-  NvM_MainFunction();
-#endif
-}
 
-static void MainTask_10ms(void) {
+static const App_MainFunctionType lCommsMains[] = {
 #ifdef USE_CAN
 #ifdef USE_CANTP
-  CanTp_MainFunction();
-  CanTp_MainFunction_Fast();
+  CanTp_MainFunction,
+  CanTp_MainFunction_Fast,
 #endif
 #ifdef USE_OSEKNM
-  OsekNm_MainFunction();
+  OsekNm_MainFunction,
 #endif
 #ifdef USE_CANNM
-  CanNm_MainFunction();
+  CanNm_MainFunction,
 #endif
 #ifdef USE_CANTSYN
-  CanTSyn_MainFunction();
+  CanTSyn_MainFunction,
 #endif
 #endif
 #ifdef USE_LINTP
-  LinTp_MainFunction();
+  LinTp_MainFunction,
 #endif
 #ifdef USE_COM
-  Com_MainFunction();
+  Com_MainFunction,
 #endif
+  NULL,
+};
 
-  MemoryTask();
-#ifdef USE_DCM
-  Dcm_MainFunction();
+static const App_MainFunctionType lMemoryMains[] = {
+#ifdef USE_EEP
+  Eep_MainFunction,
+#endif
+#ifdef USE_EA
+  Ea_MainFunction,
+#endif
+#ifdef USE_FLS
+  Fls_MainFunction,
+#endif
+#ifdef USE_FEE
+  Fee_MainFunction,
+#endif
+#ifdef USE_NVM
+  NvM_MainFunction,
 #endif
+  NULL,
+};
 
+static const App_MainFunctionType lDiagMains[] = {
+#ifdef USE_DCM
+  Dcm_MainFunction,
+#endif
 #ifdef USE_DEM
-  Dem_MainFunction();
+  Dem_MainFunction,
 #endif
+  NULL,
+};
 
+static const App_MainFunctionType lEthMains[] = {
 #ifdef USE_DOIP
-  DoIP_MainFunction();
+  DoIP_MainFunction,
 #endif
 #ifdef USE_SD
-  Sd_MainFunction();
+  Sd_MainFunction,
 #endif
 #ifdef USE_SOMEIP
-  SomeIp_MainFunction();
+  SomeIp_MainFunction,
 #endif
-
 #ifdef USE_UDPNM
-  UdpNm_MainFunction();
+  UdpNm_MainFunction,
+#endif
+  NULL,
+};
+
+/* in the order of the former MainTask_10ms, indexed by the APP_PARTITION_xxx */
+static const App_PartitionType lPartitions[] = {
+  {"comms", lCommsMains, APP_PARTITION_COMMS_PERIOD},
+  {"memory", lMemoryMains, APP_PARTITION_MEMORY_PERIOD},
+  {"diag", lDiagMains, APP_PARTITION_DIAG_PERIOD},
+  {"eth", lEthMains, APP_PARTITION_ETH_PERIOD},
+};
+
+#ifdef APP_USE_PARTITION
+static OSAL_MutexType lAppBswLock;
+static App_PartitionContextType lPartitionContexts[ARRAY_SIZE(lPartitions)];
+#endif
+/* ================================ [ LOCALS    ] ============================================== */
+static void App_PartitionRun(const App_PartitionType *partition) {
+  const App_MainFunctionType *main;
+
+  for (main = partition->mains; NULL != *main; main++) {
+    APP_BSW_LOCK();
+    (*main)();
+    APP_BSW_UNLOCK();
+  }
+}
+
+static void MemoryTask(void) {
+  App_PartitionRun(&lPartitions[APP_PARTITION_MEMORY]);
+}
+
+static void MainTask_10ms(void) {
+#ifndef APP_USE_PARTITION
+  uint8_t i;
+
+  for (i = 0; i < ARRAY_SIZE(lPartitions); i++) {
+    App_PartitionRun(&lPartitions[i]);
+  }
 #endif
 
 #ifdef USE_PLUGIN
+  APP_BSW_LOCK();
   plugin_main();
+  APP_BSW_UNLOCK();
 #endif
 }
 
+#ifdef APP_USE_PARTITION
+/* run the jobs posted by the other partitions, the job is called without the queue lock */
+static void App_PartitionDrain(App_PartitionContextType *context) {
+  App_PartitionJobEntryType entry;
+  boolean more = TRUE;
+
+  while (more) {
+    OSAL_MutexLock(context->lock);
+    if (context->count > 0) {
+      entry = context->jobs[context->head];
+      context->head = (context->head + 1) % APP_PARTITION_QUEUE_SIZE;
+      context->count--;
+    } else {
+      more = FALSE;
+    }
+    OSAL_MutexUnlock(context->lock);
+    if (more) {
+      entry.job(entry.arg);
+    }
+  }
+}
+
+static void App_PartitionUpdateStats(App_PartitionStatsType *stats, std_time_t jitter,
+                                     std_time_t exec) {
+  stats->cycles++;
+  stats->sumJitter += jitter;
+  if (jitter > stats->maxJitter) {
+    stats->maxJitter = jitter;
+  }
+  stats->sumExec += exec;
+  if (exec > stats->maxExec) {
+    stats->maxExec = exec;
+  }
+}
+
+static void App_PartitionResetStats(void *arg) {
+  App_PartitionContextType *context = (App_PartitionContextType *)arg;
+  App_PartitionStatsType *stats = &context->stats;
+
+  stats->cycles = 0;
+  stats->overruns = 0;
+  stats->sumJitter = 0;
+  stats->maxJitter = 0;
+  stats->sumExec = 0;
+  stats->maxExec = 0;
+  APP_PARTITION_STORE(stats->drops, 0);
+}
+
+/* the thread of one partition, released by the periodic timer at the absolute start of each
+ * period so that the late start of one cycle is not carried into the next one */
+static void App_PartitionMain(void *arg) {
+  uint8_t id = (uint8_t)(uintptr_t)arg;
+  const App_PartitionType *partition = &lPartitions[id];
+  App_PartitionContextType *context = &lPartitionContexts[id];
+  OSAL_TimerType timer = OSAL_TimerCreate((uint32_t)partition->period);
+  std_time_t release = Std_GetTime() + partition->period;
+  std_time_t start, end;
+  int expirations;
+
+  asAssert(NULL != timer);
+  for (;;) {
+    expirations = OSAL_TimerWait(timer);
+    if (expirations > 1) {
+      /* the missed periods are skipped rather than run back to back */
+      context->stats.overruns++;
+      release += (std_time_t)(expirations - 1) * partition->period;
+    }
+
+    start = Std_GetTime();
+    Std_TimeLatch();
+    App_PartitionDrain(context);
+    App_PartitionRun(partition);
+    Std_TimeUnlatch();
+    end = Std_GetTime();
+    App_PartitionUpdateStats(&context->stats, (start > release) ? (start - release) : 0,
+                             end - start);
+    release += partition->period;
+  }
+}
+
+static void App_PartitionInit(void) {
+  uint8_t i;
+
+  lAppBswLock = OSAL_MutexCreate(NULL);
+  asAssert(NULL != lAppBswLock);
+  for (i = 0; i < ARRAY_SIZE(lPartitions); i++) {
+    lPartitionContexts[i].lock = OSAL_MutexCreate(NULL);
+    asAssert(NULL != lPartitionContexts[i].lock);
+  }
+}
+
+static void App_PartitionStart(void) {
+  uint8_t i;
+
+  for (i = 0; i < ARRAY_SIZE(lPartitions); i++) {
+    if (NULL != lPartitions[i].mains[0]) {
+      (void)OSAL_ThreadCreate(App_PartitionMain, (void *)(uintptr_t)i);
+    }
+  }
+}
+
+#ifdef USE_SHELL
+static int partFunc(int argc, const char *argv[]) {
+  int ret = 0;
+  uint8_t i;
+  App_PartitionStatsType *stats;
+
+  if (1 == argc) {
+    printf("%-8s %8s %8s %8s %6s %8s %8s %8s %8s\n", "name", "periodUs", "cycles", "overruns",
+           "drops", "avgJitUs", "maxJitUs", "avgExeUs", "maxExeUs");
+    for (i = 0; i < ARRAY_SIZE(lPartitions); i++) {
+      stats = &lPartitionContexts[i].stats;
+      printf("%-8s %8u %8u %8u %6u %8u %8u %8u %8u\n", lPartitions[i].name,
+             (uint32_t)lPartitions[i].period, stats->cycles, stats->overruns,
+             APP_PARTITION_LOAD(stats->drops),
+             (0u != stats->cycles) ? (uint32_t)(stats->sumJitter / stats->cycles) : 0u,
+             (uint32_t)stats->maxJitter,
+             (0u != stats->cycles) ? (uint32_t)(stats->sumExec / stats->cycles) : 0u,
+             (uint32_t)stats->maxExec);
+    }
+  } else if ((2 == argc) && (0 == strcmp(argv[1], "reset"))) {
+    /* reset by the partition itself, so there is no race with its update */
+    for (i = 0; i < ARRAY_SIZE(lPartitions); i++) {
+      if (NULL != lPartitions[i].mains[0]) {
+        (void)App_PartitionPost(i, App_PartitionResetStats, &lPartitionContexts[i]);
+      } else {
+        APP_PARTITION_STORE(lPartitionContexts[i].stats.drops, 0);
+      }
+    }
+  } else {
+    ret = -1;
+  }
+
+  return ret;
+}
+SHELL_REGISTER(part,
+               "part [reset]\n"
+               "  show the cycles, overruns, dropped jobs, start jitter and execution time of the\n"
+               "  partitions of the main functions, or reset them\n",
+               partFunc);
+#endif
+#endif
+
 static void Net_Init(void) {
 #ifdef USE_VFS
   int ercd;
@@ -342,12 +593,20 @@ static void BSW_Init(void) {
 }
 
 void Task_MainLoop(void) {
+#ifdef APP_USE_PARTITION
+  App_PartitionInit();
+#endif
   BSW_Init();
   Net_Init();
   App_Init();
+#ifdef APP_USE_PARTITION
+  App_PartitionStart();
+#endif
   Std_TimerStart(&timer10ms);
   Std_TimerStart(&timer100ms);
   for (;;) {
+    /* one clock read for all the timers checked in this round */
+    Std_TimeLatch();
     if (Std_GetTimerElapsedTime(&timer10ms) >= 10000) {
       Std_TimerStart(&timer10ms);
       STD_TRACE_APP(MAIN_TASK_10MS_B);
@@ -359,6 +618,7 @@ void Task_MainLoop(void) {
       Std_TimerStart(&timer100ms);
       App_AliveIndicate();
     }
+    APP_BSW_LOCK();
 #ifdef USE_DCM
     Dcm_MainFunction_Request();
 #endif
@@ -386,6 +646,8 @@ void Task_MainLoop(void) {
     stdio_main_function();
 #endif
     STD_TRACE_APP_MAIN();
+    APP_BSW_UNLOCK();
+    Std_TimeUnlatch();
 #ifdef USE_OSAL
     OSAL_SleepUs(1000);
 #endif
@@ -402,6 +664,34 @@ void StartupHook(void) {
 }
 #endif
 /* ================================ [ FUNCTIONS ] ============================================== */
+#ifdef APP_USE_PARTITION
+Std_ReturnType App_PartitionPost(uint8_t partition, App_PartitionJobType job, void *arg) {
+  Std_ReturnType ret = E_NOT_OK;
+  App_PartitionContextType *context;
+
+  if ((partition < ARRAY_SIZE(lPartitions)) && (NULL != job)) {
+    context = &lPartitionContexts[partition];
+    if (NULL == lPartitions[partition].mains[0]) {
+      /* no thread is started for a partition without main functions, nothing would run it */
+      APP_PARTITION_INC(context->stats.drops);
+    } else {
+      OSAL_MutexLock(context->lock);
+      if (context->count < APP_PARTITION_QUEUE_SIZE) {
+        context->jobs[(context->head + context->count) % APP_PARTITION_QUEUE_SIZE].job = job;
+        context->jobs[(context->head + context->count) % APP_PARTITION_QUEUE_SIZE].arg = arg;
+        context->count++;
+        ret = E_OK;
+      } else {
+        APP_PARTITION_INC(context->stats.drops);
+      }
+      OSAL_MutexUnlock(context->lock);
+    }
+  }
+
+  return ret;
+}
+#endif
+
 #if defined(_WIN32) || defined(linux)
 void Can_ReConfig(uint8_t Controller, const char *device, int port, uint32_t baudrate);
 #endif
@@ -32,12 +32,18 @@ static const LinIf_ScheduleTableType scheduleTables[] = {
 
 static LinIf_ChannelContextType LinIf_ChannelContexts[1];
 static const LinIf_ChannelConfigType LinIf_ChannelCfgs[ARRAY_SIZE(LinIf_ChannelContexts)] = {
-  {LINIF_SLAVE, LINIF_TIMEOUT_US, 0},
+  {LINIF_SLAVE, LINIF_TIMEOUT_US, 0, LINIF_INVALD_SCHEDULE_TABLE, LINIF_INVALD_SCHEDULE_TABLE, 0},
 };
 
 const LinIf_ConfigType LinIf_Config = {
-  scheduleTables,        ARRAY_SIZE(scheduleTables),        LinIf_ChannelCfgs,
-  LinIf_ChannelContexts, ARRAY_SIZE(LinIf_ChannelContexts),
+  scheduleTables,
+  ARRAY_SIZE(scheduleTables),
+  LinIf_ChannelCfgs,
+  LinIf_ChannelContexts,
+  ARRAY_SIZE(LinIf_ChannelContexts),
+  NULL,
+  NULL,
+  0,
 };
 /* ================================ [ LOCALS    ] ============================================== */
 /* ================================ [ FUNCTIONS ] ============================================== */
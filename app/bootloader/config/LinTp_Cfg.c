@@ -41,6 +41,7 @@ static uint8_t u8P2PData[LINTP_LL_DL];
 static LinTp_ChannelConfigType LinTpChannelConfigs[] = {
   {
     /* P2P */
+    u8P2PData,
     CANTP_EXTENDED,
     0,
     0 /* PduR_RxPduId */,
@@ -54,7 +55,7 @@ static LinTp_ChannelConfigType LinTpChannelConfigs[] = {
     LINTP_CFG_RX_WFT_MAX,
     LINTP_LL_DL,
     LINTP_CFG_PADDING,
-    u8P2PData,
+    LINTP_PHYSICAL,
   },
 };
 
@@ -0,0 +1,125 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "CanIf.h"
+#include "CanIf_Cfg.h"
+#include "CanIf_Priv.h"
+#include "CanIf_Can.h"
+#include "Std_Timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/* ================================ [ MACROS    ] ============================================== */
+#ifndef CANIF_BENCH_FRAMES
+#define CANIF_BENCH_FRAMES 4096
+#endif
+#ifndef CANIF_BENCH_LOOPS
+#define CANIF_BENCH_LOOPS 1000
+#endif
+
+/* the networks of config/CanIf.json, the same rx PDUs with and without the hash */
+#define CANIF_BENCH_CTRL_HASH 0
+#define CANIF_BENCH_CTRL_SORTED 1
+/* ================================ [ TYPES     ] ============================================== */
+typedef void (*CanIfBench_DispatchFncType)(const Can_HwType *Mailbox, const PduInfoType *PduInfo);
+/* ================================ [ DECLARES  ] ============================================== */
+extern const CanIf_ConfigType CanIf_Config;
+void UserBench_RxIndication(PduIdType RxPduId, const PduInfoType *PduInfoPtr);
+void UserBench_TxConfirmation(PduIdType TxPduId, Std_ReturnType result);
+/* ================================ [ DATAS     ] ============================================== */
+static Can_HwType lFrames[CANIF_BENCH_FRAMES];
+static uint32_t lHits;
+/* ================================ [ LOCALS    ] ============================================== */
+/* the linear scan that the host builds did before the tables were sorted, as the reference */
+static void CanIfBench_Linear(const Can_HwType *Mailbox, const PduInfoType *PduInfo) {
+  const CanIf_CtrlConfigType *config = &CanIf_Config.CtrlConfigs[Mailbox->ControllerId];
+  const CanIf_RxPduType *var;
+  uint32_t canid = Mailbox->CanId & CANIF_RX_FULL_MASK;
+  uint16_t i;
+
+  for (i = 0; i < config->numOfRxPdus; i++) {
+    var = &config->rxPdus[i];
+    if (var->canid == (canid & var->mask)) {
+      var->rxInd(var->rxPduId, PduInfo);
+      break;
+    }
+  }
+}
+
+static void CanIfBench_Setup(uint8_t ControllerId) {
+  const CanIf_CtrlConfigType *config = &CanIf_Config.CtrlConfigs[ControllerId];
+  const CanIf_RxGroupType *group = &config->rxGroups[0];
+  uint32_t r;
+  uint32_t i;
+
+  srand(1);
+  for (i = 0; i < CANIF_BENCH_FRAMES; i++) {
+    r = (uint32_t)rand() % 100u;
+    if (r < 90u) {
+      /* the full CANID ones, which are the most of a real network */
+      lFrames[i].CanId = config->rxPdus[group->start + (rand() % group->numOfRxPdus)].canid;
+    } else if (r < 95u) {
+      lFrames[i].CanId = 0x98DA0000ul | ((uint32_t)rand() & 0xFFFFu); /* the masked diag ones */
+    } else {
+      lFrames[i].CanId = 0x700u + ((uint32_t)rand() & 0xFFu); /* not configured */
+    }
+    lFrames[i].Hoh = 0;
+    lFrames[i].ControllerId = ControllerId;
+  }
+}
+
+static void CanIfBench_Run(const char *name, CanIfBench_DispatchFncType dispatch, uint8_t ControllerId,
+                           uint32_t loops) {
+  uint8_t data[8] = {0};
+  PduInfoType PduInfo = {data, NULL, sizeof(data)};
+  uint64_t start;
+  uint64_t cost;
+  uint32_t i;
+  uint32_t n;
+
+  CanIfBench_Setup(ControllerId);
+  lHits = 0;
+  start = Std_GetTimeNs();
+  for (n = 0; n < loops; n++) {
+    for (i = 0; i < CANIF_BENCH_FRAMES; i++) {
+      dispatch(&lFrames[i], &PduInfo);
+    }
+  }
+  cost = Std_GetTimeNs() - start;
+
+  printf("%-8s %8.1f ns/frame, %u hits of %u frames\n", name,
+         (double)cost / ((double)loops * CANIF_BENCH_FRAMES), lHits, loops * CANIF_BENCH_FRAMES);
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+void UserBench_RxIndication(PduIdType RxPduId, const PduInfoType *PduInfoPtr) {
+  (void)RxPduId;
+  (void)PduInfoPtr;
+  lHits++;
+}
+
+void UserBench_TxConfirmation(PduIdType TxPduId, Std_ReturnType result) {
+  (void)TxPduId;
+  (void)result;
+}
+
+int main(int argc, char *argv[]) {
+  uint32_t loops = CANIF_BENCH_LOOPS;
+
+  if ((argc > 2) && (0 == strcmp(argv[1], "-n"))) {
+    loops = (uint32_t)strtoul(argv[2], NULL, 10);
+  } else if (argc > 1) {
+    printf("usage: %s [-n loops]\n", argv[0]);
+    return -1;
+  }
+
+  CanIf_Init(NULL);
+  printf("%u rx PDUs, %u frames each loop\n", CanIf_Config.CtrlConfigs[0].numOfRxPdus,
+         CANIF_BENCH_FRAMES);
+  CanIfBench_Run("linear", CanIfBench_Linear, CANIF_BENCH_CTRL_SORTED, loops);
+  CanIfBench_Run("sorted", CanIf_RxIndication, CANIF_BENCH_CTRL_SORTED, loops);
+  CanIfBench_Run("hash", CanIf_RxIndication, CANIF_BENCH_CTRL_HASH, loops);
+
+  return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "EthTSyn_Cfg.h"
+#include "EthTSyn_Priv.h"
+#include "EthTSyn.h"
+/* ================================ [ MACROS    ] ============================================== */
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* each process runs one of the configs, so the contexts are shared by them */
+static EthTSyn_MasterContextType EthTSyn_MasterContext0;
+static EthTSyn_PortContextType EthTSyn_MasterPortContext0;
+static const EthTSyn_GlobalTimeMasterType EthTSyn_GlobalTimeMaster0 = {
+  ETHTSYN_CONVERT_MS_TO_MAIN_CYCLES(125), /* GlobalTimeTxPeriod */
+  -3,                                     /* LogMessageInterval */
+};
+
+static EthTSyn_SlaveContextType EthTSyn_SlaveContext0;
+static EthTSyn_PortContextType EthTSyn_SlavePortContext0;
+static const EthTSyn_GlobalTimeSlaveType EthTSyn_GlobalTimeSlave0 = {
+  ETHTSYN_CONVERT_MS_TO_MAIN_CYCLES(100), /* GlobalTimeFollowUpTimeout */
+};
+
+/* both ends measure the pdelay and answer the Pdelay_Req of the other */
+static const EthTSyn_PdelayConfigType EthTSyn_Pdelay = {
+  0,                                       /* GlobalTimePropagationDelay */
+  1000000,                                 /* PdelayLatencyThreshold */
+  ETHTSYN_CONVERT_MS_TO_MAIN_CYCLES(1000), /* TxPdelayReqPeriod */
+  ETHTSYN_CONVERT_MS_TO_MAIN_CYCLES(100),  /* PdelayRespAndRespFollowUpTimeout */
+  TRUE,                                    /* GlobalTimePdelayRespEnable */
+};
+
+static const EthTSyn_SocketConfigType EthTSyn_MasterSocket = {
+  TCPIP_IPV4_ADDR(127, 0, 0, 1),    /* RemoteAddr */
+  ETHTSYNBENCH_MASTER_EVENT_PORT,   /* EventPort */
+  ETHTSYNBENCH_MASTER_GENERAL_PORT, /* GeneralPort */
+  ETHTSYNBENCH_SLAVE_EVENT_PORT,    /* RemoteEventPort */
+  ETHTSYNBENCH_SLAVE_GENERAL_PORT,  /* RemoteGeneralPort */
+  TCPIP_LOCALADDRID_LOCALHOST,      /* LocalAddrId */
+};
+
+static const EthTSyn_SocketConfigType EthTSyn_SlaveSocket = {
+  TCPIP_IPV4_ADDR(127, 0, 0, 1),    /* RemoteAddr */
+  ETHTSYNBENCH_SLAVE_EVENT_PORT,    /* EventPort */
+  ETHTSYNBENCH_SLAVE_GENERAL_PORT,  /* GeneralPort */
+  ETHTSYNBENCH_MASTER_EVENT_PORT,   /* RemoteEventPort */
+  ETHTSYNBENCH_MASTER_GENERAL_PORT, /* RemoteGeneralPort */
+  TCPIP_LOCALADDRID_LOCALHOST,      /* LocalAddrId */
+};
+
+static const EthTSyn_GlobalTimeDomainType EthTSyn_MasterDomains[2] = {
+  {
+    {{&EthTSyn_MasterContext0, &EthTSyn_GlobalTimeMaster0}},
+    &EthTSyn_MasterPortContext0,
+    &EthTSyn_Pdelay,
+    &EthTSyn_MasterSocket,
+    0,                             /* GlobalTimeDomainId */
+    TRUE,                          /* UseTimeStamp */
+    ETHTSYNBENCH_TIME_BASE_MASTER, /* SynchronizedTimeBaseRef */
+    ETHTSYN_MASTER,
+  },
+  {
+    {{&EthTSyn_MasterContext0, &EthTSyn_GlobalTimeMaster0}},
+    &EthTSyn_MasterPortContext0,
+    &EthTSyn_Pdelay,
+    &EthTSyn_MasterSocket,
+    0,                             /* GlobalTimeDomainId */
+    FALSE,                         /* UseTimeStamp */
+    ETHTSYNBENCH_TIME_BASE_MASTER, /* SynchronizedTimeBaseRef */
+    ETHTSYN_MASTER,
+  },
+};
+
+static const EthTSyn_GlobalTimeDomainType EthTSyn_SlaveDomains[2] = {
+  {
+    {{&EthTSyn_SlaveContext0, &EthTSyn_GlobalTimeSlave0}},
+    &EthTSyn_SlavePortContext0,
+    &EthTSyn_Pdelay,
+    &EthTSyn_SlaveSocket,
+    0,                            /* GlobalTimeDomainId */
+    TRUE,                         /* UseTimeStamp */
+    ETHTSYNBENCH_TIME_BASE_SLAVE, /* SynchronizedTimeBaseRef */
+    ETHTSYN_SLAVE,
+  },
+  {
+    {{&EthTSyn_SlaveContext0, &EthTSyn_GlobalTimeSlave0}},
+    &EthTSyn_SlavePortContext0,
+    &EthTSyn_Pdelay,
+    &EthTSyn_SlaveSocket,
+    0,                            /* GlobalTimeDomainId */
+    FALSE,                        /* UseTimeStamp */
+    ETHTSYNBENCH_TIME_BASE_SLAVE, /* SynchronizedTimeBaseRef */
+    ETHTSYN_SLAVE,
+  },
+};
+
+const EthTSyn_ConfigType EthTSyn_Config = {
+  &EthTSyn_MasterDomains[0],
+  1,
+};
+
+const EthTSyn_ConfigType EthTSyn_ConfigSlave = {
+  &EthTSyn_SlaveDomains[0],
+  1,
+};
+
+const EthTSyn_ConfigType EthTSyn_ConfigNoTimeStamp = {
+  &EthTSyn_MasterDomains[1],
+  1,
+};
+
+const EthTSyn_ConfigType EthTSyn_ConfigSlaveNoTimeStamp = {
+  &EthTSyn_SlaveDomains[1],
+  1,
+};
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
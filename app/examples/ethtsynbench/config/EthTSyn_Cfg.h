@@ -0,0 +1,36 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+#ifndef _ETH_TSYN_CFG_H
+#define _ETH_TSYN_CFG_H
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "EthTSyn.h"
+/* ================================ [ MACROS    ] ============================================== */
+#ifndef ETHTSYN_MAIN_FUNCTION_PERIOD
+#define ETHTSYN_MAIN_FUNCTION_PERIOD 5
+#endif
+#define ETHTSYN_CONVERT_MS_TO_MAIN_CYCLES(x)                                                       \
+  ((x + ETHTSYN_MAIN_FUNCTION_PERIOD - 1) / ETHTSYN_MAIN_FUNCTION_PERIOD)
+
+/* the time bases of the domains, each process has its own StbM */
+#define ETHTSYNBENCH_TIME_BASE_MASTER 0
+#define ETHTSYNBENCH_TIME_BASE_SLAVE 1
+
+/* the UDP ports on the 127.0.0.1 of the 2 processes, the 319 and 320 need the root */
+#define ETHTSYNBENCH_MASTER_EVENT_PORT 31900
+#define ETHTSYNBENCH_MASTER_GENERAL_PORT 32000
+#define ETHTSYNBENCH_SLAVE_EVENT_PORT 31901
+#define ETHTSYNBENCH_SLAVE_GENERAL_PORT 32001
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* the time master, and the time slave */
+extern const EthTSyn_ConfigType EthTSyn_Config;
+extern const EthTSyn_ConfigType EthTSyn_ConfigSlave;
+/* the same without the time stamps of the TcpIp */
+extern const EthTSyn_ConfigType EthTSyn_ConfigNoTimeStamp;
+extern const EthTSyn_ConfigType EthTSyn_ConfigSlaveNoTimeStamp;
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+#endif /* _ETH_TSYN_CFG_H */
@@ -0,0 +1,205 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "EthTSyn.h"
+#include "EthTSyn_Cfg.h"
+#include "StbM.h"
+#include "Std_Timer.h"
+#include "TcpIp.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+/* ================================ [ MACROS    ] ============================================== */
+#define ETHTSYNBENCH_DRIFT_PPB 50000       /* the clock of the time master runs 50 ppm fast */
+#define ETHTSYNBENCH_GLOBAL_S 1700000000ul /* the global time the time master starts with */
+#define ETHTSYNBENCH_SAMPLE_NS 1000000ull
+#define ETHTSYNBENCH_SETTLE_S 10 /* the offset is taken after the settle */
+#define ETHTSYNBENCH_END_S 30
+#define ETHTSYNBENCH_SAMPLES ((ETHTSYNBENCH_END_S - ETHTSYNBENCH_SETTLE_S) * 1000)
+#define ETHTSYNBENCH_NS_PER_SECOND 1000000000ull
+#define ETHTSYNBENCH_MAIN_NS ((uint64_t)ETHTSYN_MAIN_FUNCTION_PERIOD * 1000000ull)
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  const char *name;
+  const EthTSyn_ConfigType *master;
+  const EthTSyn_ConfigType *slave;
+} EthTSynBench_RunType;
+
+/* the global time of the time master is global + (t - local) * (1 + drift) at the local time t,
+ * the 2 processes have the same CLOCK_MONOTONIC, so the slave knows the master time by it */
+typedef struct {
+  uint64_t local;
+  uint64_t global;
+} EthTSynBench_ReferenceType;
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+static const EthTSynBench_RunType lRuns[] = {
+  {"SO_TIMESTAMPING", &EthTSyn_Config, &EthTSyn_ConfigSlave},
+  {"main function", &EthTSyn_ConfigNoTimeStamp, &EthTSyn_ConfigSlaveNoTimeStamp},
+};
+
+static int32_t lOffsets[ETHTSYNBENCH_SAMPLES];
+/* ================================ [ LOCALS    ] ============================================== */
+static uint64_t EthTSynBench_ToNs(const StbM_TimeStampType *timeStamp) {
+  return (((uint64_t)timeStamp->secondsHi << 32) + timeStamp->seconds) *
+           ETHTSYNBENCH_NS_PER_SECOND +
+         timeStamp->nanoseconds;
+}
+
+static uint64_t EthTSynBench_ToLocalNs(const StbM_VirtualLocalTimeType *localTime) {
+  return ((uint64_t)localTime->nanosecondsHi << 32) + localTime->nanosecondsLo;
+}
+
+static int EthTSynBench_Compare(const void *a, const void *b) {
+  int32_t x = *(const int32_t *)a;
+  int32_t y = *(const int32_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+static void EthTSynBench_SleepUntil(uint64_t deadline) {
+  struct timespec ts;
+
+  ts.tv_sec = deadline / ETHTSYNBENCH_NS_PER_SECOND;
+  ts.tv_nsec = deadline % ETHTSYNBENCH_NS_PER_SECOND;
+  while (0 != clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL)) {
+  }
+}
+
+/* the time master runs its main function until it is killed */
+static void EthTSynBench_Master(const EthTSynBench_RunType *run, int fd) {
+  StbM_TimeStampType global = {0, ETHTSYNBENCH_GLOBAL_S, 0, 0};
+  StbM_VirtualLocalTimeType local;
+  EthTSynBench_ReferenceType ref;
+  uint64_t deadline;
+
+  TcpIp_Init(NULL);
+  StbM_Init(NULL);
+  EthTSyn_Init(run->master);
+  (void)StbM_SetGlobalTime(ETHTSYNBENCH_TIME_BASE_MASTER, &global, NULL);
+  (void)StbM_SetRateCorrection(ETHTSYNBENCH_TIME_BASE_MASTER, ETHTSYNBENCH_DRIFT_PPB);
+  (void)StbM_BusGetCurrentTime(ETHTSYNBENCH_TIME_BASE_MASTER, &global, &local, NULL);
+  ref.local = EthTSynBench_ToLocalNs(&local);
+  ref.global = EthTSynBench_ToNs(&global);
+  if (sizeof(ref) != write(fd, &ref, sizeof(ref))) {
+    exit(-1);
+  }
+  close(fd);
+
+  deadline = Std_GetTimeNs();
+  for (;;) {
+    EthTSyn_MainFunction();
+    deadline += ETHTSYNBENCH_MAIN_NS;
+    EthTSynBench_SleepUntil(deadline);
+  }
+}
+
+/* the time slave runs its main function and samples its offset to the master each 1ms */
+static void EthTSynBench_Slave(const EthTSynBench_RunType *run, int fd) {
+  EthTSynBench_ReferenceType ref;
+  StbM_TimeStampType global;
+  StbM_VirtualLocalTimeType local;
+  StbM_RateDeviationType rate = 0;
+  uint64_t start, deadline, master, localNs;
+  int64_t sum = 0;
+  int32_t maxAbs = 0;
+  uint32_t n = 0;
+  uint32_t cycle = 0;
+
+  if (sizeof(ref) != read(fd, &ref, sizeof(ref))) {
+    exit(-1);
+  }
+  close(fd);
+
+  TcpIp_Init(NULL);
+  StbM_Init(NULL);
+  EthTSyn_Init(run->slave);
+
+  start = Std_GetTimeNs();
+  deadline = start;
+  while (n < ETHTSYNBENCH_SAMPLES) {
+    if (0 == (cycle % ETHTSYN_MAIN_FUNCTION_PERIOD)) {
+      EthTSyn_MainFunction();
+    }
+    cycle++;
+    if ((deadline - start) >= ((uint64_t)ETHTSYNBENCH_SETTLE_S * ETHTSYNBENCH_NS_PER_SECOND)) {
+      (void)StbM_BusGetCurrentTime(ETHTSYNBENCH_TIME_BASE_SLAVE, &global, &local, NULL);
+      localNs = EthTSynBench_ToLocalNs(&local);
+      master = ref.global + (localNs - ref.local) +
+               (localNs - ref.local) / ETHTSYNBENCH_NS_PER_SECOND * ETHTSYNBENCH_DRIFT_PPB +
+               (localNs - ref.local) % ETHTSYNBENCH_NS_PER_SECOND * ETHTSYNBENCH_DRIFT_PPB /
+                 ETHTSYNBENCH_NS_PER_SECOND;
+      lOffsets[n] = (int32_t)(int64_t)(EthTSynBench_ToNs(&global) - master);
+      sum += lOffsets[n];
+      if (abs(lOffsets[n]) > maxAbs) {
+        maxAbs = abs(lOffsets[n]);
+      }
+      n++;
+    }
+    deadline += ETHTSYNBENCH_SAMPLE_NS;
+    EthTSynBench_SleepUntil(deadline);
+  }
+
+  (void)StbM_GetRateDeviation(ETHTSYNBENCH_TIME_BASE_SLAVE, &rate);
+  qsort(lOffsets, n, sizeof(int32_t), EthTSynBench_Compare);
+  printf("%-18s %9.1f %9.1f %9.1f %9.1f %9d\n", run->name, (double)sum / n / 1000.0,
+         lOffsets[n / 100] / 1000.0, lOffsets[n - 1 - n / 100] / 1000.0, maxAbs / 1000.0,
+         (int)rate);
+  fflush(stdout);
+}
+
+static void EthTSynBench_Run(const EthTSynBench_RunType *run) {
+  int fds[2];
+  pid_t master, slave;
+
+  if (0 != pipe(fds)) {
+    printf("pipe failed\n");
+    return;
+  }
+
+  slave = fork();
+  if (0 == slave) {
+    close(fds[1]);
+    EthTSynBench_Slave(run, fds[0]);
+    exit(0);
+  }
+
+  master = fork();
+  if (0 == master) {
+    close(fds[0]);
+    EthTSynBench_Master(run, fds[1]);
+    exit(0);
+  }
+
+  close(fds[0]);
+  close(fds[1]);
+  (void)waitpid(slave, NULL, 0);
+  (void)kill(master, SIGTERM);
+  (void)waitpid(master, NULL, 0);
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+int main(int argc, char *argv[]) {
+  size_t i;
+
+  (void)argc;
+  (void)argv;
+
+  printf("2 processes on the loopback, the time master runs %d ppm fast, a Sync each 125ms, "
+         "the offset of %ds after %ds\n",
+         ETHTSYNBENCH_DRIFT_PPB / 1000, ETHTSYNBENCH_END_S - ETHTSYNBENCH_SETTLE_S,
+         ETHTSYNBENCH_SETTLE_S);
+  printf("%-18s %9s %9s %9s %9s %9s\n", "time stamp", "mean us", "p1 us", "p99 us", "max us",
+         "rate ppb");
+  fflush(stdout);
+  for (i = 0; i < ARRAY_SIZE(lRuns); i++) {
+    EthTSynBench_Run(&lRuns[i]);
+  }
+
+  return 0;
+}
@@ -0,0 +1,141 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "LinIf_Internal.h"
+#include "LinTp.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define LINIF_SLOT_US 10000
+#define LINIF_TIMEOUT_US 5000
+#define LINIF_P2_US 50000
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+Std_ReturnType LinIfBench_Callback(uint8_t channel, Lin_PduType *frame,
+                                   Std_ReturnType notifyResult);
+static Std_ReturnType LinIf_DiagMRFCallback(uint8_t channel, Lin_PduType *frame,
+                                            Std_ReturnType notifyResult);
+static Std_ReturnType LinIf_DiagSRFCallback(uint8_t channel, Lin_PduType *frame,
+                                            Std_ReturnType notifyResult);
+/* ================================ [ DATAS     ] ============================================== */
+static const PduIdType sporadicTxPdus[] = {LINIF_BENCH_TX_SPORADIC_A, LINIF_BENCH_TX_SPORADIC_B};
+
+static LinIf_ScheduleTableEntryType entrysApplicative[] = {
+  {LINIF_BENCH_ID_UNCONDITIONAL, 8, LINIF_UNCONDITIONAL, LIN_ENHANCED_CS, LIN_FRAMERESPONSE_RX,
+   LinIfBench_Callback, LINIF_SLOT_US, NULL, 0, LINIF_INVALD_SCHEDULE_TABLE},
+  {LINIF_BENCH_ID_EVENT, 8, LINIF_EVENT, LIN_ENHANCED_CS, LIN_FRAMERESPONSE_RX, LinIfBench_Callback,
+   LINIF_SLOT_US, NULL, 0, LINIF_BENCH_SCH_COLLISION},
+  {LINIF_BENCH_ID_SPORADIC, 8, LINIF_SPORADIC, LIN_ENHANCED_CS, LIN_FRAMERESPONSE_TX, NULL,
+   LINIF_SLOT_US, sporadicTxPdus, ARRAY_SIZE(sporadicTxPdus), LINIF_INVALD_SCHEDULE_TABLE},
+};
+
+static LinIf_ScheduleTableEntryType entrysDiagRequest[] = {
+  {0x3C, 8, LINIF_DIAG_MRF, LIN_CLASSIC_CS, LIN_FRAMERESPONSE_TX, LinIf_DiagMRFCallback,
+   LINIF_SLOT_US, NULL, 0, LINIF_INVALD_SCHEDULE_TABLE},
+};
+
+static LinIf_ScheduleTableEntryType entrysDiagResponse[] = {
+  {0x3D, 8, LINIF_DIAG_SRF, LIN_CLASSIC_CS, LIN_FRAMERESPONSE_RX, LinIf_DiagSRFCallback,
+   LINIF_SLOT_US, NULL, 0, LINIF_INVALD_SCHEDULE_TABLE},
+};
+
+static LinIf_ScheduleTableEntryType entrysCollision[] = {
+  {LINIF_BENCH_ID_EVENT_A, 8, LINIF_UNCONDITIONAL, LIN_ENHANCED_CS, LIN_FRAMERESPONSE_RX,
+   LinIfBench_Callback, LINIF_SLOT_US, NULL, 0, LINIF_INVALD_SCHEDULE_TABLE},
+  {LINIF_BENCH_ID_EVENT_B, 8, LINIF_UNCONDITIONAL, LIN_ENHANCED_CS, LIN_FRAMERESPONSE_RX,
+   LinIfBench_Callback, LINIF_SLOT_US, NULL, 0, LINIF_INVALD_SCHEDULE_TABLE},
+};
+
+/* the slave looks up the header by a binary search, so in the order of the id */
+static const LinIf_ScheduleTableEntryType entrysSlave[] = {
+  {LINIF_BENCH_ID_UNCONDITIONAL, 8, LINIF_UNCONDITIONAL, LIN_ENHANCED_CS, LIN_FRAMERESPONSE_TX,
+   LinIfBench_Callback, 0, NULL, 0, LINIF_INVALD_SCHEDULE_TABLE},
+  {LINIF_BENCH_ID_EVENT, 8, LINIF_EVENT, LIN_ENHANCED_CS, LIN_FRAMERESPONSE_TX, LinIfBench_Callback,
+   0, NULL, 0, LINIF_INVALD_SCHEDULE_TABLE},
+  {LINIF_BENCH_ID_EVENT_A, 8, LINIF_UNCONDITIONAL, LIN_ENHANCED_CS, LIN_FRAMERESPONSE_TX,
+   LinIfBench_Callback, 0, NULL, 0, LINIF_INVALD_SCHEDULE_TABLE},
+  {LINIF_BENCH_ID_EVENT_B, 8, LINIF_UNCONDITIONAL, LIN_ENHANCED_CS, LIN_FRAMERESPONSE_TX,
+   LinIfBench_Callback, 0, NULL, 0, LINIF_INVALD_SCHEDULE_TABLE},
+  {LINIF_BENCH_ID_SPORADIC_A, 8, LINIF_UNCONDITIONAL, LIN_ENHANCED_CS, LIN_FRAMERESPONSE_RX,
+   LinIfBench_Callback, 0, NULL, 0, LINIF_INVALD_SCHEDULE_TABLE},
+  {LINIF_BENCH_ID_SPORADIC_B, 8, LINIF_UNCONDITIONAL, LIN_ENHANCED_CS, LIN_FRAMERESPONSE_RX,
+   LinIfBench_Callback, 0, NULL, 0, LINIF_INVALD_SCHEDULE_TABLE},
+  {0x3C, 8, LINIF_DIAG_MRF, LIN_CLASSIC_CS, LIN_FRAMERESPONSE_RX, LinIf_DiagMRFCallback, 0, NULL, 0,
+   LINIF_INVALD_SCHEDULE_TABLE},
+  {0x3D, 8, LINIF_DIAG_SRF, LIN_CLASSIC_CS, LIN_FRAMERESPONSE_TX, LinIf_DiagSRFCallback, 0, NULL, 0,
+   LINIF_INVALD_SCHEDULE_TABLE},
+};
+
+static const LinIf_ScheduleTableType scheduleTables[] = {
+  {entrysApplicative, ARRAY_SIZE(entrysApplicative)},
+  {entrysDiagRequest, ARRAY_SIZE(entrysDiagRequest)},
+  {entrysDiagResponse, ARRAY_SIZE(entrysDiagResponse)},
+  {entrysCollision, ARRAY_SIZE(entrysCollision)},
+  {entrysSlave, ARRAY_SIZE(entrysSlave)},
+};
+
+static const LinIf_ScheduleTableEntryType LinIf_TxPdus[] = {
+  {LINIF_BENCH_ID_SPORADIC_A, 8, LINIF_UNCONDITIONAL, LIN_ENHANCED_CS, LIN_FRAMERESPONSE_TX,
+   LinIfBench_Callback, 0, NULL, 0, LINIF_INVALD_SCHEDULE_TABLE},
+  {LINIF_BENCH_ID_SPORADIC_B, 8, LINIF_UNCONDITIONAL, LIN_ENHANCED_CS, LIN_FRAMERESPONSE_TX,
+   LinIfBench_Callback, 0, NULL, 0, LINIF_INVALD_SCHEDULE_TABLE},
+};
+
+static boolean LinIf_TxPending[ARRAY_SIZE(LinIf_TxPdus)];
+
+static LinIf_ChannelContextType LinIf_ChannelContexts[2];
+static const LinIf_ChannelConfigType LinIf_ChannelCfgs[ARRAY_SIZE(LinIf_ChannelContexts)] = {
+  {LINIF_MASTER, LINIF_TIMEOUT_US, LINIF_BENCH_MASTER, LINIF_BENCH_SCH_DIAG_REQUEST,
+   LINIF_BENCH_SCH_DIAG_RESPONSE, LINIF_P2_US},
+  {LINIF_SLAVE, LINIF_TIMEOUT_US, LINIF_BENCH_SLAVE, LINIF_INVALD_SCHEDULE_TABLE,
+   LINIF_INVALD_SCHEDULE_TABLE, 0},
+};
+
+const LinIf_ConfigType LinIf_Config = {
+  scheduleTables,
+  ARRAY_SIZE(scheduleTables),
+  LinIf_ChannelCfgs,
+  LinIf_ChannelContexts,
+  ARRAY_SIZE(LinIf_ChannelContexts),
+  LinIf_TxPdus,
+  LinIf_TxPending,
+  ARRAY_SIZE(LinIf_TxPdus),
+};
+/* ================================ [ LOCALS    ] ============================================== */
+static Std_ReturnType LinIf_DiagMRFCallback(uint8_t channel, Lin_PduType *frame,
+                                            Std_ReturnType notifyResult) {
+  Std_ReturnType r = LINIF_R_NOT_OK;
+  PduInfoType pduInfo;
+
+  pduInfo.SduDataPtr = frame->SduPtr;
+  pduInfo.SduLength = frame->Dl;
+  if (LINIF_R_TRIGGER_TRANSMIT == notifyResult) {
+    r = LinTp_TriggerTransmit(channel, &pduInfo);
+  } else if (LINIF_R_RECEIVED_OK == notifyResult) {
+    LinTp_RxIndication(channel, &pduInfo);
+    r = LINIF_R_OK;
+  } else {
+    r = LINIF_R_OK;
+  }
+
+  return r;
+}
+
+static Std_ReturnType LinIf_DiagSRFCallback(uint8_t channel, Lin_PduType *frame,
+                                            Std_ReturnType notifyResult) {
+  return LinIf_DiagMRFCallback(channel, frame, notifyResult);
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+/* the slots of the master, which are the LIN frame time of the baudrate plus a margin */
+void LinIfBench_ReConfig(uint32_t slotUs) {
+  uint32_t i;
+
+  for (i = 0; i < ARRAY_SIZE(entrysApplicative); i++) {
+    entrysApplicative[i].delay = slotUs;
+  }
+  for (i = 0; i < ARRAY_SIZE(entrysCollision); i++) {
+    entrysCollision[i].delay = slotUs;
+  }
+  entrysDiagRequest[0].delay = slotUs;
+  entrysDiagResponse[0].delay = slotUs;
+}
@@ -0,0 +1,35 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+#ifndef LINIF_CFG_H
+#define LINIF_CFG_H
+/* ================================ [ INCLUDES  ] ============================================== */
+/* ================================ [ MACROS    ] ============================================== */
+/* the LinIf channels, the master is the tester and the slave the ECU, on the same bus */
+#define LINIF_BENCH_MASTER 0
+#define LINIF_BENCH_SLAVE 1
+
+#define LINIF_BENCH_SCH_APPLICATIVE 0
+#define LINIF_BENCH_SCH_DIAG_REQUEST 1
+#define LINIF_BENCH_SCH_DIAG_RESPONSE 2
+#define LINIF_BENCH_SCH_COLLISION 3
+#define LINIF_BENCH_SCH_SLAVE 4
+
+#define LINIF_BENCH_ID_UNCONDITIONAL 0x10
+#define LINIF_BENCH_ID_EVENT 0x11
+#define LINIF_BENCH_ID_SPORADIC 0x12
+#define LINIF_BENCH_ID_EVENT_A 0x20 /* the frames associated with the event triggered one */
+#define LINIF_BENCH_ID_EVENT_B 0x21
+#define LINIF_BENCH_ID_SPORADIC_A 0x30 /* the frames of the sporadic slot */
+#define LINIF_BENCH_ID_SPORADIC_B 0x31
+
+/* the LinTxPduIds of the sporadic frames */
+#define LINIF_BENCH_TX_SPORADIC_A 0
+#define LINIF_BENCH_TX_SPORADIC_B 1
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+#endif /* LINIF_CFG_H */
@@ -0,0 +1,70 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "LinTp_Cfg.h"
+#include "LinTp.h"
+#include "LinTp_Priv.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define LINTP_CFG_N_As 1000
+#define LINTP_CFG_N_Bs 1000
+#define LINTP_CFG_N_Cr 200
+#define LINTP_CFG_STMIN 0
+#define LINTP_CFG_BS 0
+#define LINTP_CFG_RX_WFT_MAX 8
+#define LINTP_CFG_PADDING 0xFF
+
+#define LINTP_LL_DL 8
+#define LINTP_NAD 0x01 /* the NAD of the slave */
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+static uint8_t u8MasterData[LINTP_LL_DL];
+static uint8_t u8SlaveData[LINTP_LL_DL];
+static const LinTp_ChannelConfigType LinTpChannelConfigs[] = {
+  {
+    u8MasterData,
+    CANTP_EXTENDED,
+    LINTP_BENCH_MASTER,
+    LINTP_BENCH_MASTER /* PduR_RxPduId */,
+    LINTP_BENCH_MASTER /* PduR_TxPduId */,
+    LINTP_CONVERT_MS_TO_MAIN_CYCLES(LINTP_CFG_N_As),
+    LINTP_CONVERT_MS_TO_MAIN_CYCLES(LINTP_CFG_N_Bs),
+    LINTP_CONVERT_MS_TO_MAIN_CYCLES(LINTP_CFG_N_Cr),
+    LINTP_CFG_STMIN,
+    LINTP_CFG_BS,
+    LINTP_NAD,
+    LINTP_CFG_RX_WFT_MAX,
+    LINTP_LL_DL,
+    LINTP_CFG_PADDING,
+    LINTP_PHYSICAL,
+  },
+  {
+    u8SlaveData,
+    CANTP_EXTENDED,
+    LINTP_BENCH_SLAVE,
+    LINTP_BENCH_SLAVE /* PduR_RxPduId */,
+    LINTP_BENCH_SLAVE /* PduR_TxPduId */,
+    LINTP_CONVERT_MS_TO_MAIN_CYCLES(LINTP_CFG_N_As),
+    LINTP_CONVERT_MS_TO_MAIN_CYCLES(LINTP_CFG_N_Bs),
+    LINTP_CONVERT_MS_TO_MAIN_CYCLES(LINTP_CFG_N_Cr),
+    LINTP_CFG_STMIN,
+    LINTP_CFG_BS,
+    LINTP_NAD,
+    LINTP_CFG_RX_WFT_MAX,
+    LINTP_LL_DL,
+    LINTP_CFG_PADDING,
+    LINTP_PHYSICAL,
+  },
+};
+
+static LinTp_ChannelContextType LinTpChannelContexts[ARRAY_SIZE(LinTpChannelConfigs)];
+
+const LinTp_ConfigType LinTp_Config = {
+  LinTpChannelConfigs,
+  LinTpChannelContexts,
+  ARRAY_SIZE(LinTpChannelConfigs),
+};
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
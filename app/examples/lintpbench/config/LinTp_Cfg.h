@@ -0,0 +1,23 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+#ifndef LINTP_CFG_H
+#define LINTP_CFG_H
+/* ================================ [ INCLUDES  ] ============================================== */
+/* ================================ [ MACROS    ] ============================================== */
+/* the LinTp channel of the same index as the LinIf one */
+#define LINTP_BENCH_MASTER 0
+#define LINTP_BENCH_SLAVE 1
+
+#define LINTP_MAIN_FUNCTION_PERIOD 10
+#define LINTP_CONVERT_MS_TO_MAIN_CYCLES(x)                                                         \
+  ((x + LINTP_MAIN_FUNCTION_PERIOD - 1) / LINTP_MAIN_FUNCTION_PERIOD)
+
+#define CANTP_CONVERT_MS_TO_MAIN_CYCLES(x) LINTP_CONVERT_MS_TO_MAIN_CYCLES(x)
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+#endif /* LINTP_CFG_H */
@@ -0,0 +1,338 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "LinIf_Internal.h"
+#include "LinTp.h"
+#include "LinTp_Cfg.h"
+#include "PduR_LinTp.h"
+#include "Std_Timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/* ================================ [ MACROS    ] ============================================== */
+#define LINBENCH_TICK_US 1000 /* the period of the LinIf main function */
+#define LINBENCH_MAX_SIZE 4095
+#define LINBENCH_TIMEOUT_US 30000000
+
+/* a frame has the 34 bits header, then the data and the checksum of 10 bits each */
+#define LINBENCH_FRAME_BITS(dl) (34u + 10u * ((uint32_t)(dl) + 1u))
+/* ================================ [ TYPES     ] ============================================== */
+/* the bus between the master channel and the slave channel */
+typedef struct {
+  Lin_StatusType status;
+  Lin_FrameResponseType Drc;
+  std_time_t doneTime; /* when the frame is over on the bus */
+  uint8_t data[8];
+} LinBench_BusType;
+
+typedef struct {
+  uint8_t data[LINBENCH_MAX_SIZE];
+  PduLengthType length;
+  PduLengthType index;
+  boolean done;
+} LinBench_BufferType;
+/* ================================ [ DECLARES  ] ============================================== */
+extern const LinIf_ConfigType LinIf_Config;
+void LinIfBench_ReConfig(uint32_t slotUs);
+Std_ReturnType LinIfBench_Callback(uint8_t channel, Lin_PduType *frame,
+                                   Std_ReturnType notifyResult);
+/* ================================ [ DATAS     ] ============================================== */
+static LinBench_BusType lBus;
+static uint32_t lBaudrate = 19200;
+static LinBench_BufferType lTx[2];
+static LinBench_BufferType lRx[2];
+static uint32_t lFrames[0x40]; /* the frames received by the master and the slave of each id */
+static uint32_t lMRFs;
+static boolean lEventUpdated; /* the slave has an update for the event triggered frame */
+static uint32_t lCollisions;  /* the headers of the event triggered frame to collide */
+static uint32_t lSlot;        /* the slot of the master frames in us */
+/* ================================ [ LOCALS    ] ============================================== */
+static uint32_t LinBench_FrameTime(Lin_FrameDlType dl) {
+  return (uint32_t)((uint64_t)LINBENCH_FRAME_BITS(dl) * 1000000u / lBaudrate);
+}
+
+static void LinBench_Step(void) {
+  static uint32_t ticks = 0;
+
+  Std_TimeStep((uint64_t)LINBENCH_TICK_US * 1000u);
+  LinIf_MainFunction();
+  ticks++;
+  if (ticks >= (LINTP_MAIN_FUNCTION_PERIOD * 1000u / LINBENCH_TICK_US)) {
+    ticks = 0;
+    LinTp_MainFunction();
+  }
+}
+
+static void LinBench_Run(uint32_t us) {
+  std_time_t start = Std_GetTime();
+
+  while ((Std_GetTime() - start) < us) {
+    LinBench_Step();
+  }
+}
+
+static void LinBench_Applicative(void) {
+  memset(lFrames, 0, sizeof(lFrames));
+  LinBench_Run(1000000);
+  LinIf_Transmit(LINIF_BENCH_TX_SPORADIC_B, NULL);
+  LinIf_Transmit(LINIF_BENCH_TX_SPORADIC_A, NULL);
+  LinBench_Run(200000);
+  lEventUpdated = TRUE;
+  LinBench_Run(200000);
+  lEventUpdated = TRUE;
+  lCollisions = 1;
+  LinBench_Run(200000);
+  printf("applicative: unconditional %u, event triggered %u, collision resolved %u/%u, "
+         "sporadic %u/%u\n",
+         lFrames[LINIF_BENCH_ID_UNCONDITIONAL], lFrames[LINIF_BENCH_ID_EVENT],
+         lFrames[LINIF_BENCH_ID_EVENT_A], lFrames[LINIF_BENCH_ID_EVENT_B],
+         lFrames[LINIF_BENCH_ID_SPORADIC_A], lFrames[LINIF_BENCH_ID_SPORADIC_B]);
+}
+
+static int LinBench_Transfer(PduLengthType size) {
+  LinBench_BufferType *tx = &lTx[LINTP_BENCH_MASTER];
+  PduInfoType pduInfo = {NULL, NULL, size};
+  std_time_t start;
+  std_time_t cost;
+  uint32_t frames;
+  PduLengthType i;
+  int r = 0;
+
+  for (i = 0; i < size; i++) {
+    tx->data[i] = (uint8_t)(i * 7 + size);
+  }
+  tx->length = size;
+  tx->index = 0;
+  lRx[LINTP_BENCH_MASTER].done = FALSE;
+  lRx[LINTP_BENCH_SLAVE].done = FALSE;
+  lMRFs = 0;
+
+  start = Std_GetTime();
+  if (E_OK != LinTp_Transmit(LINTP_BENCH_MASTER, &pduInfo)) {
+    r = -1;
+  }
+  while ((0 == r) && (FALSE == lRx[LINTP_BENCH_MASTER].done)) {
+    LinBench_Step();
+    if ((Std_GetTime() - start) > LINBENCH_TIMEOUT_US) {
+      r = -2;
+    }
+  }
+  cost = Std_GetTime() - start;
+
+  if ((0 == r) && ((lRx[LINTP_BENCH_SLAVE].length != size) ||
+                   (0 != memcmp(lRx[LINTP_BENCH_SLAVE].data, tx->data, size)))) {
+    r = -3;
+  }
+
+  /* the request needs 1 FF and then 1 CF of each 6 bytes */
+  frames = (size <= 6) ? 1 : (1 + (size - 5 + 5) / 6);
+  printf("%5u bytes: %8.1f ms, %6.1f B/s, %4u MRF (%u min), slot %u us, %s\n", size,
+         (double)cost / 1000.0, (double)size * 1000000.0 / (double)cost, lMRFs, frames, lSlot,
+         (0 == r) ? "OK" : "FAIL");
+  LinBench_Run(100000); /* back to the applicative schedule */
+
+  if ((0 == r) && (LINTP_APPLICATIVE_SCHEDULE != LinIf_Config.channelContexts[0].tpMode)) {
+    r = -4;
+  }
+
+  return r;
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+void Lin_Init(const Lin_ConfigType *ConfigPtr) {
+  (void)ConfigPtr;
+  memset(&lBus, 0, sizeof(lBus));
+  lBus.status = LIN_OPERATIONAL;
+}
+
+Std_ReturnType Lin_SetControllerMode(uint8_t Channel, Lin_ControllerStateType Transition) {
+  (void)Channel;
+  (void)Transition;
+  return E_OK;
+}
+
+/* the master sends the header and the slave LinIf responds at once, the result is seen by the
+ * master at the end of the frame time */
+Std_ReturnType Lin_SendFrame(uint8_t Channel, const Lin_PduType *PduInfoPtr) {
+  Lin_PduType slave;
+  Std_ReturnType ret;
+  Lin_FrameDlType dl = 0;
+
+  if (LINIF_BENCH_MASTER != Channel) {
+    return E_NOT_OK;
+  }
+
+  slave.Pid = PduInfoPtr->Pid;
+  slave.Dl = 0;
+  slave.Drc = LIN_FRAMERESPONSE_IGNORE;
+  slave.SduPtr = NULL;
+  ret = LinIf_HeaderIndication(LINIF_BENCH_SLAVE, &slave);
+  lBus.Drc = PduInfoPtr->Drc;
+  if (LIN_FRAMERESPONSE_TX == PduInfoPtr->Drc) {
+    dl = PduInfoPtr->Dl;
+    if ((E_OK == ret) && (LIN_FRAMERESPONSE_RX == slave.Drc)) {
+      LinIf_RxIndication(LINIF_BENCH_SLAVE, PduInfoPtr->SduPtr);
+    }
+    lBus.status = LIN_TX_OK;
+  } else if ((E_OK == ret) && (LIN_FRAMERESPONSE_TX == slave.Drc)) {
+    dl = slave.Dl;
+    memcpy(lBus.data, slave.SduPtr, dl);
+    lBus.status = LIN_RX_OK;
+    if ((LINIF_BENCH_ID_EVENT == PduInfoPtr->Pid) && (lCollisions > 0u)) {
+      /* another slave responds at the same time */
+      lCollisions--;
+      lBus.status = LIN_RX_ERROR;
+    }
+  } else {
+    lBus.status = LIN_RX_NO_RESPONSE;
+  }
+
+  if (0x3C == PduInfoPtr->Pid) {
+    lMRFs++;
+  }
+  lBus.doneTime = Std_GetTime() + LinBench_FrameTime(dl);
+
+  return E_OK;
+}
+
+Lin_StatusType Lin_GetStatus(uint8_t Channel, uint8_t **Lin_SduPtr) {
+  Lin_StatusType status = lBus.status;
+
+  (void)Channel;
+  *Lin_SduPtr = NULL;
+  if (Std_GetTime() < lBus.doneTime) {
+    status = (LIN_FRAMERESPONSE_TX == lBus.Drc) ? LIN_TX_BUSY : LIN_RX_BUSY;
+  } else if (LIN_RX_OK == status) {
+    *Lin_SduPtr = lBus.data;
+  } else {
+    /* the result */
+  }
+
+  return status;
+}
+
+Std_ReturnType LinIfBench_Callback(uint8_t channel, Lin_PduType *frame,
+                                   Std_ReturnType notifyResult) {
+  Std_ReturnType r = LINIF_R_OK;
+
+  if (LINIF_R_TRIGGER_TRANSMIT == notifyResult) {
+    memset(frame->SduPtr, (int)frame->Pid, frame->Dl);
+    if (LINIF_BENCH_ID_EVENT == frame->Pid) {
+      if (lEventUpdated) {
+        lEventUpdated = FALSE;
+        frame->SduPtr[0] = LINIF_BENCH_ID_EVENT_A; /* the id of the associated frame */
+      } else {
+        r = LINIF_R_NOT_OK; /* no update, no response */
+      }
+    }
+  } else if (LINIF_R_RECEIVED_OK == notifyResult) {
+    lFrames[frame->Pid & 0x3F]++;
+  } else {
+    /* tx completed */
+  }
+
+  (void)channel;
+  return r;
+}
+
+BufReq_ReturnType PduR_LinTpStartOfReception(PduIdType id, const PduInfoType *info,
+                                             PduLengthType TpSduLength,
+                                             PduLengthType *bufferSizePtr) {
+  BufReq_ReturnType ret = BUFREQ_E_OVFL;
+
+  (void)info;
+  if (TpSduLength <= LINBENCH_MAX_SIZE) {
+    lRx[id].length = TpSduLength;
+    lRx[id].index = 0;
+    *bufferSizePtr = TpSduLength;
+    ret = BUFREQ_OK;
+  }
+
+  return ret;
+}
+
+BufReq_ReturnType PduR_LinTpCopyRxData(PduIdType id, const PduInfoType *info,
+                                       PduLengthType *bufferSizePtr) {
+  BufReq_ReturnType ret = BUFREQ_E_NOT_OK;
+  LinBench_BufferType *rx = &lRx[id];
+
+  if ((rx->index + info->SduLength) <= rx->length) {
+    memcpy(&rx->data[rx->index], info->SduDataPtr, info->SduLength);
+    rx->index += info->SduLength;
+    *bufferSizePtr = rx->length - rx->index;
+    ret = BUFREQ_OK;
+  }
+
+  return ret;
+}
+
+void PduR_LinTpRxIndication(PduIdType id, Std_ReturnType result) {
+  PduInfoType pduInfo = {NULL, NULL, 2};
+
+  if ((E_OK == result) && (LINTP_BENCH_SLAVE == id)) {
+    /* the positive response of the transfer data */
+    lTx[id].data[0] = 0x76;
+    lTx[id].data[1] = 0x01;
+    lTx[id].length = 2;
+    lTx[id].index = 0;
+    (void)LinTp_Transmit(LINTP_BENCH_SLAVE, &pduInfo);
+  }
+  lRx[id].done = (E_OK == result);
+}
+
+BufReq_ReturnType PduR_LinTpCopyTxData(PduIdType id, const PduInfoType *info,
+                                       const RetryInfoType *retry,
+                                       PduLengthType *availableDataPtr) {
+  BufReq_ReturnType ret = BUFREQ_E_NOT_OK;
+  LinBench_BufferType *tx = &lTx[id];
+
+  (void)retry;
+  if ((tx->index + info->SduLength) <= tx->length) {
+    memcpy(info->SduDataPtr, &tx->data[tx->index], info->SduLength);
+    tx->index += info->SduLength;
+    *availableDataPtr = tx->length - tx->index;
+    ret = BUFREQ_OK;
+  }
+
+  return ret;
+}
+
+void PduR_LinTpTxConfirmation(PduIdType id, Std_ReturnType result) {
+  (void)id;
+  (void)result;
+}
+
+int main(int argc, char *argv[]) {
+  static const PduLengthType sizes[] = {6, 64, 512, LINBENCH_MAX_SIZE};
+  int r = 0;
+  int i;
+
+  if ((argc > 2) && (0 == strcmp(argv[1], "-b"))) {
+    lBaudrate = (uint32_t)strtoul(argv[2], NULL, 10);
+  } else if (argc > 1) {
+    printf("usage: %s [-b baudrate]\n", argv[0]);
+    return -1;
+  }
+
+  /* the slot is the max frame time, 1.4 times of the nominal, rounded up to the main periods */
+  lSlot = LinBench_FrameTime(8) * 14u / 10u;
+  lSlot = ((lSlot + LINBENCH_TICK_US - 1u) / LINBENCH_TICK_US) * LINBENCH_TICK_US;
+  LinIfBench_ReConfig(lSlot);
+
+  Std_TimeSetVirtual(TRUE);
+  Lin_Init(NULL);
+  LinIf_Init(NULL);
+  LinTp_Init(NULL);
+  LinIf_ScheduleRequest(LINIF_BENCH_MASTER, LINIF_BENCH_SCH_APPLICATIVE);
+  LinIf_ScheduleRequest(LINIF_BENCH_SLAVE, LINIF_BENCH_SCH_SLAVE);
+
+  printf("%u baud, %u us of a 8 bytes frame\n", lBaudrate, LinBench_FrameTime(8));
+  LinBench_Applicative();
+  for (i = 0; (0 == r) && (i < (int)ARRAY_SIZE(sizes)); i++) {
+    r = LinBench_Transfer(sizes[i]);
+  }
+  LinBench_Applicative();
+
+  return r;
+}
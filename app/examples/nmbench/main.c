@@ -0,0 +1,296 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Nm.h"
+#include "NmCore.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/* ================================ [ MACROS    ] ============================================== */
+#define NMBENCH_NODES 30
+#define NMBENCH_PNS 6           /* the node i is the member of the PN i%6 */
+#define NMBENCH_PERIOD 10       /* ms, of the NM main function */
+#define NMBENCH_PN_WATCHED 1    /* the PN of the requesters */
+#define NMBENCH_NODE_WATCHED 19 /* a passive member of the PN 1, whose EIRA is traced */
+#define NMBENCH_MAX_FRAMES 64
+#define NMBENCH_END_MS 40000
+
+#define NMBENCH_MS(x) ((x) / NMBENCH_PERIOD)
+
+#define NMBENCH_PN_INFO_OFFSET 4
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  const char *name;
+  boolean busLoadReduction;
+  boolean partialNetworking;
+} NmBench_RunType;
+
+typedef struct {
+  uint8_t node;
+  uint32_t requestMs;
+  uint32_t releaseMs;
+} NmBench_RequesterType;
+
+typedef struct {
+  uint8_t node;
+  uint8_t data[8];
+} NmBench_FrameType;
+
+typedef struct {
+  uint32_t woken;
+  uint32_t msgs;
+  uint32_t steadyMsgs; /* within 10s to 20s */
+  uint32_t awakeTicks; /* of all the nodes */
+  uint32_t asleepMs;   /* since when all the nodes are in the bus sleep */
+  int32_t eiraSetMs;
+  int32_t eiraClearMs;
+} NmBench_ResultType;
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+static const NmBench_RequesterType lRequesters[] = {
+  {1, 1000, 21000},
+  {7, 3000, 21000},
+  {13, 5000, 21000},
+};
+
+static const uint8_t lPnMasks[NMBENCH_PNS] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20};
+
+static NmCore_ChannelConfigType lChannelConfigs[NMBENCH_NODES];
+static NmCore_ChannelContextType lChannelContexts[NMBENCH_NODES];
+static NmCore_ConfigType lConfigs[NMBENCH_NODES];
+static uint8_t lEiraPnInfo[NMBENCH_NODES][1];
+static uint16_t lEiraTimers[NMBENCH_NODES][8];
+static NmCore_PnAggregationType lEiras[NMBENCH_NODES];
+static boolean lWoken[NMBENCH_NODES];
+
+static NmBench_FrameType lFrames[NMBENCH_MAX_FRAMES];
+static uint32_t lNumOfFrames;
+static uint32_t lNowMs;
+static NmBench_ResultType lResult;
+/* ================================ [ LOCALS    ] ============================================== */
+static Std_ReturnType NmBench_Transmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr) {
+  Std_ReturnType ret = E_NOT_OK;
+
+  if (lNumOfFrames < NMBENCH_MAX_FRAMES) {
+    lFrames[lNumOfFrames].node = (uint8_t)TxPduId;
+    memcpy(lFrames[lNumOfFrames].data, PduInfoPtr->SduDataPtr, PduInfoPtr->SduLength);
+    lNumOfFrames++;
+    lResult.msgs++;
+    if ((lNowMs >= 10000) && (lNowMs < 20000)) {
+      lResult.steadyMsgs++;
+    }
+    ret = E_OK;
+  }
+
+  return ret;
+}
+
+static void NmBench_EiraIndication(const uint8_t *PnInfo, uint8_t PnInfoLength) {
+  (void)PnInfoLength;
+  if (PnInfo[0] & lPnMasks[NMBENCH_PN_WATCHED]) {
+    if (lResult.eiraSetMs < 0) {
+      lResult.eiraSetMs = (int32_t)lNowMs;
+    }
+  } else if (lResult.eiraSetMs >= 0) {
+    lResult.eiraClearMs = (int32_t)lNowMs;
+  }
+}
+
+/* the frames sent within the main function are on the bus at the end of the tick */
+static void NmBench_Bus(void) {
+  PduInfoType pdu;
+  uint32_t i;
+  int node;
+
+  pdu.SduLength = 8;
+  for (i = 0; i < lNumOfFrames; i++) {
+    pdu.SduDataPtr = lFrames[i].data;
+    for (node = 0; node < NMBENCH_NODES; node++) {
+      if (node != lFrames[i].node) {
+        NmCore_RxIndication(&lConfigs[node], 0, &pdu);
+      }
+    }
+    NmCore_TxConfirmation(&lConfigs[lFrames[i].node], 0, E_OK);
+  }
+  lNumOfFrames = 0;
+}
+
+static void NmBench_Init(const NmBench_RunType *run) {
+  static const uint8_t noPn[1] = {0};
+  NmCore_ChannelConfigType *config;
+  int node;
+
+  memset(&lResult, 0, sizeof(lResult));
+  lResult.eiraSetMs = -1;
+  lResult.eiraClearMs = -1;
+  memset(lWoken, 0, sizeof(lWoken));
+  lNumOfFrames = 0;
+  lNowMs = 0;
+
+  for (node = 0; node < NMBENCH_NODES; node++) {
+    config = &lChannelConfigs[node];
+    memset(config, 0, sizeof(*config));
+    config->ImmediateNmCycleTime = NMBENCH_MS(20);
+    config->MsgCycleOffset = NMBENCH_MS(10 * (node % 10));
+    config->MsgCycleTime = NMBENCH_MS(1000);
+    if (run->busLoadReduction) {
+      /* a different one of each node, the smallest ones keep sending */
+      config->MsgReducedTime = NMBENCH_MS(500 + 10 * node);
+    }
+    config->MsgTimeoutTime = NMBENCH_MS(10);
+    config->RepeatMessageTime = NMBENCH_MS(1500);
+    config->NmTimeoutTime = NMBENCH_MS(2000);
+    config->WaitBusSleepTime = NMBENCH_MS(1500);
+    config->RemoteSleepIndTime = NMBENCH_MS(1500);
+    config->TxPdu = (PduIdType)node;
+    config->NodeId = (uint8_t)node;
+    config->nmNetworkHandle = (NetworkHandleType)node;
+    config->ImmediateNmTransmissions = 3;
+    config->PduLength = 8;
+    config->PduCbvPosition = NMCORE_PDU_BYTE_1;
+    config->PduNidPosition = NMCORE_PDU_BYTE_0;
+    config->ActiveWakeupBitEnabled = TRUE;
+    config->NodeDetectionEnabled = TRUE;
+    config->PnEnabled = run->partialNetworking;
+    config->AllNmMessagesKeepAwake = FALSE;
+    config->PnHandleMultipleNetworkRequests = run->partialNetworking;
+    config->PnInfoOffset = NMBENCH_PN_INFO_OFFSET;
+    config->PnInfoLength = 1;
+    config->PnFilterMaskByte = &lPnMasks[node % NMBENCH_PNS];
+    config->Era = NULL;
+
+    lEiras[node].PnInfo = lEiraPnInfo[node];
+    lEiras[node].Timers = lEiraTimers[node];
+    lConfigs[node].ChannelConfigs = config;
+    lConfigs[node].ChannelContexts = &lChannelContexts[node];
+    lConfigs[node].numOfChannels = 1;
+    lConfigs[node].features = run->partialNetworking ? NMCORE_FEATURE_GLOBAL_PN : 0;
+    lConfigs[node].MainFunctionPeriod = NMBENCH_PERIOD;
+    lConfigs[node].Transmit = NmBench_Transmit;
+    lConfigs[node].PnResetTime = NMBENCH_MS(3000);
+    lConfigs[node].PnInfoLength = 1;
+    lConfigs[node].Eira = run->partialNetworking ? &lEiras[node] : NULL;
+    lConfigs[node].EiraIndication =
+      (NMBENCH_NODE_WATCHED == node) ? NmBench_EiraIndication : NULL;
+    lConfigs[node].EraIndication = NULL;
+
+    NmCore_Init(&lConfigs[node]);
+    NmCore_ConfirmPnAvailability(&lConfigs[node], 0);
+    /* no PN requested until the application requests the network */
+    NmCore_SetPnInfo(&lConfigs[node], 0, noPn);
+  }
+}
+
+static void NmBench_Run(const NmBench_RunType *run) {
+  Nm_StateType state;
+  Nm_ModeType mode;
+  uint32_t i;
+  boolean awake;
+  int node;
+
+  NmBench_Init(run);
+  for (lNowMs = 0; lNowMs < NMBENCH_END_MS; lNowMs += NMBENCH_PERIOD) {
+    for (i = 0; i < ARRAY_SIZE(lRequesters); i++) {
+      node = lRequesters[i].node;
+      if (lNowMs == lRequesters[i].requestMs) {
+        NmCore_SetPnInfo(&lConfigs[node], 0, &lPnMasks[NMBENCH_PN_WATCHED]);
+        NmCore_NetworkRequest(&lConfigs[node], 0);
+      } else if (lNowMs == lRequesters[i].releaseMs) {
+        NmCore_NetworkRelease(&lConfigs[node], 0);
+      } else {
+      }
+    }
+
+    awake = FALSE;
+    for (node = 0; node < NMBENCH_NODES; node++) {
+      NmCore_MainFunction(&lConfigs[node]);
+      NmCore_GetState(&lConfigs[node], 0, &state, &mode);
+      if (NM_MODE_BUS_SLEEP != mode) {
+        lResult.awakeTicks++;
+        awake = TRUE;
+        if (FALSE == lWoken[node]) {
+          lWoken[node] = TRUE;
+          lResult.woken++;
+        }
+      }
+    }
+    if (awake) {
+      lResult.asleepMs = lNowMs + NMBENCH_PERIOD;
+    }
+    NmBench_Bus();
+  }
+
+  printf("%-22s %5u %8u %8.1f %10.1f %9.1f", run->name, lResult.woken, lResult.msgs,
+         lResult.steadyMsgs / 10.0, lResult.awakeTicks * NMBENCH_PERIOD / 1000.0,
+         lResult.asleepMs / 1000.0);
+  if ((lResult.eiraSetMs >= 0) && (lResult.eiraClearMs >= 0)) {
+    printf(" %6.2f/%.2f\n", lResult.eiraSetMs / 1000.0, lResult.eiraClearMs / 1000.0);
+  } else {
+    printf(" %11s\n", "-");
+  }
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+void Nm_NetworkStartIndication(NetworkHandleType nmNetworkHandle) {
+  NmCore_PassiveStartUp(&lConfigs[nmNetworkHandle], 0);
+}
+
+void Nm_NetworkMode(NetworkHandleType nmNetworkHandle) {
+  /* the PN filter is disabled by the network mode, the ECU confirms it again */
+  NmCore_ConfirmPnAvailability(&lConfigs[nmNetworkHandle], 0);
+}
+
+void Nm_BusSleepMode(NetworkHandleType nmNetworkHandle) {
+  (void)nmNetworkHandle;
+}
+
+void Nm_PrepareBusSleepMode(NetworkHandleType nmNetworkHandle) {
+  (void)nmNetworkHandle;
+}
+
+void Nm_TxTimeoutException(NetworkHandleType nmNetworkHandle) {
+  (void)nmNetworkHandle;
+}
+
+void Nm_RepeatMessageIndication(NetworkHandleType nmNetworkHandle) {
+  (void)nmNetworkHandle;
+}
+
+void Nm_RemoteSleepIndication(NetworkHandleType nmNetworkHandle) {
+  (void)nmNetworkHandle;
+}
+
+void Nm_RemoteSleepCancellation(NetworkHandleType nmNetworkHandle) {
+  (void)nmNetworkHandle;
+}
+
+void Nm_CoordReadyToSleepIndication(NetworkHandleType nmChannelHandle) {
+  (void)nmChannelHandle;
+}
+
+void Nm_CoordReadyToSleepCancellation(NetworkHandleType nmChannelHandle) {
+  (void)nmChannelHandle;
+}
+
+int main(int argc, char *argv[]) {
+  static const NmBench_RunType runs[] = {
+    {"no PN", FALSE, FALSE},
+    {"+ bus load reduction", TRUE, FALSE},
+    {"+ PN", TRUE, TRUE},
+  };
+  uint32_t i;
+
+  (void)argc;
+  (void)argv;
+  printf("%u nodes, node 1 requests the network at 1s, node 7 at 3s, node 13 at 5s, all release "
+         "at 21s\n",
+         NMBENCH_NODES);
+  printf("%-22s %5s %8s %8s %10s %9s %11s\n", "run", "woken", "NM msgs", "msgs/s", "awake ECU.s",
+         "asleep s", "EIRA PN1 s");
+  for (i = 0; i < ARRAY_SIZE(runs); i++) {
+    NmBench_Run(&runs[i]);
+  }
+
+  return 0;
+}
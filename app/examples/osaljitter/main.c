@@ -0,0 +1,180 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Std_Types.h"
+#include "osal.h"
+#include "Std_Timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/* ================================ [ MACROS    ] ============================================== */
+#ifndef OSAL_JITTER_PERIOD_US
+#define OSAL_JITTER_PERIOD_US 1000
+#endif
+#ifndef OSAL_JITTER_LOOPS
+#define OSAL_JITTER_LOOPS 10000
+#endif
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  uint32_t period; /* in us */
+  uint32_t loops;
+  bool sleep; /* the relative sleep loop as the reference */
+  uint32_t *latency; /* in ns, of each wakeup */
+  uint32_t missed;
+} OsalJitter_ContextType;
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+static int OsalJitter_Compare(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a;
+  uint32_t y = *(const uint32_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+/* the latency of each wakeup is taken against the ideal grid start + n * period, so for the
+ * sleep loop the drift adds up and shows in the high percentiles */
+static void OsalJitter_Main(void *args) {
+  OsalJitter_ContextType *context = (OsalJitter_ContextType *)args;
+  OSAL_TimerType timer = NULL;
+  uint64_t period = (uint64_t)context->period * STD_TIME_NS_PER_US;
+  uint64_t deadline = Std_GetTimeNs() + period;
+  uint64_t now;
+  uint32_t i;
+  int expirations = 1;
+
+  if (false == context->sleep) {
+    timer = OSAL_TimerCreate(context->period);
+    if (NULL == timer) {
+      printf("failed to create the timer\n");
+      context->loops = 0;
+      return;
+    }
+  }
+
+  for (i = 0; i < context->loops; i++) {
+    if (NULL != timer) {
+      expirations = OSAL_TimerWait(timer);
+      if (expirations < 1) {
+        printf("timer wait failed: %d\n", expirations);
+        context->loops = i;
+        break;
+      }
+    } else {
+      OSAL_SleepUs(context->period);
+    }
+    now = Std_GetTimeNs();
+    /* the missed periods are not counted as wakeups */
+    deadline += (uint64_t)(expirations - 1) * period;
+    context->missed += (uint32_t)(expirations - 1);
+    context->latency[i] = (now > deadline) ? (uint32_t)(now - deadline) : 0u;
+    deadline += period;
+  }
+
+  if (NULL != timer) {
+    OSAL_TimerDestory(timer);
+  }
+}
+
+static uint32_t OsalJitter_Percentile(const OsalJitter_ContextType *context, uint32_t permille) {
+  uint32_t index = (uint32_t)((uint64_t)(context->loops - 1) * permille / 1000u);
+
+  return context->latency[index];
+}
+
+static void OsalJitter_Report(const OsalJitter_ContextType *context) {
+  static const struct {
+    const char *name;
+    uint32_t permille;
+  } percentiles[] = {
+    {"min", 0}, {"p50", 500}, {"p90", 900}, {"p99", 990}, {"p99.9", 999}, {"max", 1000},
+  };
+  uint32_t i;
+
+  qsort(context->latency, context->loops, sizeof(uint32_t), OsalJitter_Compare);
+
+  printf("%s: period %u us, %u wakeups, %u missed periods\n",
+         context->sleep ? "sleep" : "timer", context->period, context->loops, context->missed);
+  printf("wakeup latency(us):");
+  for (i = 0; i < ARRAY_SIZE(percentiles); i++) {
+    printf(" %s %.1f", percentiles[i].name,
+           (float)OsalJitter_Percentile(context, percentiles[i].permille) / STD_TIME_NS_PER_US);
+  }
+  printf("\n");
+}
+
+static void OsalJitter_Usage(const char *prog) {
+  printf("usage: %s [-p periodUs] [-n loops] [-f priority] [-r priority] [-c cpuMask] [-k stack]"
+         " [-s]\n"
+         "  -f/-r runs with SCHED_FIFO/SCHED_RR at the priority, -s uses OSAL_SleepUs instead of"
+         " the timer\n",
+         prog);
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+int main(int argc, char *argv[]) {
+  OsalJitter_ContextType context;
+  OSAL_ThreadAttrType attr;
+  OSAL_ThreadType thread;
+  int i;
+
+  memset(&context, 0, sizeof(context));
+  context.period = OSAL_JITTER_PERIOD_US;
+  context.loops = OSAL_JITTER_LOOPS;
+  OSAL_ThreadAttrInit(&attr);
+
+  for (i = 1; i < argc; i++) {
+    if (0 == strcmp(argv[i], "-s")) {
+      context.sleep = true;
+    } else if ((i + 1) < argc) {
+      if (0 == strcmp(argv[i], "-p")) {
+        context.period = (uint32_t)strtoul(argv[++i], NULL, 10);
+      } else if (0 == strcmp(argv[i], "-n")) {
+        context.loops = (uint32_t)strtoul(argv[++i], NULL, 10);
+      } else if (0 == strcmp(argv[i], "-f")) {
+        attr.policy = OSAL_SCHED_FIFO;
+        attr.priority = atoi(argv[++i]);
+      } else if (0 == strcmp(argv[i], "-r")) {
+        attr.policy = OSAL_SCHED_RR;
+        attr.priority = atoi(argv[++i]);
+      } else if (0 == strcmp(argv[i], "-c")) {
+        attr.cpuMask = (uint32_t)strtoul(argv[++i], NULL, 0);
+      } else if (0 == strcmp(argv[i], "-k")) {
+        attr.stackSize = (uint32_t)strtoul(argv[++i], NULL, 0);
+      } else {
+        OsalJitter_Usage(argv[0]);
+        return -1;
+      }
+    } else {
+      OsalJitter_Usage(argv[0]);
+      return -1;
+    }
+  }
+
+  if ((0u == context.period) || (0u == context.loops)) {
+    OsalJitter_Usage(argv[0]);
+    return -1;
+  }
+
+  context.latency = (uint32_t *)malloc(context.loops * sizeof(uint32_t));
+  if (NULL == context.latency) {
+    return -ENOMEM;
+  }
+
+  thread = OSAL_ThreadCreateEx(OsalJitter_Main, &context, &attr);
+  if (NULL == thread) {
+    printf("failed to create the thread, the real time policy or the affinity may be refused\n");
+    free(context.latency);
+    return -1;
+  }
+  OSAL_ThreadJoin(thread);
+  OSAL_ThreadDestory(thread);
+
+  if (context.loops > 0u) {
+    OsalJitter_Report(&context);
+  }
+  free(context.latency);
+
+  return 0;
+}
@@ -0,0 +1,375 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2025 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Os_Cfg.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if (OS_PTHREAD_NUM > 0)
+#include <pthread.h>
+#include <semaphore.h>
+#include <mqueue.h>
+#include "timerfd.h"
+#endif
+/* ================================ [ MACROS    ] ============================================== */
+#ifndef OSBENCH_LOOPS
+#define OSBENCH_LOOPS 10000
+#endif
+
+/* the sub tick sleep and periodic wakeup, which need OS_USE_HRTIMER to be below the tick */
+#ifndef OSBENCH_PERIOD_NS
+#define OSBENCH_PERIOD_NS 200000
+#endif
+#ifndef OSBENCH_PERIOD_LOOPS
+#define OSBENCH_PERIOD_LOOPS 1000
+#endif
+
+/* the large message to compare the copy and the zero copy path of the mqueue */
+#ifndef OSBENCH_MQ_MSGSIZE
+#define OSBENCH_MQ_MSGSIZE 1024
+#endif
+
+#define OSBENCH_STAT(name)                                                                         \
+  { #name, UINT64_MAX, 0, 0, 0 }
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  const char *name;
+  uint64_t min;
+  uint64_t max;
+  uint64_t sum;
+  uint32_t count;
+} OsBench_StatType;
+
+enum {
+  STAT_ACTIVATE_PREEMPT,
+  STAT_TERMINATE_SWITCH,
+  STAT_ACTIVATE_NOPREEMPT,
+  STAT_RELEASE_PREEMPT,
+  STAT_SETEVENT_NOPREEMPT,
+  STAT_WAIT_SWITCH,
+  STAT_SETEVENT_WAKEUP,
+  STAT_GET_RESOURCE,
+  STAT_RELEASE_RESOURCE,
+#ifdef USE_SMP
+  STAT_ACTIVATE_REMOTE,
+#endif
+#if (OS_PTHREAD_NUM > 0)
+  STAT_SEM_WAKEUP,
+  STAT_MQ_WAKEUP,
+  STAT_MQ_COPY,
+  STAT_MQ_ZEROCOPY,
+  STAT_NANOSLEEP_LATE,
+  STAT_TIMERFD_LATE,
+#endif
+  STAT_MAX
+};
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+static OsBench_StatType lStats[STAT_MAX] = {
+  OSBENCH_STAT(ActivateTask preempt),
+  OSBENCH_STAT(TerminateTask switch),
+  OSBENCH_STAT(ActivateTask no preempt),
+  OSBENCH_STAT(ReleaseResource preempt),
+  OSBENCH_STAT(SetEvent no preempt),
+  OSBENCH_STAT(WaitEvent switch),
+  OSBENCH_STAT(SetEvent wakeup),
+  OSBENCH_STAT(GetResource),
+  OSBENCH_STAT(ReleaseResource),
+#ifdef USE_SMP
+  OSBENCH_STAT(ActivateTask remote),
+#endif
+#if (OS_PTHREAD_NUM > 0)
+  OSBENCH_STAT(sem_post wakeup),
+  OSBENCH_STAT(mq_send wakeup),
+  OSBENCH_STAT(mq big copy),
+  OSBENCH_STAT(mq big zero copy),
+  OSBENCH_STAT(clock_nanosleep late),
+  OSBENCH_STAT(timerfd late),
+#endif
+};
+
+/* timestamps taken by the other side of a switch */
+static volatile uint64_t lHighEntry;
+static volatile uint64_t lLowEntry;
+static volatile uint64_t lLowSet;
+#ifdef USE_SMP
+static volatile uint64_t lRemoteEntry;
+#endif
+#if (OS_PTHREAD_NUM > 0)
+static sem_t lSem;
+static mqd_t lMq;
+static mqd_t lMqBig;
+static char lMsgBig[2][OSBENCH_MQ_MSGSIZE];
+static volatile uint64_t lPost;
+#endif
+/* ================================ [ LOCALS    ] ============================================== */
+static uint64_t OsBench_Now(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void OsBench_Record(int id, uint64_t ns) {
+  OsBench_StatType *stat = &lStats[id];
+
+  if (ns < stat->min) {
+    stat->min = ns;
+  }
+  if (ns > stat->max) {
+    stat->max = ns;
+  }
+  stat->sum += ns;
+  stat->count++;
+}
+
+static void OsBench_Report(void) {
+  int i;
+  OsBench_StatType *stat;
+
+  printf("%-28s %10s %10s %10s %8s\n", "latency(ns)", "min", "avg", "max", "count");
+  for (i = 0; i < STAT_MAX; i++) {
+    stat = &lStats[i];
+    if (stat->count > 0) {
+      printf("%-28s %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %8u\n", stat->name, stat->min,
+             stat->sum / stat->count, stat->max, stat->count);
+    }
+  }
+}
+
+#if (OS_PTHREAD_NUM > 0)
+/* priority 2, always blocked until the producer posts */
+static void *OsBench_Consumer(void *arg) {
+  int i;
+  char msg[8];
+  void *buffer;
+
+  for (i = 0; i < OSBENCH_LOOPS; i++) {
+    sem_wait(&lSem);
+    OsBench_Record(STAT_SEM_WAKEUP, OsBench_Now() - lPost);
+  }
+
+  for (i = 0; i < OSBENCH_LOOPS; i++) {
+    mq_receive(lMq, msg, sizeof(msg), NULL);
+    OsBench_Record(STAT_MQ_WAKEUP, OsBench_Now() - lPost);
+  }
+
+  /* from the fill by the producer until the data is at hand of the consumer */
+  for (i = 0; i < OSBENCH_LOOPS; i++) {
+    mq_receive(lMqBig, lMsgBig[1], sizeof(lMsgBig[1]), NULL);
+    OsBench_Record(STAT_MQ_COPY, OsBench_Now() - lPost);
+  }
+
+  for (i = 0; i < OSBENCH_LOOPS; i++) {
+    mq_borrow(lMqBig, &buffer, NULL, NULL);
+    OsBench_Record(STAT_MQ_ZEROCOPY, OsBench_Now() - lPost);
+    mq_release(lMqBig, buffer);
+  }
+
+  return NULL;
+}
+
+/* priority 1 */
+static void *OsBench_Producer(void *arg) {
+  int i;
+  char msg[8] = {0};
+  void *buffer;
+
+  for (i = 0; i < OSBENCH_LOOPS; i++) {
+    lPost = OsBench_Now();
+    sem_post(&lSem);
+  }
+
+  for (i = 0; i < OSBENCH_LOOPS; i++) {
+    lPost = OsBench_Now();
+    mq_send(lMq, msg, sizeof(msg), 0);
+  }
+
+  for (i = 0; i < OSBENCH_LOOPS; i++) {
+    lPost = OsBench_Now();
+    memset(lMsgBig[0], i, sizeof(lMsgBig[0]));
+    mq_send(lMqBig, lMsgBig[0], sizeof(lMsgBig[0]), 0);
+  }
+
+  for (i = 0; i < OSBENCH_LOOPS; i++) {
+    lPost = OsBench_Now();
+    mq_reserve(lMqBig, &buffer, NULL);
+    memset(buffer, i, OSBENCH_MQ_MSGSIZE);
+    mq_commit(lMqBig, buffer, OSBENCH_MQ_MSGSIZE, 0);
+  }
+
+  (void)SetEvent(TASK_ID_TaskBench, EVENT_MASK_TaskBench_EvDone);
+
+  return NULL;
+}
+
+/* priority 3, how late the wakeups are against the requested time */
+static void *OsBench_Periodic(void *arg) {
+  int i;
+  int fd;
+  uint64_t t0, t1;
+  uint64_t expirations = 0;
+  uint64_t total = 0;
+  struct timespec ts;
+  struct itimerspec its;
+
+  ts.tv_sec = 0;
+  ts.tv_nsec = OSBENCH_PERIOD_NS;
+  for (i = 0; i < OSBENCH_PERIOD_LOOPS; i++) {
+    t0 = OsBench_Now();
+    clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, NULL);
+    t1 = OsBench_Now();
+    OsBench_Record(STAT_NANOSLEEP_LATE, t1 - t0 - OSBENCH_PERIOD_NS);
+  }
+
+  fd = timerfd_create(CLOCK_MONOTONIC, 0);
+  its.it_value = ts;
+  its.it_interval = ts;
+  t0 = OsBench_Now();
+  timerfd_settime(fd, 0, &its, NULL);
+  for (i = 0; i < OSBENCH_PERIOD_LOOPS; i++) {
+    timerfd_wait(fd, &expirations);
+    t1 = OsBench_Now();
+    total += expirations;
+    OsBench_Record(STAT_TIMERFD_LATE, t1 - t0 - total * OSBENCH_PERIOD_NS);
+  }
+  timerfd_close(fd);
+
+  return NULL;
+}
+
+static void OsBench_Pthread(void) {
+  pthread_t consumer;
+  pthread_t producer;
+  pthread_t periodic;
+  pthread_attr_t attr;
+  struct sched_param param;
+  struct mq_attr mqAttr;
+
+  sem_init(&lSem, 0, 0);
+  mqAttr.mq_flags = 0;
+  mqAttr.mq_maxmsg = 4;
+  mqAttr.mq_msgsize = 8;
+  mqAttr.mq_curmsgs = 0;
+  lMq = mq_open("/osbench", O_CREAT | O_RDWR, 0600, &mqAttr);
+  mqAttr.mq_msgsize = OSBENCH_MQ_MSGSIZE;
+  lMqBig = mq_open("/osbench-big", O_CREAT | O_RDWR, 0600, &mqAttr);
+
+  pthread_attr_init(&attr);
+  param.sched_priority = 2;
+  pthread_attr_setschedparam(&attr, &param);
+  pthread_create(&consumer, &attr, OsBench_Consumer, NULL);
+  param.sched_priority = 1;
+  pthread_attr_setschedparam(&attr, &param);
+  pthread_create(&producer, &attr, OsBench_Producer, NULL);
+
+  /* the pthreads are all below the OSEK tasks, they run while the bench is waiting */
+  (void)WaitEvent(EVENT_MASK_TaskBench_EvDone);
+  (void)ClearEvent(EVENT_MASK_TaskBench_EvDone);
+
+  pthread_join(consumer, NULL);
+  pthread_join(producer, NULL);
+
+  param.sched_priority = 3;
+  pthread_attr_setschedparam(&attr, &param);
+  pthread_create(&periodic, &attr, OsBench_Periodic, NULL);
+  pthread_join(periodic, NULL);
+}
+#endif
+/* ================================ [ FUNCTIONS ] ============================================== */
+TASK(TaskBench) {
+  int i;
+  uint64_t t0, t1;
+
+  for (i = 0; i < OSBENCH_LOOPS; i++) {
+    /* ActivateTask of a higher task switches to it, it records the entry and terminates */
+    t0 = OsBench_Now();
+    (void)ActivateTask(TASK_ID_TaskHigh);
+    t1 = OsBench_Now();
+    OsBench_Record(STAT_ACTIVATE_PREEMPT, lHighEntry - t0);
+    OsBench_Record(STAT_TERMINATE_SWITCH, t1 - lHighEntry);
+
+    /* the ceiling of RES_BENCH holds the TaskHigh off until the release */
+    t0 = OsBench_Now();
+    (void)GetResource(RES_ID_RES_BENCH);
+    t1 = OsBench_Now();
+    OsBench_Record(STAT_GET_RESOURCE, t1 - t0);
+    t0 = OsBench_Now();
+    (void)ActivateTask(TASK_ID_TaskHigh);
+    t1 = OsBench_Now();
+    OsBench_Record(STAT_ACTIVATE_NOPREEMPT, t1 - t0);
+    t0 = OsBench_Now();
+    (void)ReleaseResource(RES_ID_RES_BENCH);
+    OsBench_Record(STAT_RELEASE_PREEMPT, lHighEntry - t0);
+
+    t0 = OsBench_Now();
+    (void)GetResource(RES_ID_RES_BENCH);
+    t1 = OsBench_Now();
+    (void)ReleaseResource(RES_ID_RES_BENCH);
+    OsBench_Record(STAT_RELEASE_RESOURCE, OsBench_Now() - t1);
+
+    /* TaskLow runs once the bench waits, and wakes the bench up again */
+    t0 = OsBench_Now();
+    (void)SetEvent(TASK_ID_TaskLow, EVENT_MASK_TaskLow_EvGo);
+    t1 = OsBench_Now();
+    OsBench_Record(STAT_SETEVENT_NOPREEMPT, t1 - t0);
+    t0 = OsBench_Now();
+    (void)WaitEvent(EVENT_MASK_TaskBench_EvWake);
+    t1 = OsBench_Now();
+    (void)ClearEvent(EVENT_MASK_TaskBench_EvWake);
+    OsBench_Record(STAT_WAIT_SWITCH, lLowEntry - t0);
+    OsBench_Record(STAT_SETEVENT_WAKEUP, t1 - lLowSet);
+
+#ifdef USE_SMP
+    /* waits rather than spins, the host may have less cores than the OS */
+    t0 = OsBench_Now();
+    (void)ActivateTask(TASK_ID_TaskRemote);
+    (void)WaitEvent(EVENT_MASK_TaskBench_EvWake);
+    (void)ClearEvent(EVENT_MASK_TaskBench_EvWake);
+    OsBench_Record(STAT_ACTIVATE_REMOTE, lRemoteEntry - t0);
+#endif
+  }
+
+#if (OS_PTHREAD_NUM > 0)
+  OsBench_Pthread();
+#endif
+
+  OsBench_Report();
+  ShutdownOS(E_OK);
+}
+
+TASK(TaskHigh) {
+  lHighEntry = OsBench_Now();
+  (void)TerminateTask();
+}
+
+TASK(TaskLow) {
+  while (1) {
+    (void)WaitEvent(EVENT_MASK_TaskLow_EvGo);
+    lLowEntry = OsBench_Now();
+    (void)ClearEvent(EVENT_MASK_TaskLow_EvGo);
+    lLowSet = OsBench_Now();
+    (void)SetEvent(TASK_ID_TaskBench, EVENT_MASK_TaskBench_EvWake);
+  }
+}
+
+#ifdef USE_SMP
+TASK(TaskRemote) {
+  lRemoteEntry = OsBench_Now();
+  (void)SetEvent(TASK_ID_TaskBench, EVENT_MASK_TaskBench_EvWake);
+  (void)TerminateTask();
+}
+#endif
+
+void ShutdownHook(StatusType Error) {
+  exit(Error);
+}
+
+int main(int argc, char *argv[]) {
+  StartOS(OSDEFAULTAPPMODE);
+  return 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "CanTSyn_Cfg.h"
+#include "CanTSyn_Priv.h"
+#include "CanTSyn.h"
+#include "CanIf_Cfg.h"
+/* ================================ [ MACROS    ] ============================================== */
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+static CanTSyn_MasterContextType CanTSyn_MasterContext0;
+static const CanTSyn_GlobalTimeMasterType CanTSyn_GlobalTimeMaster0 = {
+  CANTSYN_CONVERT_MS_TO_MAIN_CYCLES(1000), /* CyclicMsgResumeTime */
+  CANTSYN_CONVERT_MS_TO_MAIN_CYCLES(10),   /* GlobalTimeDebounceTime */
+  CANTSYN_CONVERT_MS_TO_MAIN_CYCLES(1000), /* GlobalTimeTxPeriod */
+  CANIF_CANTSYN_TX,                        /* TxPduId */
+  TRUE,                                    /* GlobalTimeTxCrcSecured */
+  FALSE,                                   /* ImmediateTimeSync */
+  FALSE,                                   /* TxTmacCalculated */
+};
+
+static CanTSyn_SlaveContextType CanTSyn_SlaveContext1;
+static CanTSyn_SlaveContextType CanTSyn_SlaveContext2;
+static const CanTSyn_GlobalTimeSlaveType CanTSyn_GlobalTimeSlave = {
+  CANTSYN_CONVERT_MS_TO_MAIN_CYCLES(100), /* GlobalTimeFollowUpTimeout */
+  CANTSYN_CONVERT_MS_TO_MAIN_CYCLES(10),  /* GlobalTimeMinMsgGap */
+  3,                                      /* GlobalTimeSequenceCounterJumpWidth */
+  CANTSYN_CRC_VALIDATED,                  /* RxCrcValidated */
+  FALSE,                                  /* RxTmacValidated */
+};
+
+/* the index of a domain is the NetId of its network in the CanIf.json */
+static const CanTSyn_GlobalTimeDomainType CanTSyn_GlobalTimeDomains[3] = {
+  {
+    {{&CanTSyn_MasterContext0, &CanTSyn_GlobalTimeMaster0}},
+    FALSE,                      /* EnableTimeValidation */
+    0,                          /* GlobalTimeDomainId */
+    0,                          /* GlobalTimeNetworkSegmentId */
+    0,                          /* GlobalTimeSecureTmacLength */
+    FALSE,                      /* UseExtendedMsgFormat */
+    TSYNBENCH_TIME_BASE_MASTER, /* SynchronizedTimeBaseRef */
+    CANTSYN_MASTER,
+  },
+  {
+    {{&CanTSyn_SlaveContext1, &CanTSyn_GlobalTimeSlave}},
+    FALSE,                       /* EnableTimeValidation */
+    0,                           /* GlobalTimeDomainId */
+    0,                           /* GlobalTimeNetworkSegmentId */
+    0,                           /* GlobalTimeSecureTmacLength */
+    FALSE,                       /* UseExtendedMsgFormat */
+    TSYNBENCH_TIME_BASE_SLAVE_A, /* SynchronizedTimeBaseRef */
+    CANTSYN_SLAVE,
+  },
+  {
+    {{&CanTSyn_SlaveContext2, &CanTSyn_GlobalTimeSlave}},
+    FALSE,                       /* EnableTimeValidation */
+    0,                           /* GlobalTimeDomainId */
+    0,                           /* GlobalTimeNetworkSegmentId */
+    0,                           /* GlobalTimeSecureTmacLength */
+    FALSE,                       /* UseExtendedMsgFormat */
+    TSYNBENCH_TIME_BASE_SLAVE_B, /* SynchronizedTimeBaseRef */
+    CANTSYN_SLAVE,
+  },
+};
+
+const CanTSyn_ConfigType CanTSyn_Config = {
+  CanTSyn_GlobalTimeDomains,
+  ARRAY_SIZE(CanTSyn_GlobalTimeDomains),
+};
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
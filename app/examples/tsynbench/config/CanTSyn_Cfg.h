@@ -0,0 +1,24 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+#ifndef _CAN_TSYN_CFG_H
+#define _CAN_TSYN_CFG_H
+/* ================================ [ INCLUDES  ] ============================================== */
+/* ================================ [ MACROS    ] ============================================== */
+#ifndef CANTSYN_MAIN_FUNCTION_PERIOD
+#define CANTSYN_MAIN_FUNCTION_PERIOD 10
+#endif
+#define CANTSYN_CONVERT_MS_TO_MAIN_CYCLES(x)                                                       \
+  ((x + CANTSYN_MAIN_FUNCTION_PERIOD - 1) / CANTSYN_MAIN_FUNCTION_PERIOD)
+
+/* the time bases of the domains, the slave A has no rate correction, see the SConscript */
+#define TSYNBENCH_TIME_BASE_MASTER 0
+#define TSYNBENCH_TIME_BASE_SLAVE_A 1
+#define TSYNBENCH_TIME_BASE_SLAVE_B 2
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+#endif /* _CAN_TSYN_CFG_H */
@@ -0,0 +1,333 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Can.h"
+#include "CanIf.h"
+#include "CanIf_Can.h"
+#include "CanIf_Cfg.h"
+#include "CanTSyn.h"
+#include "CanTSyn_Cfg.h"
+#include "StbM.h"
+#include "Std_Timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/* ================================ [ MACROS    ] ============================================== */
+#define TSYNBENCH_CTRLS 3 /* the master, the slave A and the slave B */
+#define TSYNBENCH_MAX_EVENTS 16
+
+#define TSYNBENCH_FRAME_NS 250000ull      /* the 8 bytes frame at 500 kbps with the stuff bits */
+#define TSYNBENCH_TIME_STAMP_NS 1000ull   /* the resolution of the time stamp of the controller */
+#define TSYNBENCH_ISR_JITTER_NS 50000ull  /* the latency of the ISR, by the interrupt locks */
+#define TSYNBENCH_POLL_PERIOD_NS 1000000ull
+#define TSYNBENCH_TASK_JITTER_NS 500000ull /* of the tasks of the CanTSyn and the polling */
+/* each ECU polls its controller on its own, so a frame waits up to a period plus the jitter */
+#define TSYNBENCH_POLL_JITTER_NS (TSYNBENCH_POLL_PERIOD_NS + TSYNBENCH_TASK_JITTER_NS)
+#define TSYNBENCH_SAMPLE_NS 1000000ull
+#define TSYNBENCH_SETTLE_S 30 /* the error is taken after the settle */
+#define TSYNBENCH_END_S 330
+
+#define TSYNBENCH_DRIFT_PPB 50000          /* the clock of the time master runs 50 ppm fast */
+#define TSYNBENCH_GLOBAL_S 1700000000ul    /* the global time the time master starts with */
+#define TSYNBENCH_NS_PER_SECOND 1000000000ull
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  const char *name;
+  boolean polling;     /* the driver polls the controller, else by the ISR */
+  boolean hwTimeStamp; /* the controller takes the time stamp at the end of the frame */
+} TSynBench_RunType;
+
+typedef struct {
+  uint64_t at;        /* when the ISR or the poll sees it */
+  uint64_t timeStamp; /* the end of the frame on the bus */
+  Can_HwType mailbox;
+  PduIdType swPduHandle;
+  uint8_t length;
+  uint8_t data[8];
+  boolean rx;
+  boolean used;
+} TSynBench_EventType;
+
+typedef struct {
+  uint64_t sum; /* of the absolute error in ns */
+  uint64_t max;
+  uint32_t samples;
+} TSynBench_ErrorType;
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+static const TSynBench_RunType *lRun;
+static TSynBench_EventType lEvents[TSYNBENCH_MAX_EVENTS];
+/* the event the ISR or the poll is delivering, whose time stamp the controller gives */
+static const TSynBench_EventType *lDelivering;
+static uint64_t lBusIdle;
+static uint64_t lNow;
+/* ================================ [ LOCALS    ] ============================================== */
+static uint64_t TSynBench_Jitter(uint64_t range) {
+  return (uint64_t)rand() % range;
+}
+
+static void TSynBench_StepTo(uint64_t at) {
+  if (at > lNow) {
+    Std_TimeStep(at - lNow);
+    lNow = at;
+  }
+}
+
+static uint64_t TSynBench_GetGlobalTime(StbM_SynchronizedTimeBaseType timeBaseId) {
+  StbM_TimeStampType timeStamp;
+
+  (void)StbM_BusGetCurrentTime(timeBaseId, &timeStamp, NULL, NULL);
+
+  return (((uint64_t)timeStamp.secondsHi << 32) + timeStamp.seconds) * TSYNBENCH_NS_PER_SECOND +
+         timeStamp.nanoseconds;
+}
+
+static void TSynBench_GetTimeStamp(Can_TimeStampType *timeStampPtr) {
+  /* the counter of each controller has its own phase */
+  uint64_t ns = lDelivering->timeStamp + TSynBench_Jitter(TSYNBENCH_TIME_STAMP_NS);
+
+  ns -= ns % TSYNBENCH_TIME_STAMP_NS;
+
+  timeStampPtr->seconds = (uint32_t)(ns / TSYNBENCH_NS_PER_SECOND);
+  timeStampPtr->nanoseconds = (uint32_t)(ns % TSYNBENCH_NS_PER_SECOND);
+}
+
+static TSynBench_EventType *TSynBench_NewEvent(uint64_t timeStamp) {
+  TSynBench_EventType *event = NULL;
+  uint32_t i;
+
+  for (i = 0; (NULL == event) && (i < TSYNBENCH_MAX_EVENTS); i++) {
+    if (FALSE == lEvents[i].used) {
+      event = &lEvents[i];
+      memset(event, 0, sizeof(*event));
+      event->used = TRUE;
+      event->timeStamp = timeStamp;
+      event->at = timeStamp + TSynBench_Jitter(lRun->polling ? TSYNBENCH_POLL_JITTER_NS
+                                                              : TSYNBENCH_ISR_JITTER_NS);
+    }
+  }
+
+  return event;
+}
+
+static TSynBench_EventType *TSynBench_GetDueEvent(uint64_t now) {
+  TSynBench_EventType *event = NULL;
+  uint32_t i;
+
+  for (i = 0; i < TSYNBENCH_MAX_EVENTS; i++) {
+    if (lEvents[i].used && (lEvents[i].at <= now) &&
+        ((NULL == event) || (lEvents[i].at < event->at))) {
+      event = &lEvents[i];
+    }
+  }
+
+  return event;
+}
+
+static uint64_t TSynBench_GetNextEvent(void) {
+  uint64_t next = UINT64_MAX;
+  uint32_t i;
+
+  for (i = 0; i < TSYNBENCH_MAX_EVENTS; i++) {
+    if (lEvents[i].used && (lEvents[i].at < next)) {
+      next = lEvents[i].at;
+    }
+  }
+
+  return next;
+}
+
+static void TSynBench_Deliver(uint64_t now) {
+  TSynBench_EventType *event = TSynBench_GetDueEvent(now);
+  PduInfoType pduInfo;
+
+  while (NULL != event) {
+    lDelivering = event;
+    if (event->rx) {
+      pduInfo.SduDataPtr = event->data;
+      pduInfo.SduLength = event->length;
+      pduInfo.MetaDataPtr = NULL;
+      CanIf_RxIndication(&event->mailbox, &pduInfo);
+    } else {
+      CanIf_TxConfirmation(event->swPduHandle);
+    }
+    lDelivering = NULL;
+    event->used = FALSE;
+    event = TSynBench_GetDueEvent(now);
+  }
+}
+
+static void TSynBench_Sample(TSynBench_ErrorType *error, uint64_t master,
+                             StbM_SynchronizedTimeBaseType timeBaseId) {
+  uint64_t slave = TSynBench_GetGlobalTime(timeBaseId);
+  uint64_t diff = (slave > master) ? (slave - master) : (master - slave);
+
+  error->sum += diff;
+  error->samples++;
+  if (diff > error->max) {
+    error->max = diff;
+  }
+}
+
+static void TSynBench_Run(const TSynBench_RunType *run) {
+  static const StbM_TimeStampType globalTime = {0, TSYNBENCH_GLOBAL_S, 0, 0};
+  TSynBench_ErrorType errorA;
+  TSynBench_ErrorType errorB;
+  StbM_RateDeviationType rate = 0;
+  uint64_t start, end, next, master;
+  uint64_t nextMain, nextMainAt;
+  uint64_t nextSample;
+  uint8_t i;
+
+  lRun = run;
+  memset(lEvents, 0, sizeof(lEvents));
+  memset(&errorA, 0, sizeof(errorA));
+  memset(&errorB, 0, sizeof(errorB));
+  srand(1);
+
+  StbM_Init(NULL);
+  CanIf_Init(NULL);
+  for (i = 0; i < TSYNBENCH_CTRLS; i++) {
+    (void)CanIf_SetPduMode(i, CANIF_ONLINE);
+  }
+  CanTSyn_Init(NULL);
+  (void)StbM_SetGlobalTime(TSYNBENCH_TIME_BASE_MASTER, &globalTime, NULL);
+  (void)StbM_SetRateCorrection(TSYNBENCH_TIME_BASE_MASTER, TSYNBENCH_DRIFT_PPB);
+
+  start = lNow;
+  end = start + TSYNBENCH_END_S * TSYNBENCH_NS_PER_SECOND;
+  lBusIdle = start;
+  nextMain = start + CANTSYN_MAIN_FUNCTION_PERIOD * 1000000ull;
+  nextMainAt = nextMain + TSynBench_Jitter(TSYNBENCH_TASK_JITTER_NS);
+  nextSample = start + TSYNBENCH_SAMPLE_NS;
+
+  while (lNow < end) {
+    next = (nextMainAt < nextSample) ? nextMainAt : nextSample;
+    if (TSynBench_GetNextEvent() < next) {
+      next = TSynBench_GetNextEvent();
+    }
+    TSynBench_StepTo(next);
+    TSynBench_Deliver(lNow);
+
+    if (lNow >= nextMainAt) {
+      CanTSyn_MainFunction();
+      nextMain += CANTSYN_MAIN_FUNCTION_PERIOD * 1000000ull;
+      nextMainAt = nextMain + TSynBench_Jitter(TSYNBENCH_TASK_JITTER_NS);
+    }
+
+    if (lNow >= nextSample) {
+      if (lNow >= (start + TSYNBENCH_SETTLE_S * TSYNBENCH_NS_PER_SECOND)) {
+        master = TSynBench_GetGlobalTime(TSYNBENCH_TIME_BASE_MASTER);
+        TSynBench_Sample(&errorA, master, TSYNBENCH_TIME_BASE_SLAVE_A);
+        TSynBench_Sample(&errorB, master, TSYNBENCH_TIME_BASE_SLAVE_B);
+      }
+      nextSample += TSYNBENCH_SAMPLE_NS;
+    }
+  }
+
+  (void)StbM_GetRateDeviation(TSYNBENCH_TIME_BASE_SLAVE_B, &rate);
+  printf("%-26s %8.1f %8.1f %10.1f %8.1f %9d\n", run->name, errorA.max / 1000.0,
+         (errorA.samples > 0) ? (errorA.sum / 1000.0 / errorA.samples) : 0.0, errorB.max / 1000.0,
+         (errorB.samples > 0) ? (errorB.sum / 1000.0 / errorB.samples) : 0.0, (int)rate);
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+Std_ReturnType Can_Write(Can_HwHandleType Hth, const Can_PduType *PduInfo) {
+  Std_ReturnType ret = E_OK;
+  TSynBench_EventType *event;
+  uint64_t timeStamp;
+  uint8_t ctrl;
+
+  (void)Hth;
+  /* the frame of the master goes on the bus after the one ahead of it */
+  timeStamp = ((lBusIdle > lNow) ? lBusIdle : lNow) + TSYNBENCH_FRAME_NS;
+  lBusIdle = timeStamp;
+
+  event = TSynBench_NewEvent(timeStamp);
+  if (NULL != event) {
+    event->swPduHandle = PduInfo->swPduHandle;
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  for (ctrl = 1; (E_OK == ret) && (ctrl < TSYNBENCH_CTRLS); ctrl++) {
+    event = TSynBench_NewEvent(timeStamp);
+    if (NULL != event) {
+      event->rx = TRUE;
+      event->mailbox.CanId = PduInfo->id;
+      event->mailbox.Hoh = 0;
+      event->mailbox.ControllerId = ctrl;
+      event->length = (PduInfo->length > 8) ? 8 : PduInfo->length;
+      memcpy(event->data, PduInfo->sdu, event->length);
+    } else {
+      ret = E_NOT_OK;
+    }
+  }
+
+  return ret;
+}
+
+Std_ReturnType Can_SetControllerMode(uint8_t Controller, Can_ControllerStateType Transition) {
+  (void)Controller;
+  (void)Transition;
+  return E_OK;
+}
+
+Std_ReturnType Can_GetControllerMode(uint8_t Controller,
+                                     Can_ControllerStateType *ControllerModePtr) {
+  (void)Controller;
+  *ControllerModePtr = CAN_CS_STARTED;
+  return E_OK;
+}
+
+Std_ReturnType Can_GetIngressTimeStamp(Can_HwHandleType Hrh, Can_TimeStampType *timeStampPtr) {
+  Std_ReturnType ret = E_NOT_OK;
+
+  (void)Hrh;
+  if (lRun->hwTimeStamp && (NULL != lDelivering)) {
+    TSynBench_GetTimeStamp(timeStampPtr);
+    ret = E_OK;
+  }
+
+  return ret;
+}
+
+Std_ReturnType Can_GetEgressTimeStamp(PduIdType TxPduId, Can_HwHandleType Hth,
+                                      Can_TimeStampType *timeStampPtr) {
+  Std_ReturnType ret = E_NOT_OK;
+
+  (void)TxPduId;
+  (void)Hth;
+  if (lRun->hwTimeStamp && (NULL != lDelivering)) {
+    TSynBench_GetTimeStamp(timeStampPtr);
+    ret = E_OK;
+  }
+
+  return ret;
+}
+
+int main(int argc, char *argv[]) {
+  static const TSynBench_RunType runs[] = {
+    {"interrupt, sw time stamp", FALSE, FALSE},
+    {"interrupt, hw time stamp", FALSE, TRUE},
+    {"polling, sw time stamp", TRUE, FALSE},
+    {"polling, hw time stamp", TRUE, TRUE},
+  };
+  uint32_t i;
+
+  (void)argc;
+  (void)argv;
+  Std_TimeSetVirtual(TRUE);
+  lNow = Std_GetTimeNs();
+
+  printf("the time master runs %d ppm fast, a sync each 1s, the error of %ds after %ds\n",
+         TSYNBENCH_DRIFT_PPB / 1000, TSYNBENCH_END_S - TSYNBENCH_SETTLE_S, TSYNBENCH_SETTLE_S);
+  printf("%-26s %17s %19s %9s\n", "", "A: set to sync", "B: rate + filter", "B rate");
+  printf("%-26s %8s %8s %10s %8s %9s\n", "run", "max us", "avg us", "max us", "avg us", "ppb");
+  for (i = 0; i < ARRAY_SIZE(runs); i++) {
+    TSynBench_Run(&runs[i]);
+  }
+
+  return 0;
+}
@@ -13,9 +13,14 @@
 #ifdef USE_CANSM
 #include "CanSM_CanIf.h"
 #endif
+#ifdef USE_CANTSYN
+#include "CanTSyn.h"
+#endif
 
 #include "mempool.h"
 #include "Std_Critical.h"
+#include "Std_Timer.h"
+#include "Std_Compiler.h"
 #include <string.h>
 #include "Det.h"
 /* ================================ [ MACROS    ] ============================================== */
@@ -23,39 +28,147 @@
 #define AS_LOG_CANIFI 2
 #define AS_LOG_CANIFE 3
 
-#ifndef CANIF_PACKET_RX_POOL_SIZE
-#define CANIF_PACKET_RX_POOL_SIZE 0
-#endif
+#define CANIF_CONFIG (&CanIf_Config)
 
-#ifndef CANIF_PATCKET_MAX_SIZE
-#define CANIF_PATCKET_MAX_SIZE 8
-#endif
+#define CANIF_PACKET_RX_QUEUE_MASK (CANIF_PACKET_RX_QUEUE_SIZE - 1u)
 
-#define CANIF_CONFIG (&CanIf_Config)
+#define CANIF_NANOSECONDS_PER_SECOND 1000000000ull
 /* ================================ [ TYPES     ] ============================================== */
-typedef struct CanIf_Packet_s {
-  STAILQ_ENTRY(CanIf_Packet_s) entry;
+/* the ingress time of a frame taken in the rx ISR, the software one is converted to the
+ * Can_TimeStampType only if the frame is for the time synchronization */
+typedef struct {
+  Can_TimeStampType timeStamp; /* by the driver */
+  uint64_t ns;                 /* by Std_GetTimeNs if the driver has none */
+  boolean byDriver;
+} CanIf_RxTimeType;
+
+#ifdef CANIF_USE_PACKET_RX
+struct CanIf_Packet_s {
   Can_HwType mailbox;
+  std_time_t timestamp; /* when it was queued */
+#ifdef CANIF_USE_TIME_STAMP
+  CanIf_RxTimeType rxTime;
+#endif
   PduLengthType SduLength;
-  uint8_t data[CANIF_PATCKET_MAX_SIZE];
-} CanIf_PacketType;
-
-typedef STAILQ_HEAD(CanIf_PacketListHead_s, CanIf_Packet_s) CanIf_PacketListType;
+  uint8_t sizeClass; /* the index of canIfRxPacketClasses */
+  /* the data follows */
+};
+
+#define CANIF_PACKET_DEF(n)                                                                        \
+  typedef struct {                                                                                 \
+    CanIf_PacketType packet;                                                                       \
+    uint8_t data[n];                                                                               \
+  } CanIf_Packet##n##Type
+
+CANIF_PACKET_DEF(8);
+CANIF_PACKET_DEF(16);
+CANIF_PACKET_DEF(32);
+CANIF_PACKET_DEF(64);
+
+typedef struct {
+  uint8_t *slots;
+  uint16_t slotSize;
+  uint16_t number;
+  PduLengthType size; /* the max SduLength */
+} CanIf_PacketClassType;
+#endif
 /* ================================ [ DECLARES  ] ============================================== */
 extern const CanIf_ConfigType CanIf_Config;
 /* ================================ [ DATAS     ] ============================================== */
+#ifdef CANIF_USE_PACKET_RX
 #if CANIF_PACKET_RX_POOL_SIZE > 0
-static CanIf_PacketListType canIfRxPackets;
-static CanIf_PacketType canIfRxPacketSlots[CANIF_PACKET_RX_POOL_SIZE];
-static mempool_t canIfRxPacketPool;
+static CanIf_Packet8Type canIfRxSlots8[CANIF_PACKET_RX_POOL_SIZE];
+#endif
+#if CANIF_PACKET_RX_POOL_SIZE_16 > 0
+static CanIf_Packet16Type canIfRxSlots16[CANIF_PACKET_RX_POOL_SIZE_16];
+#endif
+#if CANIF_PACKET_RX_POOL_SIZE_32 > 0
+static CanIf_Packet32Type canIfRxSlots32[CANIF_PACKET_RX_POOL_SIZE_32];
+#endif
+#if CANIF_PACKET_RX_POOL_SIZE_64 > 0
+static CanIf_Packet64Type canIfRxSlots64[CANIF_PACKET_RX_POOL_SIZE_64];
+#endif
+
+/* in the order of the size */
+static const CanIf_PacketClassType canIfRxPacketClasses[] = {
+#if CANIF_PACKET_RX_POOL_SIZE > 0
+  {(uint8_t *)canIfRxSlots8, sizeof(canIfRxSlots8[0]), ARRAY_SIZE(canIfRxSlots8), 8},
+#endif
+#if CANIF_PACKET_RX_POOL_SIZE_16 > 0
+  {(uint8_t *)canIfRxSlots16, sizeof(canIfRxSlots16[0]), ARRAY_SIZE(canIfRxSlots16), 16},
+#endif
+#if CANIF_PACKET_RX_POOL_SIZE_32 > 0
+  {(uint8_t *)canIfRxSlots32, sizeof(canIfRxSlots32[0]), ARRAY_SIZE(canIfRxSlots32), 32},
+#endif
+#if CANIF_PACKET_RX_POOL_SIZE_64 > 0
+  {(uint8_t *)canIfRxSlots64, sizeof(canIfRxSlots64[0]), ARRAY_SIZE(canIfRxSlots64), 64},
+#endif
+};
+
+static mempool_t canIfRxPacketPools[ARRAY_SIZE(canIfRxPacketClasses)];
 #endif
 /* ================================ [ LOCALS    ] ============================================== */
-static void CanIf_RxDispatch(const Can_HwType *Mailbox, const PduInfoType *PduInfoPtr) {
-  const CanIf_RxPduType *var;
+#ifdef CANIF_USE_TIME_STAMP
+static void CanIf_ToTimeStamp(uint64_t ns, Can_TimeStampType *timeStampPtr) {
+  timeStampPtr->seconds = (uint32_t)(ns / CANIF_NANOSECONDS_PER_SECOND);
+  timeStampPtr->nanoseconds = (uint32_t)(ns % CANIF_NANOSECONDS_PER_SECOND);
+}
+#endif
+
+static const CanIf_RxPduType *CanIf_RxHashLookup(const CanIf_CtrlConfigType *config,
+                                                  uint32_t canid) {
+  const CanIf_RxPduType *rxPdu = NULL;
+  uint16_t slot = CANIF_RX_HASH(canid, config->rxHashSize);
+  uint16_t index = config->rxHash[slot];
+  uint16_t n;
+
+  /* the generator leaves at least half of the slots empty, so the probe ends soon */
+  for (n = 0; (NULL == rxPdu) && (CANIF_RX_HASH_EMPTY != index) && (n < config->rxHashSize); n++) {
+    if (config->rxPdus[index].canid == canid) {
+      rxPdu = &config->rxPdus[index];
+    } else {
+      slot = (slot + 1u) & (config->rxHashSize - 1u);
+      index = config->rxHash[slot];
+    }
+  }
+
+  return rxPdu;
+}
+
+/* the lower bound search, so the first one configured wins if some have the same canid */
+static const CanIf_RxPduType *CanIf_RxGroupSearch(const CanIf_CtrlConfigType *config,
+                                                  const CanIf_RxGroupType *group, uint32_t canid) {
+  const CanIf_RxPduType *rxPdu = NULL;
+  uint32_t key = canid & group->mask;
+  uint16_t l = group->start;
+  uint16_t h = group->start + group->numOfRxPdus;
+  uint16_t m;
+
+  while (l < h) {
+    m = l + ((h - l) >> 1);
+    if (config->rxPdus[m].canid < key) {
+      l = m + 1u;
+    } else {
+      h = m;
+    }
+  }
+
+  if ((l < (group->start + group->numOfRxPdus)) && (config->rxPdus[l].canid == key)) {
+    rxPdu = &config->rxPdus[l];
+  }
+
+  return rxPdu;
+}
+
+static void CanIf_RxDispatch(const Can_HwType *Mailbox, const PduInfoType *PduInfoPtr,
+                             const CanIf_RxTimeType *RxTimePtr, uint8_t Path) {
   const CanIf_RxPduType *rxPdu = NULL;
   const CanIf_CtrlConfigType *config;
-  uint16_t l, h, m;
+#ifdef CANIF_USE_TIME_STAMP
+  CanIf_TimeStampSlotType *slot = NULL;
+#endif
   uint32_t canid;
+  uint8_t g;
 
   DET_VALIDATE((NULL != Mailbox) && (NULL != PduInfoPtr) && (NULL != PduInfoPtr->SduDataPtr), 0xFF,
                CANIF_E_PARAM_POINTER, return);
@@ -68,51 +181,38 @@ static void CanIf_RxDispatch(const Can_HwType *Mailbox, const PduInfoType *PduIn
          PduInfoPtr->SduDataPtr[5], PduInfoPtr->SduDataPtr[6], PduInfoPtr->SduDataPtr[7]));
 
   config = &CANIF_CONFIG->CtrlConfigs[Mailbox->ControllerId];
-  l = 0;
-  h = config->numOfRxPdus - 1;
+  canid = Mailbox->CanId & CANIF_RX_FULL_MASK;
 
-  canid = Mailbox->CanId & 0x1FFFFFFFul;
-
-  if (canid < config->rxPdus[0].canid) {
-    l = h + 1; /* avoid the underflow of "m - 1" */
-  }
-  while ((NULL == rxPdu) && (l <= h)) {
-    m = l + ((h - l) >> 1);
-    var = &config->rxPdus[m];
-    if (var->canid == (canid & var->mask)) {
-      rxPdu = var;
-    } else if (var->canid > canid) {
-      h = m - 1;
-    } else if (var->canid < canid) {
-      l = m + 1;
-    } else {
-      /* A case that has message with the same IDs: impossible!!! */
-      for (h = m + 1, var = &config->rxPdus[h];
-           (NULL == rxPdu) && (h < config->numOfRxPdus) && (var->canid == canid); h++) {
-        rxPdu = var;
-      }
-      for (l = m - 1, var = &config->rxPdus[l];
-           (NULL == rxPdu) && (l < config->numOfRxPdus) && (var->canid == canid); l--) {
-        /* NOTE: l-- underflow then to be UINT16_MAX */
-        rxPdu = var;
-      }
-      break;
-    }
+  g = 0;
+  if (NULL != config->rxHash) {
+    rxPdu = CanIf_RxHashLookup(config, canid);
+    g = 1;
   }
 
-#if defined(linux) || defined(_WIN32)
-  /* For the host PC tools, the CanIf table is not sorted */
-  for (l = 0; (l < config->numOfRxPdus) && (NULL == rxPdu); l++) {
-    var = &config->rxPdus[l];
-    if (var->canid == (canid & var->mask)) {
-      rxPdu = var;
-    }
+  for (; (NULL == rxPdu) && (g < config->numOfRxGroups); g++) {
+    rxPdu = CanIf_RxGroupSearch(config, &config->rxGroups[g], canid);
   }
-#endif
 
   if (NULL != rxPdu) {
     if (NULL != rxPdu->rxInd) {
+#ifdef CANIF_USE_TIME_STAMP
+      if ((NULL != RxTimePtr) && CANIF_IS_TIME_STAMP_RX(rxPdu)) {
+        slot = &CANIF_CONFIG->CtrlContexts[Mailbox->ControllerId].ingress[Path];
+        if (TRUE == RxTimePtr->byDriver) {
+          slot->timeStamp = RxTimePtr->timeStamp;
+        } else {
+          CanIf_ToTimeStamp(RxTimePtr->ns, &slot->timeStamp);
+        }
+        slot->pduId = rxPdu->rxPduId;
+        slot->valid = TRUE;
+      }
+#endif
       rxPdu->rxInd(rxPdu->rxPduId, PduInfoPtr);
+#ifdef CANIF_USE_TIME_STAMP
+      if (NULL != slot) {
+        slot->valid = FALSE;
+      }
+#endif
     } else {
       ASLOG(CANIF,
             ("[%d] 0x%" PRIu32 " rx without indication\n", Mailbox->ControllerId, Mailbox->CanId));
@@ -146,17 +246,100 @@ static void CanIf_MainFunction_TxTimeout(void) {
   }
 }
 #endif
+
+#ifdef CANIF_USE_PACKET_RX
+/* called by the rx ISR of the controller, the frame is dropped if the pools or the queue is full
+ * so that the frames are always dispatched in order */
+static void CanIf_RxDefer(CanIf_CtrlContextType *context, const Can_HwType *Mailbox,
+                          const PduInfoType *PduInfoPtr, const CanIf_RxTimeType *RxTimePtr) {
+  CanIf_PacketType *packet = NULL;
+  uint32_t head = context->rxHead;
+  uint32_t used = head - STD_ATOMIC_LOAD_ACQUIRE(context->rxTail);
+  uint8_t i;
+
+  if (used < CANIF_PACKET_RX_QUEUE_SIZE) {
+    /* the smallest class that fits, or a bigger one if it is used up */
+    for (i = 0; (NULL == packet) && (i < ARRAY_SIZE(canIfRxPacketClasses)); i++) {
+      if (PduInfoPtr->SduLength <= canIfRxPacketClasses[i].size) {
+        packet = (CanIf_PacketType *)mp_alloc(&canIfRxPacketPools[i]);
+        if (NULL != packet) {
+          packet->sizeClass = i;
+        }
+      }
+    }
+  }
+
+  if (NULL != packet) {
+    packet->mailbox = *Mailbox;
+    packet->timestamp = Std_GetTime();
+#ifdef CANIF_USE_TIME_STAMP
+    packet->rxTime = *RxTimePtr;
+#endif
+    packet->SduLength = PduInfoPtr->SduLength;
+    memcpy((uint8_t *)(packet + 1), PduInfoPtr->SduDataPtr, PduInfoPtr->SduLength);
+    context->rxQueue[head & CANIF_PACKET_RX_QUEUE_MASK] = packet;
+    STD_ATOMIC_STORE_RELEASE(context->rxHead, head + 1u);
+    context->rxStats.deferred++;
+    if ((used + 1u) > context->rxStats.queueMax) {
+      context->rxStats.queueMax = (uint16_t)(used + 1u);
+    }
+  } else {
+    context->rxStats.overflows++;
+    ASLOG(CANIFE, ("RX CAN ID=0x%08X LEN=%d overflow\n", Mailbox->CanId, PduInfoPtr->SduLength));
+  }
+  (void)RxTimePtr;
+}
+
+static void CanIf_RxDrain(CanIf_CtrlContextType *context) {
+  CanIf_PacketType *packet;
+  PduInfoType pduInfo;
+  uint32_t tail = context->rxTail;
+  uint32_t head = STD_ATOMIC_LOAD_ACQUIRE(context->rxHead);
+  uint32_t budget = CANIF_PACKET_RX_BUDGET;
+  uint32_t latency;
+
+  while ((tail != head) && (budget > 0u)) {
+    packet = context->rxQueue[tail & CANIF_PACKET_RX_QUEUE_MASK];
+    latency = (uint32_t)(Std_GetTime() - packet->timestamp);
+    if (latency > context->rxStats.latencyMax) {
+      context->rxStats.latencyMax = latency;
+    }
+    context->rxLatencySum += latency;
+    pduInfo.SduDataPtr = (uint8_t *)(packet + 1);
+    pduInfo.SduLength = packet->SduLength;
+    pduInfo.MetaDataPtr = (uint8_t *)&packet->mailbox;
+#ifdef CANIF_USE_TIME_STAMP
+    CanIf_RxDispatch(&packet->mailbox, &pduInfo, &packet->rxTime, CANIF_INGRESS_DEFERRED);
+#else
+    CanIf_RxDispatch(&packet->mailbox, &pduInfo, NULL, CANIF_INGRESS_DEFERRED);
+#endif
+    mp_free(&canIfRxPacketPools[packet->sizeClass], (uint8_t *)packet);
+    context->rxStats.dispatched++;
+    tail++;
+    budget--;
+    /* the slot is given back only after the packet is freed */
+    STD_ATOMIC_STORE_RELEASE(context->rxTail, tail);
+  }
+}
+#endif
 /* ================================ [ FUNCTIONS ] ============================================== */
 void CanIf_Init(const CanIf_ConfigType *ConfigPtr) {
   int i;
 
   for (i = 0; i < CANIF_CONFIG->numOfCtrls; i++) {
     CANIF_CONFIG->CtrlContexts[i].PduMode = CANIF_OFFLINE;
+#ifdef CANIF_USE_PACKET_RX
+    CANIF_CONFIG->CtrlContexts[i].rxHead = 0;
+    CANIF_CONFIG->CtrlContexts[i].rxTail = 0;
+    CANIF_CONFIG->CtrlContexts[i].rxLatencySum = 0;
+    memset(&CANIF_CONFIG->CtrlContexts[i].rxStats, 0, sizeof(CanIf_RxQueueStatsType));
+#endif
+  }
+#ifdef CANIF_USE_PACKET_RX
+  for (i = 0; i < (int)ARRAY_SIZE(canIfRxPacketClasses); i++) {
+    mp_init(&canIfRxPacketPools[i], canIfRxPacketClasses[i].slots,
+            canIfRxPacketClasses[i].slotSize, canIfRxPacketClasses[i].number);
   }
-#if CANIF_PACKET_RX_POOL_SIZE > 0
-  STAILQ_INIT(&canIfRxPackets);
-  mp_init(&canIfRxPacketPool, (uint8_t *)&canIfRxPacketSlots, sizeof(CanIf_PacketType),
-          ARRAY_SIZE(canIfRxPacketSlots));
 #endif
 }
 
@@ -275,43 +458,69 @@ void CanIf_SetDynamicTxId(PduIdType CanIfTxSduId, Can_IdType CanId) {
 
 void CanIf_TxConfirmation(PduIdType CanTxPduId) {
   const CanIf_TxPduType *txPdu;
-#ifdef CANIF_USE_TX_TIMEOUT
+#if defined(CANIF_USE_TX_TIMEOUT) || defined(CANIF_USE_TIME_STAMP)
   CanIf_CtrlContextType *context;
+#endif
+#ifdef CANIF_USE_TIME_STAMP
+  CanIf_TimeStampSlotType *slot = NULL;
 #endif
   /* @SWS_CANIF_00410 */
   DET_VALIDATE(CanTxPduId < CANIF_CONFIG->numOfTxPdus, 0x13, CANIF_E_PARAM_LPDU, return);
   txPdu = &CANIF_CONFIG->txPdus[CanTxPduId];
+#if defined(CANIF_USE_TX_TIMEOUT) || defined(CANIF_USE_TIME_STAMP)
+  context = &CANIF_CONFIG->CtrlContexts[txPdu->ControllerId];
+#endif
+#ifdef CANIF_USE_TIME_STAMP
+  if (CANIF_IS_TIME_STAMP_TX(txPdu)) {
+    slot = &context->egress;
+    if (E_OK != Can_GetEgressTimeStamp(CanTxPduId, txPdu->hoh, &slot->timeStamp)) {
+      CanIf_ToTimeStamp(Std_GetTimeNs(), &slot->timeStamp);
+    }
+    slot->pduId = txPdu->txPduId;
+    slot->valid = TRUE;
+  }
+#endif
   txPdu->txConfirm(txPdu->txPduId, E_OK);
+#ifdef CANIF_USE_TIME_STAMP
+  if (NULL != slot) {
+    slot->valid = FALSE;
+  }
+#endif
 
 #ifdef CANIF_USE_TX_TIMEOUT
-  context = &CANIF_CONFIG->CtrlContexts[txPdu->ControllerId];
   context->txTimeoutTimer = 0; /* cancel the timer */
 #endif
 }
 
 void CanIf_RxIndication(const Can_HwType *Mailbox, const PduInfoType *PduInfoPtr) {
+  const CanIf_RxTimeType *rxTimePtr = NULL;
+#ifdef CANIF_USE_TIME_STAMP
+  CanIf_RxTimeType rxTime;
+#endif
   /* @SWS_CANIF_00419 */
   DET_VALIDATE((NULL != Mailbox) && (NULL != PduInfoPtr) && (NULL != PduInfoPtr->SduDataPtr), 0x14,
                CANIF_E_PARAM_POINTER, return);
 
-#if CANIF_PACKET_RX_POOL_SIZE > 0
-  CanIf_PacketType *packet = NULL;
-  if (PduInfoPtr->SduLength <= CANIF_PATCKET_MAX_SIZE) {
-    packet = (CanIf_PacketType *)mp_alloc(&canIfRxPacketPool);
-    if (NULL != packet) {
-      packet->mailbox = *Mailbox;
-      packet->SduLength = PduInfoPtr->SduLength;
-      memcpy(packet->data, PduInfoPtr->SduDataPtr, PduInfoPtr->SduLength);
-      EnterCritical();
-      STAILQ_INSERT_TAIL(&canIfRxPackets, packet, entry);
-      ExitCritical();
-    }
+#ifdef CANIF_USE_TIME_STAMP
+  /* taken before the deferral, so the latency of the dispatch is not in it */
+  rxTime.byDriver = (E_OK == Can_GetIngressTimeStamp(Mailbox->Hoh, &rxTime.timeStamp));
+  if (FALSE == rxTime.byDriver) {
+    rxTime.ns = Std_GetTimeNs();
   }
-  if (NULL == packet) {
-    CanIf_RxDispatch(Mailbox, PduInfoPtr);
+  rxTimePtr = &rxTime;
+#endif
+
+#ifdef CANIF_USE_PACKET_RX
+  /* the bad ControllerId is reported by the dispatch */
+  if ((Mailbox->ControllerId < CANIF_CONFIG->numOfCtrls) &&
+      (PduInfoPtr->SduLength <= canIfRxPacketClasses[ARRAY_SIZE(canIfRxPacketClasses) - 1u].size)) {
+    CanIf_RxDefer(&CANIF_CONFIG->CtrlContexts[Mailbox->ControllerId], Mailbox, PduInfoPtr,
+                  rxTimePtr);
+  } else {
+    CanIf_RxDispatch(Mailbox, PduInfoPtr, rxTimePtr, CANIF_INGRESS_INLINE);
   }
 #else
-  CanIf_RxDispatch(Mailbox, PduInfoPtr);
+  CanIf_RxDispatch(Mailbox, PduInfoPtr, rxTimePtr, CANIF_INGRESS_INLINE);
 #endif
 }
 
@@ -324,26 +533,12 @@ void CanIf_ControllerBusOff(uint8_t ControllerId) {
 }
 
 void CanIf_MainFunction_Fast(void) {
-#if CANIF_PACKET_RX_POOL_SIZE > 0
-  CanIf_PacketType *packet = NULL;
-  PduInfoType pduInfo;
-#endif
+#ifdef CANIF_USE_PACKET_RX
+  int i;
 
-#if CANIF_PACKET_RX_POOL_SIZE > 0
-  EnterCritical();
-  packet = STAILQ_FIRST(&canIfRxPackets);
-  while (NULL != packet) {
-    STAILQ_REMOVE_HEAD(&canIfRxPackets, entry);
-    InterLeaveCritical();
-    pduInfo.SduDataPtr = packet->data;
-    pduInfo.SduLength = packet->SduLength;
-    pduInfo.MetaDataPtr = (uint8_t *)&packet->mailbox;
-    CanIf_RxDispatch(&packet->mailbox, &pduInfo);
-    mp_free(&canIfRxPacketPool, (uint8_t *)packet);
-    InterEnterCritical();
-    packet = STAILQ_FIRST(&canIfRxPackets);
+  for (i = 0; i < CANIF_CONFIG->numOfCtrls; i++) {
+    CanIf_RxDrain(&CANIF_CONFIG->CtrlContexts[i]);
   }
-  ExitCritical();
 #endif
 
 #if defined(CANIF_USE_TX_TIMEOUT) && (1 == CANIF_MAIN_FUNCTION_PERIOD)
@@ -356,3 +551,102 @@ void CanIf_MainFunction(void) {
   CanIf_MainFunction_TxTimeout();
 #endif
 }
+
+Std_ReturnType CanIf_GetRxQueueStats(uint8_t ControllerId, CanIf_RxQueueStatsType *StatsPtr) {
+  Std_ReturnType ret = E_NOT_OK;
+#ifdef CANIF_USE_PACKET_RX
+  CanIf_CtrlContextType *context;
+  uint64_t latencySum;
+#endif
+
+  DET_VALIDATE(NULL != StatsPtr, 0xF0, CANIF_E_PARAM_POINTER, return E_NOT_OK);
+  DET_VALIDATE(ControllerId < CANIF_CONFIG->numOfCtrls, 0xF0, CANIF_E_PARAM_CONTROLLERID,
+               return E_NOT_OK);
+#ifdef CANIF_USE_PACKET_RX
+  if (ControllerId < CANIF_CONFIG->numOfCtrls) {
+    context = &CANIF_CONFIG->CtrlContexts[ControllerId];
+    EnterCritical();
+    *StatsPtr = context->rxStats;
+    latencySum = context->rxLatencySum;
+    ExitCritical();
+    if (StatsPtr->dispatched > 0u) {
+      StatsPtr->latencyAvg = (uint32_t)(latencySum / StatsPtr->dispatched);
+    }
+    ret = E_OK;
+  }
+#else
+  (void)ControllerId;
+  (void)StatsPtr;
+#endif
+
+  return ret;
+}
+
+Std_ReturnType CanIf_GetIngressTimeStamp(PduIdType RxPduId, Can_TimeStampType *timeStampPtr) {
+  Std_ReturnType ret = E_NOT_OK;
+#ifdef CANIF_USE_TIME_STAMP
+  const CanIf_TimeStampSlotType *slot;
+  uint8_t i;
+  uint8_t path;
+#endif
+
+  DET_VALIDATE(NULL != timeStampPtr, 0xF1, CANIF_E_PARAM_POINTER, return E_NOT_OK);
+#ifdef CANIF_USE_TIME_STAMP
+  /* the inline slot first, it is valid only while the rx ISR is running, which preempts all */
+  for (path = CANIF_INGRESS_INLINE; (E_OK != ret) && (path <= CANIF_INGRESS_DEFERRED); path++) {
+    for (i = 0; (E_OK != ret) && (i < CANIF_CONFIG->numOfCtrls); i++) {
+      slot = &CANIF_CONFIG->CtrlContexts[i].ingress[path];
+      if ((TRUE == slot->valid) && (RxPduId == slot->pduId)) {
+        *timeStampPtr = slot->timeStamp;
+        ret = E_OK;
+      }
+    }
+  }
+#else
+  (void)RxPduId;
+  (void)timeStampPtr;
+#endif
+
+  return ret;
+}
+
+Std_ReturnType CanIf_GetEgressTimeStamp(PduIdType TxPduId, Can_TimeStampType *timeStampPtr) {
+  Std_ReturnType ret = E_NOT_OK;
+#ifdef CANIF_USE_TIME_STAMP
+  const CanIf_TimeStampSlotType *slot;
+  uint8_t i;
+#endif
+
+  DET_VALIDATE(NULL != timeStampPtr, 0xF2, CANIF_E_PARAM_POINTER, return E_NOT_OK);
+#ifdef CANIF_USE_TIME_STAMP
+  for (i = 0; (E_OK != ret) && (i < CANIF_CONFIG->numOfCtrls); i++) {
+    slot = &CANIF_CONFIG->CtrlContexts[i].egress;
+    if ((TRUE == slot->valid) && (TxPduId == slot->pduId)) {
+      *timeStampPtr = slot->timeStamp;
+      ret = E_OK;
+    }
+  }
+#else
+  (void)TxPduId;
+  (void)timeStampPtr;
+#endif
+
+  return ret;
+}
+
+#ifdef CANIF_USE_TIME_STAMP
+FUNC(Std_ReturnType, __weak)
+Can_GetIngressTimeStamp(Can_HwHandleType Hrh, Can_TimeStampType *timeStampPtr) {
+  (void)Hrh;
+  (void)timeStampPtr;
+  return E_NOT_OK;
+}
+
+FUNC(Std_ReturnType, __weak)
+Can_GetEgressTimeStamp(PduIdType TxPduId, Can_HwHandleType Hth, Can_TimeStampType *timeStampPtr) {
+  (void)TxPduId;
+  (void)Hth;
+  (void)timeStampPtr;
+  return E_NOT_OK;
+}
+#endif
@@ -11,6 +11,65 @@
 #include "Can_GeneralTypes.h"
 /* ================================ [ MACROS    ] ============================================== */
 #define DET_THIS_MODULE_ID MODULE_ID_CANIF
+
+#define CANIF_RX_FULL_MASK 0x1FFFFFFFul
+
+/* the slot of the rxHash not used */
+#define CANIF_RX_HASH_EMPTY 0xFFFFu
+
+/* the generator does the same, see tools/generator/CanIf.py */
+#define CANIF_RX_HASH(canid, size) (((uint32_t)((canid) * 0x9E3779B1ul) >> 16) & ((size) - 1u))
+
+/* the number of the rx packets of each size class to defer the rx from the ISR to the
+ * CanIf_MainFunction_Fast, a frame which has no class configured is dispatched in the ISR */
+#ifndef CANIF_PACKET_RX_POOL_SIZE
+#define CANIF_PACKET_RX_POOL_SIZE 0 /* the 8 bytes class */
+#endif
+#ifndef CANIF_PACKET_RX_POOL_SIZE_16
+#define CANIF_PACKET_RX_POOL_SIZE_16 0
+#endif
+#ifndef CANIF_PACKET_RX_POOL_SIZE_32
+#define CANIF_PACKET_RX_POOL_SIZE_32 0
+#endif
+#ifndef CANIF_PACKET_RX_POOL_SIZE_64
+#define CANIF_PACKET_RX_POOL_SIZE_64 0
+#endif
+
+#if (CANIF_PACKET_RX_POOL_SIZE + CANIF_PACKET_RX_POOL_SIZE_16 + CANIF_PACKET_RX_POOL_SIZE_32 +   \
+     CANIF_PACKET_RX_POOL_SIZE_64) > 0
+#define CANIF_USE_PACKET_RX
+#endif
+
+/* the queue of each controller, power of 2 */
+#ifndef CANIF_PACKET_RX_QUEUE_SIZE
+#define CANIF_PACKET_RX_QUEUE_SIZE 32
+#endif
+#if (0 != (CANIF_PACKET_RX_QUEUE_SIZE & (CANIF_PACKET_RX_QUEUE_SIZE - 1)))
+#error CANIF_PACKET_RX_QUEUE_SIZE must be power of 2
+#endif
+
+/* the max frames of each controller dispatched by one CanIf_MainFunction_Fast */
+#ifndef CANIF_PACKET_RX_BUDGET
+#define CANIF_PACKET_RX_BUDGET CANIF_PACKET_RX_QUEUE_SIZE
+#endif
+
+/* the ingress and egress time stamps of the frames, for the time synchronization */
+#if defined(USE_CANTSYN) && !defined(CANIF_USE_TIME_STAMP)
+#define CANIF_USE_TIME_STAMP
+#endif
+
+/* only the frames of the time synchronization are time stamped */
+#ifdef USE_CANTSYN
+#define CANIF_IS_TIME_STAMP_RX(rxPdu) (CanTSyn_RxIndication == (rxPdu)->rxInd)
+#define CANIF_IS_TIME_STAMP_TX(txPdu) (CanTSyn_TxConfirmation == (txPdu)->txConfirm)
+#else
+#define CANIF_IS_TIME_STAMP_RX(rxPdu) TRUE
+#define CANIF_IS_TIME_STAMP_TX(txPdu) TRUE
+#endif
+
+/* the ingress time stamp slot of the dispatch in the rx ISR and of the deferred one */
+#define CANIF_INGRESS_INLINE 0
+#define CANIF_INGRESS_DEFERRED 1
 /* ================================ [ TYPES     ] ============================================== */
 typedef void (*CanIf_RxIndicationFncType)(PduIdType RxPduId, const PduInfoType *PduInfoPtr);
 typedef void (*CanIf_TxConfirmationFncType)(PduIdType TxPduId, Std_ReturnType result);
@@ -23,6 +82,13 @@ typedef struct {
   Can_HwHandleType hoh;
 } CanIf_RxPduType;
 
+/* the rx PDUs with the same mask, which are sorted by the canid */
+typedef struct {
+  Can_IdType mask;
+  uint16_t start; /* the index of the first rx PDU of this group */
+  uint16_t numOfRxPdus;
+} CanIf_RxGroupType;
+
 typedef struct {
   CanIf_TxConfirmationFncType txConfirm;
   PduIdType txPduId;
@@ -32,16 +98,48 @@ typedef struct {
   uint8_t ControllerId;
 } CanIf_TxPduType;
 
+typedef struct CanIf_Packet_s CanIf_PacketType;
+
+#ifdef CANIF_USE_TIME_STAMP
+typedef struct {
+  Can_TimeStampType timeStamp;
+  PduIdType pduId; /* of the upper layer */
+  boolean valid;   /* in the rx indication or the tx confirmation */
+} CanIf_TimeStampSlotType;
+#endif
+
 typedef struct {
   CanIf_PduModeType PduMode;
 #ifdef CANIF_USE_TX_TIMEOUT
   uint16_t txTimeoutTimer;
 #endif
+#ifdef CANIF_USE_PACKET_RX
+  /* the rx ISR of the controller is the only producer and the CanIf_MainFunction_Fast is the only
+   * consumer, so the queue needs no lock */
+  CanIf_PacketType *rxQueue[CANIF_PACKET_RX_QUEUE_SIZE];
+  uint32_t rxHead;
+  uint32_t rxTail;
+  uint64_t rxLatencySum;
+  CanIf_RxQueueStatsType rxStats;
+#endif
+#ifdef CANIF_USE_TIME_STAMP
+  /* kept per controller and per dispatch path, so the rx ISR which preempts the deferred dispatch
+   * doesn't overwrite the time stamp that the deferred one is taking */
+  CanIf_TimeStampSlotType ingress[2];
+  CanIf_TimeStampSlotType egress;
+#endif
 } CanIf_CtrlContextType;
 
 typedef struct {
   const CanIf_RxPduType *rxPdus;
   uint16_t numOfRxPdus;
+  /* the groups are ordered by the mask from the most specific one, which are searched in turns */
+  const CanIf_RxGroupType *rxGroups;
+  uint8_t numOfRxGroups;
+  /* optional, the open addressing table of the index of the rx PDUs of the first group which is the
+   * CANIF_RX_FULL_MASK one, the first group is then not searched */
+  const uint16_t *rxHash;
+  uint16_t rxHashSize; /* power of 2 */
 #ifdef CANIF_USE_TX_TIMEOUT
   uint16_t txTimerout;
 #endif
@@ -32,29 +32,40 @@ extern const CanTSyn_ConfigType CanTSyn_Config;
 /* ================================ [ LOCALS    ] ============================================== */
 /*               TM                            TS
  *               |                             |
- *       t0r --> | \   SYNC(s(t0r))            |
+ *       t0r --> | \   SYNC(s(t0))             |
  *               |  \---------------------\    |
  *       t1r --> |                        \--> | <-- t2r: this must be in interrupt
  *               |                             |
  *               |                             |
- *       FUP --> | \  FUP(t4r=t1r-s(t0r))      |
+ *       FUP --> | \  FUP(t4r=t1r-t0r+ns(t0))  |
  *               |  \---------------------\    |
  *               |                        \--> |
  *               |                             |
- *               |                             | <-- t3r: this can be in interrupt or pooling
- *               |                             |
- * t0r is the time that shall be transmitted. Second portion of t0r is put in CAN message.
+ * t0 is the global time that shall be transmitted, taken together with its virtual local time t0r.
+ * Second portion of t0 is put in CAN message.
  * Capture actual time of transmission time t1r through transmit confirmation in the interrupt.
  * Capture actual time of reception time t2r through receive indication in the interrupt.
- *   computed rel.time = (t3r - t2r) + s(t0r) + t4r
- *                                     `--- t1r --`
+ * The t1r and t2r are the time stamps CanIf takes in the ISR, or the hardware ones of the driver,
+ * so that they have no jitter of the processing of the confirmation and the indication.
+ *   global time at t2r = s(t0) + t4r
+ * which is given to the StbM with the t2r, so its rate correction measures on the time stamps.
  */
-static void CanTSyn_HandleMsgSync(const CanTSyn_GlobalTimeDomainType *domain,
+static void CanTSyn_GetTimeStamp(const Can_TimeStampType *timeStamp,
+                                 StbM_VirtualLocalTimeType *localTimePtr) {
+  uint64_t ns = (uint64_t)timeStamp->seconds * CANTSYN_NANOSECONDS_PER_SECOND +
+                timeStamp->nanoseconds;
+
+  localTimePtr->nanosecondsHi = (uint32_t)(ns >> 32);
+  localTimePtr->nanosecondsLo = (uint32_t)(ns & 0xFFFFFFFFul);
+}
+
+static void CanTSyn_HandleMsgSync(const CanTSyn_GlobalTimeDomainType *domain, PduIdType RxPduId,
                                   const uint8_t *payload, PduLengthType length) {
   CanTSyn_SlaveContextType *context = domain->U.S.context;
   uint8_t D, SC;
   uint8_t crc;
   Std_ReturnType ret = E_OK;
+  Can_TimeStampType timeStamp;
 
   if (CANTSYN_SYNC_NO_CRC == payload[0]) {
     /* @SWS_CanTSyn_00058, @SWS_CanTSyn_00059, @SWS_CanTSyn_00109 */
@@ -88,7 +99,7 @@ static void CanTSyn_HandleMsgSync(const CanTSyn_GlobalTimeDomainType *domain,
 
     D = (payload[2] >> 4) & 0xF;
     SC = payload[2] & 0xF;
-    if (CANTSYNC_SC_UNKNOWN != context->SC) {
+    if (CANTSYNC_SC_UNKNOWN == context->SC) {
       context->SC = SC; /* @SWS_CanTSyn_00079 */
     } else if ((SC > context->SC) &&
                ((SC - context->SC) <= domain->U.S.Slave->GlobalTimeSequenceCounterJumpWidth)) {
@@ -113,7 +124,11 @@ static void CanTSyn_HandleMsgSync(const CanTSyn_GlobalTimeDomainType *domain,
 
   if (E_OK == ret) {
     /* @SWS_CanTSyn_00073 */
-    ret = StbM_GetCurrentVirtualLocalTime(domain->SynchronizedTimeBaseRef, &context->t2r);
+    if (E_OK == CanIf_GetIngressTimeStamp(RxPduId, &timeStamp)) {
+      CanTSyn_GetTimeStamp(&timeStamp, &context->t2r);
+    } else {
+      ret = StbM_GetCurrentVirtualLocalTime(domain->SynchronizedTimeBaseRef, &context->t2r);
+    }
     if (E_OK == ret) {
       context->st0r = ((uint32_t)payload[4] << 24) + ((uint32_t)payload[5] << 16) +
                       ((uint32_t)payload[6] << 8) + payload[7];
@@ -126,14 +141,12 @@ static void CanTSyn_HandleMsgSync(const CanTSyn_GlobalTimeDomainType *domain,
   }
 }
 
-static Std_ReturnType
-CanTSyn_CalcGlobalTimestamp(StbM_TimeStampType *timestamp, uint32_t st0r /* seconds */,
-                            uint32_t t4r /*nanoseconds */, uint8_t ovs /* seconds */,
-                            StbM_VirtualLocalTimeType *t2r, StbM_VirtualLocalTimeType *t3r) {
+static Std_ReturnType CanTSyn_CalcGlobalTimestamp(StbM_TimeStampType *timestamp,
+                                                  uint32_t st0r /* seconds */,
+                                                  uint32_t t4r /*nanoseconds */,
+                                                  uint8_t ovs /* seconds */) {
   Std_ReturnType ret = E_OK;
-  uint64_t diff;
-  diff = (((uint64_t)t3r->nanosecondsHi << 32) + t3r->nanosecondsLo) -
-         (((uint64_t)t2r->nanosecondsHi << 32) + t2r->nanosecondsLo) + t4r;
+  uint64_t diff = t4r;
 
   timestamp->seconds = diff / CANTSYN_NANOSECONDS_PER_SECOND; /* get seconds portion */
   timestamp->nanoseconds = diff - timestamp->seconds * CANTSYN_NANOSECONDS_PER_SECOND;
@@ -155,7 +168,6 @@ static void CanTSyn_HandleMsgFup(const CanTSyn_GlobalTimeDomainType *domain, con
   uint8_t D, SC;
   uint8_t crc;
   Std_ReturnType ret = E_OK;
-  StbM_VirtualLocalTimeType t3r;
   uint32_t t4r;
   uint8_t sgw;
   uint8_t ovs;
@@ -213,29 +225,27 @@ static void CanTSyn_HandleMsgFup(const CanTSyn_GlobalTimeDomainType *domain, con
   }
 
   if (E_OK == ret) {
-    /* @SWS_CanTSyn_00073 */
-    ret = StbM_GetCurrentVirtualLocalTime(domain->SynchronizedTimeBaseRef, &t3r);
-    if (E_OK == ret) {
-      sgw = (payload[3] >> 2) & 0x01; /* SyncToGTM = 0, SyncToSubDomain = 1 */
-      ovs = payload[3] & 0x03;
-      t4r = ((uint32_t)payload[4] << 24) + ((uint32_t)payload[5] << 16) +
-            ((uint32_t)payload[6] << 8) + payload[7];
+    sgw = (payload[3] >> 2) & 0x01; /* SyncToGTM = 0, SyncToSubDomain = 1 */
+    ovs = payload[3] & 0x03;
+    t4r = ((uint32_t)payload[4] << 24) + ((uint32_t)payload[5] << 16) +
+          ((uint32_t)payload[6] << 8) + payload[7];
 
-      if (sgw) {
-        timestamp.timeBaseStatus |= STBM_STATUS_SYNC_TO_GATEWAY;
-      }
+    if (sgw) {
+      timestamp.timeBaseStatus |= STBM_STATUS_SYNC_TO_GATEWAY;
+    }
 
-      ret = CanTSyn_CalcGlobalTimestamp(&timestamp, context->st0r, t4r, ovs, &context->t2r, &t3r);
-      if (E_OK == ret) {
-        /* @CAN Time Synchronization (Time Slave)
-         * *timeStampPtr = T3diff + (T0+T4);
-         * *localTimePtr = T3VLT
-         */
-        (void)StbM_BusSetGlobalTime(domain->SynchronizedTimeBaseRef, &timestamp, NULL, NULL, &t3r);
-      }
-      context->timer = 0;
-      context->state = CANTSYN_SLAVE_IDLE;
+    ret = CanTSyn_CalcGlobalTimestamp(&timestamp, context->st0r, t4r, ovs);
+    if (E_OK == ret) {
+      /* @CAN Time Synchronization (Time Slave)
+       * *timeStampPtr = T0+T4;
+       * *localTimePtr = T2VLT
+       * the same as T3diff + (T0+T4) with T3VLT, without the jitter of the T3VLT
+       */
+      (void)StbM_BusSetGlobalTime(domain->SynchronizedTimeBaseRef, &timestamp, NULL, NULL,
+                                  &context->t2r);
     }
+    context->timer = 0;
+    context->state = CANTSYN_SLAVE_IDLE;
   }
 }
 
@@ -243,7 +253,6 @@ static void CanTSyn_TransmitSYNC(const CanTSyn_GlobalTimeDomainType *domain) {
   Std_ReturnType ret = E_OK;
   uint8_t data[16];
   PduInfoType PduInfo;
-  uint64_t t0rNs;
   uint32_t st0r;
   CanTSyn_MasterContextType *context = domain->U.M.context;
 
@@ -257,10 +266,9 @@ static void CanTSyn_TransmitSYNC(const CanTSyn_GlobalTimeDomainType *domain) {
   data[2] = (domain->GlobalTimeDomainId << 4) + context->SC;
   data[3] = 0x00;
 
-  ret = StbM_GetCurrentVirtualLocalTime(domain->SynchronizedTimeBaseRef, &context->t0r);
+  ret = StbM_BusGetCurrentTime(domain->SynchronizedTimeBaseRef, &context->t0, &context->t0r, NULL);
   if (E_OK == ret) {
-    t0rNs = ((uint64_t)context->t0r.nanosecondsHi << 32) + context->t0r.nanosecondsLo;
-    st0r = t0rNs / CANTSYN_NANOSECONDS_PER_SECOND;
+    st0r = context->t0.seconds;
     data[4] = (st0r >> 24) & 0xFF;
     data[5] = (st0r >> 16) & 0xFF;
     data[6] = (st0r >> 8) & 0xFF;
@@ -298,7 +306,6 @@ static void CanTSyn_TransmitFUP(const CanTSyn_GlobalTimeDomainType *domain) {
   Std_ReturnType ret = E_OK;
   uint8_t data[16];
   PduInfoType PduInfo;
-  uint32_t st0r;
   uint64_t t4r;
   uint64_t t0rNs;
   uint64_t t1rNs;
@@ -321,8 +328,7 @@ static void CanTSyn_TransmitFUP(const CanTSyn_GlobalTimeDomainType *domain) {
 
   t0rNs = ((uint64_t)context->t0r.nanosecondsHi << 32) + context->t0r.nanosecondsLo;
   t1rNs = ((uint64_t)context->t1r.nanosecondsHi << 32) + context->t1r.nanosecondsLo;
-  st0r = t0rNs / CANTSYN_NANOSECONDS_PER_SECOND;
-  t4r = t1rNs - (uint64_t)st0r * CANTSYN_NANOSECONDS_PER_SECOND;
+  t4r = t1rNs - t0rNs + context->t0.nanoseconds;
 
   if (t4r >= CANTSYN_NANOSECONDS_MAX_U32) {
     if (t4r <= CANTSYN_NANOSECONDS_MAX_WITH_OVS) {
@@ -483,7 +489,7 @@ void CanTSyn_RxIndication(PduIdType RxPduId, const PduInfoType *PduInfoPtr) {
     switch (PduInfoPtr->SduDataPtr[0]) {
     case CANTSYN_SYNC_NO_CRC:
     case CANTSYN_SYNC_WITH_CRC:
-      CanTSyn_HandleMsgSync(domain, &PduInfoPtr->SduDataPtr[0], PduInfoPtr->SduLength);
+      CanTSyn_HandleMsgSync(domain, RxPduId, &PduInfoPtr->SduDataPtr[0], PduInfoPtr->SduLength);
       break;
     case CANTSYN_FUP_NO_CRC:
     case CANTSYN_FUP_WITH_CRC:
@@ -498,15 +504,20 @@ void CanTSyn_RxIndication(PduIdType RxPduId, const PduInfoType *PduInfoPtr) {
 }
 
 void CanTSyn_TxConfirmation(PduIdType TxPduId, Std_ReturnType result) {
-  Std_ReturnType ret;
+  Std_ReturnType ret = E_OK;
   const CanTSyn_GlobalTimeDomainType *domain;
   CanTSyn_MasterContextType *context;
+  Can_TimeStampType timeStamp;
   if (TxPduId < CANTSYN_CONFIG->numOfGlobalTimeDomains) {
     domain = &CANTSYN_CONFIG->GlobalTimeDomains[TxPduId];
     if (CANTSYN_MASTER == domain->DomainType) {
       context = domain->U.M.context;
       if (CANTSYN_MASTER_SYNCED == context->state) {
-        ret = StbM_GetCurrentVirtualLocalTime(domain->SynchronizedTimeBaseRef, &context->t1r);
+        if (E_OK == CanIf_GetEgressTimeStamp(TxPduId, &timeStamp)) {
+          CanTSyn_GetTimeStamp(&timeStamp, &context->t1r);
+        } else {
+          ret = StbM_GetCurrentVirtualLocalTime(domain->SynchronizedTimeBaseRef, &context->t1r);
+        }
         if (E_OK == ret) {
           context->state = CANTSYN_MASTER_FUP;
         } else {
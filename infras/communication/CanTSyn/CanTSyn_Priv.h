@@ -82,6 +82,7 @@ typedef struct {
 typedef uint8_t CanTSync_MasterStateType;
 
 typedef struct {
+  StbM_TimeStampType t0; /* the global time of the SYNC, at the t0r */
   StbM_VirtualLocalTimeType t0r;
   StbM_VirtualLocalTimeType t1r;
   uint16_t timer;
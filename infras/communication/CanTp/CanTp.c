@@ -19,6 +19,7 @@
 #include <string.h>
 #include "Std_Topic.h"
 #include "Std_Critical.h"
+#include "Std_Compiler.h"
 
 #include "Det.h"
 /* ================================ [ MACROS    ] ============================================== */
@@ -30,6 +31,17 @@
 #define CANTP_STMIN_ADJUST 0
 #endif
 
+/* the period of CanTp_MainFunction_Fast */
+#ifndef CANTP_MAIN_FUNCTION_FAST_PERIOD_US
+#define CANTP_MAIN_FUNCTION_FAST_PERIOD_US 1000
+#endif
+
+/* the max CFs sent back to back by one call of the fast main function without the TX confirmation,
+ * they are limited by the BS and the CanIf queue as well */
+#ifndef CANTP_CF_BURST_MAX
+#define CANTP_CF_BURST_MAX 8
+#endif
+
 #define CANTP_CONFIG (&CanTp_Config)
 
 /* see ISO 15765-2 2004 */
@@ -77,6 +89,7 @@ static void CanTp_ResetToIdle(CanTp_ChannelContextType *context) {
   CanTpCancelAlarm();
   context->state = CANTP_IDLE;
   context->TpSduLength = 0;
+  context->STminTicks = 0;
 }
 
 #ifndef CANTP_FIX_LL_DL
@@ -285,9 +298,10 @@ static void CanTp_HandleFF(PduIdType RxPduId, uint8_t pci, uint8_t *data, uint8_
   }
 
   if ((config->LL_DL > 8) && (0 == TpSduLength)) {
-    TpSduLength = ((uint32_t)data[2] << 24) + ((uint32_t)data[3] << 16) + ((uint32_t)data[4] << 8) +
-                  ((uint32_t)data[5]);
-    PduInfo.SduDataPtr = &data[6];
+    /* the escape sequence, data[0] is the 0 low byte of the 12 bits FF_DL */
+    TpSduLength = ((uint32_t)data[1] << 24) + ((uint32_t)data[2] << 16) + ((uint32_t)data[3] << 8) +
+                  ((uint32_t)data[4]);
+    PduInfo.SduDataPtr = &data[5];
     PduInfo.SduLength -= 4;
     ffLen -= 4;
   }
@@ -660,6 +674,52 @@ static void CanTp_SendCF(PduIdType TxPduId) {
   }
 }
 
+#ifndef CANTP_USE_TRIGGER_TRANSMIT
+/* ISO 15765-2: 0x00 - 0x7F in ms, 0xF1 - 0xF9 in 100 us, the reserved values are taken as 0x7F */
+static uint32_t CanTp_GetSTminUs(uint8_t STmin) {
+  uint32_t us;
+
+  if (STmin <= 0x7F) {
+    us = (uint32_t)STmin * 1000u;
+  } else if ((STmin >= 0xF1) && (STmin <= 0xF9)) {
+    us = (uint32_t)(STmin - 0xF0) * 100u;
+  } else {
+    us = 0x7Fu * 1000u;
+  }
+
+  return us;
+}
+
+/* wait the STmin before the next CF, by the port timer, the fast or the slow main function */
+static void CanTp_DelayCF(PduIdType TxPduId) {
+  const CanTp_ChannelConfigType *config;
+  CanTp_ChannelContextType *context;
+  Std_ReturnType ret = E_NOT_OK;
+  uint32_t us;
+
+  context = &(CANTP_CONFIG->channelContexts[TxPduId]);
+  config = &(CANTP_CONFIG->channelConfigs[TxPduId]);
+  us = CanTp_GetSTminUs(context->STmin);
+
+  context->state = CANTP_SEND_CF_DELAY;
+  context->STminTicks = 0;
+#ifdef CANTP_USE_HIGH_RATE
+  ret = CanTp_PortStartTimer(TxPduId, us);
+#endif
+  if (E_OK == ret) {
+    /* the N_As is only a backstop in case the port timer is lost */
+    CanTpSetAlarm(config->N_As);
+  } else {
+    if (us <= CANTP_MAIN_FUNCTION_FAST_PERIOD_US) {
+      /* the first fast cycle may come right away, so it is at least 1 full cycle after 2 */
+      context->STminTicks = 2;
+    }
+    /* the slow main function sends it as well, in case the fast one is not called at all */
+    CanTpSetAlarm(CANTP_CONVERT_MS_TO_MAIN_CYCLES((us + 999u) / 1000u + CANTP_STMIN_ADJUST));
+  }
+}
+#endif
+
 static void CanTp_HandleCFTxCompleted(PduIdType TxPduId) {
   const CanTp_ChannelConfigType *config;
   CanTp_ChannelContextType *context;
@@ -683,8 +743,7 @@ static void CanTp_HandleCFTxCompleted(PduIdType TxPduId) {
       CanTp_SendCF(TxPduId);
 #else
       if (context->STmin > 0) {
-        context->state = CANTP_SEND_CF_DELAY;
-        CanTpSetAlarm(CANTP_CONVERT_MS_TO_MAIN_CYCLES(context->STmin + CANTP_STMIN_ADJUST));
+        CanTp_DelayCF(TxPduId);
       } else {
         CanTp_SendCF(TxPduId);
       }
@@ -808,6 +867,7 @@ void CanTp_InitChannel(uint8_t Channel) {
   context->state = CANTP_IDLE;
   CanTpCancelAlarm();
   context->STmin = 0;
+  context->STminTicks = 0;
   context->PduInfo.MetaDataPtr = NULL;
   context->TpSduLength = 0;
 }
@@ -1019,6 +1079,9 @@ void CanTp_MainFunction_Channel(uint8_t Channel) {
 void CanTp_MainFunction_ChannelFast(uint8_t Channel) {
 #ifndef CANTP_USE_TRIGGER_TRANSMIT
   CanTp_ChannelContextType *context;
+#if defined(CANTP_USE_HIGH_RATE) && !defined(CANTP_USE_TX_CONFIRMATION)
+  uint8_t i;
+#endif
   context = &(CANTP_CONFIG->channelContexts[Channel]);
 
   switch (context->state) {
@@ -1029,9 +1092,30 @@ void CanTp_MainFunction_ChannelFast(uint8_t Channel) {
   case CANTP_RESEND_CF:
     CanTp_ReSend((PduIdType)Channel);
     break;
+  case CANTP_SEND_CF_DELAY:
+    if (context->STminTicks > 0) {
+      context->STminTicks--;
+      if (0 == context->STminTicks) {
+        CanTp_SendCF((PduIdType)Channel);
+      }
+    }
+    break;
+#ifdef CANTP_USE_HIGH_RATE
+  case CANTP_SEND_CF_START: /* FC allow CF, not to wait for the slow main function */
+    CanTp_SendCF((PduIdType)Channel);
+    break;
+#endif
 #ifndef CANTP_USE_TX_CONFIRMATION
   case CANTP_WAIT_CF_TX_COMPLETED:
+#ifdef CANTP_USE_HIGH_RATE
+    /* without the confirmation a CF accepted by the CanIf is taken as sent, so they are sent back
+     * to back until the BS, the STmin or the CanIf queue being full stops it */
+    for (i = 0; (i < CANTP_CF_BURST_MAX) && (CANTP_WAIT_CF_TX_COMPLETED == context->state); i++) {
+      CanTp_HandleCFTxCompleted(Channel);
+    }
+#else
     CanTp_HandleCFTxCompleted(Channel);
+#endif
     break;
 #endif
   default:
@@ -1040,6 +1124,26 @@ void CanTp_MainFunction_ChannelFast(uint8_t Channel) {
 #endif
 }
 
+#ifdef CANTP_USE_HIGH_RATE
+FUNC(Std_ReturnType, __weak) CanTp_PortStartTimer(PduIdType TxPduId, uint32_t us) {
+  (void)TxPduId;
+  (void)us;
+  return E_NOT_OK;
+}
+
+void CanTp_STminExpired(PduIdType TxPduId) {
+  CanTp_ChannelContextType *context;
+
+  DET_VALIDATE(TxPduId < CANTP_CONFIG->numOfChannels, 0xF1, CANTP_E_INVALID_TX_ID, return);
+
+  context = &(CANTP_CONFIG->channelContexts[TxPduId]);
+  if (CANTP_SEND_CF_DELAY == context->state) {
+    CanTpCancelAlarm();
+    CanTp_SendCF(TxPduId);
+  }
+}
+#endif
+
 /* Note: The period of this function is generally 10 ms */
 void CanTp_MainFunction(void) {
 #if 1 != CANTP_MAIN_FUNCTION_PERIOD
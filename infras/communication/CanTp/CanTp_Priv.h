@@ -120,6 +120,7 @@ typedef struct {
   uint8_t SN;
   uint8_t STmin;
   uint8_t WftCounter;
+  uint8_t STminTicks; /* the fast main cycles left before the next CF, for a STmin below 1 ms */
   uint8_t state;
 } CanTp_ChannelContextType;
 
@@ -31,6 +31,11 @@
 #define DOIP_E_NOT_OK ((Std_ReturnType)200)
 
 #define DOIP_E_NOT_OK_SILENT ((Std_ReturnType)201)
+
+/* the max chunks sent for the responses of all testers per main cycle */
+#ifndef DOIP_TX_STEPS_PER_CYCLE
+#define DOIP_TX_STEPS_PER_CYCLE 32
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 typedef struct {
   const uint8_t *req;
@@ -43,9 +48,11 @@ typedef struct {
 
 typedef struct {
   DoIP_ActivationLineType ActivationLineState;
+  uint8_t txNext; /* the tester connection served first by the next main cycle */
 } DoIP_ContextType;
 /* ================================ [ DECLARES  ] ============================================== */
 extern const DoIP_ConfigType DoIP_Config;
+static void doipResetTesterConnection(const DoIP_TesterConnectionType *connection);
 /* ================================ [ DATAS     ] ============================================== */
 static DoIP_ContextType DoIP_Context;
 /* ================================ [ LOCALS    ] ============================================== */
@@ -319,7 +326,7 @@ static Std_ReturnType doipSocketHandler(const DoIP_TesterConnectionType *tstcon,
         /* this connection is closed by Tester, close it */
         ASLOG(DOIP, ("Tester SoCon %d not alive, close it\n", i));
         SoAd_CloseSoCon(connection->SoConId, TRUE);
-        memset(connection->context, 0, sizeof(DoIP_TesterConnectionContextType));
+        doipResetTesterConnection(connection);
         ret = E_OK;
       }
     }
@@ -625,6 +632,98 @@ static void doipForgetDiagMsg(const DoIP_TesterConnectionType *connection) {
   }
 }
 
+static void doipDiagMsgTxDone(const DoIP_TesterConnectionType *connection, Std_ReturnType result) {
+  DoIP_MessageContextType *msg = &connection->context->msg;
+
+  if (NULL != msg->txBuf) {
+    Net_MemFree(msg->txBuf);
+    msg->txBuf = NULL;
+  }
+  msg->state = DOIP_MSG_IDLE;
+  PduR_DoIPTxConfirmation(msg->TargetAddressRef->TxPduId, result);
+  ASLOG(DOIP, ("[%d] send UDS response %s\n", msg->TargetAddressRef->TxPduId,
+               (E_OK == result) ? "done" : "failed"));
+}
+
+/* send what is pending of the response and copy the next chunk from PduR once the last one was
+ * taken by the socket. The header goes out together with the first chunk by one gathered send.
+ * Returns TRUE if the socket took all and the next step may be done right now. */
+static boolean doipDiagMsgTxStep(const DoIP_TesterConnectionType *connection) {
+  DoIP_MessageContextType *msg = &connection->context->msg;
+  Std_ReturnType ret = E_OK;
+  BufReq_ReturnType bret;
+  TcpIp_IoVecType vecs[2] = {{NULL, 0}, {NULL, 0}};
+  PduInfoType PduInfo;
+  PduLengthType left;
+  PduLengthType sent;
+  PduLengthType hdrLeft;
+  uint32_t num = 0;
+  boolean more = FALSE;
+
+  if ((msg->txPos >= msg->txLen) && (msg->index < msg->TpSduLength)) {
+    PduInfo.SduDataPtr = msg->txBuf;
+    PduInfo.MetaDataPtr = NULL;
+    PduInfo.SduLength = msg->TpSduLength - msg->index;
+    if (PduInfo.SduLength > msg->txBufSize) {
+      PduInfo.SduLength = msg->txBufSize;
+    }
+    bret = PduR_DoIPCopyTxData(msg->TargetAddressRef->TxPduId, &PduInfo, NULL, &left);
+    if (BUFREQ_OK == bret) {
+      msg->txPos = 0;
+      msg->txLen = PduInfo.SduLength;
+      msg->index += PduInfo.SduLength;
+    } else if (BUFREQ_E_BUSY == bret) {
+      ret = E_NOT_OK; /* no data yet, try again the next cycle */
+    } else {
+      doipDiagMsgTxDone(connection, E_NOT_OK);
+      ret = E_NOT_OK;
+    }
+  }
+
+  if (E_OK == ret) {
+    hdrLeft = sizeof(msg->txHeader) - msg->txHeaderPos;
+    if (hdrLeft > 0) {
+      vecs[num].BufPtr = &msg->txHeader[msg->txHeaderPos];
+      vecs[num].Length = hdrLeft;
+      num++;
+    }
+    if (msg->txPos < msg->txLen) {
+      vecs[num].BufPtr = &msg->txBuf[msg->txPos];
+      vecs[num].Length = msg->txLen - msg->txPos;
+      num++;
+    }
+    ret = SoAd_TpTransmitV(connection->SoAdTxPdu, vecs, num, &sent);
+    if (E_NOT_OK == ret) {
+      doipDiagMsgTxDone(connection, E_NOT_OK);
+    } else {
+      if (sent >= hdrLeft) {
+        msg->txHeaderPos = sizeof(msg->txHeader);
+        msg->txPos += sent - hdrLeft;
+      } else {
+        msg->txHeaderPos += sent;
+      }
+      if ((msg->txHeaderPos == sizeof(msg->txHeader)) && (msg->txPos >= msg->txLen) &&
+          (msg->index >= msg->TpSduLength)) {
+        doipDiagMsgTxDone(connection, E_OK);
+      } else if (E_OK == ret) {
+        more = TRUE;
+      } else {
+        /* the socket is full, go on the next cycle */
+      }
+    }
+  }
+
+  return more;
+}
+
+static void doipResetTesterConnection(const DoIP_TesterConnectionType *connection) {
+  if (DOIP_MSG_TX == connection->context->msg.state) {
+    doipDiagMsgTxDone(connection, E_NOT_OK);
+  }
+  doipForgetDiagMsg(connection);
+  memset(connection->context, 0, sizeof(DoIP_TesterConnectionContextType));
+}
+
 static void doipReplyDiagMsg(const DoIP_TesterConnectionType *connection, DoIP_MsgType *msg,
                              uint8_t resCode) {
   PduLengthType resLen = 5;
@@ -877,8 +976,7 @@ static void doipHandleInactivityTimer(void) {
         if (0 == connection->context->InactivityTimer) {
           ASLOG(DOIP, ("Tester SoCon %d InactivityTimer timeout\n", i));
           SoAd_CloseSoCon(connection->SoConId, TRUE);
-          doipForgetDiagMsg(connection);
-          memset(connection->context, 0, sizeof(DoIP_TesterConnectionContextType));
+          doipResetTesterConnection(connection);
         }
       }
     }
@@ -898,7 +996,7 @@ static void doipHandleAliveCheckResponseTimer(void) {
         if (0 == connection->context->AliveCheckResponseTimer) {
           ASLOG(DOIP, ("Tester SoCon %d AliveCheckResponseTimer timeout\n", i));
           SoAd_CloseSoCon(connection->SoConId, TRUE);
-          memset(connection->context, 0, sizeof(DoIP_TesterConnectionContextType));
+          doipResetTesterConnection(connection);
         }
       }
     }
@@ -933,66 +1031,34 @@ static void doipHandleVehicleAnnouncement(void) {
   }
 }
 
+/* serve the responses of all the testers chunk by chunk in turns, until all sockets are full or
+ * the budget of this cycle is used up, the first one served is rotated each cycle */
 static void doipHandleDiagMsgResponse(void) {
-  Std_ReturnType ret = E_NOT_OK;
-  BufReq_ReturnType bret;
-  PduInfoType PduInfo;
-  PduLengthType left;
-  PduIdType TxPduId;
-  const DoIP_TargetAddressType *TargetAddressRef;
   const DoIP_ConfigType *config = DOIP_CONFIG;
-  const DoIP_TesterConnectionType *connection = NULL;
+  DoIP_ContextType *context = &DoIP_Context;
+  const DoIP_TesterConnectionType *connection;
+  boolean more = TRUE;
+  uint32_t steps = 0;
   int i;
-  uint8_t *res;
-  uint32_t resLen;
-
-  for (i = 0; i < (NULL == connection) && (config->MaxTesterConnections); i++) {
-    connection = &config->testerConnections[i];
-    if (DOIP_CON_CLOSED != connection->context->state) {
-      TargetAddressRef = connection->context->msg.TargetAddressRef;
-      if (NULL != TargetAddressRef) {
-        if (DOIP_MSG_TX == connection->context->msg.state) {
-          TxPduId = TargetAddressRef->TxPduId;
-          connection = &config->testerConnections[i];
-          resLen = connection->context->msg.TpSduLength - connection->context->msg.index;
-          res = Net_MemGet(&resLen);
-          if (NULL != res) {
-            ret = E_OK;
-          }
+  int n;
+
+  while (more && (steps < DOIP_TX_STEPS_PER_CYCLE)) {
+    more = FALSE;
+    for (n = 0; (n < config->MaxTesterConnections) && (steps < DOIP_TX_STEPS_PER_CYCLE); n++) {
+      i = (context->txNext + n) % config->MaxTesterConnections;
+      connection = &config->testerConnections[i];
+      if ((DOIP_CON_CLOSED != connection->context->state) &&
+          (DOIP_MSG_TX == connection->context->msg.state)) {
+        if (doipDiagMsgTxStep(connection)) {
+          more = TRUE;
         }
+        steps++;
       }
     }
   }
 
-  if (E_OK == ret) {
-    PduInfo.SduDataPtr = res;
-    PduInfo.SduLength = resLen;
-    if (PduInfo.SduLength >
-        (connection->context->msg.TpSduLength - connection->context->msg.index)) {
-      PduInfo.SduLength = connection->context->msg.TpSduLength - connection->context->msg.index;
-    }
-    bret = PduR_DoIPCopyTxData(TxPduId, &PduInfo, NULL, &left);
-    if (BUFREQ_OK == bret) {
-      ret = doipTpSendResponse(connection->SoAdTxPdu, PduInfo.SduDataPtr, PduInfo.SduLength);
-      if (E_OK != ret) {
-        connection->context->msg.state = DOIP_MSG_IDLE;
-        PduR_DoIPTxConfirmation(TxPduId, E_NOT_OK);
-      }
-    } else {
-      ret = E_NOT_OK;
-    }
-
-    if (E_OK == ret) {
-      if (PduInfo.SduLength >= connection->context->msg.TpSduLength) {
-        connection->context->msg.state = DOIP_MSG_IDLE;
-        PduR_DoIPTxConfirmation(TxPduId, E_OK);
-        ASLOG(DOIP, ("[%d] send UDS response done\n", TxPduId));
-      } else {
-        ASLOG(DOIP, ("[%d] send UDS response on going\n", TxPduId));
-      }
-    }
-
-    Net_MemFree(res);
+  if (config->MaxTesterConnections > 0) {
+    context->txNext = (context->txNext + 1) % config->MaxTesterConnections;
   }
 }
 /* ================================ [ FUNCTIONS ] ============================================== */
@@ -1107,7 +1173,7 @@ void DoIP_SoConModeChg(SoAd_SoConIdType SoConId, SoAd_SoConModeType Mode) {
     if (SoConId == config->testerConnections[i].SoConId) {
       if (SOAD_SOCON_ONLINE == Mode) {
         asAssert(DOIP_ACTIVATION_LINE_ACTIVE == context->ActivationLineState);
-        memset(config->testerConnections[i].context, 0, sizeof(DoIP_TesterConnectionContextType));
+        doipResetTesterConnection(&config->testerConnections[i]);
         config->testerConnections[i].context->InactivityTimer = config->InitialInactivityTime;
         config->testerConnections[i].context->state = DOIP_CON_OPEN;
       }
@@ -1273,13 +1339,12 @@ void DoIP_MainFunction(void) {
 
 Std_ReturnType DoIP_TpTransmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr) {
   Std_ReturnType ret = E_NOT_OK;
-  BufReq_ReturnType bret;
   int i;
   const DoIP_ConfigType *config = DOIP_CONFIG;
   DoIP_ContextType *context = &DoIP_Context;
   const DoIP_TesterConnectionType *connection = NULL;
-  PduInfoType PduInfo;
-  PduLengthType left;
+  DoIP_MessageContextType *msg;
+  uint32_t steps;
   uint16_t sa, ta;
   uint8_t *res;
   uint32_t resLen;
@@ -1309,50 +1374,36 @@ Std_ReturnType DoIP_TpTransmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr)
 
   if (E_OK == ret) {
     ASLOG(DOIP, ("[%d] UDS response, len = %d\n", TxPduId, PduInfoPtr->SduLength));
-    resLen = DOIP_HEADER_LENGTH + 4 + PduInfoPtr->SduLength;
+    resLen = PduInfoPtr->SduLength;
+    if (0u == resLen) {
+      resLen = 1;
+    }
     res = Net_MemGet(&resLen);
     if (NULL == res) {
       ret = E_NOT_OK;
     }
   }
+
   if (E_OK == ret) {
-    doipFillHeader(res, DOIP_DIAGNOSTIC_MESSAGE, PduInfoPtr->SduLength + 4);
-    sa = connection->context->msg.TargetAddressRef->TargetAddress;
+    msg = &connection->context->msg;
+    doipFillHeader(msg->txHeader, DOIP_DIAGNOSTIC_MESSAGE, PduInfoPtr->SduLength + 4);
+    sa = msg->TargetAddressRef->TargetAddress;
     ta = connection->context->TesterRef->TesterSA;
-    res[DOIP_HEADER_LENGTH + 0] = (sa >> 8) & 0xFF;
-    res[DOIP_HEADER_LENGTH + 1] = sa & 0xFF;
-    res[DOIP_HEADER_LENGTH + 2] = (ta >> 8) & 0xFF;
-    res[DOIP_HEADER_LENGTH + 3] = ta & 0xFF;
-    PduInfo.SduDataPtr = &res[DOIP_HEADER_LENGTH + 4];
-    PduInfo.SduLength = PduInfoPtr->SduLength;
-    if (PduInfo.SduLength > (resLen - DOIP_HEADER_LENGTH - 4)) {
-      PduInfo.SduLength = resLen - DOIP_HEADER_LENGTH - 4;
-    }
-    bret = PduR_DoIPCopyTxData(TxPduId, &PduInfo, NULL, &left);
-    if (BUFREQ_OK == bret) {
-      resLen = DOIP_HEADER_LENGTH + PduInfo.SduLength + 4;
-      ret = doipTpSendResponse(connection->SoAdTxPdu, res, resLen);
-      if (E_OK != ret) {
-        PduR_DoIPTxConfirmation(TxPduId, E_NOT_OK);
-      }
-    } else {
-      ret = E_NOT_OK;
-    }
-
-    if (E_OK == ret) {
-      if (PduInfo.SduLength >= PduInfoPtr->SduLength) {
-        PduR_DoIPTxConfirmation(TxPduId, E_OK);
-        ASLOG(DOIP, ("[%d] send UDS response done\n", TxPduId));
-      } else {
-        connection->context->msg.state = DOIP_MSG_TX;
-        connection->context->msg.TpSduLength = PduInfoPtr->SduLength;
-        connection->context->msg.index = PduInfo.SduLength;
-        ASLOG(DOIP, ("[%d] send UDS response on going\n", TxPduId));
-      }
+    msg->txHeader[DOIP_HEADER_LENGTH + 0] = (sa >> 8) & 0xFF;
+    msg->txHeader[DOIP_HEADER_LENGTH + 1] = sa & 0xFF;
+    msg->txHeader[DOIP_HEADER_LENGTH + 2] = (ta >> 8) & 0xFF;
+    msg->txHeader[DOIP_HEADER_LENGTH + 3] = ta & 0xFF;
+    msg->txHeaderPos = 0;
+    msg->txBuf = res;
+    msg->txBufSize = resLen;
+    msg->txPos = 0;
+    msg->txLen = 0;
+    msg->TpSduLength = PduInfoPtr->SduLength;
+    msg->index = 0;
+    msg->state = DOIP_MSG_TX;
+    /* send as much as the socket takes now, the rest by the main function */
+    for (steps = 0; (steps < DOIP_TX_STEPS_PER_CYCLE) && doipDiagMsgTxStep(connection); steps++) {
     }
-
-    Net_MemFree(res);
   }
-
   return ret;
 }
\ No newline at end of file
@@ -93,6 +93,13 @@ typedef struct {
   PduLengthType index;
   const DoIP_TargetAddressType *TargetAddressRef;
   uint8_t *req; /* len = NumByteDiagAckNack */
+  /* the response on going, held until the socket takes all of it */
+  uint8_t *txBuf; /* the chunk of the payload, from Net_MemGet for the whole response */
+  uint32_t txBufSize;
+  PduLengthType txPos; /* bytes of the chunk already sent */
+  PduLengthType txLen; /* bytes of the chunk */
+  uint8_t txHeader[12]; /* the generic header and the SA/TA */
+  uint8_t txHeaderPos;
 } DoIP_MessageContextType;
 
 typedef struct DoIP_Tester_s DoIP_TesterType;
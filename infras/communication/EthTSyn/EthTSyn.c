@@ -0,0 +1,782 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ * ref: https://www.autosar.org/fileadmin/standards/R20-11/CP/AUTOSAR_SWS_TimeSyncOverEthernet.pdf
+ * ref: IEEE 802.1AS-2020, the messages of the clause 11, over the UDP of the IEEE 1588 Annex D
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "EthTSyn_Priv.h"
+#include "EthTSyn.h"
+#include <string.h>
+#include "Std_Debug.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define AS_LOG_ETHTSYN 0
+#define AS_LOG_ETHTSYNI 0
+#define AS_LOG_ETHTSYNE 2
+
+#define ETHTSYN_CONFIG (ethTSynConfigPtr)
+
+#define ETHTSYN_NANOSECONDS_PER_SECOND 1000000000ll
+
+/* the datagrams read of each socket by one main function */
+#ifndef ETHTSYN_RX_MAX
+#define ETHTSYN_RX_MAX 8
+#endif
+
+/* the measured path delay moves 1/n of the way to each measurement */
+#ifndef ETHTSYN_PDELAY_FILTER
+#define ETHTSYN_PDELAY_FILTER 4
+#endif
+
+#define ETHTSYN_MSG_LENGTH_MAX 128
+
+#define ETHTSYN_HEADER_LENGTH 34
+#define ETHTSYN_SYNC_LENGTH 44
+/* with the Follow_Up information TLV of the IEEE 802.1AS 11.4.4.3 */
+#define ETHTSYN_FOLLOW_UP_LENGTH 76
+#define ETHTSYN_PDELAY_LENGTH 54
+
+#define ETHTSYN_TRANSPORT_SPECIFIC 0x10
+#define ETHTSYN_VERSION_PTP 0x02
+#define ETHTSYN_FLAG_TWO_STEP 0x02     /* of the byte 6 */
+#define ETHTSYN_FLAG_PTP_TIMESCALE 0x08 /* of the byte 7 */
+
+#define ETHTSYN_CONTROL_SYNC 0x00
+#define ETHTSYN_CONTROL_FOLLOW_UP 0x02
+#define ETHTSYN_CONTROL_OTHER 0x05
+
+/* the Pdelay messages are not periodic in the 802.1AS sense of the logMessageInterval */
+#define ETHTSYN_LOG_INTERVAL_NONE 0x7F
+
+#define ETHTSYN_PORT_NUMBER 1
+
+#define ETHTSYN_OFFSET_DOMAIN 4
+#define ETHTSYN_OFFSET_CORRECTION 8
+#define ETHTSYN_OFFSET_SOURCE_PORT 20
+#define ETHTSYN_OFFSET_SEQUENCE_ID 30
+#define ETHTSYN_OFFSET_BODY 34
+#define ETHTSYN_OFFSET_REQUESTING_PORT 44
+
+#define ETHTSYN_IS_MULTICAST(addr) (0xE0000000ul == ((addr)&0xF0000000ul))
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+extern const EthTSyn_ConfigType EthTSyn_Config;
+/* ================================ [ DATAS     ] ============================================== */
+static const EthTSyn_ConfigType *ethTSynConfigPtr = NULL;
+static EthTSyn_TransmissionModeType ethTSynTxMode = ETHTSYN_TX_ON;
+/* ================================ [ LOCALS    ] ============================================== */
+/*               TM                            TS
+ *               |                             |
+ *       t0r --> | \   Sync                    |
+ *               |  \---------------------\    |
+ *       t1r --> |                        \--> | <-- t2r
+ *               |                             |
+ *       FUP --> | \  FUP(s(t0)+t1r-t0r)       |
+ *               |  \---------------------\    |
+ *               |                        \--> |
+ *               |                             |
+ * The t1r and t2r are the egress and the ingress time stamps the TcpIp takes of the datagrams, the
+ * Follow_Up carries the global time at the t1r as the preciseOriginTimestamp, so
+ *   global time at t2r = preciseOriginTimestamp + correctionField + pdelay
+ * The pdelay is measured by the peer delay mechanism of the IEEE 802.1AS 11.1.2, the initiator
+ * sends the Pdelay_Req at t1, the responder receives it at t2 and sends the Pdelay_Resp with the t2
+ * at t3, which is in the Pdelay_Resp_Follow_Up, the initiator receives the Pdelay_Resp at t4
+ *   pdelay = ((t4 - t1) - (t3 - t2)) / 2
+ * the t2 and t3 are of the clock of the responder, only their difference counts.
+ */
+static uint64_t EthTSyn_LocalTimeToNs(const StbM_VirtualLocalTimeType *localTime) {
+  return ((uint64_t)localTime->nanosecondsHi << 32) + localTime->nanosecondsLo;
+}
+
+static void EthTSyn_NsToLocalTime(uint64_t ns, StbM_VirtualLocalTimeType *localTime) {
+  localTime->nanosecondsHi = (uint32_t)(ns >> 32);
+  localTime->nanosecondsLo = (uint32_t)(ns & 0xFFFFFFFFul);
+}
+
+static uint64_t EthTSyn_GetNow(const EthTSyn_GlobalTimeDomainType *domain) {
+  StbM_VirtualLocalTimeType localTime = {0, 0};
+
+  (void)StbM_GetCurrentVirtualLocalTime(domain->SynchronizedTimeBaseRef, &localTime);
+
+  return EthTSyn_LocalTimeToNs(&localTime);
+}
+
+/* the timestamp of the IEEE 1588, 48 bits seconds and 32 bits nanoseconds */
+static void EthTSyn_PutTimeStamp(uint8_t *data, uint32_t secondsHi, uint32_t seconds,
+                                 uint32_t nanoseconds) {
+  data[0] = (secondsHi >> 8) & 0xFF;
+  data[1] = secondsHi & 0xFF;
+  data[2] = (seconds >> 24) & 0xFF;
+  data[3] = (seconds >> 16) & 0xFF;
+  data[4] = (seconds >> 8) & 0xFF;
+  data[5] = seconds & 0xFF;
+  data[6] = (nanoseconds >> 24) & 0xFF;
+  data[7] = (nanoseconds >> 16) & 0xFF;
+  data[8] = (nanoseconds >> 8) & 0xFF;
+  data[9] = nanoseconds & 0xFF;
+}
+
+static void EthTSyn_GetTimeStamp(const uint8_t *data, StbM_TimeStampType *timeStamp) {
+  timeStamp->secondsHi = ((uint32_t)data[0] << 8) + data[1];
+  timeStamp->seconds = ((uint32_t)data[2] << 24) + ((uint32_t)data[3] << 16) +
+                       ((uint32_t)data[4] << 8) + data[5];
+  timeStamp->nanoseconds = ((uint32_t)data[6] << 24) + ((uint32_t)data[7] << 16) +
+                           ((uint32_t)data[8] << 8) + data[9];
+}
+
+static void EthTSyn_PutNs(uint8_t *data, uint64_t ns) {
+  uint64_t seconds = ns / ETHTSYN_NANOSECONDS_PER_SECOND;
+
+  EthTSyn_PutTimeStamp(data, (uint32_t)(seconds >> 32), (uint32_t)seconds,
+                       (uint32_t)(ns % ETHTSYN_NANOSECONDS_PER_SECOND));
+}
+
+static uint64_t EthTSyn_GetNs(const uint8_t *data) {
+  StbM_TimeStampType timeStamp;
+
+  EthTSyn_GetTimeStamp(data, &timeStamp);
+
+  return (((uint64_t)timeStamp.secondsHi << 32) + timeStamp.seconds) *
+           ETHTSYN_NANOSECONDS_PER_SECOND +
+         timeStamp.nanoseconds;
+}
+
+/* a global time plus ns, which may be negative by the correctionField */
+static void EthTSyn_AddNs(StbM_TimeStampType *timeStamp, int64_t ns) {
+  int64_t nanoseconds = (int64_t)timeStamp->nanoseconds + ns;
+  int64_t seconds = nanoseconds / ETHTSYN_NANOSECONDS_PER_SECOND;
+  uint64_t total = ((uint64_t)timeStamp->secondsHi << 32) + timeStamp->seconds;
+
+  nanoseconds -= seconds * ETHTSYN_NANOSECONDS_PER_SECOND;
+  if (nanoseconds < 0) {
+    nanoseconds += ETHTSYN_NANOSECONDS_PER_SECOND;
+    seconds -= 1;
+  }
+  total += (uint64_t)seconds;
+  timeStamp->secondsHi = (uint32_t)(total >> 32);
+  timeStamp->seconds = (uint32_t)total;
+  timeStamp->nanoseconds = (uint32_t)nanoseconds;
+}
+
+static void EthTSyn_PutHeader(const EthTSyn_GlobalTimeDomainType *domain, uint8_t *data,
+                              uint8_t msgType, uint16_t length, uint16_t sequenceId,
+                              uint8_t control, int8_t logMessageInterval) {
+  EthTSyn_PortContextType *port = domain->port;
+
+  memset(data, 0, length);
+  data[0] = ETHTSYN_TRANSPORT_SPECIFIC | msgType;
+  data[1] = ETHTSYN_VERSION_PTP;
+  data[2] = (length >> 8) & 0xFF;
+  data[3] = length & 0xFF;
+  data[ETHTSYN_OFFSET_DOMAIN] = domain->GlobalTimeDomainId;
+  if ((ETHTSYN_MSG_SYNC == msgType) || (ETHTSYN_MSG_PDELAY_RESP == msgType)) {
+    data[6] = ETHTSYN_FLAG_TWO_STEP;
+  }
+  data[7] = ETHTSYN_FLAG_PTP_TIMESCALE;
+  memcpy(&data[ETHTSYN_OFFSET_SOURCE_PORT], port->clockIdentity, ETHTSYN_CLOCK_IDENTITY_LENGTH);
+  data[ETHTSYN_OFFSET_SOURCE_PORT + 8] = (ETHTSYN_PORT_NUMBER >> 8) & 0xFF;
+  data[ETHTSYN_OFFSET_SOURCE_PORT + 9] = ETHTSYN_PORT_NUMBER & 0xFF;
+  data[ETHTSYN_OFFSET_SEQUENCE_ID] = (sequenceId >> 8) & 0xFF;
+  data[ETHTSYN_OFFSET_SEQUENCE_ID + 1] = sequenceId & 0xFF;
+  data[32] = control;
+  data[33] = (uint8_t)logMessageInterval;
+}
+
+static uint16_t EthTSyn_GetSequenceId(const uint8_t *data) {
+  return ((uint16_t)data[ETHTSYN_OFFSET_SEQUENCE_ID] << 8) + data[ETHTSYN_OFFSET_SEQUENCE_ID + 1];
+}
+
+/* the correctionField is ns * 2^16 */
+static int64_t EthTSyn_GetCorrection(const uint8_t *data) {
+  uint64_t correction = 0;
+  int i;
+
+  for (i = 0; i < 8; i++) {
+    correction = (correction << 8) + data[ETHTSYN_OFFSET_CORRECTION + i];
+  }
+
+  return (int64_t)correction / 65536;
+}
+
+/* the requestingPortIdentity of the Pdelay_Resp and Pdelay_Resp_Follow_Up is this port */
+static boolean EthTSyn_IsRequestingPort(const EthTSyn_PortContextType *port, const uint8_t *data) {
+  boolean r = FALSE;
+
+  if ((0 == memcmp(&data[ETHTSYN_OFFSET_REQUESTING_PORT], port->clockIdentity,
+                   ETHTSYN_CLOCK_IDENTITY_LENGTH)) &&
+      (0 == data[ETHTSYN_OFFSET_REQUESTING_PORT + 8]) &&
+      (ETHTSYN_PORT_NUMBER == data[ETHTSYN_OFFSET_REQUESTING_PORT + 9])) {
+    r = TRUE;
+  }
+
+  return r;
+}
+
+static void EthTSyn_Egress(const EthTSyn_GlobalTimeDomainType *domain, uint8_t egress,
+                           uint64_t timeStamp);
+
+static Std_ReturnType EthTSyn_Send(const EthTSyn_GlobalTimeDomainType *domain, boolean event,
+                                   const uint8_t *data, uint16_t length) {
+  Std_ReturnType ret;
+  TcpIp_SockAddrType RemoteAddr;
+  TcpIp_SocketIdType sock;
+
+  if (event) {
+    sock = domain->port->eventSock;
+    TcpIp_SetupAddrFrom(&RemoteAddr, domain->Socket->RemoteAddr, domain->Socket->RemoteEventPort);
+  } else {
+    sock = domain->port->generalSock;
+    TcpIp_SetupAddrFrom(&RemoteAddr, domain->Socket->RemoteAddr,
+                        domain->Socket->RemoteGeneralPort);
+  }
+
+  ret = TcpIp_SendTo(sock, &RemoteAddr, data, length);
+  if (E_OK != ret) {
+    ASLOG(ETHTSYNE, ("[%d] send message 0x%x failed\n", domain->GlobalTimeDomainId, data[0]));
+  }
+
+  return ret;
+}
+
+/* the event messages are sent by the event socket, their egress time stamp comes later by the
+ * error queue of the socket, or is the time now if the TcpIp has none */
+static Std_ReturnType EthTSyn_SendEvent(const EthTSyn_GlobalTimeDomainType *domain,
+                                        const uint8_t *data, uint16_t length, uint8_t egress) {
+  Std_ReturnType ret;
+  EthTSyn_PortContextType *port = domain->port;
+  uint64_t now = EthTSyn_GetNow(domain);
+
+  ret = EthTSyn_Send(domain, TRUE, data, length);
+  if (E_OK == ret) {
+    if (port->timeStampEnabled) {
+      port->egressId[egress] = port->txCount;
+      port->egressPending |= (1u << egress);
+      port->txCount++;
+    } else {
+      EthTSyn_Egress(domain, egress, now);
+    }
+  }
+
+  return ret;
+}
+
+static void EthTSyn_CalcPdelay(const EthTSyn_GlobalTimeDomainType *domain) {
+  EthTSyn_PortContextType *port = domain->port;
+  int64_t pdelay;
+
+  if (port->t1Received && port->t3Received && port->t4Received) {
+    pdelay = ((int64_t)(port->t4 - port->t1) - (int64_t)(port->t3 - port->t2)) / 2;
+    if ((pdelay >= 0) && (pdelay <= (int64_t)domain->Pdelay->PdelayLatencyThreshold)) {
+      if (port->pdelayMeasured) {
+        pdelay = (int64_t)port->pdelay + (pdelay - (int64_t)port->pdelay) / ETHTSYN_PDELAY_FILTER;
+        port->pdelay = (uint32_t)pdelay;
+      } else {
+        port->pdelay = (uint32_t)pdelay;
+        port->pdelayMeasured = TRUE;
+      }
+      ASLOG(ETHTSYNI, ("[%d] pdelay %u ns\n", domain->GlobalTimeDomainId, port->pdelay));
+    } else {
+      ASLOG(ETHTSYNE,
+            ("[%d] pdelay %d ns out of range\n", domain->GlobalTimeDomainId, (int)pdelay));
+    }
+    port->pdelayState = ETHTSYN_PDELAY_IDLE;
+    port->respTimer = 0;
+  }
+}
+
+static void EthTSyn_TransmitFollowUp(const EthTSyn_GlobalTimeDomainType *domain, uint64_t t1r) {
+  EthTSyn_MasterContextType *context = domain->U.M.context;
+  uint8_t data[ETHTSYN_FOLLOW_UP_LENGTH];
+  StbM_TimeStampType preciseOriginTimestamp = context->t0;
+
+  EthTSyn_PutHeader(domain, data, ETHTSYN_MSG_FOLLOW_UP, ETHTSYN_FOLLOW_UP_LENGTH,
+                    context->sequenceId, ETHTSYN_CONTROL_FOLLOW_UP,
+                    domain->U.M.Master->LogMessageInterval);
+  /* the global time at the egress of the Sync, so the correctionField is 0 */
+  EthTSyn_AddNs(&preciseOriginTimestamp, (int64_t)(t1r - EthTSyn_LocalTimeToNs(&context->t0r)));
+  EthTSyn_PutTimeStamp(&data[ETHTSYN_OFFSET_BODY], preciseOriginTimestamp.secondsHi,
+                       preciseOriginTimestamp.seconds, preciseOriginTimestamp.nanoseconds);
+  /* the Follow_Up information TLV, the grandmaster is the time master, so its rate is 1 */
+  data[44] = 0x00;
+  data[45] = 0x03; /* tlvType ORGANIZATION_EXTENSION */
+  data[46] = 0x00;
+  data[47] = 28; /* lengthField */
+  data[48] = 0x00;
+  data[49] = 0x80;
+  data[50] = 0xC2; /* organizationId */
+  data[53] = 0x01; /* organizationSubType */
+
+  (void)EthTSyn_Send(domain, FALSE, data, ETHTSYN_FOLLOW_UP_LENGTH);
+  context->sequenceId++;
+  context->state = ETHTSYN_MASTER_IDLE;
+}
+
+static void EthTSyn_TransmitPdelayRespFollowUp(const EthTSyn_GlobalTimeDomainType *domain,
+                                               uint64_t t3) {
+  EthTSyn_PortContextType *port = domain->port;
+  uint8_t data[ETHTSYN_PDELAY_LENGTH];
+
+  EthTSyn_PutHeader(domain, data, ETHTSYN_MSG_PDELAY_RESP_FOLLOW_UP, ETHTSYN_PDELAY_LENGTH,
+                    port->respSequenceId, ETHTSYN_CONTROL_OTHER, ETHTSYN_LOG_INTERVAL_NONE);
+  EthTSyn_PutNs(&data[ETHTSYN_OFFSET_BODY], t3);
+  memcpy(&data[ETHTSYN_OFFSET_REQUESTING_PORT], port->respPortIdentity,
+         ETHTSYN_PORT_IDENTITY_LENGTH);
+  (void)EthTSyn_Send(domain, FALSE, data, ETHTSYN_PDELAY_LENGTH);
+}
+
+static void EthTSyn_Egress(const EthTSyn_GlobalTimeDomainType *domain, uint8_t egress,
+                           uint64_t timeStamp) {
+  EthTSyn_PortContextType *port = domain->port;
+
+  switch (egress) {
+  case ETHTSYN_EGRESS_SYNC:
+    if ((ETHTSYN_MASTER == domain->DomainType) &&
+        (ETHTSYN_MASTER_SYNCED == domain->U.M.context->state)) {
+      EthTSyn_TransmitFollowUp(domain, timeStamp);
+    }
+    break;
+  case ETHTSYN_EGRESS_PDELAY_REQ:
+    if (ETHTSYN_PDELAY_REQ == port->pdelayState) {
+      port->t1 = timeStamp;
+      port->t1Received = TRUE;
+      EthTSyn_CalcPdelay(domain);
+    }
+    break;
+  case ETHTSYN_EGRESS_PDELAY_RESP:
+    EthTSyn_TransmitPdelayRespFollowUp(domain, timeStamp);
+    break;
+  default:
+    break;
+  }
+}
+
+static void EthTSyn_PollEgress(const EthTSyn_GlobalTimeDomainType *domain) {
+  EthTSyn_PortContextType *port = domain->port;
+  TcpIp_TimeStampType timeStamp;
+  uint32_t id;
+  uint8_t egress;
+
+  while ((0 != port->egressPending) &&
+         (E_OK == TcpIp_GetEgressTimeStamp(port->eventSock, &id, &timeStamp))) {
+    for (egress = 0; egress < ETHTSYN_EGRESS_NUM; egress++) {
+      if ((0 != (port->egressPending & (1u << egress))) && (id == port->egressId[egress])) {
+        port->egressPending &= ~(1u << egress);
+        EthTSyn_Egress(domain, egress,
+                       (uint64_t)timeStamp.seconds * ETHTSYN_NANOSECONDS_PER_SECOND +
+                         timeStamp.nanoseconds);
+      }
+    }
+  }
+}
+
+static void EthTSyn_TransmitSync(const EthTSyn_GlobalTimeDomainType *domain) {
+  Std_ReturnType ret;
+  EthTSyn_MasterContextType *context = domain->U.M.context;
+  uint8_t data[ETHTSYN_SYNC_LENGTH];
+
+  if (ETHTSYN_MASTER_IDLE != context->state) {
+    ASLOG(ETHTSYNE, ("[%d] Sync %d got no egress time stamp\n", domain->GlobalTimeDomainId,
+                     context->sequenceId));
+    context->sequenceId++;
+  }
+
+  ret = StbM_BusGetCurrentTime(domain->SynchronizedTimeBaseRef, &context->t0, &context->t0r, NULL);
+  if (E_OK == ret) {
+    EthTSyn_PutHeader(domain, data, ETHTSYN_MSG_SYNC, ETHTSYN_SYNC_LENGTH, context->sequenceId,
+                      ETHTSYN_CONTROL_SYNC, domain->U.M.Master->LogMessageInterval);
+    context->state = ETHTSYN_MASTER_SYNCED;
+    ret = EthTSyn_SendEvent(domain, data, ETHTSYN_SYNC_LENGTH, ETHTSYN_EGRESS_SYNC);
+  }
+
+  if (E_OK != ret) {
+    context->state = ETHTSYN_MASTER_IDLE;
+  }
+}
+
+static void EthTSyn_TransmitPdelayReq(const EthTSyn_GlobalTimeDomainType *domain) {
+  EthTSyn_PortContextType *port = domain->port;
+  uint8_t data[ETHTSYN_PDELAY_LENGTH];
+
+  if (ETHTSYN_PDELAY_IDLE != port->pdelayState) {
+    ASLOG(ETHTSYNE, ("[%d] Pdelay_Req %d not completed\n", domain->GlobalTimeDomainId,
+                     port->pdelaySequenceId));
+  }
+
+  port->pdelaySequenceId++;
+  port->t1Received = FALSE;
+  port->t3Received = FALSE;
+  port->t4Received = FALSE;
+  port->pdelayState = ETHTSYN_PDELAY_REQ;
+  port->respTimer = domain->Pdelay->PdelayRespAndRespFollowUpTimeout;
+  EthTSyn_PutHeader(domain, data, ETHTSYN_MSG_PDELAY_REQ, ETHTSYN_PDELAY_LENGTH,
+                    port->pdelaySequenceId, ETHTSYN_CONTROL_OTHER, ETHTSYN_LOG_INTERVAL_NONE);
+  if (E_OK != EthTSyn_SendEvent(domain, data, ETHTSYN_PDELAY_LENGTH, ETHTSYN_EGRESS_PDELAY_REQ)) {
+    port->pdelayState = ETHTSYN_PDELAY_IDLE;
+  }
+}
+
+static void EthTSyn_HandleSync(const EthTSyn_GlobalTimeDomainType *domain, const uint8_t *data,
+                               uint64_t t2r) {
+  EthTSyn_SlaveContextType *context = domain->U.S.context;
+
+  if (ETHTSYN_SLAVE_IDLE != context->state) {
+    ASLOG(ETHTSYNE, ("[%d] Sync when waiting the Follow_Up of %d\n", domain->GlobalTimeDomainId,
+                     context->sequenceId));
+  }
+
+  context->sequenceId = EthTSyn_GetSequenceId(data);
+  memcpy(context->sourcePortIdentity, &data[ETHTSYN_OFFSET_SOURCE_PORT],
+         ETHTSYN_PORT_IDENTITY_LENGTH);
+  EthTSyn_NsToLocalTime(t2r, &context->t2r);
+  context->timer = domain->U.S.Slave->GlobalTimeFollowUpTimeout;
+  context->state = ETHTSYN_SLAVE_SYNC;
+}
+
+static void EthTSyn_HandleFollowUp(const EthTSyn_GlobalTimeDomainType *domain,
+                                   const uint8_t *data) {
+  EthTSyn_SlaveContextType *context = domain->U.S.context;
+  StbM_TimeStampType timeStamp;
+  StbM_MeasurementType measureData;
+  Std_ReturnType ret = E_OK;
+
+  if (ETHTSYN_SLAVE_SYNC != context->state) {
+    ASLOG(ETHTSYNE, ("[%d] Follow_Up without Sync\n", domain->GlobalTimeDomainId));
+    ret = E_NOT_OK;
+  } else if ((EthTSyn_GetSequenceId(data) != context->sequenceId) ||
+             (0 != memcmp(context->sourcePortIdentity, &data[ETHTSYN_OFFSET_SOURCE_PORT],
+                          ETHTSYN_PORT_IDENTITY_LENGTH))) {
+    ASLOG(ETHTSYNE, ("[%d] Follow_Up %d not of the Sync %d\n", domain->GlobalTimeDomainId,
+                     EthTSyn_GetSequenceId(data), context->sequenceId));
+    ret = E_NOT_OK;
+  } else {
+    /* the global time at the t2r */
+    EthTSyn_GetTimeStamp(&data[ETHTSYN_OFFSET_BODY], &timeStamp);
+    timeStamp.timeBaseStatus = 0;
+    measureData.pathDelay = domain->port->pdelay;
+    EthTSyn_AddNs(&timeStamp, EthTSyn_GetCorrection(data) + (int64_t)measureData.pathDelay);
+    ret = StbM_BusSetGlobalTime(domain->SynchronizedTimeBaseRef, &timeStamp, NULL, &measureData,
+                                &context->t2r);
+    context->timer = 0;
+    context->state = ETHTSYN_SLAVE_IDLE;
+  }
+  (void)ret;
+}
+
+static void EthTSyn_HandlePdelayReq(const EthTSyn_GlobalTimeDomainType *domain,
+                                    const uint8_t *data, uint64_t t2) {
+  EthTSyn_PortContextType *port = domain->port;
+  uint8_t resp[ETHTSYN_PDELAY_LENGTH];
+
+  if (domain->Pdelay->GlobalTimePdelayRespEnable) {
+    port->respSequenceId = EthTSyn_GetSequenceId(data);
+    memcpy(port->respPortIdentity, &data[ETHTSYN_OFFSET_SOURCE_PORT], ETHTSYN_PORT_IDENTITY_LENGTH);
+    EthTSyn_PutHeader(domain, resp, ETHTSYN_MSG_PDELAY_RESP, ETHTSYN_PDELAY_LENGTH,
+                      port->respSequenceId, ETHTSYN_CONTROL_OTHER, ETHTSYN_LOG_INTERVAL_NONE);
+    EthTSyn_PutNs(&resp[ETHTSYN_OFFSET_BODY], t2);
+    memcpy(&resp[ETHTSYN_OFFSET_REQUESTING_PORT], port->respPortIdentity,
+           ETHTSYN_PORT_IDENTITY_LENGTH);
+    (void)EthTSyn_SendEvent(domain, resp, ETHTSYN_PDELAY_LENGTH, ETHTSYN_EGRESS_PDELAY_RESP);
+  }
+}
+
+static void EthTSyn_HandlePdelayResp(const EthTSyn_GlobalTimeDomainType *domain,
+                                     const uint8_t *data, uint8_t msgType, uint64_t rxTime) {
+  EthTSyn_PortContextType *port = domain->port;
+
+  if ((ETHTSYN_PDELAY_REQ == port->pdelayState) &&
+      (EthTSyn_GetSequenceId(data) == port->pdelaySequenceId) &&
+      EthTSyn_IsRequestingPort(port, data)) {
+    if (ETHTSYN_MSG_PDELAY_RESP == msgType) {
+      port->t2 = EthTSyn_GetNs(&data[ETHTSYN_OFFSET_BODY]);
+      port->t4 = rxTime;
+      port->t4Received = TRUE;
+    } else {
+      port->t3 = EthTSyn_GetNs(&data[ETHTSYN_OFFSET_BODY]);
+      port->t3Received = TRUE;
+    }
+    EthTSyn_CalcPdelay(domain);
+  }
+}
+
+static void EthTSyn_RxMessage(const EthTSyn_GlobalTimeDomainType *domain, const uint8_t *data,
+                              uint32_t length, uint64_t rxTime) {
+  Std_ReturnType ret = E_OK;
+  uint8_t msgType = data[0] & 0x0F;
+  uint16_t msgLength = 0;
+
+  if (length >= ETHTSYN_HEADER_LENGTH) {
+    msgLength = ((uint16_t)data[2] << 8) + data[3];
+  }
+
+  if ((length < ETHTSYN_HEADER_LENGTH) || (msgLength > length) ||
+      (ETHTSYN_VERSION_PTP != (data[1] & 0x0F))) {
+    ASLOG(ETHTSYNE, ("[%d] invalid message of %u bytes\n", domain->GlobalTimeDomainId, length));
+    ret = E_NOT_OK;
+  } else if ((domain->GlobalTimeDomainId != data[ETHTSYN_OFFSET_DOMAIN]) ||
+             (0 == memcmp(&data[ETHTSYN_OFFSET_SOURCE_PORT], domain->port->clockIdentity,
+                          ETHTSYN_CLOCK_IDENTITY_LENGTH))) {
+    /* of the other domains, or of this port itself by the multicast loop */
+    ret = E_NOT_OK;
+  } else if (((ETHTSYN_MSG_SYNC == msgType) && (msgLength < ETHTSYN_SYNC_LENGTH)) ||
+             ((ETHTSYN_MSG_FOLLOW_UP == msgType) && (msgLength < ETHTSYN_FOLLOW_UP_LENGTH)) ||
+             ((ETHTSYN_MSG_PDELAY_REQ == msgType) && (msgLength < ETHTSYN_PDELAY_LENGTH)) ||
+             ((ETHTSYN_MSG_PDELAY_RESP == msgType) && (msgLength < ETHTSYN_PDELAY_LENGTH)) ||
+             ((ETHTSYN_MSG_PDELAY_RESP_FOLLOW_UP == msgType) &&
+              (msgLength < ETHTSYN_PDELAY_LENGTH))) {
+    ASLOG(ETHTSYNE, ("[%d] message 0x%x too short: %u\n", domain->GlobalTimeDomainId, msgType,
+                     msgLength));
+    ret = E_NOT_OK;
+  } else {
+    /* valid */
+  }
+
+  if (E_OK == ret) {
+    ASLOG(ETHTSYN, ("[%d] RX message 0x%x seq %d\n", domain->GlobalTimeDomainId, msgType,
+                    EthTSyn_GetSequenceId(data)));
+    switch (msgType) {
+    case ETHTSYN_MSG_SYNC:
+      if (ETHTSYN_SLAVE == domain->DomainType) {
+        EthTSyn_HandleSync(domain, data, rxTime);
+      }
+      break;
+    case ETHTSYN_MSG_FOLLOW_UP:
+      if (ETHTSYN_SLAVE == domain->DomainType) {
+        EthTSyn_HandleFollowUp(domain, data);
+      }
+      break;
+    case ETHTSYN_MSG_PDELAY_REQ:
+      EthTSyn_HandlePdelayReq(domain, data, rxTime);
+      break;
+    case ETHTSYN_MSG_PDELAY_RESP:
+    case ETHTSYN_MSG_PDELAY_RESP_FOLLOW_UP:
+      EthTSyn_HandlePdelayResp(domain, data, msgType, rxTime);
+      break;
+    default:
+      ASLOG(ETHTSYNE, ("[%d] message 0x%x not supported\n", domain->GlobalTimeDomainId, msgType));
+      break;
+    }
+  }
+}
+
+static void EthTSyn_ReadSocket(const EthTSyn_GlobalTimeDomainType *domain,
+                               TcpIp_SocketIdType sock) {
+  Std_ReturnType ret = E_OK;
+  uint8_t data[ETHTSYN_MSG_LENGTH_MAX];
+  TcpIp_SockAddrType RemoteAddr;
+  TcpIp_TimeStampType timeStamp;
+  uint32_t length = sizeof(data);
+  int i;
+
+  for (i = 0; (i < ETHTSYN_RX_MAX) && (E_OK == ret) && (length > 0); i++) {
+    length = sizeof(data);
+    ret = TcpIp_RecvFromWithTimeStamp(sock, &RemoteAddr, data, &length, &timeStamp);
+    if ((E_OK == ret) && (length > 0)) {
+      EthTSyn_RxMessage(domain, data, length,
+                        (uint64_t)timeStamp.seconds * ETHTSYN_NANOSECONDS_PER_SECOND +
+                          timeStamp.nanoseconds);
+    }
+  }
+}
+
+static TcpIp_SocketIdType EthTSyn_OpenSocket(const EthTSyn_GlobalTimeDomainType *domain,
+                                             uint16_t port) {
+  TcpIp_SocketIdType sock;
+  TcpIp_SockAddrType addr;
+  Std_ReturnType ret = E_NOT_OK;
+
+  sock = TcpIp_Create(TCPIP_IPPROTO_UDP);
+  if (sock >= 0) {
+    ret = TcpIp_Bind(sock, domain->Socket->LocalAddrId, &port);
+    if ((E_OK == ret) && ETHTSYN_IS_MULTICAST(domain->Socket->RemoteAddr)) {
+      TcpIp_SetupAddrFrom(&addr, domain->Socket->RemoteAddr, port);
+      ret = TcpIp_AddToMulticast(sock, &addr);
+    }
+    if (E_OK != ret) {
+      TcpIp_Close(sock, TRUE);
+      sock = -1;
+    }
+  }
+
+  return sock;
+}
+
+/* the clock identity of the EUI-64 of the IEEE 802.1AS 8.5.2.2 is of the MAC address, which the
+ * TcpIp doesn't give, so it is the IP address and the event port, unique on a host */
+static void EthTSyn_SetClockIdentity(const EthTSyn_GlobalTimeDomainType *domain) {
+  EthTSyn_PortContextType *port = domain->port;
+  TcpIp_SockAddrType addr;
+
+  memset(&addr, 0, sizeof(addr));
+  if ((E_OK != TcpIp_GetLocalAddr(port->eventSock, &addr)) ||
+      ((0 == addr.addr[0]) && (0 == addr.addr[1]) && (0 == addr.addr[2]) && (0 == addr.addr[3]))) {
+    (void)TcpIp_GetIpAddr(domain->Socket->LocalAddrId, &addr, NULL, NULL);
+  }
+  port->clockIdentity[0] = addr.addr[0];
+  port->clockIdentity[1] = addr.addr[1];
+  port->clockIdentity[2] = addr.addr[2];
+  port->clockIdentity[3] = 0xFF;
+  port->clockIdentity[4] = 0xFE;
+  port->clockIdentity[5] = addr.addr[3];
+  port->clockIdentity[6] = (domain->Socket->EventPort >> 8) & 0xFF;
+  port->clockIdentity[7] = domain->Socket->EventPort & 0xFF;
+}
+
+static void EthTSyn_OpenPort(const EthTSyn_GlobalTimeDomainType *domain) {
+  EthTSyn_PortContextType *port = domain->port;
+
+  port->eventSock = EthTSyn_OpenSocket(domain, domain->Socket->EventPort);
+  if (port->eventSock >= 0) {
+    port->generalSock = EthTSyn_OpenSocket(domain, domain->Socket->GeneralPort);
+    if (port->generalSock < 0) {
+      TcpIp_Close(port->eventSock, TRUE);
+      port->eventSock = -1;
+    }
+  }
+
+  if (port->eventSock >= 0) {
+    if (domain->UseTimeStamp && (E_OK == TcpIp_EnableTimeStamp(port->eventSock))) {
+      port->timeStampEnabled = TRUE;
+    }
+    EthTSyn_SetClockIdentity(domain);
+    ASLOG(ETHTSYNI, ("[%d] port %d/%d open, time stamp %s\n", domain->GlobalTimeDomainId,
+                     domain->Socket->EventPort, domain->Socket->GeneralPort,
+                     port->timeStampEnabled ? "on" : "off"));
+  }
+}
+
+/* each domain has its own sockets, and a message of the other domains is dropped by the reader,
+ * so 2 domains can't share a UDP port */
+static boolean EthTSyn_IsPortConflict(uint8_t index) {
+  const EthTSyn_SocketConfigType *socket = ETHTSYN_CONFIG->GlobalTimeDomains[index].Socket;
+  const EthTSyn_SocketConfigType *other;
+  boolean conflict = FALSE;
+  uint8_t i;
+
+  for (i = 0; (FALSE == conflict) && (i < index); i++) {
+    other = ETHTSYN_CONFIG->GlobalTimeDomains[i].Socket;
+    if ((socket->EventPort == other->EventPort) || (socket->EventPort == other->GeneralPort) ||
+        (socket->GeneralPort == other->EventPort) || (socket->GeneralPort == other->GeneralPort)) {
+      conflict = TRUE;
+    }
+  }
+
+  return conflict;
+}
+
+static void EthTSyn_MainMaster(const EthTSyn_GlobalTimeDomainType *domain) {
+  EthTSyn_MasterContextType *context = domain->U.M.context;
+
+  if (context->timer > 0) {
+    context->timer--;
+  }
+
+  if (0 == context->timer) {
+    context->timer = domain->U.M.Master->GlobalTimeTxPeriod;
+    if (ETHTSYN_TX_ON == ethTSynTxMode) {
+      EthTSyn_TransmitSync(domain);
+    }
+  }
+}
+
+static void EthTSyn_MainSlave(const EthTSyn_GlobalTimeDomainType *domain) {
+  EthTSyn_SlaveContextType *context = domain->U.S.context;
+
+  if (ETHTSYN_SLAVE_IDLE != context->state) {
+    if (context->timer > 0) {
+      context->timer--;
+      if (0 == context->timer) {
+        ASLOG(ETHTSYNE, ("[%d] Follow_Up timeout\n", domain->GlobalTimeDomainId));
+        context->state = ETHTSYN_SLAVE_IDLE;
+      }
+    }
+  }
+}
+
+static void EthTSyn_MainPdelay(const EthTSyn_GlobalTimeDomainType *domain) {
+  EthTSyn_PortContextType *port = domain->port;
+
+  if (port->respTimer > 0) {
+    port->respTimer--;
+    if ((0 == port->respTimer) && (ETHTSYN_PDELAY_IDLE != port->pdelayState)) {
+      ASLOG(ETHTSYNE, ("[%d] Pdelay_Resp timeout\n", domain->GlobalTimeDomainId));
+      port->pdelayState = ETHTSYN_PDELAY_IDLE;
+    }
+  }
+
+  if (domain->Pdelay->TxPdelayReqPeriod > 0) {
+    if (port->pdelayTimer > 0) {
+      port->pdelayTimer--;
+    }
+    if (0 == port->pdelayTimer) {
+      port->pdelayTimer = domain->Pdelay->TxPdelayReqPeriod;
+      if (ETHTSYN_TX_ON == ethTSynTxMode) {
+        EthTSyn_TransmitPdelayReq(domain);
+      }
+    }
+  }
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+void EthTSyn_Init(const EthTSyn_ConfigType *ConfigPtr) {
+  int i;
+  const EthTSyn_GlobalTimeDomainType *domain;
+
+  if (NULL != ConfigPtr) {
+    ethTSynConfigPtr = ConfigPtr;
+  } else {
+    ethTSynConfigPtr = &EthTSyn_Config;
+  }
+
+  ethTSynTxMode = ETHTSYN_TX_ON;
+  for (i = 0; i < ETHTSYN_CONFIG->numOfGlobalTimeDomains; i++) {
+    domain = &ETHTSYN_CONFIG->GlobalTimeDomains[i];
+    if (ETHTSYN_MASTER == domain->DomainType) {
+      memset(domain->U.M.context, 0, sizeof(EthTSyn_MasterContextType));
+      domain->U.M.context->timer = domain->U.M.Master->GlobalTimeTxPeriod;
+    } else {
+      memset(domain->U.S.context, 0, sizeof(EthTSyn_SlaveContextType));
+    }
+    memset(domain->port, 0, sizeof(EthTSyn_PortContextType));
+    domain->port->eventSock = -1;
+    domain->port->generalSock = -1;
+    domain->port->pdelay = domain->Pdelay->GlobalTimePropagationDelay;
+    domain->port->pdelayTimer = domain->Pdelay->TxPdelayReqPeriod;
+    if (EthTSyn_IsPortConflict(i)) {
+      ASLOG(ETHTSYNE, ("[%d] port %d/%d is used by another domain, disabled\n",
+                       domain->GlobalTimeDomainId, domain->Socket->EventPort,
+                       domain->Socket->GeneralPort));
+      domain->port->portConflict = TRUE;
+    }
+  }
+}
+
+void EthTSyn_SetTransmissionMode(uint8_t CtrlIdx, EthTSyn_TransmissionModeType Mode) {
+  (void)CtrlIdx;
+  ethTSynTxMode = Mode;
+}
+
+void EthTSyn_MainFunction(void) {
+  int i;
+  const EthTSyn_GlobalTimeDomainType *domain;
+
+  for (i = 0; i < ETHTSYN_CONFIG->numOfGlobalTimeDomains; i++) {
+    domain = &ETHTSYN_CONFIG->GlobalTimeDomains[i];
+    if ((domain->port->eventSock < 0) && (FALSE == domain->port->portConflict)) {
+      EthTSyn_OpenPort(domain);
+    }
+    if (domain->port->eventSock >= 0) {
+      /* the event socket first, so that a Sync is handled before its Follow_Up */
+      EthTSyn_ReadSocket(domain, domain->port->eventSock);
+      EthTSyn_ReadSocket(domain, domain->port->generalSock);
+      EthTSyn_PollEgress(domain);
+      if (ETHTSYN_MASTER == domain->DomainType) {
+        EthTSyn_MainMaster(domain);
+      } else {
+        EthTSyn_MainSlave(domain);
+      }
+      EthTSyn_MainPdelay(domain);
+      /* the egress time stamps of the ones just sent, so that the Follow_Up goes at once */
+      EthTSyn_PollEgress(domain);
+    }
+  }
+}
@@ -0,0 +1,163 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ * ref: https://www.autosar.org/fileadmin/standards/R20-11/CP/AUTOSAR_SWS_TimeSyncOverEthernet.pdf
+ */
+#ifndef __ETH_TSYNC_PRIV_H__
+#define __ETH_TSYNC_PRIV_H__
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Std_Types.h"
+#include "ComStack_Types.h"
+#include "StbM.h"
+#include "TcpIp.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define ETHTSYN_MASTER ((EthTSyn_DomainTypeType)0x00)
+#define ETHTSYN_SLAVE ((EthTSyn_DomainTypeType)0x01)
+
+/* the PTP over UDP of the IEEE 1588 Annex D */
+#define ETHTSYN_EVENT_PORT 319
+#define ETHTSYN_GENERAL_PORT 320
+#define ETHTSYN_PTP_PRIMARY_ADDR TCPIP_IPV4_ADDR(224, 0, 1, 129)
+#define ETHTSYN_PTP_PDELAY_ADDR TCPIP_IPV4_ADDR(224, 0, 0, 107)
+
+/* the IEEE 802.1AS message types */
+#define ETHTSYN_MSG_SYNC 0x0
+#define ETHTSYN_MSG_PDELAY_REQ 0x2
+#define ETHTSYN_MSG_PDELAY_RESP 0x3
+#define ETHTSYN_MSG_FOLLOW_UP 0x8
+#define ETHTSYN_MSG_PDELAY_RESP_FOLLOW_UP 0xA
+
+#define ETHTSYN_SLAVE_IDLE ((EthTSyn_SlaveStateType)0x00)
+#define ETHTSYN_SLAVE_SYNC ((EthTSyn_SlaveStateType)0x01)
+
+#define ETHTSYN_MASTER_IDLE ((EthTSyn_MasterStateType)0x00)
+#define ETHTSYN_MASTER_SYNCED ((EthTSyn_MasterStateType)0x01)
+
+#define ETHTSYN_PDELAY_IDLE ((EthTSyn_PdelayStateType)0x00)
+#define ETHTSYN_PDELAY_REQ ((EthTSyn_PdelayStateType)0x01)
+
+/* the event messages waiting for their egress time stamp */
+#define ETHTSYN_EGRESS_SYNC 0
+#define ETHTSYN_EGRESS_PDELAY_REQ 1
+#define ETHTSYN_EGRESS_PDELAY_RESP 2
+#define ETHTSYN_EGRESS_NUM 3
+
+#define ETHTSYN_CLOCK_IDENTITY_LENGTH 8
+#define ETHTSYN_PORT_IDENTITY_LENGTH 10
+/* ================================ [ TYPES     ] ============================================== */
+typedef uint8_t EthTSyn_DomainTypeType;
+
+typedef struct {
+  uint16_t GlobalTimeTxPeriod; /* in main function cycles */
+  int8_t LogMessageInterval;   /* of the GlobalTimeTxPeriod, log2 of seconds, -3 is 125ms */
+} EthTSyn_GlobalTimeMasterType;
+
+typedef struct {
+  uint16_t GlobalTimeFollowUpTimeout; /* in main function cycles */
+} EthTSyn_GlobalTimeSlaveType;
+
+typedef struct {
+  /* the path delay used until it is measured, or always if the TxPdelayReqPeriod is 0, in ns */
+  uint32_t GlobalTimePropagationDelay;
+  /* a measured path delay beyond it is dropped, in ns */
+  uint32_t PdelayLatencyThreshold;
+  uint16_t TxPdelayReqPeriod;                /* in main function cycles, 0 to not measure */
+  uint16_t PdelayRespAndRespFollowUpTimeout; /* in main function cycles */
+  boolean GlobalTimePdelayRespEnable;        /* answer the Pdelay_Req of the peer */
+} EthTSyn_PdelayConfigType;
+
+/* the UDP sockets of the port, the remote is the peer or the PTP multicast group */
+typedef struct {
+  uint32_t RemoteAddr; /* TCPIP_IPV4_ADDR */
+  uint16_t EventPort;  /* the local ones */
+  uint16_t GeneralPort;
+  uint16_t RemoteEventPort;
+  uint16_t RemoteGeneralPort;
+  TcpIp_LocalAddrIdType LocalAddrId;
+} EthTSyn_SocketConfigType;
+
+typedef uint8_t EthTSyn_MasterStateType;
+
+typedef struct {
+  StbM_TimeStampType t0; /* the global time of the Sync, at the t0r */
+  StbM_VirtualLocalTimeType t0r;
+  uint16_t timer;
+  uint16_t sequenceId;
+  EthTSyn_MasterStateType state;
+} EthTSyn_MasterContextType;
+
+typedef uint8_t EthTSyn_SlaveStateType;
+
+typedef struct {
+  StbM_VirtualLocalTimeType t2r; /* the ingress time stamp of the Sync */
+  uint8_t sourcePortIdentity[ETHTSYN_PORT_IDENTITY_LENGTH];
+  uint16_t timer;
+  uint16_t sequenceId;
+  EthTSyn_SlaveStateType state;
+} EthTSyn_SlaveContextType;
+
+typedef uint8_t EthTSyn_PdelayStateType;
+
+/* the sockets and the Pdelay of a port, t1 to t4 are of the IEEE 802.1AS 11.1.2, in ns */
+typedef struct {
+  TcpIp_SocketIdType eventSock;
+  TcpIp_SocketIdType generalSock;
+  uint64_t t1;
+  uint64_t t2;
+  uint64_t t3;
+  uint64_t t4;
+  uint32_t pdelay;
+  /* the datagram count of the event socket of the ones waiting for the egress time stamp */
+  uint32_t egressId[ETHTSYN_EGRESS_NUM];
+  uint32_t txCount;
+  uint8_t egressPending; /* the bit of each ETHTSYN_EGRESS_ */
+  uint8_t clockIdentity[ETHTSYN_CLOCK_IDENTITY_LENGTH];
+  /* the Pdelay_Req being answered */
+  uint8_t respPortIdentity[ETHTSYN_PORT_IDENTITY_LENGTH];
+  uint16_t respSequenceId;
+  uint16_t pdelayTimer;
+  uint16_t respTimer; /* of the Pdelay_Resp and Pdelay_Resp_Follow_Up */
+  uint16_t pdelaySequenceId;
+  EthTSyn_PdelayStateType pdelayState;
+  boolean t1Received;
+  boolean t3Received;
+  boolean t4Received;
+  boolean timeStampEnabled;
+  boolean pdelayMeasured;
+  boolean portConflict; /* the UDP ports are of another domain, so never opened */
+} EthTSyn_PortContextType;
+
+typedef struct {
+  union {
+    struct {
+      void *context;
+      const void *config;
+    } V;
+    struct {
+      EthTSyn_MasterContextType *context;
+      const EthTSyn_GlobalTimeMasterType *Master;
+    } M;
+    struct {
+      EthTSyn_SlaveContextType *context;
+      const EthTSyn_GlobalTimeSlaveType *Slave;
+    } S;
+  } U;
+  EthTSyn_PortContextType *port;
+  const EthTSyn_PdelayConfigType *Pdelay;
+  const EthTSyn_SocketConfigType *Socket;
+  uint8_t GlobalTimeDomainId; /* the domainNumber of the messages, range 0 .. 31 */
+  boolean UseTimeStamp;       /* the time stamps of the TcpIp, else the time of the main function */
+  StbM_SynchronizedTimeBaseType SynchronizedTimeBaseRef;
+  EthTSyn_DomainTypeType DomainType;
+} EthTSyn_GlobalTimeDomainType;
+
+struct EthTSyn_Config_s {
+  const EthTSyn_GlobalTimeDomainType *GlobalTimeDomains;
+  uint8_t numOfGlobalTimeDomains;
+};
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+#endif /* __ETH_TSYNC_PRIV_H__ */
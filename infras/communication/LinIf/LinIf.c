@@ -8,6 +8,9 @@
 #include <string.h>
 #include "LinIf_Internal.h"
 #include "Std_Debug.h"
+#ifdef USE_LINTP
+#include "LinTp.h"
+#endif
 /* ================================ [ MACROS    ] ============================================== */
 #define AS_LOG_LINIF 0
 #define AS_LOG_LINIFE 2
@@ -15,11 +18,17 @@
 #define LINIF_STATUS_SCHEDULE_REQUESTED 0x01
 #define LINIF_STATUS_SCHEDULE_NEXT_ONE 0x02
 #define LINIF_STATUS_SCHEDULE_START 0x04
+#define LINIF_STATUS_COLLISION 0x08 /* the event triggered frame of the slot collided */
 /* high 4 bit for what is on going */
 #define LINIF_STATUS_SENDING 0x10   /* for master node */
 #define LINIF_STATUS_RECEIVING 0x20 /* for slave node */
+#define LINIF_STATUS_SRF_RECEIVED 0x40
+#define LINIF_STATUS_SRF_PENDING 0x80 /* the SRF received is a response pending one */
 
-#define IS_LINIF_IDEL(status) (0 == ((status) & 0xF0))
+#define IS_LINIF_IDEL(status) (0 == ((status) & (LINIF_STATUS_SENDING | LINIF_STATUS_RECEIVING)))
+
+/* the negative response code of the UDS response pending */
+#define LINIF_NRC_RESPONSE_PENDING 0x78
 
 #define LINIF_CONFIG (&LinIf_Config)
 /* ================================ [ TYPES     ] ============================================== */
@@ -27,6 +36,24 @@
 extern const LinIf_ConfigType LinIf_Config;
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
+static const LinIf_ScheduleTableEntryType *
+LinIf_GetSporadicFrame(const LinIf_ScheduleTableEntryType *entry) {
+  const LinIf_ScheduleTableEntryType *frame = NULL;
+  PduIdType txPduId;
+  uint8_t i;
+
+  for (i = 0; (NULL == frame) && (i < entry->numOfTxPdus); i++) {
+    txPduId = entry->txPdus[i];
+    if ((txPduId < LINIF_CONFIG->numOfTxPdus) && (TRUE == LINIF_CONFIG->txPending[txPduId])) {
+      /* cleared before the trigger transmit so that a new update during the send is kept */
+      LINIF_CONFIG->txPending[txPduId] = FALSE;
+      frame = &LINIF_CONFIG->txPdus[txPduId];
+    }
+  }
+
+  return frame;
+}
+
 static void LinIf_ScheduleEntry(uint8_t Channel) {
   LinIf_ChannelContextType *context;
   const LinIf_ChannelConfigType *config;
@@ -40,7 +67,14 @@ static void LinIf_ScheduleEntry(uint8_t Channel) {
   ASLOG(LINIF,
         ("%d: begin schedule %d: id=%X dlc=%d\n", Channel, context->curSch, entry->id, entry->dlc));
 
-  if (LINIF_MAX_DATA_LENGHT >= entry->dlc) {
+  if (LINIF_SPORADIC == entry->type) {
+    entry = LinIf_GetSporadicFrame(entry);
+  }
+  context->entry = entry;
+
+  if (NULL == entry) {
+    result = LINIF_R_NOT_OK; /* no sporadic frame updated, the slot is silent */
+  } else if (LINIF_MAX_DATA_LENGHT >= entry->dlc) {
     context->frame.Pid = entry->id;
     context->frame.Dl = entry->dlc;
     context->frame.SduPtr = context->data;
@@ -48,6 +82,9 @@ static void LinIf_ScheduleEntry(uint8_t Channel) {
     context->frame.Cs = entry->Cs;
     if (LIN_FRAMERESPONSE_TX == entry->Drc) {
       result = entry->callback(Channel, &context->frame, LINIF_R_TRIGGER_TRANSMIT);
+      if ((LINIF_R_OK != result) && (LINIF_UNCONDITIONAL == entry->type)) {
+        ASLOG(LINIFE, ("%d: FAIL to provide Tx buffer\n", Channel));
+      }
     }
   } else {
     result = LINIF_R_NOT_OK;
@@ -62,7 +99,21 @@ static void LinIf_ScheduleEntry(uint8_t Channel) {
       ASLOG(LINIFE, ("%d: FAIL to send\n", Channel));
     }
   } else {
-    ASLOG(LINIFE, ("%d: FAIL to provide Tx buffer\n", Channel));
+    /* nothing to send, e.g. the MRF when LinTp has no request */
+    context->entry = NULL;
+  }
+}
+
+static void LinIf_CheckSRF(LinIf_ChannelContextType *context, const Lin_PduType *frame) {
+  const uint8_t *data = frame->SduPtr;
+
+  context->status |= LINIF_STATUS_SRF_RECEIVED;
+  /* NAD, PCI of SF, 0x7F, SID, 0x78 */
+  if ((NULL != data) && (frame->Dl >= 5) && (0x00 == (data[1] & 0xF0)) && (0x7F == data[2]) &&
+      (LINIF_NRC_RESPONSE_PENDING == data[4])) {
+    context->status |= LINIF_STATUS_SRF_PENDING;
+  } else {
+    context->status &= ~LINIF_STATUS_SRF_PENDING;
   }
 }
 
@@ -75,7 +126,7 @@ static void LinIf_CheckEntry(uint8_t Channel) {
 
   context = &LINIF_CONFIG->channelContexts[Channel];
   config = &LINIF_CONFIG->channelConfigs[Channel];
-  entry = &context->scheduleTable->entrys[context->curSch];
+  entry = context->entry;
 
   status = Lin_GetStatus(config->linChannel, &context->frame.SduPtr);
   if (LIN_FRAMERESPONSE_TX == entry->Drc) {
@@ -85,15 +136,131 @@ static void LinIf_CheckEntry(uint8_t Channel) {
   } else {
     if (LIN_RX_OK == status) {
       result = LINIF_R_RECEIVED_OK;
+    } else if ((LIN_RX_ERROR == status) && (LINIF_EVENT == entry->type)) {
+      /* more than one slave responded, resolved by the collision schedule at the end of slot */
+      ASLOG(LINIF, ("%d: collision on event triggered frame %X\n", Channel, entry->id));
+      context->status |= LINIF_STATUS_COLLISION;
+      context->status &= ~LINIF_STATUS_SENDING;
+    } else {
+      /* still waiting, or no slave responded */
     }
   }
 
   if (result != LINIF_R_NOT_OK) {
     ASLOG(LINIF, ("%d: TX done with result %d\n", Channel, result));
     (void)entry->callback(Channel, &context->frame, result);
+    if ((LINIF_R_RECEIVED_OK == result) && (LINIF_DIAG_SRF == entry->type)) {
+      LinIf_CheckSRF(context, &context->frame);
+    }
     context->status &= ~LINIF_STATUS_SENDING;
   }
 }
+
+/* move to the next slot, the collision resolving table is run once and then the interrupted table
+ * goes on from the slot after the event triggered one */
+static void LinIf_NextEntry(LinIf_ChannelContextType *context) {
+  const LinIf_ScheduleTableEntryType *entry;
+
+  entry = &context->scheduleTable->entrys[context->curSch];
+  if ((0 != (context->status & LINIF_STATUS_COLLISION)) && (NULL == context->resumeTable) &&
+      (LINIF_EVENT == entry->type) && (entry->collisionSchedule < LINIF_CONFIG->numOfSchTbls) &&
+      (0 < LINIF_CONFIG->scheduleTables[entry->collisionSchedule].numOfEntries)) {
+    context->resumeTable = context->scheduleTable;
+    context->resumeSch = context->curSch;
+    context->scheduleTable = &LINIF_CONFIG->scheduleTables[entry->collisionSchedule];
+    context->curSch = 0;
+  } else {
+    context->curSch++;
+    if (context->curSch >= context->scheduleTable->numOfEntries) {
+      context->curSch = 0;
+      if (NULL != context->resumeTable) {
+        context->scheduleTable = context->resumeTable;
+        context->curSch = context->resumeSch + 1;
+        context->resumeTable = NULL;
+        if (context->curSch >= context->scheduleTable->numOfEntries) {
+          context->curSch = 0;
+        }
+      }
+    }
+  }
+  context->status &= ~LINIF_STATUS_COLLISION;
+}
+
+#ifdef USE_LINTP
+static void LinIf_TpSwitch(uint8_t Channel, LinTp_Mode Mode) {
+  LinIf_ChannelContextType *context = &LINIF_CONFIG->channelContexts[Channel];
+  const LinIf_ChannelConfigType *config = &LINIF_CONFIG->channelConfigs[Channel];
+
+  ASLOG(LINIF, ("%d: LinTp mode %d -> %d\n", Channel, context->tpMode, Mode));
+  if (LINTP_APPLICATIVE_SCHEDULE == context->tpMode) {
+    /* an applicative request not taken yet is the one to go back to */
+    if (LINIF_INVALD_SCHEDULE_TABLE == context->scheduleRequested) {
+      context->applicativeSchedule = context->curTable;
+    } else {
+      context->applicativeSchedule = context->scheduleRequested;
+    }
+  }
+
+  switch (Mode) {
+  case LINTP_DIAG_REQUEST:
+    context->scheduleRequested = config->diagRequestSchedule;
+    break;
+  case LINTP_DIAG_RESPONSE:
+    context->scheduleRequested = config->diagResponseSchedule;
+    Std_TimerStart(&context->P2Timer);
+    break;
+  default:
+    context->scheduleRequested = context->applicativeSchedule;
+    Std_TimerStop(&context->P2Timer);
+    break;
+  }
+  context->status &= ~(LINIF_STATUS_SRF_RECEIVED | LINIF_STATUS_SRF_PENDING);
+  context->tpMode = Mode;
+}
+
+/* the master switches to the MRF schedule as soon as LinTp has a request to send, then to the SRF
+ * schedule once the request is sent, and back to the applicative schedule once the response is
+ * received or the slave is silent for P2Timeout */
+static void LinIf_TpSchedule(uint8_t Channel) {
+  LinIf_ChannelContextType *context = &LINIF_CONFIG->channelContexts[Channel];
+  const LinIf_ChannelConfigType *config = &LINIF_CONFIG->channelConfigs[Channel];
+  boolean txPending = (LinTp_GetTxPacketLength((PduIdType)Channel) > 0);
+
+  switch (context->tpMode) {
+  case LINTP_APPLICATIVE_SCHEDULE:
+    if (txPending) {
+      LinIf_TpSwitch(Channel, LINTP_DIAG_REQUEST);
+    }
+    break;
+  case LINTP_DIAG_REQUEST:
+    if ((FALSE == txPending) && IS_LINIF_IDEL(context->status) &&
+        (LINIF_INVALD_SCHEDULE_TABLE == context->scheduleRequested)) {
+      LinIf_TpSwitch(Channel, LINTP_DIAG_RESPONSE);
+    }
+    break;
+  case LINTP_DIAG_RESPONSE:
+    if (txPending) {
+      LinIf_TpSwitch(Channel, LINTP_DIAG_REQUEST);
+    } else if (0 != (context->status & LINIF_STATUS_SRF_RECEIVED)) {
+      context->status &= ~LINIF_STATUS_SRF_RECEIVED;
+      if ((0 == (context->status & LINIF_STATUS_SRF_PENDING)) &&
+          (0 == LinTp_GetRxLeftLength((PduIdType)Channel))) {
+        LinIf_TpSwitch(Channel, LINTP_APPLICATIVE_SCHEDULE);
+      } else {
+        Std_TimerStart(&context->P2Timer);
+      }
+    } else if (Std_GetTimerElapsedTime(&context->P2Timer) > config->P2Timeout) {
+      ASLOG(LINIFE, ("%d: no response in %u us\n", Channel, config->P2Timeout));
+      LinIf_TpSwitch(Channel, LINTP_APPLICATIVE_SCHEDULE);
+    } else {
+      /* keep polling */
+    }
+    break;
+  default:
+    break;
+  }
+}
+#endif
 /* ================================ [ FUNCTIONS ] ============================================== */
 void LinIf_Init(const LinIf_ConfigType *ConfigPtr) {
   int i;
@@ -105,10 +272,19 @@ void LinIf_Init(const LinIf_ConfigType *ConfigPtr) {
     context = &LINIF_CONFIG->channelContexts[i];
     context->status = 0;
     context->scheduleTable = NULL;
+    context->entry = NULL;
     context->curSch = 0;
     context->scheduleRequested = LINIF_INVALD_SCHEDULE_TABLE;
+    context->curTable = LINIF_INVALD_SCHEDULE_TABLE;
+    context->resumeTable = NULL;
+    context->applicativeSchedule = LINIF_INVALD_SCHEDULE_TABLE;
+    context->tpMode = LINTP_APPLICATIVE_SCHEDULE;
     Lin_SetControllerMode(config->linChannel, LIN_CS_STARTED);
     Std_TimerStop(&context->timer);
+    Std_TimerStop(&context->P2Timer);
+  }
+  for (i = 0; i < LINIF_CONFIG->numOfTxPdus; i++) {
+    LINIF_CONFIG->txPending[i] = FALSE;
   }
 }
 
@@ -125,6 +301,18 @@ void LinIf_DeInit() {
   }
 }
 
+Std_ReturnType LinIf_Transmit(PduIdType LinTxPduId, const PduInfoType *PduInfoPtr) {
+  Std_ReturnType r = E_NOT_OK;
+  (void)PduInfoPtr; /* the data is taken by the trigger transmit of the frame */
+
+  if (LinTxPduId < LINIF_CONFIG->numOfTxPdus) {
+    LINIF_CONFIG->txPending[LinTxPduId] = TRUE;
+    r = E_OK;
+  }
+
+  return r;
+}
+
 Std_ReturnType LinIf_ScheduleRequest(NetworkHandleType Channel, LinIf_SchHandleType Schedule) {
   Std_ReturnType r = E_NOT_OK;
   LinIf_ChannelContextType *context;
@@ -133,7 +321,12 @@ Std_ReturnType LinIf_ScheduleRequest(NetworkHandleType Channel, LinIf_SchHandleT
     context = &LINIF_CONFIG->channelContexts[Channel];
 
     if (Schedule < LINIF_CONFIG->numOfSchTbls) {
-      context->scheduleRequested = Schedule;
+      if (LINTP_APPLICATIVE_SCHEDULE == context->tpMode) {
+        context->scheduleRequested = Schedule;
+      } else {
+        /* taken once the diagnostic is over */
+        context->applicativeSchedule = Schedule;
+      }
       r = E_OK;
     }
   }
@@ -144,6 +337,7 @@ Std_ReturnType LinIf_ScheduleRequest(NetworkHandleType Channel, LinIf_SchHandleT
 void LinIf_MainFunction(void) {
   int i;
   uint32_t elapsed;
+  uint32_t delay;
   LinIf_ChannelContextType *context;
   const LinIf_ChannelConfigType *config;
 
@@ -155,12 +349,21 @@ void LinIf_MainFunction(void) {
       LinIf_CheckEntry(i);
     }
 
+#ifdef USE_LINTP
+    if ((LINIF_MASTER == config->nodeType) &&
+        (LINIF_INVALD_SCHEDULE_TABLE != config->diagRequestSchedule)) {
+      LinIf_TpSchedule(i);
+    }
+#endif
+
     if (context->scheduleRequested != LINIF_INVALD_SCHEDULE_TABLE) {
       if (IS_LINIF_IDEL(context->status)) {
         /* switch only when system is IDLE */
         context->scheduleTable = &LINIF_CONFIG->scheduleTables[context->scheduleRequested];
         ASLOG(LINIF, ("%d: switch to schedule table %d\n", i, context->scheduleRequested));
+        context->curTable = context->scheduleRequested;
         context->scheduleRequested = LINIF_INVALD_SCHEDULE_TABLE;
+        context->resumeTable = NULL;
         Std_TimerStop(&context->timer);
         if (0 < context->scheduleTable->numOfEntries) {
           context->curSch = context->scheduleTable->numOfEntries - 1; /* default to the end */
@@ -192,12 +395,25 @@ void LinIf_MainFunction(void) {
       if (NULL != context->scheduleTable) {
         if (Std_IsTimerStarted(&context->timer)) {
           elapsed = Std_GetTimerElapsedTime(&context->timer);
-          if (elapsed > context->scheduleTable->entrys[context->curSch].delay) {
+          delay = context->scheduleTable->entrys[context->curSch].delay;
+          if (elapsed >= delay) {
             if (FALSE == IS_LINIF_IDEL(context->status)) {
-              ASLOG(LINIFE, ("%d: master %u us timeout, status=%X\n", i, elapsed, context->status));
+              if ((NULL != context->entry) && (LIN_FRAMERESPONSE_RX == context->entry->Drc) &&
+                  (LINIF_UNCONDITIONAL != context->entry->type)) {
+                /* no slave has a response for the event triggered frame or the SRF */
+              } else {
+                ASLOG(LINIFE,
+                      ("%d: master %u us timeout, status=%X\n", i, elapsed, context->status));
+              }
+              context->status &= ~LINIF_STATUS_SENDING;
+            }
+            context->status |= LINIF_STATUS_SCHEDULE_REQUESTED | LINIF_STATUS_SCHEDULE_NEXT_ONE;
+            if (elapsed < (2u * delay)) {
+              /* the next slot starts at the end of this one, not drift by the main period */
+              Std_TimerAdvance(&context->timer, delay);
+            } else {
+              Std_TimerStart(&context->timer);
             }
-            context->status = LINIF_STATUS_SCHEDULE_REQUESTED | LINIF_STATUS_SCHEDULE_NEXT_ONE;
-            Std_TimerStart(&context->timer);
           }
         } else {
           Std_TimerStart(&context->timer);
@@ -208,10 +424,7 @@ void LinIf_MainFunction(void) {
     if (0 != (context->status & LINIF_STATUS_SCHEDULE_NEXT_ONE)) {
       context->status &= ~LINIF_STATUS_SCHEDULE_NEXT_ONE;
       if (NULL != context->scheduleTable) {
-        context->curSch++;
-        if (context->curSch >= context->scheduleTable->numOfEntries) {
-          context->curSch = 0;
-        }
+        LinIf_NextEntry(context);
         context->status |= LINIF_STATUS_SCHEDULE_START;
       } else {
         ASLOG(LINIFE, ("%d: schedule requested with NULL schedule\n", i));
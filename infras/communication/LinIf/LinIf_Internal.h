@@ -21,6 +21,12 @@ typedef struct {
   Lin_FrameResponseType Drc;
   LinIf_NotificationCallbackType callback;
   uint32_t delay; /* delay in us */
+  /* LINIF_SPORADIC: the LinTxPduIds that share the slot, the highest priority first, the first one
+   * flagged by LinIf_Transmit is sent, the slot is silent if none is flagged */
+  const PduIdType *txPdus;
+  uint8_t numOfTxPdus;
+  /* LINIF_EVENT: the schedule table run once to poll the associated frames on a collision */
+  LinIf_SchHandleType collisionSchedule;
 } LinIf_ScheduleTableEntryType;
 
 typedef struct {
@@ -32,9 +38,18 @@ typedef struct {
   Lin_PduType frame;
   LinIf_ChannelStatusType status;
   const LinIf_ScheduleTableType *scheduleTable;
+  const LinIf_ScheduleTableEntryType *entry; /* the frame of the current slot, NULL if silent */
   LinIf_SchHandleType curSch;
   Std_TimerType timer;
   LinIf_SchHandleType scheduleRequested;
+  LinIf_SchHandleType curTable;
+  /* the schedule table interrupted by a collision resolving one */
+  const LinIf_ScheduleTableType *resumeTable;
+  LinIf_SchHandleType resumeSch;
+  /* the applicative schedule table to go back to after the diagnostic */
+  LinIf_SchHandleType applicativeSchedule;
+  LinTp_Mode tpMode;
+  Std_TimerType P2Timer;
   uint8_t data[LINIF_MAX_DATA_LENGHT];
 } LinIf_ChannelContextType;
 
@@ -49,6 +64,11 @@ typedef struct {
   LinIf_NodeTypeType nodeType;
   uint32_t timeout; /* us */
   NetworkHandleType linChannel;
+  /* for the master, the schedule tables to carry the LinTp MRF and SRF of the LinTp channel of the
+   * same index, LINIF_INVALD_SCHEDULE_TABLE if the channel has no LinTp */
+  LinIf_SchHandleType diagRequestSchedule;
+  LinIf_SchHandleType diagResponseSchedule;
+  uint32_t P2Timeout; /* us, to poll the SRF for the response after the request or each SRF */
 } LinIf_ChannelConfigType;
 
 struct LinIf_Config_s {
@@ -57,6 +77,10 @@ struct LinIf_Config_s {
   const LinIf_ChannelConfigType *channelConfigs;
   LinIf_ChannelContextType *channelContexts;
   uint8_t numOfChannels;
+  /* the frames of the sporadic slots, Drc is LIN_FRAMERESPONSE_TX */
+  const LinIf_ScheduleTableEntryType *txPdus;
+  boolean *txPending; /* set by LinIf_Transmit */
+  uint8_t numOfTxPdus;
 };
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
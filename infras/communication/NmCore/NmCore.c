@@ -0,0 +1,1102 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ * ref:
+ * https://www.autosar.org/fileadmin/user_upload/standards/classic/4-3/AUTOSAR_SWS_CANNetworkManagement.pdf
+ * Specification of UDP Network Management AUTOSAR CP Release 4.4.0
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Nm.h"
+#include "NmCore.h"
+#include "Std_Critical.h"
+#include "Std_Debug.h"
+#include <string.h>
+/* ================================ [ MACROS    ] ============================================== */
+#define AS_LOG_NMCORE 1
+
+#ifdef USE_NMCORE_CRITICAL
+#define nmEnterCritical() EnterCritical()
+#define nmExitCritical() ExitCritical()
+#else
+#define nmEnterCritical()
+#define nmExitCritical()
+#endif
+
+#define NMCORE_REQUEST_MASK 0x01
+#define NMCORE_PASSIVE_STARTUP_REQUEST_MASK 0x02
+#define NMCORE_REPEAT_MESSAGE_REQUEST_MASK 0x04
+#define NMCORE_DISABLE_COMMUNICATION_REQUEST_MASK 0x08
+#define NMCORE_RX_INDICATION_REQUEST_MASK 0x10
+#define NMCORE_NM_PDU_RECEIVED_MASK 0x20
+#define NMCORE_REMOTE_SLEEP_IND_MASK 0x40
+#define NMCORE_COORDINATOR_SLEEP_SYNC_MASK 0x80
+#define NMCORE_PN_ENABLED_MASK 0x100
+
+#define NMCORE_HAS(feature) (0 != (core->features & NMCORE_FEATURE_##feature))
+
+/* the PN info is within the NM PDU of the channel */
+#define NMCORE_PN_INFO_FITS(config)                                                                \
+  (((uint32_t)(config)->PnInfoOffset + (config)->PnInfoLength) <= (config)->PduLength)
+
+#ifdef _WIN32
+#define nmSetAlarm(Timer, v)                                                                       \
+  Std_TimerSet(&context->Alarm._##Timer, ((v)*1000 * core->MainFunctionPeriod))
+#define nmSingalAlarm(Timer)
+#define nmIsAlarmTimeout(Timer) Std_IsTimerTimeout(&context->Alarm._##Timer)
+#define nmIsAlarmStarted(Timer) Std_IsTimerStarted(&context->Alarm._##Timer)
+#define nmCancelAlarm(Timer) Std_TimerStop(&context->Alarm._##Timer)
+#else
+/* Alarm Management */
+#define nmSetAlarm(Timer, v)                                                                       \
+  do {                                                                                             \
+    context->Alarm._##Timer = 1 + (v);                                                             \
+  } while (0)
+
+/* signal the alarm to process one step/tick forward */
+#define nmSingalAlarm(Timer)                                                                       \
+  do {                                                                                             \
+    if (context->Alarm._##Timer > 1) {                                                             \
+      (context->Alarm._##Timer)--;                                                                 \
+    }                                                                                              \
+  } while (0)
+
+#define nmIsAlarmTimeout(Timer) (1 == context->Alarm._##Timer)
+
+#define nmIsAlarmStarted(Timer) (0 != context->Alarm._##Timer)
+
+#define nmCancelAlarm(Timer)                                                                       \
+  do {                                                                                             \
+    context->Alarm._##Timer = 0;                                                                   \
+  } while (0)
+#endif
+
+/* @SWS_CanNm_00045 */
+#define NMCORE_CBV_REPEAT_MESSAGE_REQUEST 0x01
+#define NMCORE_CBV_NM_COORDINATOR_SLEEP 0x08
+#define NMCORE_CBV_ACTIVE_WAKEUP 0x10
+#define NMCORE_CBV_PARTIAL_NETWORK_INFORMATION 0x40
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* add the PNs of the PN info that are set in the mask, and restart their reset timers */
+static void nmPnAggregate(const NmCore_ConfigType *core, NmCore_PnAggregationType *aggregation,
+                          uint8_t length, const uint8_t *PnInfo, const uint8_t *mask) {
+  uint8_t requested;
+  uint8_t i;
+  uint8_t j;
+
+  for (i = 0; i < length; i++) {
+    requested = PnInfo[i] & mask[i];
+    /* the timers and the bits go together, the EIRA is fed by the rx and the tx paths */
+    nmEnterCritical();
+    for (j = 0; (j < 8) && (0 != requested); j++) {
+      if (0 != (requested & (1u << j))) {
+        aggregation->Timers[i * 8 + j] = 1 + core->PnResetTime;
+      }
+    }
+    if (requested != (aggregation->PnInfo[i] & requested)) {
+      aggregation->PnInfo[i] |= requested;
+      aggregation->changed = TRUE;
+    }
+    nmExitCritical();
+  }
+}
+
+/* @SWS_CanNm_00438, @SWS_CanNm_00439: a PN not requested for the PnResetTime is released */
+static void nmPnAggregationMain(NmCore_PnAggregationType *aggregation, uint8_t length) {
+  uint16_t *timer;
+  uint8_t i;
+  uint8_t j;
+
+  for (i = 0; i < length; i++) {
+    for (j = 0; (j < 8) && (0 != aggregation->PnInfo[i]); j++) {
+      timer = &aggregation->Timers[i * 8 + j];
+      nmEnterCritical();
+      if (*timer > 1) {
+        (*timer)--;
+      }
+      if (1 == *timer) {
+        *timer = 0;
+        aggregation->PnInfo[i] &= ~(1u << j);
+        aggregation->changed = TRUE;
+      }
+      nmExitCritical();
+    }
+  }
+}
+
+static uint8_t nmEiraLength(const NmCore_ConfigType *core, const NmCore_ChannelConfigType *config) {
+  uint8_t length = config->PnInfoLength;
+
+  if (length > core->PnInfoLength) {
+    length = core->PnInfoLength;
+  }
+
+  return length;
+}
+
+static void nmSendMessage(const NmCore_ConfigType *core, NmCore_ChannelContextType *context,
+                          const NmCore_ChannelConfigType *config, uint16_t reload) {
+  Std_ReturnType ret;
+  PduInfoType pdu;
+
+  pdu.SduLength = config->PduLength;
+  pdu.SduDataPtr = context->data;
+  if (0 == (context->flags & NMCORE_DISABLE_COMMUNICATION_REQUEST_MASK)) {
+    ret = core->Transmit(config->TxPdu, &pdu);
+    if (E_OK == ret) {
+      nmSetAlarm(TxTimeout, config->MsgTimeoutTime);
+      if (reload > 0) {
+        nmSetAlarm(Tx, reload);
+      }
+      if (NMCORE_HAS(GLOBAL_PN) && (config->PnEnabled) && (NULL != core->Eira) &&
+          NMCORE_PN_INFO_FITS(config)) {
+        /* @SWS_CanNm_00428: the PNs requested by this ECU */
+        nmPnAggregate(core, core->Eira, nmEiraLength(core, config),
+                      &context->data[config->PnInfoOffset], config->PnFilterMaskByte);
+      }
+    } else {
+      /* @SWS_CanNm_00335 */
+      nmSetAlarm(Tx, 0);
+    }
+  }
+}
+
+static void nmEnterNetworkMode(const NmCore_ConfigType *core, NmCore_ChannelContextType *context,
+                               const NmCore_ChannelConfigType *config) {
+  context->state = NM_STATE_REPEAT_MESSAGE;
+  context->TxCounter = 0;
+  if ((context->flags & NMCORE_REQUEST_MASK) && (config->ImmediateNmTransmissions > 0)) {
+    /* @SWS_CanNm_00334 */
+    nmSendMessage(core, context, config, config->ImmediateNmCycleTime);
+  } else {
+    /* SWS_CanNm_00005 */
+    nmSetAlarm(Tx, config->MsgCycleOffset);
+  }
+  nmSetAlarm(NMTimeout, config->NmTimeoutTime);
+  nmSetAlarm(RepeatMessage, config->RepeatMessageTime);
+
+  nmEnterCritical();
+  context->flags &= ~(NMCORE_NM_PDU_RECEIVED_MASK | NMCORE_PASSIVE_STARTUP_REQUEST_MASK |
+                      NMCORE_REMOTE_SLEEP_IND_MASK | NMCORE_RX_INDICATION_REQUEST_MASK |
+                      NMCORE_COORDINATOR_SLEEP_SYNC_MASK | NMCORE_PN_ENABLED_MASK);
+  nmExitCritical();
+
+  Nm_NetworkMode(config->nmNetworkHandle);
+  ASLOG(NMCORE,
+        ("%d: Enter Repeat Message Mode, flags %02X\n", config->nmNetworkHandle, context->flags));
+}
+
+static void nmRepeatMessageMain(const NmCore_ConfigType *core, NmCore_ChannelContextType *context,
+                                const NmCore_ChannelConfigType *config) {
+  uint16_t reload = config->MsgCycleTime;
+
+  if (context->flags & NMCORE_RX_INDICATION_REQUEST_MASK) {
+    nmEnterCritical();
+    context->flags &= ~NMCORE_RX_INDICATION_REQUEST_MASK;
+    nmExitCritical();
+  }
+
+  if ((context->flags & NMCORE_REQUEST_MASK) && (config->ImmediateNmTransmissions > 0)) {
+    /* @SWS_CanNm_00334 */
+    if (context->TxCounter < (config->ImmediateNmTransmissions - 1)) {
+      reload = config->ImmediateNmCycleTime;
+    }
+  }
+
+  if (nmIsAlarmStarted(TxTimeout)) {
+    nmSingalAlarm(TxTimeout);
+    if (nmIsAlarmTimeout(TxTimeout)) {
+      nmCancelAlarm(TxTimeout);
+      Nm_TxTimeoutException(config->nmNetworkHandle);
+    }
+  }
+
+  if (nmIsAlarmStarted(NMTimeout)) {
+    nmSingalAlarm(NMTimeout);
+    if (nmIsAlarmTimeout(NMTimeout)) {
+      nmSetAlarm(NMTimeout, config->NmTimeoutTime);
+    }
+  } else {
+    nmSetAlarm(NMTimeout, config->NmTimeoutTime);
+  }
+
+  if (nmIsAlarmStarted(Tx)) {
+    nmSingalAlarm(Tx);
+    if (nmIsAlarmTimeout(Tx)) {
+      nmSendMessage(core, context, config, reload);
+    }
+  } else {
+    nmSetAlarm(Tx, reload);
+  }
+
+  if (nmIsAlarmStarted(RepeatMessage)) {
+    nmSingalAlarm(RepeatMessage);
+    if (nmIsAlarmTimeout(RepeatMessage)) {
+      if (context->flags & NMCORE_REQUEST_MASK) {
+        context->state = NM_STATE_NORMAL_OPERATION;
+        if (NMCORE_HAS(REMOTE_SLEEP_IND)) { /* @SWS_CanNm_00149, @SWS_CanNm_00150 */
+          nmSetAlarm(RemoteSleepInd, config->RemoteSleepIndTime);
+        }
+        ASLOG(NMCORE, ("%d: Enter Normal Operation Mode, flags %02X\n", config->nmNetworkHandle,
+                       context->flags));
+      } else {
+        context->state = NM_STATE_READY_SLEEP;
+        ASLOG(NMCORE, ("%d: Enter Ready Sleep Mode, flags %02X\n", config->nmNetworkHandle,
+                       context->flags));
+      }
+      if (config->PduCbvPosition < config->PduLength) {
+        /* @SWS_CanNm_00107 */
+        nmEnterCritical();
+        context->data[config->PduCbvPosition] &= ~NMCORE_CBV_REPEAT_MESSAGE_REQUEST;
+        nmExitCritical();
+      }
+    }
+  } else {
+    nmSetAlarm(RepeatMessage, config->RepeatMessageTime);
+  }
+}
+
+static void nmBusSleepMain(const NmCore_ConfigType *core, NmCore_ChannelContextType *context,
+                           const NmCore_ChannelConfigType *config) {
+  if (context->flags & (NMCORE_REQUEST_MASK | NMCORE_PASSIVE_STARTUP_REQUEST_MASK)) {
+    nmEnterNetworkMode(core, context, config);
+  } else {
+    if (context->flags & NMCORE_RX_INDICATION_REQUEST_MASK) {
+      /* @SWS_CanNm_00127 */
+      nmEnterCritical();
+      context->flags &= ~NMCORE_RX_INDICATION_REQUEST_MASK;
+      nmExitCritical();
+      Nm_NetworkStartIndication(config->nmNetworkHandle);
+    }
+  }
+}
+
+static void nmPrepareBusSleepMain(const NmCore_ConfigType *core,
+                                  NmCore_ChannelContextType *context,
+                                  const NmCore_ChannelConfigType *config) {
+  if (context->flags & (NMCORE_REQUEST_MASK | NMCORE_PASSIVE_STARTUP_REQUEST_MASK |
+                        NMCORE_RX_INDICATION_REQUEST_MASK)) {
+    if (context->flags & NMCORE_RX_INDICATION_REQUEST_MASK) {
+      nmEnterCritical();
+      context->flags &= ~NMCORE_RX_INDICATION_REQUEST_MASK;
+      nmExitCritical();
+    }
+    nmEnterNetworkMode(core, context, config);
+  } else {
+    if (nmIsAlarmStarted(WaitBusSleep)) {
+      nmSingalAlarm(WaitBusSleep);
+      if (nmIsAlarmTimeout(WaitBusSleep)) {
+        context->state = NM_STATE_BUS_SLEEP;
+        ASLOG(NMCORE,
+              ("%d: Enter Bus Sleep Mode, flags %02X\n", config->nmNetworkHandle, context->flags));
+        Nm_BusSleepMode(config->nmNetworkHandle);
+      }
+    } else {
+      nmSetAlarm(WaitBusSleep, config->WaitBusSleepTime);
+    }
+  }
+}
+
+static void nmEnterRepeatMessageMode(const NmCore_ConfigType *core,
+                                     NmCore_ChannelContextType *context,
+                                     const NmCore_ChannelConfigType *config) {
+  context->state = NM_STATE_REPEAT_MESSAGE;
+  if (NMCORE_HAS(REMOTE_SLEEP_IND) && (context->flags & NMCORE_REMOTE_SLEEP_IND_MASK)) {
+    /* @SWS_CanNm_00152 */
+    Nm_RemoteSleepCancellation(config->nmNetworkHandle);
+  }
+  nmEnterCritical();
+  context->flags &= ~(NMCORE_REPEAT_MESSAGE_REQUEST_MASK | NMCORE_REMOTE_SLEEP_IND_MASK);
+  nmExitCritical();
+  ASLOG(NMCORE,
+        ("%d: Enter Repeat Message Mode, flags %02X\n", config->nmNetworkHandle, context->flags));
+  /* @SWS_CanNm_00005 */
+  nmSetAlarm(Tx, config->MsgCycleOffset);
+  nmSetAlarm(RepeatMessage, config->RepeatMessageTime);
+}
+
+static void nmReadySleepMain(const NmCore_ConfigType *core, NmCore_ChannelContextType *context,
+                             const NmCore_ChannelConfigType *config) {
+  if (context->flags & NMCORE_RX_INDICATION_REQUEST_MASK) {
+    nmEnterCritical();
+    context->flags &= ~NMCORE_RX_INDICATION_REQUEST_MASK;
+    nmExitCritical();
+    if (NMCORE_HAS(REMOTE_SLEEP_IND) && (context->flags & NMCORE_REMOTE_SLEEP_IND_MASK)) {
+      nmEnterCritical();
+      context->flags &= ~NMCORE_REMOTE_SLEEP_IND_MASK;
+      nmExitCritical();
+      /* @SWS_CanNm_00151 */
+      Nm_RemoteSleepCancellation(config->nmNetworkHandle);
+    }
+  }
+
+  if (context->flags & NMCORE_REPEAT_MESSAGE_REQUEST_MASK) {
+    nmEnterRepeatMessageMode(core, context, config);
+  } else if (context->flags & NMCORE_REQUEST_MASK) {
+    context->state = NM_STATE_NORMAL_OPERATION;
+    if (NMCORE_HAS(REMOTE_SLEEP_IND)) { /* @SWS_CanNm_00149, @SWS_CanNm_00150 */
+      nmSetAlarm(RemoteSleepInd, config->RemoteSleepIndTime);
+    }
+    nmSendMessage(core, context, config, config->MsgCycleTime); /* @SWS_CanNm_00006 */
+    ASLOG(NMCORE, ("%d: Enter Normal Operation Mode, flags %02X\n", config->nmNetworkHandle,
+                   context->flags));
+  } else {
+  }
+
+  if (nmIsAlarmStarted(NMTimeout)) {
+    nmSingalAlarm(NMTimeout);
+    if (context->flags & NMCORE_DISABLE_COMMUNICATION_REQUEST_MASK) {
+      nmCancelAlarm(NMTimeout); /* @SWS_CanNm_00174 */
+    }
+    if (nmIsAlarmTimeout(NMTimeout)) {
+      if (NM_STATE_READY_SLEEP == context->state) {
+        nmCancelAlarm(NMTimeout);
+        nmSetAlarm(WaitBusSleep, config->WaitBusSleepTime);
+        context->state = NM_STATE_PREPARE_BUS_SLEEP;
+        if ((config->ActiveWakeupBitEnabled) && (config->PduCbvPosition < config->PduLength)) {
+          /* @SWS_CanNm_00402 */
+          context->data[config->PduCbvPosition] &= ~NMCORE_CBV_ACTIVE_WAKEUP;
+        }
+        Nm_PrepareBusSleepMode(config->nmNetworkHandle);
+        ASLOG(NMCORE, ("%d: Enter Prepare Bus Sleep Mode, flags %02X\n", config->nmNetworkHandle,
+                       context->flags));
+      } else {
+        nmSetAlarm(NMTimeout, config->NmTimeoutTime);
+      }
+    }
+  } else {
+    if (0 == (context->flags & NMCORE_DISABLE_COMMUNICATION_REQUEST_MASK)) {
+      /* @SWS_CanNm_00178, @SWS_CanNm_00179 */
+      ASLOG(ERROR, ("NM NMTimeout not started\n"));
+      nmSetAlarm(NMTimeout, config->NmTimeoutTime);
+    }
+  }
+}
+
+static void nmNetworkNormalOperationMain(const NmCore_ConfigType *core,
+                                         NmCore_ChannelContextType *context,
+                                         const NmCore_ChannelConfigType *config) {
+  if (nmIsAlarmStarted(TxTimeout)) {
+    nmSingalAlarm(TxTimeout);
+    if (nmIsAlarmTimeout(TxTimeout)) {
+      nmCancelAlarm(TxTimeout);
+      Nm_TxTimeoutException(config->nmNetworkHandle);
+    }
+  }
+
+  if (nmIsAlarmStarted(NMTimeout)) {
+    nmSingalAlarm(NMTimeout);
+    if (nmIsAlarmTimeout(NMTimeout)) {
+      nmSetAlarm(NMTimeout, config->NmTimeoutTime);
+    }
+  } else {
+    nmSetAlarm(NMTimeout, config->NmTimeoutTime);
+  }
+
+  if (context->flags & NMCORE_RX_INDICATION_REQUEST_MASK) {
+    nmEnterCritical();
+    context->flags &= ~NMCORE_RX_INDICATION_REQUEST_MASK;
+    nmExitCritical();
+    if (config->MsgReducedTime > 0) {
+      /* @SWS_CanNm_00069: the bus load reduction */
+      nmSetAlarm(Tx, config->MsgReducedTime);
+    }
+    if (NMCORE_HAS(REMOTE_SLEEP_IND)) {
+      nmSetAlarm(RemoteSleepInd, config->RemoteSleepIndTime);
+      if (context->flags & NMCORE_REMOTE_SLEEP_IND_MASK) {
+        nmEnterCritical();
+        context->flags &= ~NMCORE_REMOTE_SLEEP_IND_MASK;
+        nmExitCritical();
+        /* @SWS_CanNm_00151 */
+        Nm_RemoteSleepCancellation(config->nmNetworkHandle);
+      }
+    }
+  }
+
+  if (nmIsAlarmStarted(Tx)) {
+    nmSingalAlarm(Tx);
+    if (nmIsAlarmTimeout(Tx)) {
+      nmSendMessage(core, context, config, config->MsgCycleTime);
+    }
+  } else {
+    nmSetAlarm(Tx, config->MsgCycleTime);
+  }
+
+  /* @SWS_CanNm_00149, @SWS_CanNm_00150 */
+  if (NMCORE_HAS(REMOTE_SLEEP_IND) && nmIsAlarmStarted(RemoteSleepInd)) {
+    nmSingalAlarm(RemoteSleepInd);
+    if (nmIsAlarmTimeout(RemoteSleepInd)) {
+      nmCancelAlarm(RemoteSleepInd);
+      if (0 == (context->flags & NMCORE_DISABLE_COMMUNICATION_REQUEST_MASK)) {
+        /* @SWS_CanNm_00175 */
+        Nm_RemoteSleepIndication(config->nmNetworkHandle);
+        nmEnterCritical();
+        context->flags |= NMCORE_REMOTE_SLEEP_IND_MASK;
+        nmExitCritical();
+      }
+    }
+  }
+
+  if (context->flags & NMCORE_REPEAT_MESSAGE_REQUEST_MASK) {
+    nmEnterRepeatMessageMode(core, context, config);
+  } else if (0 == (context->flags & NMCORE_REQUEST_MASK)) {
+    context->state = NM_STATE_READY_SLEEP;
+    ASLOG(NMCORE,
+          ("%d: Enter Ready Sleep Mode, flags %02X\n", config->nmNetworkHandle, context->flags));
+  } else {
+  }
+}
+
+/* the PN info of the NM PDU, NULL if the PDU has no PN info */
+static const uint8_t *nmGetPnInfo(const NmCore_ChannelConfigType *config,
+                                  const PduInfoType *PduInfoPtr) {
+  const uint8_t *PnInfo = NULL;
+
+  if ((config->PduCbvPosition < PduInfoPtr->SduLength) &&
+      (PduInfoPtr->SduDataPtr[config->PduCbvPosition] & NMCORE_CBV_PARTIAL_NETWORK_INFORMATION) &&
+      (((uint32_t)config->PnInfoOffset + config->PnInfoLength) <= PduInfoPtr->SduLength)) {
+    PnInfo = &PduInfoPtr->SduDataPtr[config->PnInfoOffset];
+  }
+
+  return PnInfo;
+}
+
+static Std_ReturnType nmRxFilter(NmCore_ChannelContextType *context,
+                                 const NmCore_ChannelConfigType *config, const uint8_t *PnInfo) {
+  Std_ReturnType ret = E_OK;
+  int i;
+  if (context->flags & NMCORE_PN_ENABLED_MASK) {
+    if (NULL == PnInfo) {
+      if (config->AllNmMessagesKeepAwake) { /* @SWS_CanNm_00410 */
+        ret = E_OK;
+      } else {
+        /* @SWS_CanNm_00411 */
+        ret = E_NOT_OK;
+      }
+    } else {
+      /* @SWS_CanNm_00412 */
+      ret = E_NOT_OK;
+      for (i = 0; i < config->PnInfoLength; i++) {
+        /* @SWS_CanNm_00417, @SWS_CanNm_00419 */
+        if (PnInfo[i] & config->PnFilterMaskByte[i]) {
+          ret = E_OK;
+          break;
+        }
+      }
+    }
+  } else {
+    /* @SWS_CanNm_00409 */
+  }
+
+  return ret;
+}
+
+static void nmUserDataMask(const NmCore_ConfigType *core, const NmCore_ChannelConfigType *config,
+                           uint32_t *notUserDataMask) {
+  int i;
+
+  *notUserDataMask = 0;
+  if (config->PduNidPosition < config->PduLength) {
+    *notUserDataMask |= (1u << config->PduNidPosition);
+  }
+  if (config->PduCbvPosition < config->PduLength) {
+    *notUserDataMask |= (1u << config->PduCbvPosition);
+  }
+  if (NMCORE_HAS(GLOBAL_PN) && config->PnEnabled) {
+    for (i = 0; i < config->PnInfoLength; i++) {
+      *notUserDataMask |= (1u << (config->PnInfoOffset + i));
+    }
+  }
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+void NmCore_Init(const NmCore_ConfigType *core) {
+  int i;
+  NmCore_ChannelContextType *context;
+  const NmCore_ChannelConfigType *config;
+
+  for (i = 0; i < core->numOfChannels; i++) {
+    context = &core->ChannelContexts[i];
+    config = &core->ChannelConfigs[i];
+    memset(&context->Alarm, 0, sizeof(context->Alarm));
+    context->state = NM_STATE_BUS_SLEEP; /* @SWS_CanNm_00141 */
+    context->flags = 0;                  /* @SWS_CanNm_00403 */
+    memset(context->rxPdu, 0xFF, sizeof(context->rxPdu));
+    memset(context->data, 0xFF, sizeof(context->data)); /* @SWS_CanNm_00025 */
+    if (config->PduNidPosition < config->PduLength) {
+      context->data[config->PduNidPosition] = config->NodeId; /* @SWS_CanNm_00013 */
+    }
+    if (config->PduCbvPosition < config->PduLength) {
+      context->data[config->PduCbvPosition] = 0x00; /* @SWS_CanNm_00085 */
+      if (NMCORE_HAS(GLOBAL_PN) && config->PnEnabled &&
+          NMCORE_PN_INFO_FITS(config)) { /* @SWS_CanNm_00413 */
+        context->data[config->PduCbvPosition] |= NMCORE_CBV_PARTIAL_NETWORK_INFORMATION;
+        memcpy(&context->data[config->PnInfoOffset], config->PnFilterMaskByte,
+               config->PnInfoLength);
+      }
+    }
+    if (NULL != config->Era) {
+      memset(config->Era->PnInfo, 0, config->PnInfoLength);
+      memset(config->Era->Timers, 0, config->PnInfoLength * 8 * sizeof(uint16_t));
+      config->Era->changed = FALSE;
+    }
+  }
+
+  if (NULL != core->Eira) {
+    memset(core->Eira->PnInfo, 0, core->PnInfoLength);
+    memset(core->Eira->Timers, 0, core->PnInfoLength * 8 * sizeof(uint16_t));
+    core->Eira->changed = FALSE;
+  }
+}
+
+Std_ReturnType NmCore_PassiveStartUp(const NmCore_ConfigType *core,
+                                     NetworkHandleType nmChannelHandle) {
+  Std_ReturnType ret = E_OK;
+  NmCore_ChannelContextType *context;
+
+  if (nmChannelHandle < core->numOfChannels) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    switch ((context->state)) {
+    case NM_STATE_BUS_SLEEP:
+    case NM_STATE_PREPARE_BUS_SLEEP:
+      nmEnterCritical();
+      context->flags |= NMCORE_PASSIVE_STARTUP_REQUEST_MASK;
+      nmExitCritical();
+      break;
+    default:
+      /* @SWS_CanNm_00147 */
+      ret = E_NOT_OK;
+      break;
+    }
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+
+Std_ReturnType NmCore_NetworkRequest(const NmCore_ConfigType *core,
+                                     NetworkHandleType nmChannelHandle) {
+  Std_ReturnType ret = E_OK;
+  NmCore_ChannelContextType *context;
+  const NmCore_ChannelConfigType *config;
+
+  if (nmChannelHandle < core->numOfChannels) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    config = &core->ChannelConfigs[nmChannelHandle];
+    nmEnterCritical();
+    context->flags |= NMCORE_REQUEST_MASK;
+    if ((config->ActiveWakeupBitEnabled) && (config->PduCbvPosition < config->PduLength)) {
+      context->data[config->PduCbvPosition] |= NMCORE_CBV_ACTIVE_WAKEUP; /* @SWS_CanNm_00401 */
+    }
+    if (NMCORE_HAS(GLOBAL_PN) && config->PnEnabled && config->PnHandleMultipleNetworkRequests &&
+        ((NM_STATE_NORMAL_OPERATION == context->state) ||
+         (NM_STATE_READY_SLEEP == context->state) ||
+         (NM_STATE_REPEAT_MESSAGE == context->state))) {
+      /* @SWS_CanNm_00444: enter the repeat message state with the immediate transmissions */
+      context->state = NM_STATE_REPEAT_MESSAGE;
+      context->TxCounter = 0;
+      context->flags &= ~NMCORE_REMOTE_SLEEP_IND_MASK;
+      nmSetAlarm(Tx, 0);
+      nmSetAlarm(RepeatMessage, config->RepeatMessageTime);
+    }
+    nmExitCritical();
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+
+Std_ReturnType NmCore_NetworkRelease(const NmCore_ConfigType *core,
+                                     NetworkHandleType nmChannelHandle) {
+  Std_ReturnType ret = E_OK;
+  NmCore_ChannelContextType *context;
+
+  if (nmChannelHandle < core->numOfChannels) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    nmEnterCritical();
+    context->flags &= ~NMCORE_REQUEST_MASK;
+    nmExitCritical();
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+
+Std_ReturnType NmCore_RepeatMessageRequest(const NmCore_ConfigType *core,
+                                           NetworkHandleType nmChannelHandle) {
+  Std_ReturnType ret = E_OK;
+  NmCore_ChannelContextType *context;
+  const NmCore_ChannelConfigType *config;
+
+  if (nmChannelHandle < core->numOfChannels) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    config = &core->ChannelConfigs[nmChannelHandle];
+    switch (context->state) {
+    case NM_STATE_READY_SLEEP:
+    case NM_STATE_NORMAL_OPERATION:
+      nmEnterCritical();
+      context->flags |= NMCORE_REPEAT_MESSAGE_REQUEST_MASK;
+      /* @SWS_CanNm_00121, @SWS_CanNm_00113 */
+      if (config->NodeDetectionEnabled) {
+        if (config->PduCbvPosition < config->PduLength) {
+          context->data[config->PduCbvPosition] |= NMCORE_CBV_REPEAT_MESSAGE_REQUEST;
+        }
+      }
+      nmExitCritical();
+      break;
+    default:
+      /* @SWS_CanNm_00137 */
+      ret = E_NOT_OK;
+      break;
+    }
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+
+Std_ReturnType NmCore_DisableCommunication(const NmCore_ConfigType *core,
+                                           NetworkHandleType nmChannelHandle) {
+  Std_ReturnType ret = E_OK;
+  NmCore_ChannelContextType *context;
+
+  if (nmChannelHandle < core->numOfChannels) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    /* @SWS_CanNm_00170 */
+    nmEnterCritical();
+    context->flags |= NMCORE_DISABLE_COMMUNICATION_REQUEST_MASK;
+    nmExitCritical();
+    /* could see codes that check NMCORE_DISABLE_COMMUNICATION_REQUEST_MASK in the MainFunction,
+     * That is because that Alarm operation is not atomic, so the codes that added to check
+     * NMCORE_DISABLE_COMMUNICATION_REQUEST_MASK is a workaroud and which is not good but it
+     * satisfied the requirement */
+    nmCancelAlarm(Tx);             /* @SWS_CanNm_00173 */
+    nmCancelAlarm(NMTimeout);      /* @SWS_CanNm_00174 */
+    nmCancelAlarm(RemoteSleepInd); /* @SWS_CanNm_00175 */
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+
+Std_ReturnType NmCore_EnableCommunication(const NmCore_ConfigType *core,
+                                          NetworkHandleType nmChannelHandle) {
+  Std_ReturnType ret = E_OK;
+  NmCore_ChannelContextType *context;
+  const NmCore_ChannelConfigType *config;
+
+  if (nmChannelHandle < core->numOfChannels) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    config = &core->ChannelConfigs[nmChannelHandle];
+    nmEnterCritical();
+    context->flags &= ~NMCORE_DISABLE_COMMUNICATION_REQUEST_MASK;
+    nmExitCritical();
+    nmSetAlarm(Tx, 0);                            /* @SWS_CanNm_00178 */
+    nmSetAlarm(NMTimeout, config->NmTimeoutTime); /* @SWS_CanNm_00179 */
+    if (NMCORE_HAS(REMOTE_SLEEP_IND)) {
+      nmSetAlarm(RemoteSleepInd, config->RemoteSleepIndTime); /* @SWS_CanNm_00180 */
+    }
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+
+void NmCore_TxConfirmation(const NmCore_ConfigType *core, PduIdType TxPduId,
+                           Std_ReturnType result) {
+  NmCore_ChannelContextType *context;
+  const NmCore_ChannelConfigType *config;
+  if (TxPduId < core->numOfChannels) {
+    context = &core->ChannelContexts[TxPduId];
+    config = &core->ChannelConfigs[TxPduId];
+    if (E_OK == result) {
+      if (context->TxCounter < 0xFF) {
+        context->TxCounter++;
+      }
+      nmCancelAlarm(TxTimeout);
+
+      if ((NM_STATE_NORMAL_OPERATION == context->state) ||
+          (NM_STATE_REPEAT_MESSAGE == context->state) || (NM_STATE_READY_SLEEP == context->state)) {
+        nmSetAlarm(NMTimeout, config->NmTimeoutTime);
+      }
+    } else {
+      /* @SWS_CanNm_00066 */
+      Nm_TxTimeoutException(config->nmNetworkHandle);
+    }
+  } else {
+    ASLOG(ERROR, ("NM TxConfirmation with invalid TxPduId %d\n", TxPduId));
+  }
+}
+
+void NmCore_RxIndication(const NmCore_ConfigType *core, PduIdType RxPduId,
+                         const PduInfoType *PduInfoPtr) {
+  NmCore_ChannelContextType *context = NULL;
+  const NmCore_ChannelConfigType *config = NULL;
+  const uint8_t *PnInfo = NULL;
+  uint16_t flags = NMCORE_RX_INDICATION_REQUEST_MASK | NMCORE_NM_PDU_RECEIVED_MASK;
+  PduLengthType length;
+  Std_ReturnType ret = E_NOT_OK;
+  if (RxPduId < core->numOfChannels) {
+    context = &core->ChannelContexts[RxPduId];
+    config = &core->ChannelConfigs[RxPduId];
+    ret = E_OK;
+    if (NMCORE_HAS(GLOBAL_PN) && config->PnEnabled) {
+      PnInfo = nmGetPnInfo(config, PduInfoPtr);
+      ret = nmRxFilter(context, config, PnInfo);
+    }
+  } else {
+    ASLOG(ERROR, ("NM RxIndication with invalid RxPduId %d\n", RxPduId));
+  }
+  if (E_OK == ret) {
+    if (NULL != PnInfo) {
+      /* @SWS_CanNm_00429, @SWS_CanNm_00433 */
+      if (NULL != core->Eira) {
+        nmPnAggregate(core, core->Eira, nmEiraLength(core, config), PnInfo,
+                      config->PnFilterMaskByte);
+      }
+      if (NULL != config->Era) {
+        nmPnAggregate(core, config->Era, config->PnInfoLength, PnInfo, config->PnFilterMaskByte);
+      }
+    }
+    /* @SWS_CanNm_00035 */
+    length = PduInfoPtr->SduLength;
+    if (length > config->PduLength) {
+      length = config->PduLength;
+    }
+    memcpy(context->rxPdu, PduInfoPtr->SduDataPtr, length);
+    if (config->PduCbvPosition < length) {
+      if (context->rxPdu[config->PduCbvPosition] & NMCORE_CBV_REPEAT_MESSAGE_REQUEST) {
+        if (config->NodeDetectionEnabled) {
+          /* @SWS_CanNm_00119, @SWS_CanNm_00111 */
+          if ((NM_STATE_NORMAL_OPERATION == context->state) ||
+              (NM_STATE_READY_SLEEP == context->state)) {
+            flags |= NMCORE_REPEAT_MESSAGE_REQUEST_MASK;
+          }
+        }
+        /* @SWS_CanNm_00014 */
+        if (config->RepeatMsgIndEnabled && config->NodeDetectionEnabled) {
+          Nm_RepeatMessageIndication(config->nmNetworkHandle);
+        }
+      }
+      if (NMCORE_HAS(COORDINATOR_SYNC) && ((NM_STATE_NORMAL_OPERATION == context->state) ||
+                                           (NM_STATE_REPEAT_MESSAGE == context->state) ||
+                                           (NM_STATE_READY_SLEEP == context->state))) {
+        if (context->rxPdu[config->PduCbvPosition] & NMCORE_CBV_NM_COORDINATOR_SLEEP) {
+          /* @SWS_CanNm_00341 */
+          if (0 == (context->flags & NMCORE_COORDINATOR_SLEEP_SYNC_MASK)) {
+            flags |= NMCORE_COORDINATOR_SLEEP_SYNC_MASK;
+            Nm_CoordReadyToSleepIndication(config->nmNetworkHandle);
+          }
+        } else if (context->flags & NMCORE_COORDINATOR_SLEEP_SYNC_MASK) {
+          /* @SWS_CanNm_00348 */
+          Nm_CoordReadyToSleepCancellation(config->nmNetworkHandle);
+          nmEnterCritical();
+          context->flags &= ~NMCORE_COORDINATOR_SLEEP_SYNC_MASK;
+          nmExitCritical();
+        }
+      }
+    }
+    if ((NM_STATE_NORMAL_OPERATION == context->state) ||
+        (NM_STATE_REPEAT_MESSAGE == context->state) || (NM_STATE_READY_SLEEP == context->state)) {
+      nmSetAlarm(NMTimeout, config->NmTimeoutTime);
+    }
+    nmEnterCritical();
+    context->flags |= flags;
+    nmExitCritical();
+  }
+}
+
+Std_ReturnType NmCore_GetLocalNodeIdentifier(const NmCore_ConfigType *core,
+                                             NetworkHandleType nmChannelHandle,
+                                             uint8_t *nmNodeIdPtr) {
+  Std_ReturnType ret = E_OK;
+  const NmCore_ChannelConfigType *config;
+
+  if ((nmChannelHandle < core->numOfChannels) && (NULL != nmNodeIdPtr)) {
+    config = &core->ChannelConfigs[nmChannelHandle];
+    *nmNodeIdPtr = config->NodeId;
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+
+Std_ReturnType NmCore_GetNodeIdentifier(const NmCore_ConfigType *core,
+                                        NetworkHandleType nmChannelHandle, uint8_t *nmNodeIdPtr) {
+  Std_ReturnType ret = E_OK;
+  NmCore_ChannelContextType *context;
+  const NmCore_ChannelConfigType *config;
+  uint8_t nodeId = NMCORE_INVALID_NODE_ID;
+
+  if ((nmChannelHandle < core->numOfChannels) && (NULL != nmNodeIdPtr)) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    config = &core->ChannelConfigs[nmChannelHandle];
+    /* @SWS_CanNm_00132 */
+    if (config->PduNidPosition < config->PduLength) {
+      nodeId = context->rxPdu[config->PduNidPosition];
+    }
+    if (NMCORE_INVALID_NODE_ID == nodeId) {
+      ret = E_NOT_OK;
+    } else {
+      *nmNodeIdPtr = nodeId;
+    }
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+
+Std_ReturnType NmCore_SetUserData(const NmCore_ConfigType *core,
+                                  NetworkHandleType nmChannelHandle, const uint8_t *nmUserDataPtr) {
+  Std_ReturnType ret = E_OK;
+  NmCore_ChannelContextType *context;
+  const NmCore_ChannelConfigType *config;
+  uint32_t notUserDataMask;
+  int i, j = 0;
+
+  if ((nmChannelHandle < core->numOfChannels) && (NULL != nmUserDataPtr)) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    config = &core->ChannelConfigs[nmChannelHandle];
+    nmUserDataMask(core, config, &notUserDataMask);
+    for (i = 0; i < config->PduLength; i++) {
+      if (0 == (notUserDataMask & (1u << i))) {
+        context->data[i] = nmUserDataPtr[j];
+        j++;
+      }
+    }
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+
+Std_ReturnType NmCore_GetUserData(const NmCore_ConfigType *core,
+                                  NetworkHandleType nmChannelHandle, uint8_t *nmUserDataPtr) {
+  Std_ReturnType ret = E_OK;
+  NmCore_ChannelContextType *context;
+  const NmCore_ChannelConfigType *config;
+  uint32_t notUserDataMask;
+  int i, j = 0;
+
+  if ((nmChannelHandle < core->numOfChannels) && (NULL != nmUserDataPtr)) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    config = &core->ChannelConfigs[nmChannelHandle];
+    nmUserDataMask(core, config, &notUserDataMask);
+    for (i = 0; i < config->PduLength; i++) {
+      if (0 == (notUserDataMask & (1u << i))) {
+        nmUserDataPtr[j] = context->data[i];
+        j++;
+      }
+    }
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+
+Std_ReturnType NmCore_SetPnInfo(const NmCore_ConfigType *core, NetworkHandleType nmChannelHandle,
+                                const uint8_t *PnInfo) {
+  Std_ReturnType ret = E_NOT_OK;
+  NmCore_ChannelContextType *context;
+  const NmCore_ChannelConfigType *config;
+
+  if ((nmChannelHandle < core->numOfChannels) && (NULL != PnInfo) && NMCORE_HAS(GLOBAL_PN)) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    config = &core->ChannelConfigs[nmChannelHandle];
+    if (config->PnEnabled && NMCORE_PN_INFO_FITS(config)) {
+      nmEnterCritical();
+      memcpy(&context->data[config->PnInfoOffset], PnInfo, config->PnInfoLength);
+      nmExitCritical();
+      ret = E_OK;
+    }
+  }
+
+  return ret;
+}
+
+Std_ReturnType NmCore_GetPduData(const NmCore_ConfigType *core,
+                                 NetworkHandleType nmChannelHandle, uint8_t *nmPduDataPtr) {
+  Std_ReturnType ret = E_OK;
+  NmCore_ChannelContextType *context;
+  const NmCore_ChannelConfigType *config;
+
+  if ((nmChannelHandle < core->numOfChannels) && (NULL != nmPduDataPtr)) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    config = &core->ChannelConfigs[nmChannelHandle];
+    if (context->flags & NMCORE_NM_PDU_RECEIVED_MASK) {
+      memcpy(nmPduDataPtr, &context->rxPdu, config->PduLength);
+    } else {
+      ret = E_NOT_OK;
+    }
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+
+Std_ReturnType NmCore_GetState(const NmCore_ConfigType *core, NetworkHandleType nmChannelHandle,
+                               Nm_StateType *nmStatePtr, Nm_ModeType *nmModePtr) {
+  Std_ReturnType ret = E_OK;
+  NmCore_ChannelContextType *context;
+
+  if ((nmChannelHandle < core->numOfChannels) && (NULL != nmStatePtr) && (NULL != nmModePtr)) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    *nmStatePtr = context->state;
+    switch (context->state) {
+    case NM_STATE_BUS_SLEEP:
+      *nmModePtr = NM_MODE_BUS_SLEEP;
+      break;
+    case NM_STATE_PREPARE_BUS_SLEEP:
+      *nmModePtr = NM_MODE_PREPARE_BUS_SLEEP;
+      break;
+    default:
+      *nmModePtr = NM_MODE_NETWORK;
+      break;
+    }
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+
+void NmCore_ConfirmPnAvailability(const NmCore_ConfigType *core,
+                                  NetworkHandleType nmChannelHandle) {
+  NmCore_ChannelContextType *context;
+  const NmCore_ChannelConfigType *config;
+  if (nmChannelHandle < core->numOfChannels) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    config = &core->ChannelConfigs[nmChannelHandle];
+    if (NMCORE_HAS(GLOBAL_PN) && config->PnEnabled) {
+      ASLOG(NMCORE, ("%d: confirm PN, flags %X\n", nmChannelHandle, context->flags));
+      /* @SWS_CanNm_00404 */
+      nmEnterCritical();
+      context->flags |= NMCORE_PN_ENABLED_MASK;
+      nmExitCritical();
+    }
+  }
+}
+
+Std_ReturnType NmCore_SetSleepReadyBit(const NmCore_ConfigType *core,
+                                       NetworkHandleType nmChannelHandle, boolean nmSleepReadyBit) {
+  Std_ReturnType ret = E_OK;
+  NmCore_ChannelContextType *context;
+  const NmCore_ChannelConfigType *config;
+
+  if (nmChannelHandle < core->numOfChannels) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    config = &core->ChannelConfigs[nmChannelHandle];
+    nmEnterCritical();
+    if (config->PduCbvPosition < config->PduLength) {
+      /* @SWS_CanNm_00342 */
+      if (nmSleepReadyBit) {
+        context->data[config->PduCbvPosition] |= NMCORE_CBV_NM_COORDINATOR_SLEEP;
+      } else {
+        context->data[config->PduCbvPosition] &= ~NMCORE_CBV_NM_COORDINATOR_SLEEP;
+      }
+    } else {
+      ret = E_NOT_OK;
+    }
+    nmExitCritical();
+    if (E_OK == ret) {
+      nmSendMessage(core, context, config, 0);
+    }
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+
+Std_ReturnType NmCore_CheckRemoteSleepIndication(const NmCore_ConfigType *core,
+                                                 NetworkHandleType nmChannelHandle,
+                                                 boolean *nmRemoteSleepIndPtr) {
+  Std_ReturnType ret = E_OK;
+  NmCore_ChannelContextType *context;
+
+  if ((nmChannelHandle < core->numOfChannels) && (nmRemoteSleepIndPtr)) {
+    context = &core->ChannelContexts[nmChannelHandle];
+    switch (context->state) {
+    case NM_STATE_NORMAL_OPERATION:
+      if (context->flags & NMCORE_REMOTE_SLEEP_IND_MASK) {
+        *nmRemoteSleepIndPtr = TRUE;
+      } else {
+        *nmRemoteSleepIndPtr = FALSE;
+      }
+      break;
+    default:
+      /* @SWS_CanNm_00154 */
+      ret = E_NOT_OK;
+      break;
+    }
+  } else {
+    ret = E_NOT_OK;
+  }
+
+  return ret;
+}
+
+void NmCore_MainFunction(const NmCore_ConfigType *core) {
+  int i;
+  NmCore_ChannelContextType *context;
+  const NmCore_ChannelConfigType *config;
+
+  for (i = 0; i < core->numOfChannels; i++) {
+    context = &core->ChannelContexts[i];
+    config = &core->ChannelConfigs[i];
+    switch (context->state) {
+    case NM_STATE_BUS_SLEEP:
+      nmBusSleepMain(core, context, config);
+      break;
+    case NM_STATE_PREPARE_BUS_SLEEP:
+      nmPrepareBusSleepMain(core, context, config);
+      break;
+    case NM_STATE_READY_SLEEP:
+      nmReadySleepMain(core, context, config);
+      break;
+    case NM_STATE_REPEAT_MESSAGE:
+      nmRepeatMessageMain(core, context, config);
+      break;
+    case NM_STATE_NORMAL_OPERATION:
+      nmNetworkNormalOperationMain(core, context, config);
+      break;
+    default:
+      break;
+    }
+
+    if (NULL != config->Era) {
+      nmPnAggregationMain(config->Era, config->PnInfoLength);
+      if (config->Era->changed) {
+        config->Era->changed = FALSE;
+        if (NULL != core->EraIndication) {
+          /* @SWS_CanNm_00434 */
+          core->EraIndication(config->nmNetworkHandle, config->Era->PnInfo, config->PnInfoLength);
+        }
+      }
+    }
+  }
+
+  if (NULL != core->Eira) {
+    nmPnAggregationMain(core->Eira, core->PnInfoLength);
+    if (core->Eira->changed) {
+      core->Eira->changed = FALSE;
+      if (NULL != core->EiraIndication) {
+        /* @SWS_CanNm_00435 */
+        core->EiraIndication(core->Eira->PnInfo, core->PnInfoLength);
+      }
+    }
+  }
+}
@@ -0,0 +1,180 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ * The state machine shared by CanNm and UdpNm, each API takes the config of the NM module, so that
+ * the bus specific part of CanNm and UdpNm is only the transmit and the API names.
+ *
+ * ref:
+ * https://www.autosar.org/fileadmin/user_upload/standards/classic/4-3/AUTOSAR_SWS_CANNetworkManagement.pdf
+ * Specification of UDP Network Management AUTOSAR CP Release 4.4.0
+ */
+#ifndef _NM_CORE_H
+#define _NM_CORE_H
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "ComStack_Types.h"
+#include "NmStack_Types.h"
+#include "Std_Timer.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define NMCORE_PDU_BYTE_0 ((NmCore_PduPositionType)0)
+#define NMCORE_PDU_BYTE_1 ((NmCore_PduPositionType)1)
+#define NMCORE_PDU_OFF ((NmCore_PduPositionType)0xFF)
+
+#define NMCORE_INVALID_NODE_ID 0xFF
+
+#ifndef NMCORE_PDU_LENGTH_MAX
+#define NMCORE_PDU_LENGTH_MAX 8
+#endif
+
+/* the optional features of a NM module, for all of its channels */
+#define NMCORE_FEATURE_REMOTE_SLEEP_IND 0x01
+#define NMCORE_FEATURE_COORDINATOR_SYNC 0x02
+#define NMCORE_FEATURE_GLOBAL_PN 0x04
+
+/* the PN info and its reset timers, the PN info is the 1 bit of each PN that was requested within
+ * the last PnResetTime */
+#define NMCORE_PN_AGGREGATION_DEF(name, length)                                                    \
+  static uint8_t name##PnInfo[length];                                                             \
+  static uint16_t name##Timers[(length)*8];                                                        \
+  static NmCore_PnAggregationType name = {name##PnInfo, name##Timers, FALSE}
+/* ================================ [ TYPES     ] ============================================== */
+typedef uint8_t NmCore_PduPositionType;
+
+#ifdef _WIN32
+typedef Std_TimerType NmCore_TimerType;
+#else
+typedef uint16_t NmCore_TimerType;
+#endif
+
+typedef Std_ReturnType (*NmCore_TransmitFncType)(PduIdType TxPduId, const PduInfoType *PduInfoPtr);
+
+/* EIRA: the PNs requested by this ECU or any other ECU on any channel of the NM module */
+typedef void (*NmCore_EiraIndicationFncType)(const uint8_t *PnInfo, uint8_t PnInfoLength);
+
+/* ERA: the PNs requested by the other ECUs on the channel, for the gateway */
+typedef void (*NmCore_EraIndicationFncType)(NetworkHandleType nmNetworkHandle,
+                                            const uint8_t *PnInfo, uint8_t PnInfoLength);
+
+typedef struct {
+  uint8_t *PnInfo;
+  uint16_t *Timers; /* in main function cycles, 0 when the PN is not requested */
+  boolean changed;  /* to be indicated by the main function */
+} NmCore_PnAggregationType;
+
+typedef struct {
+  uint16_t ImmediateNmCycleTime;
+  uint16_t MsgCycleOffset;
+  uint16_t MsgCycleTime;
+  /* the bus load reduction, 0 to disable. In the normal operation each NM PDU received reloads the
+   * Tx timer with it, so with a different one of each node, which is between the half of the
+   * MsgCycleTime and the MsgCycleTime, only the 2 nodes of the smallest ones keep sending */
+  uint16_t MsgReducedTime;
+  uint16_t MsgTimeoutTime;
+  /* dependency: RepeatMessageTime = n * MsgCycleTime;
+   * RepeatMessageTime > ImmediateNmTransmissions * ImmediateNmCycleTime */
+  uint16_t RepeatMessageTime;
+  uint16_t NmTimeoutTime;
+  uint16_t WaitBusSleepTime;
+  uint16_t RemoteSleepIndTime; /* with NMCORE_FEATURE_REMOTE_SLEEP_IND */
+  PduIdType TxPdu;
+  uint8_t NodeId;
+  NetworkHandleType nmNetworkHandle;
+  uint8_t ImmediateNmTransmissions;
+  uint8_t PduLength; /* up to NMCORE_PDU_LENGTH_MAX */
+  NmCore_PduPositionType PduCbvPosition;
+  NmCore_PduPositionType PduNidPosition;
+  boolean ActiveWakeupBitEnabled;
+  boolean PassiveModeEnabled;
+  boolean RepeatMsgIndEnabled;
+  boolean NodeDetectionEnabled;
+  /* below with NMCORE_FEATURE_GLOBAL_PN */
+  boolean PnEnabled;
+  boolean AllNmMessagesKeepAwake;
+  /* a network request in the network mode goes to the repeat message state, so that the PNs
+   * newly requested are sent at once by the immediate transmissions */
+  boolean PnHandleMultipleNetworkRequests;
+  uint8_t PnInfoOffset;
+  uint8_t PnInfoLength;
+  const uint8_t *PnFilterMaskByte;
+  NmCore_PnAggregationType *Era; /* NULL if the ERA of the channel is not calculated */
+} NmCore_ChannelConfigType;
+
+typedef struct {
+  struct {
+    NmCore_TimerType _Tx;
+    NmCore_TimerType _TxTimeout;
+    NmCore_TimerType _NMTimeout;
+    union {
+      NmCore_TimerType _RepeatMessage;
+      NmCore_TimerType _WaitBusSleep;
+    };
+    NmCore_TimerType _RemoteSleepInd;
+  } Alarm;
+  uint16_t flags;
+  Nm_StateType state;
+  uint8_t TxCounter;
+  uint8_t data[NMCORE_PDU_LENGTH_MAX];
+  uint8_t rxPdu[NMCORE_PDU_LENGTH_MAX];
+} NmCore_ChannelContextType;
+
+typedef struct {
+  const NmCore_ChannelConfigType *ChannelConfigs;
+  NmCore_ChannelContextType *ChannelContexts;
+  uint8_t numOfChannels;
+  uint8_t features;
+  uint16_t MainFunctionPeriod; /* ms */
+  NmCore_TransmitFncType Transmit;
+  /* the time a PN stays in the EIRA and ERA after the last NM PDU requesting it, in main function
+   * cycles, which shall be longer than the MsgCycleTime */
+  uint16_t PnResetTime;
+  uint8_t PnInfoLength;          /* of the EIRA */
+  NmCore_PnAggregationType *Eira; /* NULL if the EIRA is not calculated */
+  NmCore_EiraIndicationFncType EiraIndication;
+  NmCore_EraIndicationFncType EraIndication;
+} NmCore_ConfigType;
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+void NmCore_Init(const NmCore_ConfigType *core);
+Std_ReturnType NmCore_PassiveStartUp(const NmCore_ConfigType *core,
+                                     NetworkHandleType nmChannelHandle);
+Std_ReturnType NmCore_NetworkRequest(const NmCore_ConfigType *core,
+                                     NetworkHandleType nmChannelHandle);
+Std_ReturnType NmCore_NetworkRelease(const NmCore_ConfigType *core,
+                                     NetworkHandleType nmChannelHandle);
+Std_ReturnType NmCore_RepeatMessageRequest(const NmCore_ConfigType *core,
+                                           NetworkHandleType nmChannelHandle);
+Std_ReturnType NmCore_DisableCommunication(const NmCore_ConfigType *core,
+                                           NetworkHandleType nmChannelHandle);
+Std_ReturnType NmCore_EnableCommunication(const NmCore_ConfigType *core,
+                                          NetworkHandleType nmChannelHandle);
+void NmCore_TxConfirmation(const NmCore_ConfigType *core, PduIdType TxPduId,
+                           Std_ReturnType result);
+void NmCore_RxIndication(const NmCore_ConfigType *core, PduIdType RxPduId,
+                         const PduInfoType *PduInfoPtr);
+Std_ReturnType NmCore_GetLocalNodeIdentifier(const NmCore_ConfigType *core,
+                                             NetworkHandleType nmChannelHandle,
+                                             uint8_t *nmNodeIdPtr);
+Std_ReturnType NmCore_GetNodeIdentifier(const NmCore_ConfigType *core,
+                                        NetworkHandleType nmChannelHandle, uint8_t *nmNodeIdPtr);
+Std_ReturnType NmCore_SetUserData(const NmCore_ConfigType *core,
+                                  NetworkHandleType nmChannelHandle, const uint8_t *nmUserDataPtr);
+Std_ReturnType NmCore_GetUserData(const NmCore_ConfigType *core,
+                                  NetworkHandleType nmChannelHandle, uint8_t *nmUserDataPtr);
+/* the PNs requested by this ECU, PnInfoLength bytes, which is the PN filter mask after the init */
+Std_ReturnType NmCore_SetPnInfo(const NmCore_ConfigType *core, NetworkHandleType nmChannelHandle,
+                                const uint8_t *PnInfo);
+Std_ReturnType NmCore_GetPduData(const NmCore_ConfigType *core,
+                                 NetworkHandleType nmChannelHandle, uint8_t *nmPduDataPtr);
+Std_ReturnType NmCore_GetState(const NmCore_ConfigType *core, NetworkHandleType nmChannelHandle,
+                               Nm_StateType *nmStatePtr, Nm_ModeType *nmModePtr);
+void NmCore_ConfirmPnAvailability(const NmCore_ConfigType *core,
+                                  NetworkHandleType nmChannelHandle);
+Std_ReturnType NmCore_SetSleepReadyBit(const NmCore_ConfigType *core,
+                                       NetworkHandleType nmChannelHandle, boolean nmSleepReadyBit);
+Std_ReturnType NmCore_CheckRemoteSleepIndication(const NmCore_ConfigType *core,
+                                                 NetworkHandleType nmChannelHandle,
+                                                 boolean *nmRemoteSleepIndPtr);
+void NmCore_MainFunction(const NmCore_ConfigType *core);
+#endif /* _NM_CORE_H */
@@ -18,6 +18,7 @@
 #define IS_CON_TYPE_OF(con, mask) (0 != ((con)->SoConType & (mask)))
 
 #define SOAD_TX_ON_GOING 0x01
+#define SOAD_RX_READY 0x02
 
 #define SOAD_CONFIG (soAdConfigPtr)
 /* ================================ [ TYPES     ] ============================================== */
@@ -80,6 +81,60 @@ static void soAdCreateSocket(SoAd_SoConIdType SoConId) {
   }
 }
 
+static uint32_t soAdGetU32(const uint8_t *data) {
+  return ((uint32_t)data[0] << 24) + ((uint32_t)data[1] << 16) + ((uint32_t)data[2] << 8) +
+         (uint32_t)data[3];
+}
+
+static void soAdSetU32(uint8_t *data, uint32_t u32) {
+  data[0] = (uint8_t)(u32 >> 24);
+  data[1] = (uint8_t)(u32 >> 16);
+  data[2] = (uint8_t)(u32 >> 8);
+  data[3] = (uint8_t)u32;
+}
+
+/* split the datagram by the PDU headers, the PDU with an unknown id is dropped and a truncated one
+ * drops the rest of the datagram */
+static void soAdSocketPduHeaderRxNotify(SoAd_SocketContextType *context,
+                                       const SoAd_SocketConnectionGroupType *conG, uint8_t *data,
+                                       uint16_t rxLen) {
+  const SoAd_IfInterfaceType *IF = (const SoAd_IfInterfaceType *)conG->Interface;
+  const SoAd_PduHeaderType *header = conG->PduHeader;
+  PduInfoType PduInfo;
+  uint32_t offset = 0;
+  uint32_t id;
+  uint32_t len;
+  uint16_t i;
+
+  PduInfo.MetaDataPtr = (uint8_t *)&context->RemoteAddr;
+  while ((offset + SOAD_PDU_HEADER_SIZE) <= rxLen) {
+    id = soAdGetU32(&data[offset]);
+    len = soAdGetU32(&data[offset + 4]);
+    offset += SOAD_PDU_HEADER_SIZE;
+    if (len > (rxLen - offset)) {
+      ASLOG(SOADE, ("PDU %X length %u is over the datagram\n", id, len));
+      break;
+    }
+
+    for (i = 0; i < header->numOfRxRoutes; i++) {
+      if (header->RxRoutes[i].HeaderId == id) {
+        break;
+      }
+    }
+
+    if (i < header->numOfRxRoutes) {
+      if (IF->IfRxIndication) {
+        PduInfo.SduDataPtr = &data[offset];
+        PduInfo.SduLength = (PduLengthType)len;
+        IF->IfRxIndication(header->RxRoutes[i].RxPduId, &PduInfo);
+      }
+    } else {
+      ASLOG(SOAD, ("PDU %X is unknown\n", id));
+    }
+    offset += len;
+  }
+}
+
 static void soAdSocketIfRxNotify(SoAd_SocketContextType *context,
                                  const SoAd_SocketConnectionType *connection, uint8_t *data,
                                  uint16_t rxLen) {
@@ -90,8 +145,12 @@ static void soAdSocketIfRxNotify(SoAd_SocketContextType *context,
   PduInfo.SduLength = rxLen;
   PduInfo.MetaDataPtr = (uint8_t *)&context->RemoteAddr;
 
-  if (IF->IfRxIndication) {
+  if (NULL != conG->PduHeader) {
+    soAdSocketPduHeaderRxNotify(context, conG, data, rxLen);
+  } else if (IF->IfRxIndication) {
     IF->IfRxIndication(connection->RxPduId, &PduInfo);
+  } else {
+    /* do nothing */
   }
 }
 
@@ -111,6 +170,45 @@ static void soAdSocketTpRxNotify(SoAd_SocketContextType *context,
   }
 }
 
+/* read a batch of datagrams into the preallocated ring, E_OK if the ring was filled up as there
+ * may be more pending */
+static Std_ReturnType soAdSocketUdpRingMain(SoAd_SoConIdType SoConId) {
+  const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
+  const SoAd_SocketConnectionGroupType *conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
+  SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
+  SoAd_RxRingType *ring = context->rxRing;
+  uint32_t count = SOAD_RX_RING_SIZE;
+  Std_ReturnType ret;
+  uint32_t i;
+
+  for (i = 0; i < SOAD_RX_RING_SIZE; i++) {
+    ring->msgs[i].BufPtr = ring->data[i];
+    ring->msgs[i].Length = SOAD_RX_SLOT_SIZE;
+  }
+
+  ret = TcpIp_RecvFromMulti(context->sock, ring->msgs, &count);
+  if (E_OK == ret) {
+    for (i = 0; (i < count) && (SOAD_SOCKET_READY == context->state); i++) {
+      if (ring->msgs[i].Length > 0) {
+        ASLOG(SOAD, ("[%d] UDP read %d bytes\n", SoConId, ring->msgs[i].Length));
+        context->RemoteAddr = ring->msgs[i].RemoteAddr;
+        if (conG->IsTP) {
+          soAdSocketTpRxNotify(context, connection, ring->data[i], ring->msgs[i].Length);
+        } else {
+          soAdSocketIfRxNotify(context, connection, ring->data[i], ring->msgs[i].Length);
+        }
+      }
+    }
+    if ((count < SOAD_RX_RING_SIZE) || (SOAD_SOCKET_READY != context->state)) {
+      ret = E_NOT_OK;
+    }
+  } else {
+    ASLOG(SOADE, ("[%d] UDP read failed\n", SoConId));
+  }
+
+  return ret;
+}
+
 static Std_ReturnType soAdSocketUdpReadyMain(SoAd_SoConIdType SoConId, uint8_t *dataIn,
                                              uint32_t length) {
   const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
@@ -266,6 +364,143 @@ static void soAdSocketAcceptMain(SoAd_SoConIdType SoConId) {
   }
 }
 
+static void soAdCountError(SoAd_SoConIdType SoConId, Std_ReturnType ret) {
+#if SOAD_ERROR_COUNTER_LIMIT > 0
+  SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
+
+  if (E_OK != ret) {
+    context->errorCounter++;
+    if (context->errorCounter >= SOAD_ERROR_COUNTER_LIMIT) {
+      SoAd_CloseSoCon(SoConId, TRUE);
+    }
+  }
+#else
+  (void)SoConId;
+  (void)ret;
+#endif
+}
+
+/* send the packed PDUs by one datagram */
+static Std_ReturnType soAdPduHeaderFlush(SoAd_SoConIdType SoConId,
+                                         const TcpIp_SockAddrType *RemoteAddr) {
+  const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
+  const SoAd_SocketConnectionGroupType *conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
+  SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
+  TcpIp_SockAddrType addr;
+  Std_ReturnType ret = E_OK;
+  uint16_t i;
+
+  if (context->txLen > 0) {
+    if (NULL == RemoteAddr) {
+      TcpIp_SetupAddrFrom(&addr, conG->Remote, conG->Port);
+      RemoteAddr = &addr;
+    }
+    ret = TcpIp_SendTo(context->sock, RemoteAddr, conG->PduHeader->TxBuffer, context->txLen);
+    ASLOG(SOAD, ("[%d] send %d bytes of PDUs\n", SoConId, context->txLen));
+    context->txLen = 0;
+    /* the packed PDUs share the result of this datagram */
+    for (i = context->txDone; i < context->txNum; i++) {
+      conG->PduHeader->TxPdus[i].result = ret;
+    }
+    context->txDone = context->txNum;
+    if (context->txDone > 0) {
+      context->flag |= SOAD_TX_ON_GOING;
+    }
+    soAdCountError(SoConId, ret);
+  }
+
+  return ret;
+}
+
+/* pack the PDU with its header into the TxBuffer, a PDU to a specific remote is not packed with
+ * the others but sent right away */
+static Std_ReturnType soAdPduHeaderTransmit(SoAd_SoConIdType SoConId, PduIdType TxPduId,
+                                            const PduInfoType *PduInfoPtr) {
+  const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
+  const SoAd_SocketConnectionGroupType *conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
+  const SoAd_IfInterfaceType *ifIF = (const SoAd_IfInterfaceType *)conG->Interface;
+  const SoAd_PduHeaderType *header = conG->PduHeader;
+  SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
+  uint32_t HeaderId = SOAD_CONFIG->TxPduHeaderIds[TxPduId];
+  uint32_t size = SOAD_PDU_HEADER_SIZE + PduInfoPtr->SduLength;
+  Std_ReturnType ret = E_OK;
+
+  if (size > header->TxBufferSize) {
+    ASLOG(SOADE, ("[%d] PDU %X is too big: %d\n", SoConId, HeaderId, PduInfoPtr->SduLength));
+    ret = E_NOT_OK;
+  } else if ((NULL != ifIF->IfTxConfirmation) && (context->txNum >= header->numOfTxPdus)) {
+    ASLOG(SOADE, ("[%d] PDU %X: too many PDUs to be confirmed\n", SoConId, HeaderId));
+    ret = E_NOT_OK;
+  } else if ((NULL != PduInfoPtr->MetaDataPtr) || ((context->txLen + size) > header->TxBufferSize)) {
+    ret = soAdPduHeaderFlush(SoConId, NULL);
+  } else {
+    /* pack it */
+  }
+
+  if (E_OK == ret) {
+    if (0 == context->txLen) {
+      context->txTimer = header->TxTimeout;
+    }
+    soAdSetU32(&header->TxBuffer[context->txLen], HeaderId);
+    soAdSetU32(&header->TxBuffer[context->txLen + 4], PduInfoPtr->SduLength);
+    memcpy(&header->TxBuffer[context->txLen + SOAD_PDU_HEADER_SIZE], PduInfoPtr->SduDataPtr,
+           PduInfoPtr->SduLength);
+    context->txLen += (uint16_t)size;
+    if (NULL != ifIF->IfTxConfirmation) {
+      header->TxPdus[context->txNum].TxPduId = TxPduId;
+      header->TxPdus[context->txNum].result = E_OK;
+      context->txNum++;
+    }
+    if (NULL != PduInfoPtr->MetaDataPtr) {
+      ret = soAdPduHeaderFlush(SoConId, (const TcpIp_SockAddrType *)PduInfoPtr->MetaDataPtr);
+    } else if ((0 == header->TxTimeout) ||
+               ((context->txLen + SOAD_PDU_HEADER_SIZE) >= header->TxBufferSize)) {
+      ret = soAdPduHeaderFlush(SoConId, NULL);
+    } else {
+      /* wait for more */
+    }
+  }
+
+  return ret;
+}
+
+static void soAdPduHeaderMain(SoAd_SoConIdType SoConId) {
+  SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
+
+  if (context->txLen > 0) {
+    if (context->txTimer > 0) {
+      context->txTimer--;
+    }
+    if (0 == context->txTimer) {
+      (void)soAdPduHeaderFlush(SoConId, NULL);
+    }
+  }
+}
+
+/* confirm each sent PDU, the upper layer may pack new PDUs in its confirmation */
+static void soAdPduHeaderConfirm(SoAd_SoConIdType SoConId) {
+  const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
+  const SoAd_SocketConnectionGroupType *conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
+  const SoAd_IfInterfaceType *ifIF = (const SoAd_IfInterfaceType *)conG->Interface;
+  SoAd_PduHeaderTxType *TxPdus = conG->PduHeader->TxPdus;
+  SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
+  uint16_t done = context->txDone;
+  uint16_t i;
+
+  for (i = 0; i < done; i++) {
+    ifIF->IfTxConfirmation(TxPdus[i].TxPduId, TxPdus[i].result);
+  }
+
+  for (i = done; i < context->txNum; i++) {
+    TxPdus[i - done] = TxPdus[i];
+  }
+  context->txNum -= done;
+  context->txDone -= done;
+  if (0 == context->txDone) {
+    context->flag &= ~SOAD_TX_ON_GOING;
+  }
+}
+
 static void soAdSocketReadyMain(SoAd_SoConIdType SoConId) {
   const SoAd_SocketConnectionType *connection = &SOAD_CONFIG->Connections[SoConId];
   const SoAd_SocketConnectionGroupType *conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
@@ -274,7 +509,9 @@ static void soAdSocketReadyMain(SoAd_SoConIdType SoConId) {
   SoAd_SocketContextType *context = &SOAD_CONFIG->Contexts[SoConId];
   Std_ReturnType ret = E_OK;
 
-  if (context->flag & SOAD_TX_ON_GOING) {
+  if ((context->flag & SOAD_TX_ON_GOING) && (NULL != conG->PduHeader)) {
+    soAdPduHeaderConfirm(SoConId);
+  } else if (context->flag & SOAD_TX_ON_GOING) {
     if (conG->IsTP) {
       if (tpIF->TpTxConfirmation) {
         tpIF->TpTxConfirmation(connection->RxPduId, E_OK);
@@ -287,17 +524,73 @@ static void soAdSocketReadyMain(SoAd_SoConIdType SoConId) {
     context->flag &= ~SOAD_TX_ON_GOING;
   }
 
+  if (NULL != conG->PduHeader) {
+    soAdPduHeaderMain(SoConId);
+  }
+
+  if ((TCPIP_IPPROTO_UDP == conG->ProtocolType) && (SOAD_SOCKET_READY == context->state)) {
+    if (0 == (context->flag & SOAD_RX_READY)) {
+      ret = E_NOT_OK; /* nothing pending */
+    }
+    context->flag &= ~SOAD_RX_READY;
+  }
+
   while (E_OK == ret) {
     if (TCPIP_IPPROTO_TCP == conG->ProtocolType) {
       ret = soAdSocketTcpReadyMain(SoConId, NULL, 0);
+    } else if (NULL != context->rxRing) {
+      ret = soAdSocketUdpRingMain(SoConId);
     } else {
       ret = soAdSocketUdpReadyMain(SoConId, NULL, 0);
     }
   }
 }
+
+static void soAdSelectFlush(const TcpIp_SocketIdType *socks, const SoAd_SoConIdType *ids,
+                            uint32_t num) {
+  boolean ready[SOAD_SELECT_MAX];
+  uint32_t i;
+
+  (void)TcpIp_Select(socks, ready, num, 0);
+  for (i = 0; i < num; i++) {
+    if (ready[i]) {
+      SOAD_CONFIG->Contexts[ids[i]].flag |= SOAD_RX_READY;
+    }
+  }
+}
+
+/* mark the UDP sockets that have data pending, so that the idle ones cost nothing but a bit of
+ * one select for each SOAD_SELECT_MAX sockets */
+static void soAdSelectUdp(void) {
+  TcpIp_SocketIdType socks[SOAD_SELECT_MAX];
+  SoAd_SoConIdType ids[SOAD_SELECT_MAX];
+  const SoAd_SocketConnectionGroupType *conG;
+  SoAd_SocketContextType *context;
+  uint32_t num = 0;
+  int i;
+
+  for (i = 0; i < SOAD_CONFIG->numOfConnections; i++) {
+    context = &SOAD_CONFIG->Contexts[i];
+    conG = &SOAD_CONFIG->ConnectionGroups[SOAD_CONFIG->Connections[i].GID];
+    if ((SOAD_SOCKET_READY == context->state) && (TCPIP_IPPROTO_UDP == conG->ProtocolType)) {
+      socks[num] = context->sock;
+      ids[num] = (SoAd_SoConIdType)i;
+      num++;
+      if (SOAD_SELECT_MAX == num) {
+        soAdSelectFlush(socks, ids, num);
+        num = 0;
+      }
+    }
+  }
+
+  if (num > 0) {
+    soAdSelectFlush(socks, ids, num);
+  }
+}
 /* ================================ [ FUNCTIONS ] ============================================== */
 void SoAd_Init(const SoAd_ConfigType *ConfigPtr) {
   int i;
+  uint16_t numOfRings = 0;
   const SoAd_SocketConnectionType *connection;
   const SoAd_SocketConnectionGroupType *conG;
   SoAd_SocketContextType *context;
@@ -324,6 +617,10 @@ void SoAd_Init(const SoAd_ConfigType *ConfigPtr) {
         context->state = SOAD_SOCKET_CREATE;
       }
       TcpIp_SetupAddrFrom(&context->RemoteAddr, conG->Remote, conG->Port);
+      if ((TCPIP_IPPROTO_UDP == conG->ProtocolType) && (numOfRings < SOAD_CONFIG->numOfRxRings)) {
+        context->rxRing = &SOAD_CONFIG->RxRings[numOfRings];
+        numOfRings++;
+      }
     } else {
       ASLOG(SOADE, ("[%d] Invalid GID\n", i));
     }
@@ -334,6 +631,8 @@ void SoAd_MainFunction(void) {
   int i;
   SoAd_SocketContextType *context;
 
+  soAdSelectUdp();
+
   for (i = 0; i < SOAD_CONFIG->numOfConnections; i++) {
     context = &SOAD_CONFIG->Contexts[i];
     switch (context->state) {
@@ -366,13 +665,15 @@ Std_ReturnType SoAd_IfTransmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr)
     conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
     context = &SOAD_CONFIG->Contexts[SoConId];
     if (SOAD_SOCKET_READY <= context->state) {
-      if (0 == (context->flag & SOAD_TX_ON_GOING)) {
+      if ((0 == (context->flag & SOAD_TX_ON_GOING)) || (NULL != conG->PduHeader)) {
         ret = E_OK;
       }
     }
   }
 
-  if (E_OK == ret) {
+  if ((E_OK == ret) && (NULL != conG->PduHeader) && (TCPIP_IPPROTO_UDP == conG->ProtocolType)) {
+    ret = soAdPduHeaderTransmit(SoConId, TxPduId, PduInfoPtr);
+  } else if (E_OK == ret) {
     if (TCPIP_IPPROTO_UDP == conG->ProtocolType) {
       if (PduInfoPtr->MetaDataPtr != NULL) {
         addr = *(const TcpIp_SockAddrType *)PduInfoPtr->MetaDataPtr;
@@ -440,6 +741,41 @@ Std_ReturnType SoAd_TpTransmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr)
   return ret;
 }
 
+Std_ReturnType SoAd_TpTransmitV(PduIdType TxPduId, const TcpIp_IoVecType *Vecs, uint32_t Num,
+                                PduLengthType *Length) {
+  Std_ReturnType ret = E_NOT_OK;
+  SoAd_SoConIdType SoConId;
+  const SoAd_SocketConnectionType *connection;
+  const SoAd_SocketConnectionGroupType *conG;
+  SoAd_SocketContextType *context;
+  uint32_t sent = 0;
+
+  if (TxPduId < SOAD_CONFIG->numOfTxPduIds) {
+    SoConId = SOAD_CONFIG->TxPduIdToSoCondIdMap[TxPduId];
+    connection = &SOAD_CONFIG->Connections[SoConId];
+    conG = &SOAD_CONFIG->ConnectionGroups[connection->GID];
+    context = &SOAD_CONFIG->Contexts[SoConId];
+    if (SOAD_SOCKET_READY <= context->state) {
+      if (TCPIP_IPPROTO_TCP == conG->ProtocolType) {
+        ret = TcpIp_SendV(context->sock, Vecs, Num, &sent);
+#if SOAD_ERROR_COUNTER_LIMIT > 0
+        /* a full socket is not an error here */
+        if (E_NOT_OK == ret) {
+          context->errorCounter++;
+          if (context->errorCounter >= SOAD_ERROR_COUNTER_LIMIT) {
+            SoAd_CloseSoCon(SoConId, TRUE);
+          }
+        }
+#endif
+      }
+    }
+  }
+
+  *Length = (PduLengthType)sent;
+
+  return ret;
+}
+
 Std_ReturnType SoAd_GetSoConId(PduIdType TxPduId, SoAd_SoConIdType *SoConIdPtr) {
   Std_ReturnType ret = E_NOT_OK;
 
@@ -514,6 +850,9 @@ Std_ReturnType SoAd_OpenSoCon(SoAd_SoConIdType SoConId) {
     context = &SOAD_CONFIG->Contexts[SoConId];
     if (SOAD_SOCKET_CLOSED == context->state) {
       context->flag = 0;
+      context->txLen = 0;
+      context->txNum = 0;
+      context->txDone = 0;
 #if SOAD_ERROR_COUNTER_LIMIT > 0
       context->errorCounter = 0;
 #endif
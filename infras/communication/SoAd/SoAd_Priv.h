@@ -19,6 +19,23 @@
 #ifndef SOAD_ERROR_COUNTER_LIMIT
 #define SOAD_ERROR_COUNTER_LIMIT 3
 #endif
+
+/* the datagrams read by one TcpIp_RecvFromMulti for a UDP socket */
+#ifndef SOAD_RX_RING_SIZE
+#define SOAD_RX_RING_SIZE 8
+#endif
+
+#ifndef SOAD_RX_SLOT_SIZE
+#define SOAD_RX_SLOT_SIZE 1420
+#endif
+
+/* the PDU header: 32 bits id and 32 bits length, both in big endian */
+#define SOAD_PDU_HEADER_SIZE 8
+
+/* the max sockets checked by one TcpIp_Select */
+#ifndef SOAD_SELECT_MAX
+#define SOAD_SELECT_MAX 32
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 
 typedef void (*SoAd_SoConModeChgNotificationFncType)(SoAd_SoConIdType SoConId,
@@ -88,6 +105,32 @@ typedef struct {
 
 typedef uint8_t SoAd_SoConTypeType;
 
+typedef struct {
+  uint32_t HeaderId;
+  PduIdType RxPduId;
+} SoAd_SocketRouteType;
+
+/* a TX PDU packed in the PDU header mode, kept until its confirmation is raised */
+typedef struct {
+  PduIdType TxPduId;
+  Std_ReturnType result;
+} SoAd_PduHeaderTxType;
+
+/* the PDU header mode of a UDP connection group. The TX PDUs are packed into the
+ * TxBuffer which is sent once full or TxTimeout main function cycles after the first PDU, 0 to
+ * send each PDU by its own datagram. If the upper layer has a TX confirmation, each packed PDU
+ * is confirmed by its SoAd TxPduId with the result of the datagram which carried it, a transmit
+ * is rejected while all the TxPdus are waiting for their confirmation */
+typedef struct {
+  const SoAd_SocketRouteType *RxRoutes;
+  uint16_t numOfRxRoutes;
+  uint8_t *TxBuffer;
+  uint16_t TxBufferSize;
+  uint16_t TxTimeout;
+  SoAd_PduHeaderTxType *TxPdus;
+  uint16_t numOfTxPdus;
+} SoAd_PduHeaderType;
+
 /* @ECUC_SoAd_00009 */
 typedef struct {
   PduIdType RxPduId;
@@ -111,6 +154,7 @@ typedef struct {
   boolean AutomaticSoConSetup;
   boolean IsTP;
   boolean IsMulitcast;       /* if True, the Remote is a multicast UDP IPv4 address */
+  const SoAd_PduHeaderType *PduHeader; /* NULL if the PDU header mode is disabled */
 } SoAd_SocketConnectionGroupType;
 
 typedef enum
@@ -122,11 +166,23 @@ typedef enum
   SOAD_SOCKET_TAKEN_CONTROL,
 } SoAd_SocketStateType;
 
+/* the preallocated receive slots of a UDP socket, they are filled by one batch read and then
+ * consumed in order by the upper layer within the same main function */
+typedef struct {
+  TcpIp_MsgType msgs[SOAD_RX_RING_SIZE];
+  uint8_t data[SOAD_RX_RING_SIZE][SOAD_RX_SLOT_SIZE];
+} SoAd_RxRingType;
+
 typedef struct {
+  SoAd_RxRingType *rxRing; /* NULL to read each datagram into the NetMem */
   TcpIp_SocketIdType sock;
   SoAd_SocketStateType state;
   TcpIp_SockAddrType RemoteAddr;
   TcpIp_SockAddrType LocalAddr;
+  uint16_t txLen;   /* the bytes packed in the TxBuffer of the PDU header mode */
+  uint16_t txTimer; /* the cycles left to send the TxBuffer */
+  uint16_t txNum;   /* the TxPdus packed or sent but not yet confirmed */
+  uint16_t txDone;  /* the TxPdus sent, they are always the first ones */
   uint8_t flag;
 #if SOAD_ERROR_COUNTER_LIMIT > 0
   uint8_t errorCounter;
@@ -138,9 +194,12 @@ struct SoAd_Config_s {
   SoAd_SocketContextType *Contexts;
   uint16_t numOfConnections;
   const SoAd_SoConIdType *TxPduIdToSoCondIdMap;
-  uint8_t numOfTxPduIds;
+  const uint32_t *TxPduHeaderIds; /* the PDU header id of each TxPduId, NULL if none */
+  uint16_t numOfTxPduIds;
   const SoAd_SocketConnectionGroupType *ConnectionGroups;
   uint16_t numOfGroups;
+  SoAd_RxRingType *RxRings; /* for the UDP connections in order */
+  uint16_t numOfRxRings;
 };
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
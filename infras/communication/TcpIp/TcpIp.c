@@ -5,11 +5,15 @@
  * ref: Specification of TCP/IP Stack AUTOSAR CP Release 4.4.0
  */
 /* ================================ [ INCLUDES  ] ============================================== */
+#if defined(linux) && !defined(USE_LWIP) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for the recvmmsg */
+#endif
 #include <string.h>
 #include <stdlib.h>
 
 #include "TcpIp.h"
 #include "Std_Debug.h"
+#include "Std_Timer.h"
 
 #if defined(linux) && !defined(USE_LWIP)
 #include <arpa/inet.h>
@@ -18,11 +22,14 @@
 #include <netinet/tcp.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/select.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include <errno.h>
 #include <sys/time.h>
 #include <time.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
 #elif defined(_WIN32) && !defined(USE_LWIP)
 #include <Ws2tcpip.h>
 #include <windows.h>
@@ -61,6 +68,35 @@
 #define TCPIP_MAX_DATA_SIZE 1420
 #endif
 
+/* the max datagrams read by one recvmmsg */
+#ifndef TCPIP_RECV_MULTI_MAX
+#define TCPIP_RECV_MULTI_MAX 16
+#endif
+
+/* the winsock fd_set is a list of up to FD_SETSIZE sockets, else a bit map of the fds below it */
+#ifdef _WIN32
+#define TCPIP_FD_SET_FITS(index, fd) ((index) < FD_SETSIZE)
+#else
+#define TCPIP_FD_SET_FITS(index, fd) (((fd) >= 0) && ((fd) < FD_SETSIZE))
+#endif
+
+/* the max buffers of one TcpIp_SendV */
+#ifndef TCPIP_SEND_V_MAX
+#define TCPIP_SEND_V_MAX 4
+#endif
+
+/* a peer closed connection shall be an error but not a signal */
+#ifdef MSG_NOSIGNAL
+#define TCPIP_SEND_V_FLAGS (MSG_DONTWAIT | MSG_NOSIGNAL)
+#else
+#define TCPIP_SEND_V_FLAGS MSG_DONTWAIT
+#endif
+
+/* the control messages of a time stamp and its error queue info */
+#define TCPIP_TIME_STAMP_CTRL_SIZE 256
+
+#define TCPIP_NS_PER_SECOND 1000000000ll
+
 /* ================================ [ TYPES     ] ============================================== */
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
@@ -235,6 +271,46 @@ Std_ReturnType TcpIp_GetAdapterAddress(uint32_t number, TcpIp_SockAddrType *addr
   return ret;
 }
 #endif
+
+static void TcpIp_ToTimeStamp(uint64_t ns, TcpIp_TimeStampType *TimeStampPtr) {
+  TimeStampPtr->seconds = (uint32_t)(ns / TCPIP_NS_PER_SECOND);
+  TimeStampPtr->nanoseconds = (uint32_t)(ns % TCPIP_NS_PER_SECOND);
+}
+
+#if defined(linux) && !defined(USE_LWIP)
+/* the kernel time stamps are of the CLOCK_REALTIME, which is moved to the Std_GetTimeNs by its age,
+ * so that a step of the CLOCK_REALTIME between them doesn't count */
+static void TcpIp_FromKernelTime(const struct timespec *ts, TcpIp_TimeStampType *TimeStampPtr) {
+  struct timespec real;
+  uint64_t now = Std_GetTimeNs();
+  int64_t age;
+
+  (void)clock_gettime(CLOCK_REALTIME, &real);
+  age = ((int64_t)real.tv_sec - ts->tv_sec) * TCPIP_NS_PER_SECOND + (real.tv_nsec - ts->tv_nsec);
+  if ((age < 0) || ((uint64_t)age > now)) {
+    age = 0;
+  }
+  TcpIp_ToTimeStamp(now - (uint64_t)age, TimeStampPtr);
+}
+
+/* the software one of the SCM_TIMESTAMPING, NULL if none */
+static const struct timespec *TcpIp_GetKernelTime(struct msghdr *hdr) {
+  const struct timespec *ts = NULL;
+  const struct timespec *stamps;
+  struct cmsghdr *cmsg;
+
+  for (cmsg = CMSG_FIRSTHDR(hdr); (NULL != cmsg) && (NULL == ts); cmsg = CMSG_NXTHDR(hdr, cmsg)) {
+    if ((SOL_SOCKET == cmsg->cmsg_level) && (SCM_TIMESTAMPING == cmsg->cmsg_type)) {
+      stamps = (const struct timespec *)CMSG_DATA(cmsg);
+      if ((0 != stamps[0].tv_sec) || (0 != stamps[0].tv_nsec)) {
+        ts = &stamps[0];
+      }
+    }
+  }
+
+  return ts;
+}
+#endif
 /* ================================ [ FUNCTIONS ] ============================================== */
 void TcpIp_Init(const TcpIp_ConfigType *ConfigPtr) {
   if (FALSE == lInitialized) {
@@ -591,6 +667,112 @@ Std_ReturnType TcpIp_RecvFrom(TcpIp_SocketIdType SocketId, TcpIp_SockAddrType *R
   return ret;
 }
 
+Std_ReturnType TcpIp_RecvFromMulti(TcpIp_SocketIdType SocketId, TcpIp_MsgType *Msgs,
+                                   uint32_t *Count /* InOut */) {
+  Std_ReturnType ret = E_OK;
+#if defined(linux) && !defined(USE_LWIP)
+  struct mmsghdr hdrs[TCPIP_RECV_MULTI_MAX];
+  struct iovec iovs[TCPIP_RECV_MULTI_MAX];
+  struct sockaddr_in fromAddrs[TCPIP_RECV_MULTI_MAX];
+  uint32_t num = *Count;
+  uint32_t i;
+  int r;
+
+  if (num > TCPIP_RECV_MULTI_MAX) {
+    num = TCPIP_RECV_MULTI_MAX;
+  }
+
+  memset(hdrs, 0, sizeof(struct mmsghdr) * num);
+  for (i = 0; i < num; i++) {
+    iovs[i].iov_base = Msgs[i].BufPtr;
+    iovs[i].iov_len = Msgs[i].Length;
+    hdrs[i].msg_hdr.msg_iov = &iovs[i];
+    hdrs[i].msg_hdr.msg_iovlen = 1;
+    hdrs[i].msg_hdr.msg_name = &fromAddrs[i];
+    hdrs[i].msg_hdr.msg_namelen = sizeof(fromAddrs[i]);
+  }
+
+  r = recvmmsg(SocketId, hdrs, num, MSG_DONTWAIT, NULL);
+  *Count = 0;
+  if (r > 0) {
+    for (i = 0; i < (uint32_t)r; i++) {
+      Msgs[i].RemoteAddr.port = htons(fromAddrs[i].sin_port);
+      memcpy(Msgs[i].RemoteAddr.addr, &fromAddrs[i].sin_addr.s_addr, 4);
+      if (0 != (hdrs[i].msg_hdr.msg_flags & MSG_TRUNC)) {
+        ASLOG(TCPIPE, ("[%d] datagram over %u bytes dropped\n", SocketId, Msgs[i].Length));
+        Msgs[i].Length = 0;
+      } else {
+        Msgs[i].Length = hdrs[i].msg_len;
+      }
+    }
+    *Count = (uint32_t)r;
+    ASLOG(TCPIP, ("[%d] recv %d datagrams\n", SocketId, r));
+  } else if ((r < 0) && (EAGAIN != errno) && (EWOULDBLOCK != errno)) {
+    ret = E_NOT_OK;
+    ASLOG(TCPIPE, ("[%d] recvmmsg got error %d\n", SocketId, errno));
+  } else {
+    /* got nothing */
+  }
+#else
+  uint32_t i;
+
+  for (i = 0; (i < *Count) && (E_OK == ret); i++) {
+    ret = TcpIp_RecvFrom(SocketId, &Msgs[i].RemoteAddr, Msgs[i].BufPtr, &Msgs[i].Length);
+    if (0 == Msgs[i].Length) {
+      break;
+    }
+  }
+  *Count = i;
+#endif
+
+  return ret;
+}
+
+Std_ReturnType TcpIp_Select(const TcpIp_SocketIdType *SocketIds, boolean *Ready, uint32_t Num,
+                            uint32_t TimeoutMs) {
+  Std_ReturnType ret = E_NOT_OK;
+  fd_set rdSet;
+  struct timeval tv;
+  int maxFd = -1;
+  boolean fits = TRUE;
+  uint32_t i;
+  int r = -1;
+
+  FD_ZERO(&rdSet);
+  for (i = 0; (i < Num) && fits; i++) {
+    if (TCPIP_FD_SET_FITS(i, SocketIds[i])) {
+      FD_SET(SocketIds[i], &rdSet);
+      if (SocketIds[i] > maxFd) {
+        maxFd = SocketIds[i];
+      }
+    } else {
+      ASLOG(TCPIPE, ("[%d] socket beyond the FD_SETSIZE\n", SocketIds[i]));
+      fits = FALSE;
+    }
+  }
+
+  if (fits) {
+    tv.tv_sec = TimeoutMs / 1000;
+    tv.tv_usec = (TimeoutMs % 1000) * 1000;
+    r = select(maxFd + 1, &rdSet, NULL, NULL, &tv);
+  }
+  if (r > 0) {
+    for (i = 0; i < Num; i++) {
+      Ready[i] = FD_ISSET(SocketIds[i], &rdSet) ? TRUE : FALSE;
+    }
+    ret = E_OK;
+  } else {
+    if (r < 0) {
+      ASLOG(TCPIPE, ("select got error %d\n", r));
+    }
+    for (i = 0; i < Num; i++) {
+      Ready[i] = (r < 0) ? TRUE : FALSE;
+    }
+  }
+
+  return ret;
+}
+
 Std_ReturnType TcpIp_SendTo(TcpIp_SocketIdType SocketId, const TcpIp_SockAddrType *RemoteAddrPtr,
                             const uint8_t *BufPtr, uint32_t Length) {
   Std_ReturnType ret = E_OK;
@@ -644,6 +826,68 @@ Std_ReturnType TcpIp_Send(TcpIp_SocketIdType SocketId, const uint8_t *BufPtr, ui
   return ret;
 }
 
+Std_ReturnType TcpIp_SendV(TcpIp_SocketIdType SocketId, const TcpIp_IoVecType *Vecs, uint32_t Num,
+                           uint32_t *Length /* Out */) {
+  Std_ReturnType ret = E_OK;
+  uint32_t total = 0;
+  uint32_t i;
+  int nbytes;
+#if defined(_WIN32) && !defined(USE_LWIP)
+  WSABUF bufs[TCPIP_SEND_V_MAX];
+  DWORD sent = 0;
+#else
+  struct iovec iovs[TCPIP_SEND_V_MAX];
+  struct msghdr hdr;
+#endif
+
+  if (Num > TCPIP_SEND_V_MAX) {
+    Num = TCPIP_SEND_V_MAX;
+  }
+
+  for (i = 0; i < Num; i++) {
+    total += Vecs[i].Length;
+#if defined(_WIN32) && !defined(USE_LWIP)
+    bufs[i].buf = (char *)Vecs[i].BufPtr;
+    bufs[i].len = Vecs[i].Length;
+#else
+    iovs[i].iov_base = (void *)Vecs[i].BufPtr;
+    iovs[i].iov_len = Vecs[i].Length;
+#endif
+  }
+
+#if defined(_WIN32) && !defined(USE_LWIP)
+  if (0 == WSASend(SocketId, bufs, Num, &sent, 0, NULL, NULL)) {
+    nbytes = (int)sent;
+  } else if (WSAEWOULDBLOCK == WSAGetLastError()) {
+    nbytes = 0;
+  } else {
+    nbytes = -1;
+  }
+#else
+  memset(&hdr, 0, sizeof(hdr));
+  hdr.msg_iov = iovs;
+  hdr.msg_iovlen = Num;
+  nbytes = sendmsg(SocketId, &hdr, TCPIP_SEND_V_FLAGS);
+  if ((nbytes < 0) && ((EAGAIN == errno) || (EWOULDBLOCK == errno))) {
+    nbytes = 0;
+  }
+#endif
+  ASLOG(TCPIP, ("[%d] sendv(%d/%d)\n", SocketId, nbytes, total));
+
+  if (nbytes < 0) {
+    ASLOG(TCPIPE, ("[%d] sendv(%d), error is %d\n", SocketId, total, nbytes));
+    *Length = 0;
+    ret = E_NOT_OK;
+  } else {
+    *Length = (uint32_t)nbytes;
+    if ((uint32_t)nbytes != total) {
+      ret = TCPIP_E_NOSPACE;
+    }
+  }
+
+  return ret;
+}
+
 Std_ReturnType TcpIp_TcpConnect(TcpIp_SocketIdType SocketId,
                                 const TcpIp_SockAddrType *RemoteAddrPtr) {
   Std_ReturnType ret = E_NOT_OK;
@@ -764,4 +1008,124 @@ uint16_t TcpIp_Tell(TcpIp_SocketIdType SocketId) {
   }
 
   return Length;
+}
+
+Std_ReturnType TcpIp_EnableTimeStamp(TcpIp_SocketIdType SocketId) {
+  Std_ReturnType ret = E_NOT_OK;
+#if defined(linux) && !defined(USE_LWIP)
+  /* the OPT_ID gives the egress time stamps the count of the datagram, the OPT_TSONLY leaves the
+   * datagram itself out of the error queue */
+  int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_TX_SOFTWARE |
+              SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+  int r;
+
+  r = setsockopt(SocketId, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags));
+  if (0 == r) {
+    ret = E_OK;
+  } else {
+    ASLOG(TCPIPE, ("[%d] enable time stamp failed: %d\n", SocketId, errno));
+  }
+#else
+  (void)SocketId;
+#endif
+  ASLOG(TCPIP, ("[%d] time stamp %s\n", SocketId, (E_OK == ret) ? "on" : "off"));
+
+  return ret;
+}
+
+Std_ReturnType TcpIp_RecvFromWithTimeStamp(TcpIp_SocketIdType SocketId,
+                                           TcpIp_SockAddrType *RemoteAddrPtr, uint8_t *BufPtr,
+                                           uint32_t *Length /* InOut */,
+                                           TcpIp_TimeStampType *TimeStampPtr) {
+  Std_ReturnType ret = E_OK;
+#if defined(linux) && !defined(USE_LWIP)
+  struct sockaddr_in fromAddr;
+  char ctrl[TCPIP_TIME_STAMP_CTRL_SIZE];
+  struct iovec iov;
+  struct msghdr hdr;
+  const struct timespec *ts;
+  int nbytes;
+
+  iov.iov_base = BufPtr;
+  iov.iov_len = *Length;
+  memset(&hdr, 0, sizeof(hdr));
+  hdr.msg_name = &fromAddr;
+  hdr.msg_namelen = sizeof(fromAddr);
+  hdr.msg_iov = &iov;
+  hdr.msg_iovlen = 1;
+  hdr.msg_control = ctrl;
+  hdr.msg_controllen = sizeof(ctrl);
+
+  nbytes = recvmsg(SocketId, &hdr, MSG_DONTWAIT);
+  *Length = 0;
+  if (nbytes > 0) {
+    RemoteAddrPtr->port = htons(fromAddr.sin_port);
+    memcpy(RemoteAddrPtr->addr, &fromAddr.sin_addr.s_addr, 4);
+    ts = TcpIp_GetKernelTime(&hdr);
+    if (NULL != ts) {
+      TcpIp_FromKernelTime(ts, TimeStampPtr);
+    } else {
+      TcpIp_ToTimeStamp(Std_GetTimeNs(), TimeStampPtr);
+    }
+    *Length = nbytes;
+    ASLOG(TCPIP, ("[%d] recv %d bytes at %u.%09us\n", SocketId, nbytes, TimeStampPtr->seconds,
+                  TimeStampPtr->nanoseconds));
+  } else if ((nbytes < 0) && (EAGAIN != errno) && (EWOULDBLOCK != errno)) {
+    ret = E_NOT_OK;
+    ASLOG(TCPIPE, ("[%d] recvmsg got error %d\n", SocketId, errno));
+  } else {
+    /* got nothing */
+  }
+#else
+  ret = TcpIp_RecvFrom(SocketId, RemoteAddrPtr, BufPtr, Length);
+  if (*Length > 0) {
+    TcpIp_ToTimeStamp(Std_GetTimeNs(), TimeStampPtr);
+  }
+#endif
+
+  return ret;
+}
+
+Std_ReturnType TcpIp_GetEgressTimeStamp(TcpIp_SocketIdType SocketId, uint32_t *IdPtr,
+                                        TcpIp_TimeStampType *TimeStampPtr) {
+  Std_ReturnType ret = E_NOT_OK;
+#if defined(linux) && !defined(USE_LWIP)
+  char ctrl[TCPIP_TIME_STAMP_CTRL_SIZE];
+  struct msghdr hdr;
+  struct cmsghdr *cmsg;
+  const struct sock_extended_err *err;
+  const struct timespec *ts;
+  boolean hasId = FALSE;
+  int r;
+
+  memset(&hdr, 0, sizeof(hdr));
+  hdr.msg_control = ctrl;
+  hdr.msg_controllen = sizeof(ctrl);
+  r = recvmsg(SocketId, &hdr, MSG_ERRQUEUE | MSG_DONTWAIT);
+  if (r >= 0) {
+    for (cmsg = CMSG_FIRSTHDR(&hdr); NULL != cmsg; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+      if (((SOL_IP == cmsg->cmsg_level) && (IP_RECVERR == cmsg->cmsg_type)) ||
+          ((SOL_IPV6 == cmsg->cmsg_level) && (IPV6_RECVERR == cmsg->cmsg_type))) {
+        err = (const struct sock_extended_err *)CMSG_DATA(cmsg);
+        if (SO_EE_ORIGIN_TIMESTAMPING == err->ee_origin) {
+          *IdPtr = err->ee_data;
+          hasId = TRUE;
+        }
+      }
+    }
+    ts = TcpIp_GetKernelTime(&hdr);
+    if ((NULL != ts) && hasId) {
+      TcpIp_FromKernelTime(ts, TimeStampPtr);
+      ret = E_OK;
+      ASLOG(TCPIP, ("[%d] sent %u at %u.%09us\n", SocketId, *IdPtr, TimeStampPtr->seconds,
+                    TimeStampPtr->nanoseconds));
+    }
+  }
+#else
+  (void)SocketId;
+  (void)IdPtr;
+  (void)TimeStampPtr;
+#endif
+
+  return ret;
 }
\ No newline at end of file
@@ -4,87 +4,51 @@
  *
  * ref: Specification of UDP Network Management AUTOSAR CP Release 4.4.0
  */
-#ifndef _CAN_NM_PRIV_H
-#define _CAN_NM_PRIV_H
+#ifndef _UDP_NM_PRIV_H
+#define _UDP_NM_PRIV_H
 /* ================================ [ INCLUDES  ] ============================================== */
-#include "ComStack_Types.h"
-#include "NmStack_Types.h"
-#include "Std_Timer.h"
+#include "NmCore.h"
+#include "UdpNm_Cfg.h"
 /* ================================ [ MACROS    ] ============================================== */
-#define UDPNM_PDU_BYTE_0 ((UdpNm_PduPositionType)0)
-#define UDPNM_PDU_BYTE_1 ((UdpNm_PduPositionType)1)
-#define UDPNM_PDU_OFF ((UdpNm_PduPositionType)0xFF)
+#define UDPNM_PDU_BYTE_0 NMCORE_PDU_BYTE_0
+#define UDPNM_PDU_BYTE_1 NMCORE_PDU_BYTE_1
+#define UDPNM_PDU_OFF NMCORE_PDU_OFF
 
-#define UDPNM_INVALID_NODE_ID 0xFF
-/* ================================ [ TYPES     ] ============================================== */
-/* @SWS_UdpNm_00304 */
-typedef uint8_t UdpNm_PduPositionType;
+#define UDPNM_INVALID_NODE_ID NMCORE_INVALID_NODE_ID
 
-typedef struct {
-  uint16_t ImmediateNmCycleTime; /* @ECUC_UdpNm_00079 */
-  uint16_t MsgCycleOffset;       /* @ECUC_UdpNm_00029 */
-  uint16_t MsgCycleTime;         /* @ECUC_UdpNm_00028 */
-  uint16_t MsgTimeoutTime;       /* @ */
-  /* dependency: RepeatMessageTime = n * UdpNmMsgCycleTime;
-   * RepeatMessageTime > ImmediateNmTransmissions * ImmediateNmCycleTime */
-  uint16_t RepeatMessageTime; /* @ECUC_UdpNm_00022 */
-  uint16_t NmTimeoutTime;     /* @ECUC_UdpNm_00020 */
-  uint16_t WaitBusSleepTime;  /* @ECUC_UdpNm_00021 */
 #ifdef UDPNM_REMOTE_SLEEP_IND_ENABLED
-  uint16_t RemoteSleepIndTime; /* @ECUC_UdpNm_00023 */
+#define UDPNM_FEATURE_REMOTE_SLEEP_IND NMCORE_FEATURE_REMOTE_SLEEP_IND
+#else
+#define UDPNM_FEATURE_REMOTE_SLEEP_IND 0
 #endif
-  PduIdType TxPdu; /* @ECUC_UdpNm_00036 */
-  uint8_t NodeId;  /* @SWS_UdpNm_00013 */
-  NetworkHandleType nmNetworkHandle;
-  uint8_t ImmediateNmTransmissions;     /* @ECUC_UdpNm_00075 */
-  UdpNm_PduPositionType PduCbvPosition; /* @ECUC_UdpNm_00026 */
-  UdpNm_PduPositionType PduNidPosition; /* @ECUC_UdpNm_00025 */
-  boolean ActiveWakeupBitEnabled;       /* @ECUC_UdpNm_00074 */
-  boolean PassiveModeEnabled;           /* @ECUC_UdpNm_00010 */
-  boolean RepeatMsgIndEnabled;          /* @ECUC_UdpNm_00092 */
-  boolean NodeDetectionEnabled;         /* @ECUC_UdpNm_00090  */
-#ifdef UDPNM_GLOBAL_PN_SUPPORT
-  boolean PnEnabled;               /* @ECUC_UdpNm_00061 */
-  boolean AllNmMessagesKeepAwake;  /* @ECUC_UdpNm_00089 */
-  uint8_t PnInfoOffset;            /* @ECUC_UdpNm_00068 */
-  uint8_t PnInfoLength;            /* @ECUC_UdpNm_00069 */
-  const uint8_t *PnFilterMaskByte; /* @ECUC_UdpNm_00070 */
+#ifdef UDPNM_COORDINATOR_SYNC_SUPPORT
+#define UDPNM_FEATURE_COORDINATOR_SYNC NMCORE_FEATURE_COORDINATOR_SYNC
+#else
+#define UDPNM_FEATURE_COORDINATOR_SYNC 0
 #endif
-} UdpNm_ChannelConfigType;
-
-#ifdef _WIN32
-typedef Std_TimerType UdpNm_TimerType;
+#ifdef UDPNM_GLOBAL_PN_SUPPORT
+#define UDPNM_FEATURE_GLOBAL_PN NMCORE_FEATURE_GLOBAL_PN
 #else
-typedef uint16_t UdpNm_TimerType;
+#define UDPNM_FEATURE_GLOBAL_PN 0
 #endif
 
-typedef struct {
-  struct {
-    UdpNm_TimerType _Tx;
-    UdpNm_TimerType _TxTimeout;
-    UdpNm_TimerType _NMTimeout;
-    union {
-      UdpNm_TimerType _RepeatMessage;
-      UdpNm_TimerType _WaitBusSleep;
-    };
-#ifdef UDPNM_REMOTE_SLEEP_IND_ENABLED
-    UdpNm_TimerType _RemoteSleepInd;
+#if UDPNM_PDU_LENGTH > NMCORE_PDU_LENGTH_MAX
+#error "UDPNM_PDU_LENGTH is longer than NMCORE_PDU_LENGTH_MAX"
 #endif
-  } Alarm;
-  uint16_t flags;
-  Nm_StateType state;
-  uint8_t TxCounter;
-  uint8_t data[UDPNM_PDU_LENGTH];
-  uint8_t rxPdu[UDPNM_PDU_LENGTH];
-} UdpNm_ChannelContextType;
+
+#define UDPNM_FEATURES                                                                             \
+  (UDPNM_FEATURE_REMOTE_SLEEP_IND | UDPNM_FEATURE_COORDINATOR_SYNC | UDPNM_FEATURE_GLOBAL_PN)
+/* ================================ [ TYPES     ] ============================================== */
+typedef NmCore_PduPositionType UdpNm_PduPositionType;
+/* the ECUC_UdpNm parameters, see NmCore_ChannelConfigType for the order */
+typedef NmCore_ChannelConfigType UdpNm_ChannelConfigType;
+typedef NmCore_ChannelContextType UdpNm_ChannelContextType;
 
 struct UdpNm_Config_s {
-  const UdpNm_ChannelConfigType *ChannelConfigs;
-  UdpNm_ChannelContextType *ChannelContexts;
-  uint8_t numOfChannels;
+  NmCore_ConfigType core;
 };
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
 /* ================================ [ FUNCTIONS ] ============================================== */
-#endif /* _CAN_NM_PRIV_H */
+#endif /* _UDP_NM_PRIV_H */
@@ -80,6 +80,14 @@ void Can_MainFunction_BusOff(void);
 void Can_MainFunction_WakeUp(void);
 /* @SWS_Can_00368 */
 void Can_MainFunction_Mode(void);
+
+/* the hardware time stamps of the frame being indicated or confirmed, optional for a driver,
+ * E_NOT_OK if there is none, then CanIf takes the time in the ISR. The stamps must be of the
+ * Std_GetTimeNs clock, which is the virtual local time of StbM, so a driver whose controller
+ * runs its own counter converts them before it returns. */
+Std_ReturnType Can_GetIngressTimeStamp(Can_HwHandleType Hrh, Can_TimeStampType *timeStampPtr);
+Std_ReturnType Can_GetEgressTimeStamp(PduIdType TxPduId, Can_HwHandleType Hth,
+                                      Can_TimeStampType *timeStampPtr);
 #ifdef __cplusplus
 }
 #endif
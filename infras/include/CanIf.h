@@ -40,6 +40,16 @@ typedef struct CanIf_Config_s CanIf_ConfigType;
 /* @SWS_CANIF_00137 */
 typedef uint8_t CanIf_PduModeType;
 
+/* the counters of the rx deferred from the ISR to the CanIf_MainFunction_Fast */
+typedef struct {
+  uint32_t deferred;   /* the frames queued */
+  uint32_t dispatched; /* the frames dispatched by the main function */
+  uint32_t overflows;  /* the frames dropped as the pool or the queue was full */
+  uint32_t latencyMax; /* in us, from the queue to the dispatch */
+  uint32_t latencyAvg; /* in us */
+  uint16_t queueMax;   /* the high water of the queue */
+} CanIf_RxQueueStatsType;
+
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
@@ -76,6 +86,15 @@ Std_ReturnType CanIf_GetTrcvMode(uint8_t TransceiverId, CanTrcv_TrcvModeType *Tr
 void CanIf_MainFunction(void);
 
 void CanIf_MainFunction_Fast(void);
+
+/* E_NOT_OK if the deferred rx is not enabled, see CANIF_PACKET_RX_POOL_SIZE */
+Std_ReturnType CanIf_GetRxQueueStats(uint8_t ControllerId, CanIf_RxQueueStatsType *StatsPtr);
+
+/* the time stamps taken in the ISR of the frame of the PDU, only valid in its rx indication or tx
+ * confirmation, E_NOT_OK if the time stamp is not enabled, see CANIF_USE_TIME_STAMP. With
+ * USE_CANTSYN only the frames of CanTSyn are time stamped */
+Std_ReturnType CanIf_GetIngressTimeStamp(PduIdType RxPduId, Can_TimeStampType *timeStampPtr);
+Std_ReturnType CanIf_GetEgressTimeStamp(PduIdType TxPduId, Can_TimeStampType *timeStampPtr);
 #ifdef __cplusplus
 }
 #endif
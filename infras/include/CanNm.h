@@ -83,6 +83,9 @@ void CanNm_RxIndication(PduIdType RxPduId, const PduInfoType *PduInfoPtr);
 /* @SWS_CanNm_00334 */
 void CanNm_ConfirmPnAvailability(NetworkHandleType nmChannelHandle);
 
+/* the PNs requested by this ECU, PnInfoLength bytes sent at the PnInfoOffset of the NM PDU */
+Std_ReturnType CanNm_SetPnInfo(NetworkHandleType nmChannelHandle, const uint8_t *PnInfo);
+
 /* @SWS_CanNm_91001 */
 Std_ReturnType CanNm_TriggerTransmit(PduIdType TxPduId, PduInfoType *PduInfoPtr);
 
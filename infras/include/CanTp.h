@@ -47,6 +47,12 @@ void CanTp_MainFunction_Channel(uint8_t Channel);
 void CanTp_MainFunction_Fast(void);
 
 void CanTp_MainFunction_ChannelFast(uint8_t Channel);
+
+/* For the CANTP_USE_HIGH_RATE mode, the one shot timer of the port to keep a STmin below the
+ * period of the main functions, it shall call CanTp_STminExpired after the us. The weak default
+ * has no timer and returns E_NOT_OK, then the STmin is kept by the main functions. */
+Std_ReturnType CanTp_PortStartTimer(PduIdType TxPduId, uint32_t us);
+void CanTp_STminExpired(PduIdType TxPduId);
 #ifdef __cplusplus
 }
 #endif
@@ -47,6 +47,12 @@ typedef struct {
   uint8_t ControllerId;
 } Can_HwType;
 
+/* the time stamp of a frame, in the clock of the StbM virtual local time */
+typedef struct {
+  uint32_t nanoseconds;
+  uint32_t seconds;
+} Can_TimeStampType;
+
 /* @SWS_Can_91021 */
 typedef enum {
   CAN_ERROR_BIT_MONITORING1 = 0x01, /* A 0 was transmitted and a 1 was read back */
@@ -0,0 +1,32 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ *
+ * ref: https://www.autosar.org/fileadmin/standards/R20-11/CP/AUTOSAR_SWS_TimeSyncOverEthernet.pdf
+ */
+#ifndef __ETH_TSYNC_H__
+#define __ETH_TSYNC_H__
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Std_Types.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define ETHTSYN_TX_OFF ((EthTSyn_TransmissionModeType)0x00)
+#define ETHTSYN_TX_ON ((EthTSyn_TransmissionModeType)0x01)
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct EthTSyn_Config_s EthTSyn_ConfigType;
+
+typedef uint8_t EthTSyn_TransmissionModeType;
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+/* the EthTSyn_Config if the ConfigPtr is NULL */
+void EthTSyn_Init(const EthTSyn_ConfigType *ConfigPtr);
+
+/* there is no EthIf, so the CtrlIdx is not used, the Sync and the Pdelay_Req of all the domains
+ * are stopped by the ETHTSYN_TX_OFF, the Pdelay_Resp to the peers are still sent */
+void EthTSyn_SetTransmissionMode(uint8_t CtrlIdx, EthTSyn_TransmissionModeType Mode);
+
+/* the sockets are read here, the time stamps of the messages are taken by the TcpIp when they are
+ * sent and received, so the period doesn't add to the error */
+void EthTSyn_MainFunction(void);
+#endif /* __ETH_TSYNC_H__ */
@@ -55,6 +55,12 @@ Std_ReturnType SoAd_IfSpecificRoutingGroupTransmit(SoAd_RoutingGroupIdType id,
 /* @SWS_SoAd_00105 */
 Std_ReturnType SoAd_TpTransmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr);
 
+/* the gathered variant of the SoAd_TpTransmit for the TCP, the buffers are sent without being
+ * copied together. The Length is set to the bytes taken by the socket, TCPIP_E_NOSPACE is returned
+ * if the socket is full and the rest shall be sent later. */
+Std_ReturnType SoAd_TpTransmitV(PduIdType TxPduId, const TcpIp_IoVecType *Vecs, uint32_t Num,
+                                PduLengthType *Length);
+
 /* @SWS_SoAd_00522 */
 Std_ReturnType SoAd_TpCancelTransmit(PduIdType TxPduId);
 
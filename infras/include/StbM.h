@@ -50,6 +50,9 @@ typedef struct {
   uint8_t userByte1;
   uint8_t userByte2;
 } StbM_UserDataType;
+
+/* the rate of a time base against the virtual local time - 1, in ppb */
+typedef int32_t StbM_RateDeviationType;
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
@@ -85,4 +88,16 @@ Std_ReturnType StbM_GetOffset(StbM_SynchronizedTimeBaseType timeBaseId,
 
 /* @SWS_StbM_00347 */
 uint8_t StbM_GetTimeBaseUpdateCounter(StbM_SynchronizedTimeBaseType timeBaseId);
+
+/* @SWS_StbM_00213: by the time master */
+Std_ReturnType StbM_SetGlobalTime(StbM_SynchronizedTimeBaseType timeBaseId,
+                                  const StbM_TimeStampType *timeStamp,
+                                  const StbM_UserDataType *userData);
+
+/* the rate of the time base of the time master, the time slave measures it from the syncs */
+Std_ReturnType StbM_SetRateCorrection(StbM_SynchronizedTimeBaseType timeBaseId,
+                                      StbM_RateDeviationType rateDeviation);
+
+Std_ReturnType StbM_GetRateDeviation(StbM_SynchronizedTimeBaseType timeBaseId,
+                                     StbM_RateDeviationType *rateDeviation);
 #endif /* __STB_M_H__ */
@@ -5,6 +5,7 @@
 #ifndef STD_CRITICAL_H
 #define STD_CRITICAL_H
 /* ================================ [ INCLUDES  ] ============================================== */
+#include <stdint.h>
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -22,6 +23,17 @@ extern "C" {
   while (0)
 #endif
 
+/* the load acquire and the store release of a 32 bits index shared by a single producer and a
+ * single consumer, the compilers without the GCC atomics such as MSVC and armcc take the critical
+ * section instead */
+#if defined(__GNUC__) && !defined(__CC_ARM)
+#define STD_ATOMIC_LOAD_ACQUIRE(v) __atomic_load_n(&(v), __ATOMIC_ACQUIRE)
+#define STD_ATOMIC_STORE_RELEASE(v, x) __atomic_store_n(&(v), (x), __ATOMIC_RELEASE)
+#else
+#define STD_ATOMIC_LOAD_ACQUIRE(v) Std_AtomicLoad32(&(v))
+#define STD_ATOMIC_STORE_RELEASE(v, x) Std_AtomicStore32(&(v), (x))
+#endif
+
 /* ================================ [ TYPES     ] ============================================== */
 typedef unsigned int imask_t;
 /* ================================ [ DECLARES  ] ============================================== */
@@ -30,6 +42,22 @@ typedef unsigned int imask_t;
 /* ================================ [ FUNCTIONS ] ============================================== */
 imask_t Std_EnterCritical(void);
 void Std_ExitCritical(imask_t);
+
+#if !(defined(__GNUC__) && !defined(__CC_ARM))
+static __inline uint32_t Std_AtomicLoad32(const volatile uint32_t *v) {
+  uint32_t x;
+  imask_t imask = Std_EnterCritical();
+  x = *v;
+  Std_ExitCritical(imask);
+  return x;
+}
+
+static __inline void Std_AtomicStore32(volatile uint32_t *v, uint32_t x) {
+  imask_t imask = Std_EnterCritical();
+  *v = x;
+  Std_ExitCritical(imask);
+}
+#endif
 #ifdef __cplusplus
 }
 #endif
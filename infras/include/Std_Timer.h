@@ -30,6 +30,8 @@ extern "C" {
 
 #define STD_TIMER_ONE_SECOND ((std_time_t)1000000)
 #define STD_TIMER_ONE_MILISECOND ((std_time_t)1000)
+
+#define STD_TIME_NS_PER_US 1000u
 /* ================================ [ TYPES     ] ============================================== */
 #if defined(linux) || defined(_WIN32) || defined(USE_STD_TIME_64)
 typedef uint64_t std_time_t;
@@ -44,13 +46,35 @@ typedef struct {
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
 /* ================================ [ FUNCTIONS ] ============================================== */
+/* the monotonic time in us, it doesn't jump with the adjustments of the wall clock */
 std_time_t Std_GetTime(void);
+/* the monotonic time in ns */
+uint64_t Std_GetTimeNs(void);
 void Std_Sleep(std_time_t time);
+
+/* Latch the time of the calling thread at the start of a cycle, the timer APIs below then check
+ * against the latched time instead of reading the clock each time, until Std_TimeUnlatch. Don't
+ * busy wait on a timer between the two. */
+void Std_TimeLatch(void);
+void Std_TimeUnlatch(void);
+
+#if defined(linux) || defined(_WIN32)
+/* In the virtual time mode the clock only moves by Std_TimeStep and Std_Sleep, which returns at
+ * once, so that a simulation is deterministic and runs as fast as it can. The virtual time starts
+ * from the real time at the moment it is enabled. */
+void Std_TimeSetVirtual(bool enable);
+bool Std_TimeIsVirtual(void);
+void Std_TimeStep(uint64_t ns);
+#endif
 void Std_TimerStart(Std_TimerType *timer);
 void Std_TimerStop(Std_TimerType *timer);
 bool Std_IsTimerStarted(Std_TimerType *timer);
 std_time_t Std_GetTimerElapsedTime(Std_TimerType *timer);
 
+/* move the start of a started timer later by time, so its elapsed time is reduced by time, e.g.
+ * to start the next period at the end of the last one instead of at now */
+void Std_TimerAdvance(Std_TimerType *timer, std_time_t time);
+
 /* Initialize the timer and set the timer with the timeout value */
 void Std_TimerInit(Std_TimerType *timer, std_time_t timeout);
 
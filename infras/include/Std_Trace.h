@@ -9,7 +9,6 @@
 #define __STD_TRACE_H__
 /* ================================ [ INCLUDES  ] ============================================== */
 #include <stdint.h>
-#include "ringbuffer.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -21,19 +20,73 @@ extern "C" {
 #define STD_TRACE_EVENT(area, ev)
 #define STD_TRACE_MAIN(area)
 #endif
+
+/* the events taken out of the rings but not yet accepted by the output */
+#define STD_TRACE_PENDING_MAX 32
 /* ================================ [ TYPES     ] ============================================== */
 typedef uint32_t Std_TraceEventType;
 
+/* one single producer single consumer ring per context, the indexes are free running */
+typedef struct {
+  uint32_t head;  /* written by the producer only */
+  uint32_t tail;  /* written by the consumer only */
+  uint32_t drops; /* the events lost as the ring is full, written by the producer only */
+} Std_TraceRingType;
+
+typedef struct {
+  uint32_t lost; /* the events of the cores beyond the configured number */
+  uint32_t last; /* the timestamp of the last merged event */
+  uint32_t numOfPending;
+  Std_TraceEventType pending[STD_TRACE_PENDING_MAX];
+  uint8_t busy; /* 1 while a consumer drains the area */
+  uint32_t credit;    /* the bytes Std_TraceMain may still put on the bus */
+  uint32_t timestamp; /* the time of the last credit refill */
+  uint8_t sequence;   /* of the next stream frame */
+} Std_TraceAreaVarType;
+
+/* The context is the core on the MCU and the OS builds, and the thread on the host without OS,
+ * where the last ring is shared by the threads beyond the other rings.
+ * The rings are merged by the truncated timestamp of the events when they are taken out, so the
+ * timer must count up and the rings must be drained within half of its wrap period. */
 typedef struct {
-  const RingBufferType *rb;
+  Std_TraceEventType *buffer; /* contexts * size */
+  Std_TraceRingType *rings;
+  Std_TraceAreaVarType *var;
+  uint32_t size; /* events of one ring, a power of 2 */
+  uint32_t tsMask;
+  uint8_t contexts;
 } Std_TraceAreaType;
+
+/* write the events to a file, socket or the like, return the bytes accepted or negative on error */
+typedef int (*Std_TraceSinkType)(void *param, const void *data, uint32_t size);
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
 /* ================================ [ FUNCTIONS ] ============================================== */
 void Std_TraceEvent(const Std_TraceAreaType *area, Std_TraceEventType event);
 void Std_TraceDump(const Std_TraceAreaType *area);
+/* the live mode, send the events over CAN or UDP, see the stream frame format in std_trace.c */
 void Std_TraceMain(const Std_TraceAreaType *area);
+/* print the usage and the drop counters of each ring */
+void Std_TraceStat(const Std_TraceAreaType *area);
+/* the continuous mode, drain at most max events in the time order to the sink, to be called
+ * periodically by a low priority task, the events not accepted by the sink are kept for the next
+ * call. Std_TraceDump, Std_TraceMain and Std_TraceStream are serialised per area, the one which
+ * finds the area busy does nothing, so better to build in only one of them. */
+uint32_t Std_TraceStream(const Std_TraceAreaType *area, Std_TraceSinkType sink, void *param,
+                         uint32_t max);
+
+/* the context of the caller, the OS provides it on the SMP builds, 0 by default */
+uint32_t Std_TraceGetContext(void);
+
+#ifdef USE_VFS
+/* param is a VFS_FILE* */
+int Std_TraceSinkVfs(void *param, const void *data, uint32_t size);
+#endif
+#if defined(linux)
+/* param is the file descriptor of a file or a connected socket */
+int Std_TraceSinkFd(void *param, const void *data, uint32_t size);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -77,6 +77,26 @@ typedef enum
 
 typedef struct TcpIp_Config_s TcpIp_ConfigType;
 
+/* one datagram of the TcpIp_RecvFromMulti */
+typedef struct {
+  TcpIp_SockAddrType RemoteAddr;
+  uint8_t *BufPtr;
+  uint32_t Length; /* InOut */
+} TcpIp_MsgType;
+
+/* one buffer of the TcpIp_SendV */
+typedef struct {
+  const uint8_t *BufPtr;
+  uint32_t Length;
+} TcpIp_IoVecType;
+
+/* the time stamp of a datagram, in the clock of the Std_GetTimeNs, that is the StbM virtual local
+ * time */
+typedef struct {
+  uint32_t nanoseconds;
+  uint32_t seconds;
+} TcpIp_TimeStampType;
+
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
@@ -130,11 +150,30 @@ Std_ReturnType TcpIp_Recv(TcpIp_SocketIdType SocketId, uint8_t *BufPtr,
 Std_ReturnType TcpIp_RecvFrom(TcpIp_SocketIdType SocketId, TcpIp_SockAddrType *RemoteAddrPtr,
                               uint8_t *BufPtr, uint32_t *Length /* InOut */);
 
+/* receive up to Count datagrams by one call, the Count is updated to what was received, 0 if
+ * nothing pending. On linux this is one recvmmsg, else recvfrom is called for each. On linux a
+ * datagram bigger than its buffer is dropped, its Length is 0. */
+Std_ReturnType TcpIp_RecvFromMulti(TcpIp_SocketIdType SocketId, TcpIp_MsgType *Msgs,
+                                   uint32_t *Count /* InOut */);
+
+/* check which of the sockets have data to read or an error pending, the Ready is set TRUE for
+ * those, E_OK is returned if any is ready. A TimeoutMs 0 is a poll. If the check itself fails, or
+ * a socket is beyond the FD_SETSIZE, all are taken as ready so that the caller falls back to poll
+ * them one by one. */
+Std_ReturnType TcpIp_Select(const TcpIp_SocketIdType *SocketIds, boolean *Ready, uint32_t Num,
+                            uint32_t TimeoutMs);
+
 Std_ReturnType TcpIp_SendTo(TcpIp_SocketIdType SocketId, const TcpIp_SockAddrType *RemoteAddrPtr,
                             const uint8_t *BufPtr, uint32_t Length);
 
 Std_ReturnType TcpIp_Send(TcpIp_SocketIdType SocketId, const uint8_t *BufPtr, uint32_t Length);
 
+/* send the buffers by one gathered write without copying them together. The Length is set to the
+ * bytes taken by the stack, TCPIP_E_NOSPACE is returned if not all were taken and the caller shall
+ * send the rest later, this never blocks. */
+Std_ReturnType TcpIp_SendV(TcpIp_SocketIdType SocketId, const TcpIp_IoVecType *Vecs, uint32_t Num,
+                           uint32_t *Length /* Out */);
+
 /*
  * Idel: The time (in seconds) the connection needs to remain idle before TCP starts sending
  * keepalive probes,
@@ -145,6 +184,23 @@ Std_ReturnType TcpIp_TcpKeepAlive(TcpIp_SocketIdType SocketId, uint32_t Idel, ui
                                   uint32_t Count);
 
 uint16_t TcpIp_Tell(TcpIp_SocketIdType SocketId);
+
+/* let the stack take the time stamps of the datagrams of the UDP socket when they are sent and
+ * received, so that they have no latency of the main function. E_NOT_OK if the stack has none, on
+ * linux they are the SO_TIMESTAMPING of the kernel. */
+Std_ReturnType TcpIp_EnableTimeStamp(TcpIp_SocketIdType SocketId);
+
+/* as the TcpIp_RecvFrom, with the ingress time stamp of the datagram, which is the time it is read
+ * if the stack has none */
+Std_ReturnType TcpIp_RecvFromWithTimeStamp(TcpIp_SocketIdType SocketId,
+                                           TcpIp_SockAddrType *RemoteAddrPtr, uint8_t *BufPtr,
+                                           uint32_t *Length /* InOut */,
+                                           TcpIp_TimeStampType *TimeStampPtr);
+
+/* the egress time stamp of the next datagram sent since the TcpIp_EnableTimeStamp, the Id counts
+ * the datagrams sent from 0. E_NOT_OK if there is none yet. */
+Std_ReturnType TcpIp_GetEgressTimeStamp(TcpIp_SocketIdType SocketId, uint32_t *IdPtr,
+                                        TcpIp_TimeStampType *TimeStampPtr);
 #ifdef __cplusplus
 }
 #endif
@@ -69,6 +69,12 @@ Std_ReturnType UdpNm_CheckRemoteSleepIndication(NetworkHandleType nmChannelHandl
 /* @SWS_UdpNm_00324 */
 Std_ReturnType UdpNm_SetSleepReadyBit(NetworkHandleType nmChannelHandle, boolean nmSleepReadyBit);
 
+/* @SWS_UdpNm_00344 */
+void UdpNm_ConfirmPnAvailability(NetworkHandleType nmChannelHandle);
+
+/* the PNs requested by this ECU, PnInfoLength bytes sent at the PnInfoOffset of the NM PDU */
+Std_ReturnType UdpNm_SetPnInfo(NetworkHandleType nmChannelHandle, const uint8 *PnInfo);
+
 /* @SWS_UdpNm_00313 */
 Std_ReturnType UdpNm_Transmit(PduIdType TxPduId, const PduInfoType *PduInfoPtr);
 
@@ -7,11 +7,16 @@
 #define _FACTORY_H
 /* ================================ [ INCLUDES  ] ============================================== */
 #include "Std_Types.h"
+#ifdef FACTORY_USE_BUDGET
+#include "Std_Timer.h"
+#endif
 /* ================================ [ MACROS    ] ============================================== */
 /* depend on event happens */
 #define FACTORY_E_EVENT 10
 /* Stop this factory */
 #define FACTORY_E_STOP 11
+/* stay on this node, but nothing more can be done in this cycle, e.g. the hardware is busy */
+#define FACTORY_E_YIELD 12
 
 #define FACTORY_MAX_MACHINES 80
 /* from 20 to 99, map machine 0 to 79, switch to that machine */
@@ -28,14 +33,34 @@
 #define factory_switch(machine) (Std_ReturnType)(FACTORY_E_SWITCH_TO + FEE_MACHINE_##machine)
 #define factory_goto(node) (Std_ReturnType)(FACTORY_E_GOTO + FEE_NODE_##node)
 /* ================================ [ TYPES     ] ============================================== */
+typedef struct factory_s factory_t;
+
+#ifdef FACTORY_USE_BUDGET
+typedef struct {
+  uint32_t calls;     /* number of factory_main that run at least one node */
+  uint32_t steps;     /* number of nodes that were run */
+  uint32_t exhausted; /* number of factory_main that was stopped by the budget */
+  uint16_t maxSteps;  /* max nodes run by one factory_main */
+  std_time_t maxTime; /* max time of one factory_main in us */
+  std_time_t sumTime;
+} factory_stats_t;
+#endif
+
 typedef struct {
   uint8_t state;
   uint8_t machineId;
   uint8_t nodeId;
+#ifdef FACTORY_USE_BUDGET
+  boolean registered;
+  /* the budget of one factory_main, 0 steps means 1 node per call as the default,
+   * 0 us means no time limit */
+  uint16_t maxSteps;
+  uint32_t budgetUs;
+  factory_stats_t stats;
+  const factory_t *next;
+#endif
 } factory_context_t;
 
-typedef struct factory_s factory_t;
-
 typedef Std_ReturnType (*factory_event_t)(void);
 typedef Std_ReturnType (*factory_main_t)(void);
 
@@ -72,10 +97,18 @@ typedef struct factory_s {
 void factory_init(const factory_t *factory);
 void factory_cancel(const factory_t *factory);
 
+/* Run the current node of the factory. With FACTORY_USE_BUDGET, the following nodes will be run
+ * in the same call until the step or time budget is used up or the factory has to wait for an
+ * event or a node yields, FACTORY_E_YIELD is returned for the latter. */
 Std_ReturnType factory_main(const factory_t *factory);
 Std_ReturnType factory_on_event(const factory_t *factory, uint8_t eventId);
 
 Std_ReturnType factory_start_machine(const factory_t *factory, uint8_t machineId);
 
 uint8_t factory_get_state(const factory_t *factory);
+
+#ifdef FACTORY_USE_BUDGET
+void factory_set_budget(const factory_t *factory, uint16_t maxSteps, uint32_t budgetUs);
+void factory_get_stats(const factory_t *factory, factory_stats_t *stats);
+#endif
 #endif /* _FACTORY_H */
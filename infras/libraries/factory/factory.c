@@ -6,11 +6,19 @@
 /* ================================ [ INCLUDES  ] ============================================== */
 #include "factory.h"
 #include "Std_Debug.h"
+#if defined(USE_SHELL) && defined(FACTORY_USE_BUDGET)
+#include "shell.h"
+#include <string.h>
+#include <stdlib.h>
+#endif
 /* ================================ [ MACROS    ] ============================================== */
 #define AS_LOG_FACTORY 0
 /* ================================ [ TYPES     ] ============================================== */
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
+#ifdef FACTORY_USE_BUDGET
+static const factory_t *lFactoryList = NULL;
+#endif
 /* ================================ [ LOCALS    ] ============================================== */
 static Std_ReturnType factory_health_check(const factory_t *factory) {
   Std_ReturnType ret = E_NOT_OK;
@@ -39,8 +47,9 @@ Std_ReturnType factory_post(const factory_t *factory, uint8_t machineId, uint8_t
                             Std_ReturnType ercd) {
   Std_ReturnType ret = ercd;
 
-  if (E_OK == ercd) {
+  if ((E_OK == ercd) || (FACTORY_E_YIELD == ercd)) {
     /* pass */
+    ret = E_OK;
   } else if (FACTORY_E_EVENT == ercd) {
     factory->context->state = FACTORY_WAITING;
     ret = E_OK;
@@ -86,11 +95,136 @@ Std_ReturnType factory_post(const factory_t *factory, uint8_t machineId, uint8_t
 
   return ret;
 }
+
+static Std_ReturnType factory_run_node(const factory_t *factory, Std_ReturnType *ercd) {
+  Std_ReturnType ret;
+  uint8_t machineId;
+  uint8_t nodeId;
+
+  ret = factory_health_check(factory);
+  if (E_OK == ret) {
+    machineId = factory->context->machineId;
+    nodeId = factory->context->nodeId;
+    ASLOG(FACTORY, ("%s: %s %s main\n", factory->name, factory->machines[machineId].name,
+                    factory->machines[machineId].nodes[nodeId].name));
+    *ercd = factory->machines[machineId].nodes[nodeId].main();
+    ret = factory_post(factory, machineId, nodeId, *ercd);
+  }
+
+  return ret;
+}
+
+#ifdef FACTORY_USE_BUDGET
+static Std_ReturnType factory_run_budget(const factory_t *factory) {
+  Std_ReturnType ret = E_OK;
+  Std_ReturnType ercd = E_OK;
+  factory_context_t *context = factory->context;
+  uint16_t maxSteps = context->maxSteps;
+  uint16_t steps = 0;
+  std_time_t start = Std_GetTime();
+  std_time_t elapsed = 0;
+  boolean exhausted = FALSE;
+
+  if (0u == maxSteps) {
+    maxSteps = 1;
+  }
+
+  /* keep on running nodes while the factory still has work to do: a node that waits for an event
+   * or yields as the hardware is busy ends this cycle, the same for a stop or a failure */
+  while ((FACTORY_RUNNING == context->state) && (FACTORY_E_YIELD != ercd) &&
+         ((E_OK == ret) || (FACTORY_E_SWITCH_TO == ret) || (FACTORY_E_GOTO == ret)) &&
+         (FALSE == exhausted)) {
+    ret = factory_run_node(factory, &ercd);
+    steps++;
+    elapsed = Std_GetTime() - start;
+    if ((steps >= maxSteps) || ((0u != context->budgetUs) && (elapsed >= context->budgetUs))) {
+      exhausted = TRUE;
+    }
+  }
+
+  if (steps > 0u) {
+    context->stats.calls++;
+    context->stats.steps += steps;
+    context->stats.sumTime += elapsed;
+    if (steps > context->stats.maxSteps) {
+      context->stats.maxSteps = steps;
+    }
+    if (elapsed > context->stats.maxTime) {
+      context->stats.maxTime = elapsed;
+    }
+    if ((TRUE == exhausted) && (FACTORY_RUNNING == context->state) && (FACTORY_E_YIELD != ercd)) {
+      context->stats.exhausted++;
+    }
+  }
+
+  if ((E_OK == ret) && (FACTORY_E_YIELD == ercd)) {
+    ret = FACTORY_E_YIELD; /* tell the caller the hardware is busy, not the node failed */
+  }
+
+  return ret;
+}
+#endif
+
+#if defined(USE_SHELL) && defined(FACTORY_USE_BUDGET)
+static int factoryFunc(int argc, const char *argv[]) {
+  int ret = 0;
+  const factory_t *factory;
+  factory_context_t *context;
+
+  if (1 == argc) {
+    printf("%-12s %8s %8s %6s %8s %10s %8s %8s\n", "name", "budget", "calls", "steps", "avgSteps",
+           "exhausted", "avgUs", "maxUs");
+    for (factory = lFactoryList; factory != NULL; factory = factory->context->next) {
+      context = factory->context;
+      printf("%-12s %3u/%4u %8u %6u %8u %10u %8u %8u\n", factory->name,
+             (uint32_t)context->maxSteps, (uint32_t)context->budgetUs, context->stats.calls,
+             (uint32_t)context->stats.maxSteps,
+             (0u != context->stats.calls) ? (context->stats.steps / context->stats.calls) : 0u,
+             context->stats.exhausted,
+             (0u != context->stats.calls) ? (uint32_t)(context->stats.sumTime / context->stats.calls)
+                                          : 0u,
+             (uint32_t)context->stats.maxTime);
+    }
+  } else if ((2 == argc) && (0 == strcmp(argv[1], "reset"))) {
+    for (factory = lFactoryList; factory != NULL; factory = factory->context->next) {
+      memset(&factory->context->stats, 0, sizeof(factory_stats_t));
+    }
+  } else if (4 == argc) {
+    for (factory = lFactoryList; factory != NULL; factory = factory->context->next) {
+      if (0 == strcmp(argv[1], factory->name)) {
+        break;
+      }
+    }
+    if (NULL != factory) {
+      factory_set_budget(factory, (uint16_t)strtoul(argv[2], NULL, 10),
+                         (uint32_t)strtoul(argv[3], NULL, 10));
+    } else {
+      ret = -2;
+    }
+  } else {
+    ret = -1;
+  }
+
+  return ret;
+}
+SHELL_REGISTER(factory,
+               "factory [reset | name steps us]\n"
+               "  show the step and latency statistics of factories, reset them,\n"
+               "  or set the max nodes and the time budget of one main cycle of a factory\n",
+               factoryFunc);
+#endif
 /* ================================ [ FUNCTIONS ] ============================================== */
 void factory_init(const factory_t *factory) {
   factory->context->state = FACTORY_IDLE;
   factory->context->machineId = 0;
   factory->context->nodeId = 0;
+#ifdef FACTORY_USE_BUDGET
+  if (FALSE == factory->context->registered) {
+    factory->context->registered = TRUE;
+    factory->context->next = lFactoryList;
+    lFactoryList = factory;
+  }
+#endif
 }
 
 void factory_cancel(const factory_t *factory) {
@@ -107,19 +241,16 @@ void factory_cancel(const factory_t *factory) {
 
 Std_ReturnType factory_main(const factory_t *factory) {
   Std_ReturnType ret = E_OK;
-  uint8_t machineId;
-  uint8_t nodeId;
+#ifndef FACTORY_USE_BUDGET
+  Std_ReturnType ercd;
+#endif
 
   if (FACTORY_RUNNING == factory->context->state) {
-    ret = factory_health_check(factory);
-    if (E_OK == ret) {
-      machineId = factory->context->machineId;
-      nodeId = factory->context->nodeId;
-      ASLOG(FACTORY, ("%s: %s %s main\n", factory->name, factory->machines[machineId].name,
-                      factory->machines[machineId].nodes[nodeId].name));
-      ret = factory->machines[machineId].nodes[nodeId].main();
-      ret = factory_post(factory, machineId, nodeId, ret);
-    }
+#ifdef FACTORY_USE_BUDGET
+    ret = factory_run_budget(factory);
+#else
+    ret = factory_run_node(factory, &ercd);
+#endif
   }
 
   return ret;
@@ -184,3 +315,15 @@ Std_ReturnType factory_start_machine(const factory_t *factory, uint8_t machineId
 uint8_t factory_get_state(const factory_t *factory) {
   return factory->context->state;
 }
+
+#ifdef FACTORY_USE_BUDGET
+void factory_set_budget(const factory_t *factory, uint16_t maxSteps, uint32_t budgetUs) {
+  factory->context->maxSteps = maxSteps;
+  factory->context->budgetUs = budgetUs;
+  ASLOG(FACTORY, ("%s: budget %u steps %u us\n", factory->name, maxSteps, budgetUs));
+}
+
+void factory_get_stats(const factory_t *factory, factory_stats_t *stats) {
+  *stats = factory->context->stats;
+}
+#endif
@@ -25,10 +25,28 @@
 
 #define FEE_CONFIG (&Fee_Config)
 
+#ifdef FACTORY_USE_BUDGET
+/* the Fls is busy, no more node can be run in this cycle */
+#define FACTORY_E_FEE_RETRY FACTORY_E_YIELD
+#else
 #define FACTORY_E_FEE_RETRY E_OK
+#endif
 
 #define FEE_E_EXIST 0x10
 
+/* the Fls job result left by the Fls notifications for Fee_MainFunction */
+#define FEE_JOB_NONE 0
+#define FEE_JOB_END 1
+#define FEE_JOB_ERROR 2
+
+#ifndef FEE_FACTORY_MAX_STEPS
+#define FEE_FACTORY_MAX_STEPS 8
+#endif
+
+#ifndef FEE_FACTORY_BUDGET_US
+#define FEE_FACTORY_BUDGET_US 200
+#endif
+
 #ifndef FEE_MAX_ADMIN_READ_PER_CYCLE
 #define FEE_MAX_ADMIN_READ_PER_CYCLE 100
 #endif
@@ -57,6 +75,7 @@ typedef struct {
   uint32_t dataFreeAddr;  /* bank high address */
   uint8_t curWrokingBank;
   uint8_t retryCounter;
+  volatile uint8_t jobResult;
   struct {
     uint16_t BlockId;
     uint16_t BlockOffset;
@@ -66,6 +85,12 @@ typedef struct {
     uint32_t Length;
     uint32_t NextAddr;
   } job;
+#ifdef FEE_USE_CHECKPOINT
+  struct {
+    uint32_t FreeSpace; /* free space of the working bank when the latest checkpoint was done */
+    uint8_t RefIndex;   /* index of the next free checkpoint reference of the working bank */
+  } checkpoint;
+#endif
 } Fee_ContextType;
 /* ================================ [ DECLARES  ] ============================================== */
 extern const Fee_ConfigType Fee_Config;
@@ -118,13 +143,34 @@ static boolean Fee_IsAllErased(uint8_t *data, uint16_t size) {
   return r;
 }
 
-static Std_ReturnType Fee_DoWrite_Admin(boolean fromBackup) {
+static Std_ReturnType Fee_DoWrite_AdminRecord(uint16_t BlockNumber, uint16_t size,
+                                              uint32_t NumberOfWriteCycles) {
   Std_ReturnType r;
   const Fee_ConfigType *config = FEE_CONFIG;
   Fee_ContextType *context = &Fee_Context;
   Fee_BlockType *admin;
   uint32_t address;
-  uint16_t size;
+
+  address = context->dataFreeAddr - FEE_DATA_ALIGNED(size);
+  admin = (Fee_BlockType *)config->workingArea;
+  admin->BlockNumber = BlockNumber;
+  admin->InvBlockNumber = ~BlockNumber;
+  admin->Address = address;
+  admin->NumberOfWriteCycles = NumberOfWriteCycles;
+  admin->BlockSize = size;
+  admin->Crc = Crc_CalculateCRC16((uint8_t *)admin, offsetof(Fee_BlockType, Crc), 0, TRUE);
+  r = Fee_FlsWrite(context->adminFreeAddr, (uint8_t *)admin, sizeof(Fee_BlockType));
+  if (E_OK == r) {
+    context->adminFreeAddr += FEE_ALIGNED(sizeof(Fee_BlockType));
+    context->dataFreeAddr -= FEE_DATA_ALIGNED(size);
+  }
+
+  return r;
+}
+
+static Std_ReturnType Fee_DoWrite_Admin(boolean fromBackup) {
+  const Fee_ConfigType *config = FEE_CONFIG;
+  Fee_ContextType *context = &Fee_Context;
   uint32_t NumberOfWriteCycles = 1;
 #ifdef FLS_DIRECT_ACCESS
   const Fee_BlockType *block;
@@ -146,22 +192,23 @@ static Std_ReturnType Fee_DoWrite_Admin(boolean fromBackup) {
   }
 #endif
 
-  size = config->Blocks[context->job.BlockId].BlockSize;
-  address = context->dataFreeAddr - FEE_DATA_ALIGNED(size);
-  admin = (Fee_BlockType *)config->workingArea;
-  admin->BlockNumber = context->job.BlockId + 1;
-  admin->InvBlockNumber = ~(context->job.BlockId + 1);
-  admin->Address = address;
-  admin->NumberOfWriteCycles = NumberOfWriteCycles;
-  admin->BlockSize = size;
-  admin->Crc = Crc_CalculateCRC16((uint8_t *)admin, offsetof(Fee_BlockType, Crc), 0, TRUE);
-  r = Fee_FlsWrite(context->adminFreeAddr, (uint8_t *)admin, sizeof(Fee_BlockType));
-  if (E_OK == r) {
-    context->adminFreeAddr += FEE_ALIGNED(sizeof(Fee_BlockType));
-    context->dataFreeAddr -= FEE_DATA_ALIGNED(size);
-  }
+  return Fee_DoWrite_AdminRecord(context->job.BlockId + 1,
+                                 config->Blocks[context->job.BlockId].BlockSize,
+                                 NumberOfWriteCycles);
+}
 
-  return r;
+static void Fee_FillDataCrc(uint8_t *data, uint16_t size) {
+  uint16_t *crc;
+  uint16_t *invCrc;
+  int i;
+
+  for (i = size; i < FEE_DATA_ALIGNED(size) - 4; i++) {
+    data[i] = FLS_ERASED_VALUE;
+  }
+  crc = (uint16_t *)(data + FEE_DATA_ALIGNED(size) - 4);
+  invCrc = crc + 1;
+  *crc = Crc_CalculateCRC16(data, FEE_DATA_ALIGNED(size) - 4, 0, TRUE);
+  *invCrc = ~(*crc);
 }
 
 static Std_ReturnType Fee_DoWrite_Data(uint8_t *jobDataBufferPtr) {
@@ -171,21 +218,12 @@ static Std_ReturnType Fee_DoWrite_Data(uint8_t *jobDataBufferPtr) {
   uint32_t address;
   uint16_t size;
   uint8_t *data;
-  uint16_t *crc;
-  uint16_t *invCrc;
-  int i;
   size = config->Blocks[context->job.BlockId].BlockSize;
   address = context->dataFreeAddr;
   data = config->workingArea;
   if (data != jobDataBufferPtr) {
     memcpy(data, jobDataBufferPtr, size);
-    for (i = size; i < FEE_DATA_ALIGNED(size) - 4; i++) {
-      data[i] = FLS_ERASED_VALUE;
-    }
-    crc = (uint16_t *)(data + FEE_DATA_ALIGNED(size) - 4);
-    invCrc = crc + 1;
-    *crc = Crc_CalculateCRC16(data, FEE_DATA_ALIGNED(size) - 4, 0, TRUE);
-    *invCrc = ~(*crc);
+    Fee_FillDataCrc(data, size);
   }
   r = Fee_FlsWrite(address, data, FEE_DATA_ALIGNED(size));
   return r;
@@ -230,7 +268,13 @@ static boolean Fee_SearchFreeSpace_Analyze(const Fee_BlockType *blocks, uint32_t
       if (Crc == block->Crc) {
         /* During sudden power off test, find that sometimes CRC is correct
          * for the admin block, but in fact, it is not correct, so it can't panic */
-        if ((block->BlockNumber <= config->numOfBlocks) && (block->BlockNumber > 0)) {
+#ifdef FEE_USE_CHECKPOINT
+        if (FEE_CHECKPOINT_BLOCK_NUMBER == block->BlockNumber) {
+          /* a checkpoint record, only its data space need to be skipped */
+          context->dataFreeAddr -= FEE_DATA_ALIGNED(block->BlockSize);
+        } else
+#endif
+          if ((block->BlockNumber <= config->numOfBlocks) && (block->BlockNumber > 0)) {
           if (block->BlockSize == config->Blocks[block->BlockNumber - 1].BlockSize) {
             context->dataFreeAddr -= FEE_DATA_ALIGNED(block->BlockSize);
             if (block->Address == context->dataFreeAddr) {
@@ -410,9 +454,142 @@ static Std_ReturnType Fee_DoBackup_Copy_Start(void) {
   context->adminFreeAddr = bank->LowAddress + offsetof(Fee_BankAdminType, blocks);
   context->dataFreeAddr = bank->HighAddress;
   context->job.BlockId = 0;
+#ifdef FEE_USE_CHECKPOINT
+  context->checkpoint.RefIndex = 0;
+  context->checkpoint.FreeSpace = bank->HighAddress - bank->LowAddress;
+#endif
 
   return factory_goto(BACKUP_COPY_ADMIN);
 }
+
+#ifdef FEE_USE_CHECKPOINT
+static uint16_t Fee_Checkpoint_ConfigCrc(void) {
+  const Fee_ConfigType *config = FEE_CONFIG;
+  uint16_t crc = 0;
+  int i;
+
+  for (i = 0; i < config->numOfBlocks; i++) {
+    crc = Crc_CalculateCRC16((const uint8_t *)&config->Blocks[i].BlockSize, sizeof(uint16_t), crc,
+                             (0 == i) ? TRUE : FALSE);
+  }
+
+  return crc;
+}
+
+/* The checkpoints are spread over the whole bank, a new one is due when 1/(FEE_CHECKPOINT_NUM+1)
+ * of the bank was used since the latest one, so the init needs to search at most that part */
+static boolean Fee_Checkpoint_IsDue(boolean force) {
+  const Fee_ConfigType *config = FEE_CONFIG;
+  Fee_ContextType *context = &Fee_Context;
+  const Fee_BankType *bank = &config->Banks[context->curWrokingBank];
+  uint32_t spacing = (bank->HighAddress - bank->LowAddress) / (FEE_CHECKPOINT_NUM + 1);
+  uint32_t freeSpace = context->dataFreeAddr - context->adminFreeAddr;
+  uint16_t size = FEE_CHECKPOINT_SIZE(config->numOfBlocks);
+  boolean r = FALSE;
+
+  /* the checkpoint shall never take the space that is reserved for the backup */
+  if (((TRUE == force) || ((context->checkpoint.FreeSpace - freeSpace) >= spacing)) &&
+      (context->checkpoint.RefIndex < FEE_CHECKPOINT_NUM) &&
+      (FEE_DATA_ALIGNED(size) <= config->sizeOfWorkingArea) &&
+      ((context->dataFreeAddr - context->adminFreeAddr) >=
+       (FEE_BLOCK_ADMIN_AND_DATA_SIZE(size) + FEE_MIN_FREE_SPACE))) {
+    r = TRUE;
+  }
+
+  return r;
+}
+
+/* find the latest valid checkpoint reference of the working bank, if there is one, load the
+ * checkpoint, else search the free space from the begin of the bank */
+static Std_ReturnType Fee_Checkpoint_Lookup(const Fee_BankAdminType *bankAdmin) {
+  const Fee_ConfigType *config = FEE_CONFIG;
+  Fee_ContextType *context = &Fee_Context;
+  const Fee_BankType *bank = &config->Banks[context->curWrokingBank];
+  const Fee_CheckpointRefType *ref;
+  uint32_t size = FEE_DATA_ALIGNED(FEE_CHECKPOINT_SIZE(config->numOfBlocks));
+  uint32_t address = FEE_INVALID_ADDRESS;
+  Std_ReturnType ret;
+  int i;
+
+  context->checkpoint.RefIndex = 0;
+  context->checkpoint.FreeSpace = bank->HighAddress - bank->LowAddress;
+  for (i = 0; i < FEE_CHECKPOINT_NUM; i++) {
+    ref = &bankAdmin->Checkpoints[i];
+    if (FALSE == Fee_IsAllErased((uint8_t *)ref, sizeof(Fee_CheckpointRefType))) {
+      context->checkpoint.RefIndex = i + 1;
+      if (ref->Address == (~ref->InvAddress)) {
+        address = ref->Address;
+      }
+    }
+  }
+
+  if ((FEE_INVALID_ADDRESS != address) && (size <= config->sizeOfWorkingArea) &&
+      (address >= (bank->LowAddress + offsetof(Fee_BankAdminType, blocks))) &&
+      (address <= (bank->HighAddress - size))) {
+    ASLOG(FEE, ("bank %d has checkpoint @ %X\n", context->curWrokingBank, address));
+    context->job.NextAddr = address;
+    ret = factory_goto(INIT_LOAD_CHECKPOINT);
+  } else {
+    ret = factory_goto(INIT_SEARCH_FREE_SPACE);
+  }
+
+  return ret;
+}
+
+/* verify the checkpoint data @ address and restore the blocks address and the free space from it,
+ * nothing will be changed if the checkpoint is not valid */
+static Std_ReturnType Fee_Checkpoint_Restore(const uint8_t *pData, uint32_t address) {
+  Std_ReturnType r = E_NOT_OK;
+  const Fee_ConfigType *config = FEE_CONFIG;
+  Fee_ContextType *context = &Fee_Context;
+  const Fee_BankType *bank = &config->Banks[context->curWrokingBank];
+  const Fee_CheckpointType *checkpoint = (const Fee_CheckpointType *)pData;
+  const uint32_t *blockAddress = (const uint32_t *)&checkpoint[1];
+  uint16_t size = FEE_CHECKPOINT_SIZE(config->numOfBlocks);
+  const uint16_t *pCrc = (const uint16_t *)(pData + FEE_DATA_ALIGNED(size) - 4);
+  const uint16_t *pInvCrc = pCrc + 1;
+  uint32_t low;
+  uint32_t high;
+  int i;
+
+  if (((uint16_t)(~(*pCrc)) == (*pInvCrc)) &&
+      ((*pCrc) == Crc_CalculateCRC16(pData, FEE_DATA_ALIGNED(size) - 4, 0, TRUE))) {
+    if ((FEE_CHECKPOINT_MAGIC_NUMBER == checkpoint->MagicNumber) &&
+        (config->numOfBlocks == checkpoint->NumberOfBlocks) &&
+        (Fee_Checkpoint_ConfigCrc() == checkpoint->ConfigCrc) &&
+        (checkpoint->AdminAddress >= (bank->LowAddress + offsetof(Fee_BankAdminType, blocks))) &&
+        ((checkpoint->AdminAddress + FEE_ALIGNED(sizeof(Fee_BlockType))) <= address)) {
+      r = E_OK;
+    }
+  }
+
+#ifdef FLS_DIRECT_ACCESS
+  /* the address of the admin record */
+  low = bank->LowAddress + offsetof(Fee_BankAdminType, blocks);
+  high = checkpoint->AdminAddress;
+#else
+  /* the address of the data */
+  low = address + FEE_DATA_ALIGNED(size);
+  high = bank->HighAddress;
+#endif
+  for (i = 0; (i < config->numOfBlocks) && (E_OK == r); i++) {
+    if ((FEE_INVALID_ADDRESS != blockAddress[i]) &&
+        ((blockAddress[i] < low) || (blockAddress[i] >= high))) {
+      ASLOG(FEEE, ("checkpoint with invalid address %X for block %d\n", blockAddress[i], i));
+      r = E_NOT_OK;
+    }
+  }
+
+  if (E_OK == r) {
+    memcpy(config->blockAddress, blockAddress, sizeof(uint32_t) * config->numOfBlocks);
+    context->adminFreeAddr = checkpoint->AdminAddress + FEE_ALIGNED(sizeof(Fee_BlockType));
+    context->dataFreeAddr = address;
+    context->checkpoint.FreeSpace = address - context->adminFreeAddr;
+  }
+
+  return r;
+}
+#endif
 /* ================================ [ FUNCTIONS ] ============================================== */
 void Fee_FactoryStateNotification(uint8_t machineId, machine_state_t state) {
   const Fee_ConfigType *config = FEE_CONFIG;
@@ -616,7 +793,7 @@ Std_ReturnType Fee_Init_EraseInvalidBank_Main(void) {
   if (E_OK == ret) {
     ret = FACTORY_E_EVENT;
   } else {
-    ret = E_OK;
+    ret = FACTORY_E_FEE_RETRY;
   }
   return ret;
 }
@@ -826,7 +1003,11 @@ Std_ReturnType Fee_Init_GetWorkingBank_Main(void) {
     context->dataFreeAddr = config->Banks[whichBank].HighAddress;
     context->curWrokingBank = whichBank;
     ASLOG(FEE, ("FEE Init and Post Check Finished, activate bank is %d\n", whichBank));
+#ifdef FEE_USE_CHECKPOINT
+    ret = Fee_Checkpoint_Lookup(&bankAdmin[whichBank]);
+#else
     ret = factory_goto(INIT_SEARCH_FREE_SPACE);
+#endif
   } else if (2 == bankWithBlocks) {
     if (fullBank != -1) {
       /* 2 banks has data, there is must be one in FULL state, and should ensure all data backedup
@@ -837,7 +1018,11 @@ Std_ReturnType Fee_Init_GetWorkingBank_Main(void) {
       context->curWrokingBank = fullBank;
       ASLOG(FEE, ("FEE Init and Post Check Finished, activate bank is %d, but which is full\n",
                   whichBank));
+#ifdef FEE_USE_CHECKPOINT
+      ret = Fee_Checkpoint_Lookup(&bankAdmin[fullBank]);
+#else
       ret = factory_goto(INIT_SEARCH_FREE_SPACE);
+#endif
     } else {
       ASLOG(FEEE, ("impossible case, 2 banks has data, but no one is full\n"));
       Fee_Panic();
@@ -858,6 +1043,54 @@ Std_ReturnType Fee_Init_GetWorkingBank_Error(void) {
   return E_NOT_OK;
 }
 
+Std_ReturnType Fee_Init_LoadCheckpoint_Main(void) {
+  Std_ReturnType ret = E_NOT_OK;
+#ifdef FEE_USE_CHECKPOINT
+#ifdef FLS_DIRECT_ACCESS
+  ret = Fee_Init_LoadCheckpoint_End();
+#else
+  const Fee_ConfigType *config = FEE_CONFIG;
+  Fee_ContextType *context = &Fee_Context;
+
+  ret = Fls_Read(context->job.NextAddr, config->workingArea,
+                 FEE_DATA_ALIGNED(FEE_CHECKPOINT_SIZE(config->numOfBlocks)));
+  if (E_OK == ret) {
+    ret = FACTORY_E_EVENT;
+  } else {
+    ret = FACTORY_E_FEE_RETRY;
+  }
+#endif
+#endif
+  return ret;
+}
+
+Std_ReturnType Fee_Init_LoadCheckpoint_End(void) {
+  Std_ReturnType ret = E_NOT_OK;
+#ifdef FEE_USE_CHECKPOINT
+  Fee_ContextType *context = &Fee_Context;
+#ifdef FLS_DIRECT_ACCESS
+  const uint8_t *pData = (const uint8_t *)FEE_ADDRESS(context->job.NextAddr);
+#else
+  const uint8_t *pData = FEE_CONFIG->workingArea;
+#endif
+
+  ret = Fee_Checkpoint_Restore(pData, context->job.NextAddr);
+  if (E_OK == ret) {
+    ASLOG(FEE, ("Restored from checkpoint @ %X, search from 0x%X - 0x%X\n", context->job.NextAddr,
+                context->adminFreeAddr, context->dataFreeAddr));
+  } else {
+    /* the adminFreeAddr and dataFreeAddr are still the begin of the bank */
+    ASLOG(FEEE, ("checkpoint @ %X is invalid, do full search\n", context->job.NextAddr));
+  }
+  ret = factory_goto(INIT_SEARCH_FREE_SPACE);
+#endif
+  return ret;
+}
+
+Std_ReturnType Fee_Init_LoadCheckpoint_Error(void) {
+  return FACTORY_E_FEE_RETRY;
+}
+
 Std_ReturnType Fee_Init_SearchFreeSpace_Main(void) {
   Std_ReturnType ret = E_NOT_OK;
   const Fee_ConfigType *config = FEE_CONFIG;
@@ -1154,6 +1387,11 @@ Std_ReturnType Fee_Write_WriteData_End(void) {
     ASLOG(FEEI, ("bank %d is full, do backup\n", context->curWrokingBank));
   } else {
     ret = FACTORY_E_STOP;
+#ifdef FEE_USE_CHECKPOINT
+    if (TRUE == Fee_Checkpoint_IsDue(FALSE)) {
+      ret = factory_switch(CHECKPOINT);
+    }
+#endif
   }
 
   return ret;
@@ -1762,6 +2000,12 @@ Std_ReturnType Fee_Backup_SetBankAdmin_Main(void) {
   } else {
     ret = FACTORY_E_STOP;
     ASLOG(FEE, ("backup done\n"));
+#ifdef FEE_USE_CHECKPOINT
+    /* all the blocks were just copied, checkpoint them to save a full search on next init */
+    if (TRUE == Fee_Checkpoint_IsDue(TRUE)) {
+      ret = factory_switch(CHECKPOINT);
+    }
+#endif
   }
 
   return ret;
@@ -1786,27 +2030,143 @@ Std_ReturnType Fee_Backup_SetBankAdmin_Error(void) {
   return FACTORY_E_FEE_RETRY;
 }
 
-void Fee_JobEndNotification(void) {
+#ifdef FEE_USE_CHECKPOINT
+Std_ReturnType Fee_Checkpoint_WriteAdmin_Main(void) {
+  Std_ReturnType ret;
+  const Fee_ConfigType *config = FEE_CONFIG;
+
+  ret = Fee_DoWrite_AdminRecord(FEE_CHECKPOINT_BLOCK_NUMBER,
+                                FEE_CHECKPOINT_SIZE(config->numOfBlocks), 1);
+  if (E_OK == ret) {
+    ret = FACTORY_E_EVENT;
+  } else {
+    ret = FACTORY_E_FEE_RETRY;
+  }
+
+  return ret;
+}
+
+Std_ReturnType Fee_Checkpoint_WriteAdmin_End(void) {
+  return factory_goto(CHECKPOINT_WRITE_DATA);
+}
+
+Std_ReturnType Fee_Checkpoint_WriteAdmin_Error(void) {
+  return FACTORY_E_FEE_RETRY;
+}
+
+Std_ReturnType Fee_Checkpoint_WriteData_Main(void) {
+  Std_ReturnType ret;
+  const Fee_ConfigType *config = FEE_CONFIG;
   Fee_ContextType *context = &Fee_Context;
-  context->retryCounter = 0;
-  factory_on_event(&Fee_Factory, FEE_EVENT_END);
+  Fee_CheckpointType *checkpoint = (Fee_CheckpointType *)config->workingArea;
+  uint16_t size = FEE_CHECKPOINT_SIZE(config->numOfBlocks);
+
+  checkpoint->MagicNumber = FEE_CHECKPOINT_MAGIC_NUMBER;
+  checkpoint->AdminAddress = context->adminFreeAddr - FEE_ALIGNED(sizeof(Fee_BlockType));
+  checkpoint->NumberOfBlocks = config->numOfBlocks;
+  checkpoint->ConfigCrc = Fee_Checkpoint_ConfigCrc();
+  memcpy(&checkpoint[1], config->blockAddress, sizeof(uint32_t) * config->numOfBlocks);
+  Fee_FillDataCrc(config->workingArea, size);
+  ret = Fee_FlsWrite(context->dataFreeAddr, config->workingArea, FEE_DATA_ALIGNED(size));
+  if (E_OK == ret) {
+    ret = FACTORY_E_EVENT;
+  } else {
+    ret = FACTORY_E_FEE_RETRY;
+  }
+
+  return ret;
 }
 
-void Fee_JobErrorNotification(void) {
+Std_ReturnType Fee_Checkpoint_WriteData_End(void) {
+  return factory_goto(CHECKPOINT_WRITE_REF);
+}
+
+Std_ReturnType Fee_Checkpoint_WriteData_Error(void) {
+  return FACTORY_E_FEE_RETRY;
+}
+
+/* the reference is the last one to be written, so a checkpoint interrupted by power off is never
+ * referenced, and it is just skipped as an unknown block by the search */
+Std_ReturnType Fee_Checkpoint_WriteRef_Main(void) {
+  Std_ReturnType ret;
   const Fee_ConfigType *config = FEE_CONFIG;
   Fee_ContextType *context = &Fee_Context;
+  const Fee_BankType *bank = &config->Banks[context->curWrokingBank];
+  Fee_CheckpointRefType *ref = (Fee_CheckpointRefType *)config->workingArea;
 
-  if (context->retryCounter <= config->maxJobRetry) {
-    context->retryCounter++;
-    factory_on_event(&Fee_Factory, FEE_EVENT_ERROR);
+  ref->Address = context->dataFreeAddr;
+  ref->InvAddress = ~context->dataFreeAddr;
+  ret = Fee_FlsWrite(bank->LowAddress + offsetof(Fee_BankAdminType, Checkpoints) +
+                       context->checkpoint.RefIndex * sizeof(Fee_CheckpointRefType),
+                     (uint8_t *)ref, sizeof(Fee_CheckpointRefType));
+  if (E_OK == ret) {
+    ret = FACTORY_E_EVENT;
   } else {
-    ASLOG(FEEE, ("reach max attempts during error:%s:%s\n",
-                 Fee_Factory.machines[Fee_Factory.context->machineId].name,
-                 Fee_Factory.machines[Fee_Factory.context->machineId]
-                   .nodes[Fee_Factory.context->nodeId]
-                   .name));
-    factory_cancel(&Fee_Factory);
+    ret = FACTORY_E_FEE_RETRY;
   }
+
+  return ret;
+}
+
+Std_ReturnType Fee_Checkpoint_WriteRef_End(void) {
+  Fee_ContextType *context = &Fee_Context;
+
+  ASLOG(FEE, ("checkpoint %d @ %X done\n", context->checkpoint.RefIndex, context->dataFreeAddr));
+  context->checkpoint.RefIndex++;
+  context->checkpoint.FreeSpace = context->dataFreeAddr - context->adminFreeAddr;
+
+  return FACTORY_E_STOP;
+}
+
+Std_ReturnType Fee_Checkpoint_WriteRef_Error(void) {
+  return FACTORY_E_FEE_RETRY;
+}
+#else
+Std_ReturnType Fee_Checkpoint_WriteAdmin_Main(void) {
+  return E_NOT_OK;
+}
+
+Std_ReturnType Fee_Checkpoint_WriteAdmin_End(void) {
+  return E_NOT_OK;
+}
+
+Std_ReturnType Fee_Checkpoint_WriteAdmin_Error(void) {
+  return E_NOT_OK;
+}
+
+Std_ReturnType Fee_Checkpoint_WriteData_Main(void) {
+  return E_NOT_OK;
+}
+
+Std_ReturnType Fee_Checkpoint_WriteData_End(void) {
+  return E_NOT_OK;
+}
+
+Std_ReturnType Fee_Checkpoint_WriteData_Error(void) {
+  return E_NOT_OK;
+}
+
+Std_ReturnType Fee_Checkpoint_WriteRef_Main(void) {
+  return E_NOT_OK;
+}
+
+Std_ReturnType Fee_Checkpoint_WriteRef_End(void) {
+  return E_NOT_OK;
+}
+
+Std_ReturnType Fee_Checkpoint_WriteRef_Error(void) {
+  return E_NOT_OK;
+}
+#endif
+
+/* the Fls notifications may be called from the ISR, so only the result is noted here, and the
+ * chain of the nodes goes on in Fee_MainFunction */
+void Fee_JobEndNotification(void) {
+  Fee_Context.jobResult = FEE_JOB_END;
+}
+
+void Fee_JobErrorNotification(void) {
+  Fee_Context.jobResult = FEE_JOB_ERROR;
 }
 
 MemIf_StatusType Fee_GetStatus(void) {
@@ -1836,6 +2196,9 @@ void Fee_Init(const Fee_ConfigType *ConfigPtr) {
   }
   memset(context, 0, sizeof(Fee_ContextType));
   factory_init(&Fee_Factory);
+#ifdef FACTORY_USE_BUDGET
+  factory_set_budget(&Fee_Factory, FEE_FACTORY_MAX_STEPS, FEE_FACTORY_BUDGET_US);
+#endif
   (void)factory_start_machine(&Fee_Factory, FEE_MACHINE_INIT);
 }
 
@@ -1920,15 +2283,41 @@ void Fee_MainFunction(void) {
   Std_ReturnType ret;
   const Fee_ConfigType *config = FEE_CONFIG;
   Fee_ContextType *context = &Fee_Context;
-  uint8_t state = factory_get_state(&Fee_Factory);
+  uint8_t jobResult = context->jobResult;
+  uint8_t state;
 
+  if (FEE_JOB_NONE != jobResult) {
+    /* cleared first as the event may start the next Fls job */
+    context->jobResult = FEE_JOB_NONE;
+    if (FEE_JOB_END == jobResult) {
+      context->retryCounter = 0;
+      (void)factory_on_event(&Fee_Factory, FEE_EVENT_END);
+    } else if (context->retryCounter <= config->maxJobRetry) {
+      context->retryCounter++;
+      (void)factory_on_event(&Fee_Factory, FEE_EVENT_ERROR);
+    } else {
+      ASLOG(FEEE, ("reach max attempts during error:%s:%s\n",
+                   Fee_Factory.machines[Fee_Factory.context->machineId].name,
+                   Fee_Factory.machines[Fee_Factory.context->machineId]
+                     .nodes[Fee_Factory.context->nodeId]
+                     .name));
+      factory_cancel(&Fee_Factory);
+    }
+  }
+
+  state = factory_get_state(&Fee_Factory);
   if (FACTORY_RUNNING == state) {
     if (context->retryCounter <= config->maxJobRetry) {
       context->retryCounter++;
       ret = factory_main(&Fee_Factory);
-      if ((FACTORY_E_SWITCH_TO == ret) || (FACTORY_E_GOTO == ret)) {
+      if (FACTORY_E_YIELD == ret) {
+        context->retryCounter = 0; /* the Fls is busy, it is not a failed attempt */
+      } else if ((FACTORY_E_SWITCH_TO == ret) || (FACTORY_E_GOTO == ret)) {
         context->retryCounter = 0;
+#ifndef FACTORY_USE_BUDGET
+        /* with the budget, factory_main already runs the next nodes */
         factory_main(&Fee_Factory);
+#endif
       }
     } else {
       ASLOG(FEEE, ("reach max attempts during main:%s:%s\n",
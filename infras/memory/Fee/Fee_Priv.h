@@ -35,6 +35,24 @@ extern "C" {
 #ifndef FEE_PAGE_SIZE
 #define FEE_PAGE_SIZE 8
 #endif
+
+#ifdef FEE_USE_CHECKPOINT
+/* number of checkpoints that could be referenced by the bank admin, when all of them are used,
+ * no more checkpoint will be written until the next bank switch */
+#ifndef FEE_CHECKPOINT_NUM
+#define FEE_CHECKPOINT_NUM 16
+#endif
+#endif
+
+/* block number of the checkpoint records, 0xFFFF is not allowed by @SWS_Fee_00006 */
+#define FEE_CHECKPOINT_BLOCK_NUMBER ((uint16_t)0xFFFE)
+
+#define FEE_CHECKPOINT_MAGIC_NUMBER                                                                \
+  (((uint32_t)'F' << 24) | ((uint32_t)'E' << 16) | ((uint32_t)'C' << 8) | ((uint32_t)'P'))
+
+/* the checkpoint header is followed by the address of each block */
+#define FEE_CHECKPOINT_SIZE(numOfBlocks)                                                           \
+  (sizeof(Fee_CheckpointType) + sizeof(uint32_t) * (numOfBlocks))
 /* ================================ [ TYPES     ] ============================================== */
 /* Mapping of Fee Banks, paddings are stripped
  * High:
@@ -51,6 +69,7 @@ extern "C" {
  *   |   | NoOfWrite  |  BlockSize   |           + Admin Data of Fee Block {BN}
  *   +------------------------+                  |
  *       | BN  | ~BN  |   Address    | ----------/
+ *       | Address    | ~ Address    | <- Checkpoint References (FEE_USE_CHECKPOINT only)
  *       | Full Magic | ~ Full Magic | <- Status -\
  *       | Number     | ~ Number     | <- Info     + <- Bank Admin
  * Low:  | FEE Magic  | ~ FEE Magic  | <- Header -/
@@ -85,6 +104,26 @@ typedef struct {
   uint32_t FullMagic;
 } Fee_BankStatusType;
 
+/* Reference to the data of a checkpoint record, written after the checkpoint record is
+ * completely written, so the last valid reference always points to a complete checkpoint */
+typedef struct {
+  uint32_t Address;
+  uint32_t InvAddress;
+#if FEE_PAGE_SIZE > 8 /*sizeof(Fee_CheckpointRefType) */
+  uint8_t _padding[FEE_PAGE_SIZE - 8];
+#endif
+} Fee_CheckpointRefType;
+
+/* The data of a checkpoint record, a snapshot of the blocks address and the free space, so that
+ * the init only needs to search the admin records that are written after the checkpoint */
+typedef struct {
+  uint32_t MagicNumber;
+  uint32_t AdminAddress; /* address of the admin record of this checkpoint */
+  uint16_t NumberOfBlocks;
+  uint16_t ConfigCrc; /* CRC of the block size of all blocks, to detect FEE config update */
+  /* uint32_t blockAddress[NumberOfBlocks]; */
+} Fee_CheckpointType;
+
 typedef struct {
   Fee_BankHeaderMagicType HeaderMagic;
 #if FEE_PAGE_SIZE > 8 /*sizeof(Fee_BankMagicType) */
@@ -97,6 +136,9 @@ typedef struct {
   Fee_BankStatusType Status;
 #if FEE_PAGE_SIZE > 4 /*sizeof(Fee_BankInfoType) */
   uint8_t _padding3[FEE_PAGE_SIZE - 4];
+#endif
+#ifdef FEE_USE_CHECKPOINT
+  Fee_CheckpointRefType Checkpoints[FEE_CHECKPOINT_NUM];
 #endif
   uint8_t blocks[FEE_PAGE_SIZE];
 } Fee_BankAdminType;
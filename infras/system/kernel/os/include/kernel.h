@@ -117,6 +117,9 @@
 #ifndef USECONDS_PER_TICK
 #define USECONDS_PER_TICK (1000000 / OS_TICKS_PER_SECOND)
 #endif
+#ifndef NSECONDS_PER_TICK
+#define NSECONDS_PER_TICK (1000000000ull / OS_TICKS_PER_SECOND)
+#endif
 
 #define TICK_MAX ((TickType)0xFFFFFFFFul)
 /* ================================ [ TYPES     ] ============================================== */
@@ -165,6 +168,29 @@ typedef union {
 } _ErrorHook_Par;
 
 typedef void (*FP)(void);
+
+/* the execution time statistics of a task or an ISR with OS_USE_TASK_STAT, in port cycles */
+typedef struct {
+  uint32_t start; /* the cycle of the last switch in */
+  uint32_t exec;  /* the cycles used in the current window */
+  uint32_t load;  /* the cycles used in the last full window */
+  uint32_t began; /* the cycle of the activation of the task or the entry of the ISR */
+  /* the response time of the task or the execution time of the ISR */
+  uint32_t min;
+  uint32_t max;
+  uint32_t count;
+  uint64_t sum;
+} Os_StatType;
+
+typedef struct Os_IsrStat {
+  const char *name;
+  struct Os_IsrStat *next; /* all of the ISRs ever entered, for the top command */
+  struct Os_IsrStat *prev; /* the ISR interrupted by this one */
+  boolean linked;
+  Os_StatType stat;
+} Os_IsrStatType;
+
+#define OS_ISR_STAT(name) Os_IsrStatType OsIsrStat_##name = {#name}
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 extern OSServiceIdType _errorhook_svcid;
@@ -219,4 +245,10 @@ void SuspendOSInterrupts(void);
 void ResumeOSInterrupts(void);
 
 void Os_Sleep(TickType tick);
+
+/* account the ISR apart from the task it interrupts, called at the very begin and end of the ISR
+ * with the interrupts disabled, the ports call them for the ISRs they dispatch. An ISR taken by
+ * several cores at the same time needs one Os_IsrStatType per core. */
+void Os_StatIsrEnter(Os_IsrStatType *isr);
+void Os_StatIsrExit(Os_IsrStatType *isr);
 #endif /* KERNEL_H_ */
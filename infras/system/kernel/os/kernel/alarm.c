@@ -11,6 +11,57 @@
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
+/* The key is the ticks left before expiry, the keys of all the started alarms go down together as
+ * the counter goes on, so the order of the heap is kept. Only the alarms that are being expired by
+ * Os_CounterAdvance have the key 0. */
+static inline boolean Os_AlarmBefore(const CounterVarType *pCounterVar, AlarmType a, AlarmType b) {
+  TickType keyA = (TickType)(AlarmVarArray[a].value - pCounterVar->value);
+  TickType keyB = (TickType)(AlarmVarArray[b].value - pCounterVar->value);
+
+  /* lower AlarmID serve first if expires at the same time */
+  return (boolean)((keyA < keyB) || ((keyA == keyB) && (a < b)));
+}
+
+static inline void Os_AlarmHeapSet(CounterVarType *pCounterVar, AlarmType index, AlarmType id) {
+  pCounterVar->heap[index] = id;
+  AlarmVarArray[id].index = index;
+}
+
+static void Os_AlarmSiftUp(CounterVarType *pCounterVar, AlarmType index) {
+  AlarmType id = pCounterVar->heap[index];
+  AlarmType parent;
+
+  while (index > 0) {
+    parent = (index - 1) / 2;
+    if (Os_AlarmBefore(pCounterVar, id, pCounterVar->heap[parent])) {
+      Os_AlarmHeapSet(pCounterVar, index, pCounterVar->heap[parent]);
+      index = parent;
+    } else {
+      break;
+    }
+  }
+  Os_AlarmHeapSet(pCounterVar, index, id);
+}
+
+static void Os_AlarmSiftDown(CounterVarType *pCounterVar, AlarmType index) {
+  AlarmType id = pCounterVar->heap[index];
+  AlarmType child;
+
+  while ((2 * (uint32)index + 1) < pCounterVar->size) {
+    child = 2 * index + 1;
+    if (((child + 1) < pCounterVar->size) &&
+        Os_AlarmBefore(pCounterVar, pCounterVar->heap[child + 1], pCounterVar->heap[child])) {
+      child++;
+    }
+    if (Os_AlarmBefore(pCounterVar, pCounterVar->heap[child], id)) {
+      Os_AlarmHeapSet(pCounterVar, index, pCounterVar->heap[child]);
+      index = child;
+    } else {
+      break;
+    }
+  }
+  Os_AlarmHeapSet(pCounterVar, index, id);
+}
 /* ================================ [ FUNCTIONS ] ============================================== */
 /* |------------------+------------------------------------------------------------------| */
 /* | Syntax:          | StatusType GetAlarmBase (AlarmType <AlarmID>,                    | */
@@ -81,8 +132,8 @@ StatusType GetAlarm(AlarmType AlarmID, TickRefType Tick) {
     EnterCritical();
     if (OS_IS_ALARM_STARTED(&AlarmVarArray[AlarmID])) {
       /* rely on the trick of integer overflow */
-      *Tick =
-        (TickType)(AlarmVarArray[AlarmID].value - AlarmConstArray[AlarmID].pCounter->pVar->value);
+      *Tick = (TickType)(AlarmVarArray[AlarmID].value -
+                         OS_COUNTER_VALUE(AlarmConstArray[AlarmID].pCounter));
     } else {
       ercd = E_OS_NOFUNC;
     }
@@ -149,7 +200,8 @@ StatusType SetRelAlarm(AlarmType AlarmID, TickType Increment, TickType Cycle) {
 #if (OS_STATUS == EXTENDED)
   if (AlarmID >= ALARM_NUM) {
     ercd = E_OS_ID;
-  } else if (Increment > AlarmConstArray[AlarmID].pCounter->base.maxallowedvalue) {
+  } else if ((0 == Increment) ||
+             (Increment > AlarmConstArray[AlarmID].pCounter->base.maxallowedvalue)) {
     ercd = E_OS_VALUE;
   } else if ((Cycle > AlarmConstArray[AlarmID].pCounter->base.maxallowedvalue) ||
              ((Cycle > 0) && (Cycle < AlarmConstArray[AlarmID].pCounter->base.mincycle))) {
@@ -160,8 +212,9 @@ StatusType SetRelAlarm(AlarmType AlarmID, TickType Increment, TickType Cycle) {
   if (E_OK == ercd) {
     EnterCritical();
     if (FALSE == OS_IS_ALARM_STARTED(&AlarmVarArray[AlarmID])) {
-      TickType Start = (TickType)(AlarmConstArray[AlarmID].pCounter->pVar->value + Increment);
+      TickType Start = (TickType)(OS_COUNTER_VALUE(AlarmConstArray[AlarmID].pCounter) + Increment);
       Os_StartAlarm(AlarmID, Start, Cycle);
+      OS_COUNTER_UPDATE(AlarmConstArray[AlarmID].pCounter);
     } else {
       ercd = E_OS_STATE;
     }
@@ -239,29 +292,29 @@ StatusType SetAbsAlarm(AlarmType AlarmID, TickType Start, TickType Cycle) {
   if (E_OK == ercd) {
     EnterCritical();
     if (FALSE == OS_IS_ALARM_STARTED(&AlarmVarArray[AlarmID])) {
-      TickType Increment = AlarmConstArray[AlarmID].pCounter->pVar->value %
-                           AlarmConstArray[AlarmID].pCounter->base.maxallowedvalue;
+      TickType curValue = OS_COUNTER_VALUE(AlarmConstArray[AlarmID].pCounter);
+      TickType Increment = curValue % AlarmConstArray[AlarmID].pCounter->base.maxallowedvalue;
 
       if (Increment == Start) {
         if (Cycle > 0) {
-          Start = AlarmConstArray[AlarmID].pCounter->pVar->value + Cycle;
+          Start = curValue + Cycle;
           Os_StartAlarm(AlarmID, Start, Cycle);
+          OS_COUNTER_UPDATE(AlarmConstArray[AlarmID].pCounter);
         }
         AlarmConstArray[AlarmID].Action();
       } else {
         if (Increment < Start) {
-          Start = (AlarmConstArray[AlarmID].pCounter->pVar->value /
-                   AlarmConstArray[AlarmID].pCounter->base.maxallowedvalue) *
+          Start = (curValue / AlarmConstArray[AlarmID].pCounter->base.maxallowedvalue) *
                     AlarmConstArray[AlarmID].pCounter->base.maxallowedvalue +
                   Start;
         } else {
-          Start = (1 + (AlarmConstArray[AlarmID].pCounter->pVar->value /
-                        AlarmConstArray[AlarmID].pCounter->base.maxallowedvalue)) *
+          Start = (1 + (curValue / AlarmConstArray[AlarmID].pCounter->base.maxallowedvalue)) *
                     AlarmConstArray[AlarmID].pCounter->base.maxallowedvalue +
                   Start;
         }
 
         Os_StartAlarm(AlarmID, Start, Cycle);
+        OS_COUNTER_UPDATE(AlarmConstArray[AlarmID].pCounter);
       }
     } else {
       ercd = E_OS_STATE;
@@ -300,9 +353,8 @@ StatusType CancelAlarm(AlarmType AlarmID) {
 #endif
     EnterCritical();
     if (OS_IS_ALARM_STARTED(&AlarmVarArray[AlarmID])) {
-      TAILQ_REMOVE(&(AlarmConstArray[AlarmID].pCounter->pVar->head), &AlarmVarArray[AlarmID],
-                   entry);
-      OS_STOP_ALARM(&AlarmVarArray[AlarmID]);
+      Os_StopAlarm(AlarmID);
+      OS_COUNTER_UPDATE(AlarmConstArray[AlarmID].pCounter);
     } else {
       ercd = E_OS_NOFUNC;
     }
@@ -336,35 +388,38 @@ void Os_AlarmInit(AppModeType appMode) {
 }
 
 void Os_StartAlarm(AlarmType AlarmID, TickType Start, TickType Cycle) {
-  AlarmVarType *pVar;
-  AlarmVarType *pPosVar = NULL;
-  TickType curValue = AlarmConstArray[AlarmID].pCounter->pVar->value;
-
-  TickType left = (TickType)(Start - curValue);
+  CounterVarType *pCounterVar = AlarmConstArray[AlarmID].pCounter->pVar;
 
   asAssert(FALSE == OS_IS_ALARM_STARTED(&AlarmVarArray[AlarmID]));
+  asAssert(pCounterVar->size < ALARM_NUM);
 
   AlarmVarArray[AlarmID].value = Start;
   AlarmVarArray[AlarmID].period = Cycle;
 
-  TAILQ_FOREACH(pVar, &(AlarmConstArray[AlarmID].pCounter->pVar->head), entry) {
-    if ((TickType)(pVar->value - curValue) > left) {
-      pPosVar = pVar;
-      break;
-    } else if (((TickType)(pVar->value - curValue) == left) &&
-               ((pVar - AlarmVarArray) > AlarmID)) { /*this is not necessary but for fix behavior,
-                                                        lower AlarmID serve first */
-      pPosVar = pVar;
-      break;
+  pCounterVar->heap[pCounterVar->size] = AlarmID;
+  pCounterVar->size++;
+  Os_AlarmSiftUp(pCounterVar, pCounterVar->size - 1);
+}
+
+void Os_StopAlarm(AlarmType AlarmID) {
+  CounterVarType *pCounterVar = AlarmConstArray[AlarmID].pCounter->pVar;
+  AlarmType index = AlarmVarArray[AlarmID].index;
+
+  asAssert(OS_IS_ALARM_STARTED(&AlarmVarArray[AlarmID]));
+  asAssert(index < pCounterVar->size);
+
+  pCounterVar->size--;
+  if (index < pCounterVar->size) {
+    Os_AlarmHeapSet(pCounterVar, index, pCounterVar->heap[pCounterVar->size]);
+    if ((index > 0) && Os_AlarmBefore(pCounterVar, pCounterVar->heap[index],
+                                      pCounterVar->heap[(index - 1) / 2])) {
+      Os_AlarmSiftUp(pCounterVar, index);
+    } else {
+      Os_AlarmSiftDown(pCounterVar, index);
     }
   }
 
-  if (NULL != pPosVar) {
-    TAILQ_INSERT_BEFORE(pPosVar, &AlarmVarArray[AlarmID], entry);
-  } else {
-    TAILQ_INSERT_TAIL(&(AlarmConstArray[AlarmID].pCounter->pVar->head), &AlarmVarArray[AlarmID],
-                      entry);
-  }
+  OS_STOP_ALARM(&AlarmVarArray[AlarmID]);
 }
 
 #ifdef USE_SHELL
@@ -13,69 +13,142 @@
 /* ================================ [ FUNCTIONS ] ============================================== */
 StatusType SignalCounter(CounterType CounterID) {
   StatusType ercd = E_OK;
-  AlarmVarType *pVar;
-  AlarmType AlarmID;
-  unsigned int savedLevel;
-  TickType curValue;
-  DECLARE_SMP_PROCESSOR_ID();
 
   if (CounterID < COUNTER_NUM) {
-    EnterCritical();
-    savedLevel = CallLevel;
-    CallLevel = TCL_LOCK;
     /* yes, only software counter supported */
-    CounterVarArray[CounterID].value++;
-    curValue = CounterVarArray[CounterID].value;
+    Os_CounterAdvance(CounterID, 1);
+  } else {
+    ercd = E_OS_ID;
+  }
+
+  return ercd;
+}
+
+/* Move the counter ticks forward, the alarms expire in the order of time and then AlarmID, each
+ * one sees the counter value of its own expiry, so does a cyclic alarm that is started again. */
+void Os_CounterAdvance(CounterType CounterID, TickType ticks) {
+  CounterVarType *pVar = &CounterVarArray[CounterID];
+  unsigned int savedLevel;
+  TickType target;
+#if (ALARM_NUM > 0)
+  AlarmType AlarmID;
+#endif
+  DECLARE_SMP_PROCESSOR_ID();
+
+  EnterCritical();
+  savedLevel = CallLevel;
+  CallLevel = TCL_LOCK;
+#ifdef OS_USE_TICKLESS
+  if (OS_TICKLESS_COUNTER == CounterID) {
+    Os_PortTicklessProgram(ticks, 0);
+    /* OsTick is not called in the tickless mode, so the ticks slept over are added at once */
+    OsTickCounter += ticks;
+  }
+#endif
+  target = pVar->value + ticks;
 #if (ALARM_NUM > 0)
-    while (NULL != (pVar = TAILQ_FIRST(&CounterVarArray[CounterID].head))) /* intended '=' */
-    {
-      if (pVar->value == curValue) {
-        AlarmID = pVar - AlarmVarArray;
-        TAILQ_REMOVE(&CounterVarArray[CounterID].head, &AlarmVarArray[AlarmID], entry);
-        OS_STOP_ALARM(&AlarmVarArray[AlarmID]);
-        if (AlarmVarArray[AlarmID].period != 0) {
-          Os_StartAlarm(AlarmID, (TickType)(curValue + AlarmVarArray[AlarmID].period),
-                        AlarmVarArray[AlarmID].period);
-        }
+  while ((pVar->size > 0) && ((TickType)(AlarmVarArray[pVar->heap[0]].value - pVar->value) <=
+                              (TickType)(target - pVar->value))) {
+    AlarmID = pVar->heap[0];
+    pVar->value = AlarmVarArray[AlarmID].value;
+    Os_StopAlarm(AlarmID);
+    if (AlarmVarArray[AlarmID].period != 0) {
+      Os_StartAlarm(AlarmID, (TickType)(pVar->value + AlarmVarArray[AlarmID].period),
+                    AlarmVarArray[AlarmID].period);
+    }
+
+    InterLeaveCritical();
+    AlarmConstArray[AlarmID].Action();
+    InterEnterCritical();
+  }
+#endif
+  pVar->value = target;
+#ifdef OS_USE_TICKLESS
+  Os_CounterUpdate(CounterID);
+#endif
+  CallLevel = savedLevel;
+  ExitCritical();
+}
 
-        InterLeaveCritical();
-        AlarmConstArray[AlarmID].Action();
-        InterEnterCritical();
-      } else {
-        break;
+#ifdef OS_USE_TICKLESS
+/* The value of the tickless counter is only updated when the port announces the elapsed ticks,
+ * the ticks elapsed since then are added here but never beyond the next expiry, as that alarm
+ * has not been processed yet. Called with the critical section held. */
+TickType Os_CounterGetValue(CounterType CounterID) {
+  CounterVarType *pVar = &CounterVarArray[CounterID];
+  TickType value = pVar->value;
+  TickType elapsed;
+#if (ALARM_NUM > 0)
+  TickType left;
+#endif
+
+  if (OS_TICKLESS_COUNTER == CounterID) {
+    elapsed = Os_PortTicklessElapsed();
+#if (ALARM_NUM > 0)
+    if (pVar->size > 0) {
+      left = (TickType)(AlarmVarArray[pVar->heap[0]].value - value);
+      if ((left > 0) && (elapsed >= left)) {
+        elapsed = left - 1;
       }
     }
 #endif
-    CallLevel = savedLevel;
-    ExitCritical();
-  } else {
-    ercd = E_OS_ID;
+    value += elapsed;
   }
 
-  return ercd;
+  return value;
 }
 
+/* program the port timer for the next expiry, called with the critical section held after the
+ * head of the alarm heap of the counter may be changed */
+void Os_CounterUpdate(CounterType CounterID) {
+  TickType next = 0;
+#if (ALARM_NUM > 0)
+  CounterVarType *pVar = &CounterVarArray[CounterID];
+#endif
+
+  if (OS_TICKLESS_COUNTER == CounterID) {
+#if (ALARM_NUM > 0)
+    if (pVar->size > 0) {
+      next = (TickType)(AlarmVarArray[pVar->heap[0]].value - pVar->value);
+      if (0 == next) {
+        next = 1;
+      }
+    }
+#endif
+    Os_PortTicklessProgram(0, next);
+  }
+}
+#endif
+
 void Os_CounterInit(void) {
   CounterType id;
 
   for (id = 0; id < COUNTER_NUM; id++) {
     CounterVarArray[id].value = 0;
-    TAILQ_INIT(&CounterVarArray[id].head);
+#if (ALARM_NUM > 0)
+    CounterVarArray[id].size = 0;
+#endif
   }
 }
 #ifdef USE_SHELL
 void statOsCounter(void) {
   CounterType id;
-  AlarmVarType *pVar;
+#if (ALARM_NUM > 0)
+  AlarmType i;
+  AlarmType AlarmID;
+#endif
 
   EnterCritical();
 
   printf("\nName\n");
   for (id = 0; id < COUNTER_NUM; id++) {
     printf("%-16s ", CounterConstArray[id].name);
-    TAILQ_FOREACH(pVar, &(CounterVarArray[id].head), entry) {
-      printf("%s(%d) -> ", AlarmConstArray[pVar - AlarmVarArray].name, pVar->value);
+#if (ALARM_NUM > 0)
+    for (i = 0; i < CounterVarArray[id].size; i++) {
+      AlarmID = CounterVarArray[id].heap[i];
+      printf("%s(%d) -> ", AlarmConstArray[AlarmID].name, AlarmVarArray[AlarmID].value);
     }
+#endif
   }
 
   ExitCritical();
@@ -55,6 +55,7 @@ static void Os_MiscInit(void) {
 #if (OS_PTHREAD_NUM > 0)
   Os_MemInit();
   Os_SleepInit();
+  Os_TimerInit();
 #ifdef USE_PTHREAD_SIGNAL
   Os_SignalInit();
 #endif
@@ -153,6 +154,9 @@ void StartOS(AppModeType Mode) {
 
   Os_MiscInit();
   Os_PortInit();
+#ifdef OS_USE_TASK_STAT
+  Os_StatInit();
+#endif
   Os_TaskInit(Mode);
   Os_ResourceInit();
 #if (COUNTER_NUM > 0)
@@ -173,6 +177,8 @@ void StartOS(AppModeType Mode) {
 }
 
 void ShutdownOS(StatusType Error) {
+  DECLARE_SMP_PROCESSOR_ID();
+
   OSShutdownHook(Error);
   DisableInterrupt();
   while (1)
@@ -186,7 +192,7 @@ AppModeType GetActiveApplicationMode(void) {
 void OsTick(void) {
   OsTickCounter++;
 
-#if (OS_PTHREAD_NUM > 0)
+#if (OS_PTHREAD_NUM > 0) && !defined(OS_USE_HRTIMER)
   Os_SleepTick();
 #endif
 }
@@ -217,17 +217,38 @@ enum {
 #define USE_SCHED_BUBBLE
 #endif
 
-#define OS_IS_ALARM_STARTED(pVar) (NULL != ((pVar)->entry.tqe_prev))
+#define OS_IS_ALARM_STARTED(pVar) (INVALID_ALARM != ((pVar)->index))
 #define OS_STOP_ALARM(pVar)                                                                        \
   do {                                                                                             \
-    ((pVar)->entry.tqe_prev) = NULL;                                                               \
+    ((pVar)->index) = INVALID_ALARM;                                                               \
   } while (0)
 
+/* In tickless mode, the counter OS_TICKLESS_COUNTER is not signaled on each tick, the port
+ * programs its timer to fire when the next alarm expires and announces the elapsed ticks. */
+#ifdef OS_USE_TICKLESS
+#ifndef OS_TICKLESS_COUNTER
+#define OS_TICKLESS_COUNTER 0
+#endif
+#if (OS_PTHREAD_NUM > 0) && !defined(OS_USE_HRTIMER)
+#error "tickless mode with pthread needs OS_USE_HRTIMER, else the sleep queue depends on OsTick"
+#endif
+#define OS_COUNTER_VALUE(pCounter) Os_CounterGetValue((CounterType)((pCounter)-CounterConstArray))
+#define OS_COUNTER_UPDATE(pCounter) Os_CounterUpdate((CounterType)((pCounter)-CounterConstArray))
+#else
+#define OS_COUNTER_VALUE(pCounter) ((pCounter)->pVar->value)
+#define OS_COUNTER_UPDATE(pCounter)
+#endif
+
 #if (OS_PTHREAD_NUM > 0)
 #ifndef PTHREAD_DEFAULT_STACK_SIZE
 #define PTHREAD_DEFAULT_STACK_SIZE 1024
 #endif
 #define PTHREAD_DEFAULT_PRIORITY (OS_PTHREAD_PRIORITY / 2)
+#ifndef OS_TIMERFD_NUM
+#define OS_TIMERFD_NUM 4
+#endif
+/* the sleeping tasks and the timerfds share one timer heap */
+#define OS_TIMER_NUM (TASK_NUM + OS_PTHREAD_NUM + OS_TIMERFD_NUM)
 #endif
 
 /* PTHREAD TASK flag mask */
@@ -248,6 +269,21 @@ enum {
 #define USE_PTHREAD_PARENT
 #endif
 
+/* The stacks are filled with the pattern before the first use so that the high water mark can be
+ * found, else the stacks in the bss are taken as filled with 0. */
+#ifdef OS_USE_TASK_STAT
+#define OS_STACK_FILL_PATTERN 0xA5A5A5A5u
+#ifndef OS_STAT_WINDOW_MS
+#define OS_STAT_WINDOW_MS 1000
+#endif
+#define OS_STAT_TASK_ACTIVATE(pTaskVar) Os_StatActivate(pTaskVar)
+#define OS_STAT_TASK_TERMINATE(pTaskVar) Os_StatTerminate(pTaskVar)
+#else
+#define OS_STACK_FILL_PATTERN 0u
+#define OS_STAT_TASK_ACTIVATE(pTaskVar)
+#define OS_STAT_TASK_TERMINATE(pTaskVar)
+#endif
+
 #ifdef USE_SMP
 #define DECLARE_SMP_PROCESSOR_ID() int cpuid = smp_processor_id()
 #define GET_SMP_PROCESSOR_ID() cpuid = smp_processor_id()
@@ -308,6 +344,16 @@ typedef struct {
 #endif
 } TaskConstType;
 
+#if (OS_PTHREAD_NUM > 0)
+/* The timers of the posix layer, kept in a heap ordered by the deadline in ns of the OS time, which
+ * is the high resolution time of the port with OS_USE_HRTIMER, else the ticks of OsTick. */
+typedef struct OsTimer {
+  uint64_t deadline;
+  void (*expire)(struct OsTimer *timer); /* called in the critical section */
+  uint16 index;                          /* position in the heap */
+} OsTimerType;
+#endif
+
 typedef struct TaskVar {
   TaskContextType context;
   PriorityType priority; /* TODO: move it to uint8 area */
@@ -321,16 +367,16 @@ typedef struct TaskVar {
   /* generic entry for event/timer/mutex/semaphore etc. */
   TAILQ_ENTRY(TaskVar) entry;
   TaskListType *list; /* the list that the task is waiting on*/
-  TAILQ_ENTRY(TaskVar) sentry;
+  OsTimerType timer;  /* the timer of sleep or timed wait */
 #endif
 
 /*** uint32 area ***/
-#if (OS_PTHREAD_NUM > 0)
-  TickType sleep_tick;
-#endif
 #ifdef USE_SHELL
   uint32 actCnt;
 #endif
+#ifdef OS_USE_TASK_STAT
+  Os_StatType stat;
+#endif
 
 /*** uint16 area ***/
 
@@ -346,11 +392,14 @@ typedef struct TaskVar {
 #endif
 } TaskVarType;
 
-struct AlarmVar;
-
 typedef struct {
   TickType value;
-  TAILQ_HEAD(AlarmVarHead, AlarmVar) head;
+#if (ALARM_NUM > 0)
+  /* binary min heap of the started alarms of this counter, ordered by the ticks left before
+   * expiry and then by AlarmID */
+  AlarmType heap[ALARM_NUM];
+  AlarmType size;
+#endif
 } CounterVarType;
 
 typedef struct {
@@ -362,7 +411,7 @@ typedef struct {
 typedef struct AlarmVar {
   TickType value;
   TickType period;
-  TAILQ_ENTRY(AlarmVar) entry;
+  AlarmType index; /* position in the heap of the counter, INVALID_ALARM if stopped */
 } AlarmVarType;
 
 typedef struct {
@@ -433,6 +482,40 @@ extern void Os_ResourceInit(void);
 extern void Os_CounterInit(void);
 extern void Os_AlarmInit(AppModeType appMode);
 extern void Os_StartAlarm(AlarmType AlarmID, TickType Start, TickType Cycle);
+extern void Os_StopAlarm(AlarmType AlarmID);
+extern void Os_CounterAdvance(CounterType CounterID, TickType ticks);
+#ifdef OS_USE_TICKLESS
+extern TickType Os_CounterGetValue(CounterType CounterID);
+extern void Os_CounterUpdate(CounterType CounterID);
+/* whole ticks elapsed since the reference point of the tickless timer */
+extern TickType Os_PortTicklessElapsed(void);
+/* move the reference point forward by advance whole ticks, keep the sub tick remainder, and arm
+ * the timer to fire next ticks after the new reference point, 0 means no alarm is pending */
+extern void Os_PortTicklessProgram(TickType advance, TickType next);
+#endif
+#ifdef OS_USE_HRTIMER
+/* the high resolution OS time in ns, starts from 0 */
+extern uint64_t Os_PortHrTime(void);
+/* arm the one shot timer to call Os_SleepExpire in an ISR at the deadline, 0 disarms it */
+extern void Os_PortHrTimerProgram(uint64_t deadline);
+#endif
+
+#ifdef OS_USE_TASK_STAT
+/* the free running cycle counter of the statistics, the tick counter if the port has no better */
+extern uint32_t Os_PortCycles(void);
+extern uint32_t Os_PortCyclesPerSecond(void);
+extern void Os_StatInit(void);
+extern void Os_StatActivate(TaskVarType *pTaskVar);
+extern void Os_StatTerminate(TaskVarType *pTaskVar);
+/* called by the generated PreTaskHook and PostTaskHook, which the ports call around each switch */
+extern void Os_StatPreTask(void);
+extern void Os_StatPostTask(void);
+#endif
+extern void Os_StackFill(void *pStack, uint32_t stackSize);
+#ifdef USE_SHELL
+/* the high water mark of the stack in percent, and in bytes by used */
+extern uint32_t Os_CheckStackUsage(const TaskConstType *pTaskConst, uint32_t *used);
+#endif
 
 extern void Os_PortInit(void);
 extern void Os_PortInitContext(TaskVarType *pTaskVar);
@@ -451,10 +534,20 @@ extern boolean Sched_Schedule(void);
 extern void OsTick(void);
 #if (OS_PTHREAD_NUM > 0)
 extern void Os_SleepInit(void);
+#ifndef OS_USE_HRTIMER
 extern void Os_SleepTick(void);
+#endif
+extern void Os_SleepExpire(void);
+extern uint64_t Os_SleepNow(void);
+extern uint64_t Os_SleepRealTimeOffset(void);
 extern void Os_Sleep(TickType tick);
-extern void Os_SleepAdd(TaskVarType *pTaskVar, TickType ticks);
+extern void Os_SleepUntil(uint64_t deadline);
+extern void Os_SleepAdd(TaskVarType *pTaskVar, uint64_t deadline);
 extern void Os_SleepRemove(TaskVarType *pTaskVar);
+extern void Os_TimerStart(OsTimerType *timer, uint64_t deadline);
+extern void Os_TimerStop(OsTimerType *timer);
+extern boolean Os_TimerIsStarted(const OsTimerType *timer);
+extern void Os_TimerInit(void);
 extern int Os_ListWait(TaskListType *list, const struct timespec *abstime);
 extern int Os_ListPost(TaskListType *list, boolean schedule);
 extern void Os_ListDetach(TaskVarType *pTaskVar, boolean AddReady);
@@ -462,7 +555,9 @@ extern int Os_PortInstallSignal(TaskVarType *pTaskVar, int sig, void *handler);
 extern void Os_FreeSignalHandler(struct pthread *tid);
 extern void Os_SignalInit(void);
 extern void Os_SignalBroadCast(int signo);
+#endif
 
+#ifdef USE_SMP
 extern imask_t Os_LockKernel(void);
 extern void Os_UnLockKernel(imask_t imask);
 extern void Os_PortRequestSchedule(uint8 cpu);
@@ -10,6 +10,9 @@
 #include <fcntl.h>
 #include <sys/types.h>
 /* ================================ [ MACROS    ] ============================================== */
+#ifndef MQ_PRIO_MAX
+#define MQ_PRIO_MAX 32
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 struct mq_attr {
   long mq_flags;   /* message queue flags */
@@ -38,4 +41,13 @@ int mq_timedsend(mqd_t mq, const char *msg_ptr, size_t msg_len, unsigned msg_pri
 
 int mq_unlink(const char *name);
 
+/* The zero copy extension, the message buffer of the queue is lent out instead of being copied.
+ * A sender reserves a buffer of mq_msgsize, fills it and commits it, or releases it to give it up.
+ * A receiver borrows the message of the highest priority and releases it when done. */
+int mq_reserve(mqd_t mq, void **msg_ptr, const struct timespec *abs_timeout);
+int mq_commit(mqd_t mq, void *msg_ptr, size_t msg_len, unsigned msg_prio);
+ssize_t mq_borrow(mqd_t mq, void **msg_ptr, unsigned *msg_prio,
+                  const struct timespec *abs_timeout);
+int mq_release(mqd_t mq, void *msg_ptr);
+
 #endif /* _ASKAR_MQUEUE_H_ */
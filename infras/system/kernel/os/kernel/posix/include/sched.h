@@ -22,7 +22,11 @@ struct sched_param {
 struct TaskVar;
 typedef TAILQ_HEAD(TaskList, TaskVar) TaskListType;
 
+/* same guard as glibc, so that a hosted build only sees this one */
+#ifndef __sigset_t_defined
+#define __sigset_t_defined 1
 typedef unsigned long sigset_t;
+#endif
 
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
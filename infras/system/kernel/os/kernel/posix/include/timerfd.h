@@ -0,0 +1,41 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2025 Parai Wang <parai@foxmail.com>
+ */
+#ifndef _ASKAR_TIMERFD_H_
+#define _ASKAR_TIMERFD_H_
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "Std_Types.h"
+#include <time.h>
+/* ================================ [ MACROS    ] ============================================== */
+/* the same as Linux */
+#define TFD_TIMER_ABSTIME 0x01
+#define TFD_NONBLOCK 04000
+
+#ifndef TIMER_ABSTIME
+#define TIMER_ABSTIME 0x01
+#endif
+#ifndef CLOCK_REALTIME
+#define CLOCK_REALTIME 0
+#endif
+#ifndef CLOCK_MONOTONIC
+#define CLOCK_MONOTONIC 1
+#endif
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+/* A periodic timer like the Linux timerfd, but there is no file, timerfd_wait takes the place of
+ * the read of the expirations, and timerfd_close the place of the close. The period is kept by
+ * the deadline, so it doesn't drift with the latency of the waiter. */
+int timerfd_create(int clockid, int flags);
+int timerfd_settime(int fd, int flags, const struct itimerspec *new_value,
+                    struct itimerspec *old_value);
+int timerfd_gettime(int fd, struct itimerspec *curr_value);
+int timerfd_wait(int fd, uint64_t *expirations);
+int timerfd_close(int fd);
+
+int clock_nanosleep(clockid_t clock_id, int flags, const struct timespec *request,
+                    struct timespec *remain);
+#endif /* _ASKAR_TIMERFD_H_ */
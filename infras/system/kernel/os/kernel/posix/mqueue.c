@@ -14,37 +14,175 @@
 /* ================================ [ MACROS    ] ============================================== */
 #define MQ_ALIGN(sz) ((sz + sizeof(void *) - 1) & (~(sizeof(void *) - 1)))
 
+/* the buckets of the name registry, must be a power of 2 */
+#ifndef OS_MQ_HASH_SIZE
+#define OS_MQ_HASH_SIZE 16
+#endif
+
+#define MQ_MSG_DATA(msg) ((void *)&(msg)[1])
+#define MQ_DATA_MSG(ptr) (((struct mqd_msg *)(ptr)) - 1)
+
+/* the state of a message slot, a lent out one may only be given back once */
+#define MQ_MSG_FREE 0
+#define MQ_MSG_RESERVED 1
+#define MQ_MSG_QUEUED 2
+#define MQ_MSG_BORROWED 3
 /* ================================ [ TYPES     ] ============================================== */
 struct mqd_msg {
   TAILQ_ENTRY(mqd_msg) entry;
+  size_t len;
+  unsigned int prio;
+  unsigned int state;
 };
 
 struct mqd {
   size_t msgsize;
+  size_t slotsize;
+  long maxmsg;
+  long curmsgs;
   unsigned int refcount;
   unsigned int unlinked;
+  uint32_t hash;
   char *name;
   TAILQ_HEAD(mqfree_list, mqd_msg) free;
+  /* ordered by the priority from high to low, FIFO for the same priority */
   TAILQ_HEAD(mqavail_list, mqd_msg) avail;
   TAILQ_ENTRY(mqd) entry;
   TaskListType slist;
   TaskListType rlist;
 };
+
+TAILQ_HEAD(mqueue_list, mqd);
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
-static TAILQ_HEAD(mqueue_list, mqd) OsMqueueList = TAILQ_HEAD_INITIALIZER(OsMqueueList);
+static struct mqueue_list OsMqueueHash[OS_MQ_HASH_SIZE];
+static boolean OsMqueueHashInited = FALSE;
 /* ================================ [ LOCALS    ] ============================================== */
-static mqd_t mq_find(const char *name) {
+/* FNV-1a */
+static uint32_t mq_hash(const char *name) {
+  uint32_t hash = 2166136261u;
+
+  while ('\0' != *name) {
+    hash ^= (uint8_t)*name;
+    hash *= 16777619u;
+    name++;
+  }
+
+  return hash;
+}
+
+static struct mqueue_list *mq_bucket(uint32_t hash) {
+  int i;
+
+  if (FALSE == OsMqueueHashInited) {
+    for (i = 0; i < OS_MQ_HASH_SIZE; i++) {
+      TAILQ_INIT(&OsMqueueHash[i]);
+    }
+    OsMqueueHashInited = TRUE;
+  }
+
+  return &OsMqueueHash[hash & (OS_MQ_HASH_SIZE - 1)];
+}
+
+/* called with the critical section held */
+static mqd_t mq_find(const char *name, uint32_t hash) {
   struct mqd *mq = NULL;
 
-  TAILQ_FOREACH(mq, &OsMqueueList, entry) {
-    if (0u == strcmp(mq->name, name)) {
+  TAILQ_FOREACH(mq, mq_bucket(hash), entry) {
+    if ((hash == mq->hash) && (0u == strcmp(mq->name, name))) {
       break;
     }
   }
 
   return mq;
 }
+
+static void mq_destroy(mqd_t mq) {
+  TAILQ_REMOVE(mq_bucket(mq->hash), mq, entry);
+  Os_MemFree((uint8_t *)mq);
+}
+
+static boolean mq_owns(mqd_t mq, struct mqd_msg *msg) {
+  uint8_t *first = (uint8_t *)&mq[1];
+  uint8_t *p = (uint8_t *)msg;
+
+  return (boolean)((p >= first) && (p < (first + mq->slotsize * mq->maxmsg)) &&
+                   (0 == ((p - first) % mq->slotsize)));
+}
+
+/* take a free message, wait if the queue is full, called with the critical section held */
+static struct mqd_msg *mq_get_free(mqd_t mq, const struct timespec *abs_timeout, int *ercd) {
+  struct mqd_msg *msg = TAILQ_FIRST(&mq->free);
+
+  /* another sender may take the message first after the wakeup, so wait again */
+  while ((NULL == msg) && (0 == *ercd)) {
+    *ercd = Os_ListWait(&mq->slist, abs_timeout);
+    if (*ercd > 0) {
+      *ercd = -*ercd; /* the ETIMEDOUT of Os_ListWait is positive */
+    } else if (0 == *ercd) {
+      msg = TAILQ_FIRST(&mq->free);
+    }
+  }
+
+  if (NULL != msg) {
+    TAILQ_REMOVE(&mq->free, msg, entry);
+    msg->state = MQ_MSG_RESERVED;
+  }
+
+  return msg;
+}
+
+/* queue the message behind the ones of the same or a higher priority, the common case of all
+ * messages with the same priority is found at the tail in O(1) */
+static void mq_put_avail(mqd_t mq, struct mqd_msg *msg, size_t msg_len, unsigned msg_prio) {
+  struct mqd_msg *prev;
+
+  msg->len = msg_len;
+  msg->prio = msg_prio;
+  msg->state = MQ_MSG_QUEUED;
+  TAILQ_FOREACH_REVERSE(prev, &mq->avail, mqavail_list, entry) {
+    if (prev->prio >= msg_prio) {
+      break;
+    }
+  }
+
+  if (NULL != prev) {
+    TAILQ_INSERT_AFTER(&mq->avail, prev, msg, entry);
+  } else {
+    TAILQ_INSERT_HEAD(&mq->avail, msg, entry);
+  }
+  mq->curmsgs++;
+  (void)Os_ListPost(&mq->rlist, TRUE);
+}
+
+/* take the highest priority message, wait if the queue is empty, called with the critical
+ * section held */
+static struct mqd_msg *mq_get_avail(mqd_t mq, const struct timespec *abs_timeout, int *ercd) {
+  struct mqd_msg *msg = TAILQ_FIRST(&mq->avail);
+
+  while ((NULL == msg) && (0 == *ercd)) {
+    *ercd = Os_ListWait(&mq->rlist, abs_timeout);
+    if (*ercd > 0) {
+      *ercd = -*ercd; /* the ETIMEDOUT of Os_ListWait is positive */
+    } else if (0 == *ercd) {
+      msg = TAILQ_FIRST(&mq->avail);
+    }
+  }
+
+  if (NULL != msg) {
+    TAILQ_REMOVE(&mq->avail, msg, entry);
+    mq->curmsgs--;
+    msg->state = MQ_MSG_BORROWED;
+  }
+
+  return msg;
+}
+
+static void mq_put_free(mqd_t mq, struct mqd_msg *msg) {
+  msg->state = MQ_MSG_FREE;
+  TAILQ_INSERT_TAIL(&mq->free, msg, entry);
+  (void)Os_ListPost(&mq->slist, TRUE);
+}
 /* ================================ [ FUNCTIONS ] ============================================== */
 mqd_t mq_open(const char *name, int oflag, ...) {
   struct mqd *mq = NULL;
@@ -53,11 +191,13 @@ mqd_t mq_open(const char *name, int oflag, ...) {
   mode_t mode;
   long sz, i;
   struct mq_attr *attr = NULL;
+  uint32_t hash;
 
   asAssert(name != NULL);
 
+  hash = mq_hash(name);
   EnterCritical();
-  mq = mq_find(name);
+  mq = mq_find(name, hash);
   ExitCritical();
 
   if ((NULL == mq) && (0 != (oflag & O_CREAT))) {
@@ -74,21 +214,28 @@ mqd_t mq_open(const char *name, int oflag, ...) {
     if (NULL != mq) {
       TAILQ_INIT(&mq->free);
       TAILQ_INIT(&mq->avail);
+      TAILQ_INIT(&mq->slist);
+      TAILQ_INIT(&mq->rlist);
       msg = (struct mqd_msg *)&mq[1];
       for (i = 0; i < attr->mq_maxmsg; i++) {
+        msg->state = MQ_MSG_FREE;
         TAILQ_INSERT_TAIL(&mq->free, msg, entry);
         msg = (struct mqd_msg *)(((void *)msg) + sz);
       }
       mq->name = ((char *)&mq[1]) + sz * attr->mq_maxmsg;
       strcpy(mq->name, name);
+      mq->hash = hash;
       mq->msgsize = attr->mq_msgsize;
+      mq->slotsize = sz;
+      mq->maxmsg = attr->mq_maxmsg;
+      mq->curmsgs = 0;
       mq->refcount = 0;
       mq->unlinked = 0;
       EnterCritical();
       /* no consideration of the mq_create race condition,
        * so just assert if such condition */
-      asAssert(NULL == mq_find(name));
-      TAILQ_INSERT_TAIL(&OsMqueueList, mq, entry);
+      asAssert(NULL == mq_find(name, hash));
+      TAILQ_INSERT_TAIL(mq_bucket(hash), mq, entry);
       ExitCritical();
     }
   }
@@ -110,8 +257,7 @@ int mq_close(mqd_t mq) {
   if (mq->refcount > 0) {
     mq->refcount--;
     if ((0 == mq->refcount) && (mq->unlinked)) {
-      TAILQ_REMOVE(&OsMqueueList, mq, entry);
-      Os_MemFree((uint8_t *)mq);
+      mq_destroy(mq);
     }
   } else {
     ercd = -EACCES;
@@ -125,14 +271,14 @@ ELF_EXPORT(mq_close);
 int mq_unlink(const char *name) {
   int ercd = 0;
   struct mqd *mq = NULL;
+  uint32_t hash = mq_hash(name);
 
   EnterCritical();
-  mq = mq_find(name);
+  mq = mq_find(name, hash);
   if (NULL != mq) {
     mq->unlinked = 1;
     if (0 == mq->refcount) {
-      TAILQ_REMOVE(&OsMqueueList, mq, entry);
-      Os_MemFree((uint8_t *)mq);
+      mq_destroy(mq);
     }
   }
   ExitCritical();
@@ -141,6 +287,21 @@ int mq_unlink(const char *name) {
 }
 ELF_EXPORT(mq_unlink);
 
+int mq_getattr(mqd_t mq, struct mq_attr *mqstat) {
+  asAssert(mq);
+  asAssert(mqstat);
+
+  EnterCritical();
+  mqstat->mq_flags = 0;
+  mqstat->mq_maxmsg = mq->maxmsg;
+  mqstat->mq_msgsize = (long)mq->msgsize;
+  mqstat->mq_curmsgs = mq->curmsgs;
+  ExitCritical();
+
+  return 0;
+}
+ELF_EXPORT(mq_getattr);
+
 int mq_timedsend(mqd_t mq, const char *msg_ptr, size_t msg_len, unsigned msg_prio,
                  const struct timespec *abs_timeout) {
   int ercd = 0;
@@ -149,32 +310,23 @@ int mq_timedsend(mqd_t mq, const char *msg_ptr, size_t msg_len, unsigned msg_pri
   asAssert(mq);
   asAssert(msg_ptr);
   asAssert(msg_len > 0);
-  (void)msg_prio;
 
-  /* greater than one message size */
-  if (msg_len <= mq->msgsize) {
+  if (msg_len > mq->msgsize) {
+    ercd = -EMSGSIZE;
+  } else if (msg_prio >= MQ_PRIO_MAX) {
+    ercd = -EINVAL;
+  } else {
     EnterCritical();
-    msg = TAILQ_FIRST(&mq->free);
-    if (NULL == msg) {
-
-      ercd = Os_ListWait(&mq->slist, abs_timeout);
-
-      if (0 == ercd) {
-        msg = TAILQ_FIRST(&mq->free);
-      }
-    }
-
+    msg = mq_get_free(mq, abs_timeout, &ercd);
     if (NULL != msg) {
-      TAILQ_REMOVE(&mq->free, msg, entry);
-      memcpy(&msg[1], msg_ptr, msg_len);
-      TAILQ_INSERT_TAIL(&mq->avail, msg, entry);
-      (void)Os_ListPost(&mq->rlist, TRUE);
-    } else {
+      memcpy(MQ_MSG_DATA(msg), msg_ptr, msg_len);
+      mq_put_avail(mq, msg, msg_len, msg_prio);
+    } else if (0 == ercd) {
       ercd = -ENOSPC;
+    } else {
+      /* the timeout of the wait */
     }
     ExitCritical();
-  } else {
-    ercd = -EINVAL;
   }
 
   return ercd;
@@ -189,39 +341,34 @@ ELF_EXPORT(mq_send);
 ssize_t mq_timedreceive(mqd_t mq, char *msg_ptr, size_t msg_len, unsigned *msg_prio,
                         const struct timespec *abs_timeout) {
   int ercd = 0;
+  ssize_t len = 0;
   struct mqd_msg *msg;
 
   asAssert(mq);
   asAssert(msg_ptr);
-  asAssert(msg_len > 0);
-  (void)msg_prio;
 
-  /* greater than one message size */
-  if (msg_len <= mq->msgsize) {
+  /* the buffer must be able to hold the largest message */
+  if (msg_len < mq->msgsize) {
+    ercd = -EMSGSIZE;
+  } else {
     EnterCritical();
-    msg = TAILQ_FIRST(&mq->avail);
-    if (NULL == msg) {
-      ercd = Os_ListWait(&mq->rlist, abs_timeout);
-
-      if (0 == ercd) {
-        msg = TAILQ_FIRST(&mq->free);
-      }
-    }
-
+    msg = mq_get_avail(mq, abs_timeout, &ercd);
     if (NULL != msg) {
-      TAILQ_REMOVE(&mq->avail, msg, entry);
-      memcpy(msg_ptr, &msg[1], msg_len > mq->msgsize ? mq->msgsize : msg_len);
-      TAILQ_INSERT_TAIL(&mq->free, msg, entry);
-      (void)Os_ListPost(&mq->slist, TRUE);
-    } else {
+      len = (ssize_t)msg->len;
+      memcpy(msg_ptr, MQ_MSG_DATA(msg), msg->len);
+      if (NULL != msg_prio) {
+        *msg_prio = msg->prio;
+      }
+      mq_put_free(mq, msg);
+    } else if (0 == ercd) {
       ercd = -ENOSPC;
+    } else {
+      /* the timeout of the wait */
     }
     ExitCritical();
-  } else {
-    ercd = -EINVAL;
   }
 
-  return ercd;
+  return (0 == ercd) ? len : ercd;
 }
 ELF_EXPORT(mq_timedreceive);
 
@@ -230,4 +377,109 @@ ssize_t mq_receive(mqd_t mq, char *msg_ptr, size_t msg_len, unsigned *msg_prio)
 }
 ELF_EXPORT(mq_receive);
 
+int mq_reserve(mqd_t mq, void **msg_ptr, const struct timespec *abs_timeout) {
+  int ercd = 0;
+  struct mqd_msg *msg;
+
+  asAssert(mq);
+  asAssert(msg_ptr);
+
+  EnterCritical();
+  msg = mq_get_free(mq, abs_timeout, &ercd);
+  ExitCritical();
+
+  if (NULL != msg) {
+    *msg_ptr = MQ_MSG_DATA(msg);
+  } else if (0 == ercd) {
+    ercd = -ENOSPC;
+  } else {
+    /* the timeout of the wait */
+  }
+
+  return ercd;
+}
+ELF_EXPORT(mq_reserve);
+
+int mq_commit(mqd_t mq, void *msg_ptr, size_t msg_len, unsigned msg_prio) {
+  int ercd = 0;
+  struct mqd_msg *msg;
+
+  asAssert(mq);
+  asAssert(msg_ptr);
+  asAssert(msg_len > 0);
+
+  msg = MQ_DATA_MSG(msg_ptr);
+  if (FALSE == mq_owns(mq, msg)) {
+    ercd = -EINVAL;
+  } else if (msg_len > mq->msgsize) {
+    ercd = -EMSGSIZE;
+  } else if (msg_prio >= MQ_PRIO_MAX) {
+    ercd = -EINVAL;
+  } else {
+    EnterCritical();
+    if (MQ_MSG_RESERVED == msg->state) {
+      mq_put_avail(mq, msg, msg_len, msg_prio);
+    } else {
+      ercd = -EINVAL; /* not reserved or already committed */
+    }
+    ExitCritical();
+  }
+
+  return ercd;
+}
+ELF_EXPORT(mq_commit);
+
+ssize_t mq_borrow(mqd_t mq, void **msg_ptr, unsigned *msg_prio,
+                  const struct timespec *abs_timeout) {
+  int ercd = 0;
+  ssize_t len = 0;
+  struct mqd_msg *msg;
+
+  asAssert(mq);
+  asAssert(msg_ptr);
+
+  EnterCritical();
+  msg = mq_get_avail(mq, abs_timeout, &ercd);
+  ExitCritical();
+
+  if (NULL != msg) {
+    len = (ssize_t)msg->len;
+    *msg_ptr = MQ_MSG_DATA(msg);
+    if (NULL != msg_prio) {
+      *msg_prio = msg->prio;
+    }
+  } else if (0 == ercd) {
+    ercd = -ENOSPC;
+  } else {
+    /* the timeout of the wait */
+  }
+
+  return (0 == ercd) ? len : ercd;
+}
+ELF_EXPORT(mq_borrow);
+
+int mq_release(mqd_t mq, void *msg_ptr) {
+  int ercd = 0;
+  struct mqd_msg *msg;
+
+  asAssert(mq);
+  asAssert(msg_ptr);
+
+  msg = MQ_DATA_MSG(msg_ptr);
+  if (mq_owns(mq, msg)) {
+    EnterCritical();
+    if ((MQ_MSG_RESERVED == msg->state) || (MQ_MSG_BORROWED == msg->state)) {
+      mq_put_free(mq, msg);
+    } else {
+      ercd = -EINVAL; /* not lent out or already released */
+    }
+    ExitCritical();
+  } else {
+    ercd = -EINVAL;
+  }
+
+  return ercd;
+}
+ELF_EXPORT(mq_release);
+
 #endif /* OS_PTHREAD_NUM */
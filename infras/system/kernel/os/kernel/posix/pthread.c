@@ -144,7 +144,7 @@ int pthread_create(pthread_t *tid, const pthread_attr_t *attr, void *(*start)(vo
     pTaskVar->activation = 1;
 #endif
     pTaskVar->state = READY;
-    memset(pTaskConst->pStack, 0, pTaskConst->stackSize);
+    Os_StackFill(pTaskConst->pStack, pTaskConst->stackSize);
     pTaskVar->currentResource = INVALID_RESOURCE;
     pTaskVar->pConst = pTaskConst;
     pTaskVar->priority = pTaskConst->initPriority;
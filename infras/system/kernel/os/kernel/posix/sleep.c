@@ -6,40 +6,222 @@
 #include "kernel_internal.h"
 #if (OS_PTHREAD_NUM > 0)
 #include "pthread.h"
+#include <stddef.h>
 #include <unistd.h>
 #include "Std_Debug.h"
 /* ================================ [ MACROS    ] ============================================== */
 #define AS_LOG_OS 1
+
+#define OS_TIMER_KEY_BEFORE(a, b)                                                                  \
+  (((a)->deadline < (b)->deadline) || (((a)->deadline == (b)->deadline) && ((a) < (b))))
 /* ================================ [ TYPES     ] ============================================== */
+#if defined(__GLIBC__) && !defined(__useconds_t_defined)
+/* the hosted posix port builds with a strict _POSIX_C_SOURCE, see portable.h */
+typedef __useconds_t useconds_t;
+#define __useconds_t_defined
+#endif
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
-static TAILQ_HEAD(sleep_list, TaskVar) OsSleepListHead;
+/* The same binary min heap as the alarms of a counter, but keyed by an absolute deadline in ns,
+ * so that neither the insert nor the tick has to walk the sleeping tasks. */
+static OsTimerType *OsTimerHeap[OS_TIMER_NUM];
+static uint16 OsTimerSize;
+#ifdef OS_USE_HRTIMER
+static uint64_t OsTimerProgrammed; /* the deadline the one shot timer is armed for, 0 if not */
+#else
+static uint64_t OsSleepTicks; /* OsTick never wraps in the OS time */
+#endif
 
-static struct timeval timeofday;
+/* TODO: should get timeofday from RTC */
+static uint64_t OsRealTimeOffset;
 /* ================================ [ LOCALS    ] ============================================== */
+static inline void Os_TimerHeapSet(uint16 index, OsTimerType *timer) {
+  OsTimerHeap[index] = timer;
+  timer->index = index;
+}
+
+static void Os_TimerSiftUp(uint16 index) {
+  OsTimerType *timer = OsTimerHeap[index];
+  uint16 parent;
+
+  while (index > 0) {
+    parent = (index - 1) / 2;
+    if (OS_TIMER_KEY_BEFORE(timer, OsTimerHeap[parent])) {
+      Os_TimerHeapSet(index, OsTimerHeap[parent]);
+      index = parent;
+    } else {
+      break;
+    }
+  }
+  Os_TimerHeapSet(index, timer);
+}
+
+static void Os_TimerSiftDown(uint16 index) {
+  OsTimerType *timer = OsTimerHeap[index];
+  uint16 child;
+
+  while ((2 * (uint32)index + 1) < OsTimerSize) {
+    child = 2 * index + 1;
+    if (((child + 1) < OsTimerSize) &&
+        OS_TIMER_KEY_BEFORE(OsTimerHeap[child + 1], OsTimerHeap[child])) {
+      child++;
+    }
+    if (OS_TIMER_KEY_BEFORE(OsTimerHeap[child], timer)) {
+      Os_TimerHeapSet(index, OsTimerHeap[child]);
+      index = child;
+    } else {
+      break;
+    }
+  }
+  Os_TimerHeapSet(index, timer);
+}
+
+/* arm the one shot timer for the head of the heap if it is changed */
+static void Os_TimerProgram(void) {
+#ifdef OS_USE_HRTIMER
+  uint64_t deadline = 0;
+
+  if (OsTimerSize > 0) {
+    deadline = OsTimerHeap[0]->deadline;
+    if (0u == deadline) {
+      deadline = 1; /* 0 is to disarm */
+    }
+  }
+
+  if (deadline != OsTimerProgrammed) {
+    OsTimerProgrammed = deadline;
+    Os_PortHrTimerProgram(deadline);
+  }
+#endif
+}
+
+static void Os_SleepWakeup(OsTimerType *timer) {
+  TaskVarType *pTaskVar = (TaskVarType *)(((uint8 *)timer) - offsetof(TaskVarType, timer));
+
+  /* the PTHREAD_STATE_WAITING is left to tell the Os_ListWait that it is timeout */
+  pTaskVar->state &= ~PTHREAD_STATE_SLEEPING;
+  OS_TRACE_TASK_ACTIVATION(pTaskVar);
+  Sched_AddReady(pTaskVar - TaskVarArray);
+}
+
+static uint64_t Os_TimespecToNs(const struct timespec *ts) {
+  return ((uint64_t)ts->tv_sec * 1000000000ull) + (uint64_t)ts->tv_nsec;
+}
 /* ================================ [ FUNCTIONS ] ============================================== */
 void Os_SleepInit(void) {
-  /* TODO: should get timeofday from RTC*/
-  timeofday.tv_sec = 0;
-  timeofday.tv_usec = 0;
-  TAILQ_INIT(&OsSleepListHead);
+  OsTimerSize = 0;
+  OsRealTimeOffset = 0;
+#ifdef OS_USE_HRTIMER
+  OsTimerProgrammed = 0;
+#else
+  OsSleepTicks = 0;
+#endif
 }
 
-void Os_Sleep(TickType tick) {
+/* the OS time in ns */
+uint64_t Os_SleepNow(void) {
+#ifdef OS_USE_HRTIMER
+  return Os_PortHrTime();
+#else
+  uint64_t now;
+
+  EnterCritical();
+  now = OsSleepTicks * NSECONDS_PER_TICK;
+  ExitCritical();
+
+  return now;
+#endif
+}
+
+/* CLOCK_REALTIME = the OS time + the offset */
+uint64_t Os_SleepRealTimeOffset(void) {
+  return OsRealTimeOffset;
+}
+
+boolean Os_TimerIsStarted(const OsTimerType *timer) {
+  return (boolean)((timer->index < OsTimerSize) && (timer == OsTimerHeap[timer->index]));
+}
+
+/* called with the critical section held, the timer must be stopped */
+void Os_TimerStart(OsTimerType *timer, uint64_t deadline) {
+  asAssert(OsTimerSize < OS_TIMER_NUM);
+  asAssert(FALSE == Os_TimerIsStarted(timer));
+
+  timer->deadline = deadline;
+  Os_TimerHeapSet(OsTimerSize, timer);
+  OsTimerSize++;
+  Os_TimerSiftUp(timer->index);
+  Os_TimerProgram();
+}
+
+/* called with the critical section held, nothing to do if not started */
+void Os_TimerStop(OsTimerType *timer) {
+  uint16 index = timer->index;
+
+  if (Os_TimerIsStarted(timer)) {
+    OsTimerSize--;
+    if (index < OsTimerSize) {
+      Os_TimerHeapSet(index, OsTimerHeap[OsTimerSize]);
+      if ((index > 0) && OS_TIMER_KEY_BEFORE(OsTimerHeap[index], OsTimerHeap[(index - 1) / 2])) {
+        Os_TimerSiftUp(index);
+      } else {
+        Os_TimerSiftDown(index);
+      }
+    }
+    timer->index = OS_TIMER_NUM;
+    Os_TimerProgram();
+  }
+}
+
+/* expire all the timers whose deadline is reached, called by OsTick or the ISR of the one shot
+ * timer, an expire callback may start its timer again */
+void Os_SleepExpire(void) {
+  OsTimerType *timer;
+  uint64_t now;
+
+  EnterCritical();
+#ifdef OS_USE_HRTIMER
+  OsTimerProgrammed = 0; /* the one shot is consumed */
+#endif
+  now = Os_SleepNow();
+  while ((OsTimerSize > 0) && (OsTimerHeap[0]->deadline <= now)) {
+    timer = OsTimerHeap[0];
+    Os_TimerStop(timer);
+    timer->expire(timer);
+  }
+  Os_TimerProgram();
+  ExitCritical();
+}
+
+#ifndef OS_USE_HRTIMER
+void Os_SleepTick(void) {
+  EnterCritical();
+  OsSleepTicks++;
+  ExitCritical();
+
+  Os_SleepExpire();
+}
+#endif
+
+void Os_SleepUntil(uint64_t deadline) {
   DECLARE_SMP_PROCESSOR_ID();
 
   EnterCritical();
-  if (NULL != RunningVar) {
-    Os_SleepAdd(RunningVar, tick);
+  if ((NULL != RunningVar) && (deadline > Os_SleepNow())) {
+    Os_SleepAdd(RunningVar, deadline);
     Sched_GetReady();
     Os_PortDispatch();
   }
   ExitCritical();
 }
 
+void Os_Sleep(TickType tick) {
+  Os_SleepUntil(Os_SleepNow() + (uint64_t)tick * NSECONDS_PER_TICK);
+}
+
 int usleep(useconds_t __useconds) {
-  Os_Sleep((__useconds + USECONDS_PER_TICK - 1) / USECONDS_PER_TICK);
-  return __useconds;
+  Os_SleepUntil(Os_SleepNow() + (uint64_t)__useconds * 1000u);
+  return 0;
 }
 ELF_EXPORT(usleep);
 
@@ -60,73 +242,21 @@ long int sysconf(int parameter) {
 ELF_EXPORT(sysconf);
 
 unsigned int sleep(unsigned int __seconds) {
-  Os_Sleep((__seconds * 1000000 + USECONDS_PER_TICK - 1) / USECONDS_PER_TICK);
+  Os_SleepUntil(Os_SleepNow() + (uint64_t)__seconds * 1000000000ull);
   return 0;
 }
 ELF_EXPORT(sleep);
 
-void Os_SleepTick(void) {
-  TaskVarType *pTaskVar;
-  TaskVarType *pNext;
-
-  EnterCritical();
-  timeofday.tv_usec += USECONDS_PER_TICK;
-
-  if (timeofday.tv_usec > 1000000) {
-    timeofday.tv_usec -= 1000000;
-    timeofday.tv_sec += 1;
-  }
-
-  pTaskVar = TAILQ_FIRST(&OsSleepListHead);
-
-  while (NULL != pTaskVar) {
-    pNext = TAILQ_NEXT(pTaskVar, sentry);
-
-    if (pTaskVar->sleep_tick > 0) {
-      pTaskVar->sleep_tick--;
-    }
-    if (0u == pTaskVar->sleep_tick) {
-      OS_TRACE_TASK_ACTIVATION(pTaskVar);
-      Sched_AddReady(pTaskVar - TaskVarArray);
-      Os_SleepRemove(pTaskVar);
-    }
-
-    pTaskVar = pNext;
-    if ((NULL != pTaskVar) && (pTaskVar->sleep_tick > 0)) {
-      break;
-    }
-  }
-  ExitCritical();
-}
-
-void Os_SleepAdd(TaskVarType *pTaskVar, TickType ticks) {
-  TaskVarType *pVar;
-  TaskVarType *pPosVar = NULL;
-
-  TAILQ_FOREACH(pVar, &OsSleepListHead, sentry) {
-    if ((TickType)(pVar->sleep_tick) > ticks) {
-      pPosVar = pVar;
-      pVar->sleep_tick -= ticks;
-      break;
-    } else {
-      ticks -= pVar->sleep_tick;
-    }
-  }
-
-  pTaskVar->sleep_tick = ticks;
+void Os_SleepAdd(TaskVarType *pTaskVar, uint64_t deadline) {
   asAssert(0u == (pTaskVar->state & PTHREAD_STATE_SLEEPING));
   pTaskVar->state |= PTHREAD_STATE_SLEEPING;
-
-  if (NULL != pPosVar) {
-    TAILQ_INSERT_BEFORE(pPosVar, pTaskVar, sentry);
-  } else {
-    TAILQ_INSERT_TAIL(&OsSleepListHead, pTaskVar, sentry);
-  }
+  pTaskVar->timer.expire = Os_SleepWakeup;
+  Os_TimerStart(&pTaskVar->timer, deadline);
 }
 
 void Os_SleepRemove(TaskVarType *pTaskVar) {
   pTaskVar->state &= ~PTHREAD_STATE_SLEEPING;
-  TAILQ_REMOVE(&OsSleepListHead, pTaskVar, sentry);
+  Os_TimerStop(&pTaskVar->timer);
 }
 #if defined(__USE_BSD)
 int gettimeofday(struct timeval *tp, struct timezone *tzp)
@@ -134,58 +264,35 @@ int gettimeofday(struct timeval *tp, struct timezone *tzp)
 int gettimeofday(struct timeval *tp, void *tzp)
 #endif
 {
+  uint64_t now;
+
   if (tp != NULL) {
-    *tp = timeofday;
+    now = Os_SleepNow() + OsRealTimeOffset;
+    tp->tv_sec = (time_t)(now / 1000000000ull);
+    tp->tv_usec = (long)((now % 1000000000ull) / 1000u);
   }
 
   return 0;
 }
 ELF_EXPORT(gettimeofday);
 
-TickType GetTimespecLeftTicks(const struct timespec *abstime) {
-  TickType ticks;
-  struct timeval tp;
-  time_t sec;
-  long usec;
-
-  tp.tv_sec = abstime->tv_sec;
-  tp.tv_usec = (abstime->tv_nsec + 999) / 1000;
-
-  usec = tp.tv_usec - timeofday.tv_usec;
-
-  if (tp.tv_sec > timeofday.tv_sec) {
-    sec = tp.tv_sec - timeofday.tv_sec;
-    if (usec < 0) {
-      sec -= 1;
-      usec = 1000000 + usec;
-    }
-  } else if ((tp.tv_sec == timeofday.tv_sec) && (usec > 0)) {
-    sec = 0;
-  } else {
-    sec = 0;
-    usec = 0;
-  }
-
-  ticks = sec * OS_TICKS_PER_SECOND + (usec / USECONDS_PER_TICK);
-
-  return ticks;
-}
-
+/* abstime is of the CLOCK_REALTIME */
 int Os_ListWait(TaskListType *list, const struct timespec *abstime) {
   int ercd = 0;
-  TickType ticks;
+  uint64_t deadline = 0;
   DECLARE_SMP_PROCESSOR_ID();
 
   if (NULL != abstime) {
-    ticks = GetTimespecLeftTicks(abstime);
-    if (ticks > 0) {
+    deadline = Os_TimespecToNs(abstime);
+    if (deadline > (Os_SleepNow() + OsRealTimeOffset)) {
+      deadline -= OsRealTimeOffset;
       /* do wait event of list with timeout */
       asAssert(0u == (RunningVar->state & PTHREAD_STATE_WAITING));
       RunningVar->state |= PTHREAD_STATE_WAITING;
       RunningVar->list = list;
       TAILQ_INSERT_TAIL(list, RunningVar, entry);
 
-      Os_SleepAdd(RunningVar, ticks);
+      Os_SleepAdd(RunningVar, deadline);
     } else {
       /* no "-" for lwip ports/unix/sys_arch.c line 396 */
       ercd = ETIMEDOUT;
@@ -10,16 +10,87 @@
 #include <string.h>
 #include <sys/time.h>
 #include <sys/times.h>
+#include "timerfd.h"
 #ifdef USE_PTHREAD_SIGNAL
 #include "signal.h"
 #endif
 #include "Std_Debug.h"
 /* ================================ [ MACROS    ] ============================================== */
 #define AS_LOG_TIMER 0
+
+#define NSECONDS_PER_SECOND 1000000000ull
 /* ================================ [ TYPES     ] ============================================== */
+struct timerfd {
+  OsTimerType timer;
+  uint64_t period;
+  uint64_t expirations;
+  TaskListType waiters;
+  int clockid;
+  int flags;
+  boolean used;
+};
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
+static struct timerfd OsTimerFds[OS_TIMERFD_NUM];
 /* ================================ [ LOCALS    ] ============================================== */
+static inline uint64_t timespec2Ns(const struct timespec *ts) {
+  return ((uint64_t)ts->tv_sec * NSECONDS_PER_SECOND) + (uint64_t)ts->tv_nsec;
+}
+
+static inline void ns2Timespec(struct timespec *ts, uint64_t ns) {
+  ts->tv_sec = (time_t)(ns / NSECONDS_PER_SECOND);
+  ts->tv_nsec = (long)(ns % NSECONDS_PER_SECOND);
+}
+
+static inline boolean timespecIsValid(const struct timespec *ts) {
+  return (boolean)((ts->tv_sec >= 0) && (ts->tv_nsec >= 0) &&
+                   ((uint64_t)ts->tv_nsec < NSECONDS_PER_SECOND));
+}
+
+/* the deadline in the OS time of an absolute time of the clock */
+static uint64_t clockAbsToDeadline(int clockid, uint64_t abs) {
+  uint64_t offset = 0;
+
+  if (CLOCK_REALTIME == clockid) {
+    offset = Os_SleepRealTimeOffset();
+  }
+
+  return (abs > offset) ? (abs - offset) : 0;
+}
+
+static struct timerfd *timerfd_get(int fd) {
+  struct timerfd *tfd = NULL;
+
+  if ((fd >= 0) && (fd < OS_TIMERFD_NUM) && (OsTimerFds[fd].used)) {
+    tfd = &OsTimerFds[fd];
+  }
+
+  return tfd;
+}
+
+/* called in the critical section when the deadline is reached, the next deadline is the last one
+ * plus the period, the periods missed meanwhile are counted as expirations */
+static void timerfd_expire(OsTimerType *timer) {
+  struct timerfd *tfd = (struct timerfd *)timer;
+  uint64_t now;
+  uint64_t missed;
+
+  tfd->expirations++;
+  if (tfd->period > 0) {
+    now = Os_SleepNow();
+    timer->deadline += tfd->period;
+    if (timer->deadline <= now) {
+      missed = (now - timer->deadline) / tfd->period + 1;
+      tfd->expirations += missed;
+      timer->deadline += missed * tfd->period;
+    }
+    Os_TimerStart(timer, timer->deadline);
+  }
+
+  while (0 == Os_ListPost(&tfd->waiters, FALSE)) {
+  }
+}
+
 static inline TickType timeval2Ticks(const struct timeval *val) { /* no consideration overflow */
   return (OS_TICKS_PER_SECOND * val->tv_sec) +
          ((val->tv_usec + USECONDS_PER_TICK - 1) / USECONDS_PER_TICK);
@@ -83,6 +154,224 @@ int setitimer(int which, const struct itimerval *new, struct itimerval *old) {
 }
 ELF_EXPORT(setitimer);
 
+int clock_gettime(clockid_t clock_id, struct timespec *tp) {
+  int ercd = 0;
+  uint64_t now = Os_SleepNow();
+
+  switch (clock_id) {
+  case CLOCK_REALTIME:
+    ns2Timespec(tp, now + Os_SleepRealTimeOffset());
+    break;
+  case CLOCK_MONOTONIC:
+    ns2Timespec(tp, now);
+    break;
+  default:
+    ercd = -EINVAL;
+    break;
+  }
+
+  return ercd;
+}
+ELF_EXPORT(clock_gettime);
+
+int clock_getres(clockid_t clock_id, struct timespec *res) {
+  int ercd = 0;
+
+  if ((CLOCK_REALTIME != clock_id) && (CLOCK_MONOTONIC != clock_id)) {
+    ercd = -EINVAL;
+  } else if (NULL != res) {
+#ifdef OS_USE_HRTIMER
+    ns2Timespec(res, 1);
+#else
+    ns2Timespec(res, NSECONDS_PER_TICK);
+#endif
+  }
+
+  return ercd;
+}
+ELF_EXPORT(clock_getres);
+
+/* no signal interrupts the sleep, so the remain is always 0 */
+int clock_nanosleep(clockid_t clock_id, int flags, const struct timespec *request,
+                    struct timespec *remain) {
+  int ercd = 0;
+  uint64_t deadline;
+
+  if ((CLOCK_REALTIME != clock_id) && (CLOCK_MONOTONIC != clock_id)) {
+    ercd = -EINVAL;
+  } else if ((NULL == request) || (FALSE == timespecIsValid(request))) {
+    ercd = -EINVAL;
+  } else {
+    if (flags & TIMER_ABSTIME) {
+      deadline = clockAbsToDeadline(clock_id, timespec2Ns(request));
+    } else {
+      deadline = Os_SleepNow() + timespec2Ns(request);
+    }
+    Os_SleepUntil(deadline);
+    if ((NULL != remain) && (0 == (flags & TIMER_ABSTIME))) {
+      ns2Timespec(remain, 0);
+    }
+  }
+
+  return ercd;
+}
+ELF_EXPORT(clock_nanosleep);
+
+int nanosleep(const struct timespec *request, struct timespec *remain) {
+  return clock_nanosleep(CLOCK_MONOTONIC, 0, request, remain);
+}
+ELF_EXPORT(nanosleep);
+
+void Os_TimerInit(void) {
+  int fd;
+
+  for (fd = 0; fd < OS_TIMERFD_NUM; fd++) {
+    OsTimerFds[fd].used = FALSE;
+  }
+}
+
+int timerfd_create(int clockid, int flags) {
+  int fd = -ENFILE;
+  int i;
+  struct timerfd *tfd;
+
+  if ((CLOCK_REALTIME != clockid) && (CLOCK_MONOTONIC != clockid)) {
+    fd = -EINVAL;
+  } else {
+    EnterCritical();
+    for (i = 0; i < OS_TIMERFD_NUM; i++) {
+      tfd = &OsTimerFds[i];
+      if (FALSE == tfd->used) {
+        memset(tfd, 0, sizeof(*tfd));
+        tfd->timer.index = OS_TIMER_NUM;
+        tfd->timer.expire = timerfd_expire;
+        TAILQ_INIT(&tfd->waiters);
+        tfd->clockid = clockid;
+        tfd->flags = flags;
+        tfd->used = TRUE;
+        fd = i;
+        break;
+      }
+    }
+    ExitCritical();
+  }
+
+  return fd;
+}
+ELF_EXPORT(timerfd_create);
+
+int timerfd_gettime(int fd, struct itimerspec *curr_value) {
+  int ercd = 0;
+  struct timerfd *tfd = timerfd_get(fd);
+  uint64_t now;
+
+  if ((NULL == tfd) || (NULL == curr_value)) {
+    ercd = -EINVAL;
+  } else {
+    EnterCritical();
+    now = Os_SleepNow();
+    if (Os_TimerIsStarted(&tfd->timer) && (tfd->timer.deadline > now)) {
+      ns2Timespec(&curr_value->it_value, tfd->timer.deadline - now);
+    } else if (Os_TimerIsStarted(&tfd->timer)) {
+      ns2Timespec(&curr_value->it_value, 1); /* expiring */
+    } else {
+      ns2Timespec(&curr_value->it_value, 0);
+    }
+    ns2Timespec(&curr_value->it_interval, tfd->period);
+    ExitCritical();
+  }
+
+  return ercd;
+}
+ELF_EXPORT(timerfd_gettime);
+
+int timerfd_settime(int fd, int flags, const struct itimerspec *new_value,
+                    struct itimerspec *old_value) {
+  int ercd = 0;
+  struct timerfd *tfd = timerfd_get(fd);
+  uint64_t value;
+  uint64_t deadline;
+
+  if ((NULL == tfd) || (NULL == new_value)) {
+    ercd = -EINVAL;
+  } else if ((FALSE == timespecIsValid(&new_value->it_value)) ||
+             (FALSE == timespecIsValid(&new_value->it_interval))) {
+    ercd = -EINVAL;
+  } else {
+    if (NULL != old_value) {
+      (void)timerfd_gettime(fd, old_value);
+    }
+    value = timespec2Ns(&new_value->it_value);
+    EnterCritical();
+    Os_TimerStop(&tfd->timer);
+    tfd->expirations = 0;
+    tfd->period = timespec2Ns(&new_value->it_interval);
+    if (value > 0) { /* 0 to disarm */
+      if (flags & TFD_TIMER_ABSTIME) {
+        deadline = clockAbsToDeadline(tfd->clockid, value);
+      } else {
+        deadline = Os_SleepNow() + value;
+      }
+      Os_TimerStart(&tfd->timer, deadline);
+    }
+    ExitCritical();
+  }
+
+  return ercd;
+}
+ELF_EXPORT(timerfd_settime);
+
+/* wait until the timer expires at least once, and take the number of the expirations since the
+ * last wait */
+int timerfd_wait(int fd, uint64_t *expirations) {
+  int ercd = 0;
+  struct timerfd *tfd = timerfd_get(fd);
+
+  if ((NULL == tfd) || (NULL == expirations)) {
+    ercd = -EINVAL;
+  } else {
+    EnterCritical();
+    while ((0 == ercd) && (0u == tfd->expirations)) {
+      if (tfd->flags & TFD_NONBLOCK) {
+        ercd = -EAGAIN;
+      } else {
+        (void)Os_ListWait(&tfd->waiters, NULL);
+        if (FALSE == tfd->used) {
+          ercd = -EBADF; /* closed while waiting */
+        }
+      }
+    }
+    if (0 == ercd) {
+      *expirations = tfd->expirations;
+      tfd->expirations = 0;
+    }
+    ExitCritical();
+  }
+
+  return ercd;
+}
+ELF_EXPORT(timerfd_wait);
+
+int timerfd_close(int fd) {
+  int ercd = 0;
+  struct timerfd *tfd = timerfd_get(fd);
+
+  if (NULL == tfd) {
+    ercd = -EBADF;
+  } else {
+    EnterCritical();
+    Os_TimerStop(&tfd->timer);
+    tfd->used = FALSE;
+    while (0 == Os_ListPost(&tfd->waiters, FALSE)) {
+    }
+    ExitCritical();
+    (void)Schedule();
+  }
+
+  return ercd;
+}
+ELF_EXPORT(timerfd_close);
+
 clock_t times(struct tms *buffer) {
   buffer->tms_stime = OsTickCounter;
   buffer->tms_cstime = OsTickCounter;
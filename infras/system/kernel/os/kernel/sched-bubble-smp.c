@@ -182,7 +182,7 @@ void Sched_AddReady(TaskType TaskID) {
   Sched_FindReady(&pReadyQueue);
 
   if ((cpuid != oncpu) && (OS_ON_ANY_CPU != oncpu)) {
-    if (priority > RunningVars[oncpu]->priority) {
+    if ((NULL == RunningVars[oncpu]) || (priority > RunningVars[oncpu]->priority)) {
       Os_PortRequestSchedule(oncpu);
     }
   }
@@ -213,7 +213,9 @@ void Sched_AddReady(TaskType TaskID) {
 
   Sched_SetReadyBit(oncpu, priority);
 
-  if (priority > ReadyVar->priority) {
+  if ((cpuid != oncpu) && (OS_ON_ANY_CPU != oncpu)) {
+    /* the ReadyVar of this CPU can't be a task bound to another CPU */
+  } else if ((NULL == ReadyVar) || (priority > ReadyVar->priority)) {
     ReadyVar = &TaskVarArray[fifo->pFIFO[SCHED_FIFO_HEAD(fifo)]];
   } else if (ReadyVar == RunningVar) {
     PriorityType priority1;
@@ -238,7 +240,7 @@ void Sched_AddReady(TaskType TaskID) {
   }
 
   if ((cpuid != oncpu) && (OS_ON_ANY_CPU != oncpu)) {
-    if (priority > RunningVars[oncpu]->priority) {
+    if ((NULL == RunningVars[oncpu]) || (priority > RunningVars[oncpu]->priority)) {
       Os_PortRequestSchedule(oncpu);
     }
   }
@@ -345,6 +347,7 @@ boolean Sched_Schedule(void) {
   PriorityType priority2;
   PriorityType priority;
 
+  EnterCritical();
   priority1 = Sched_GetReadyBit(cpuid);
   priority2 = Sched_GetReadyBit(OS_ON_ANY_CPU);
 
@@ -397,6 +400,7 @@ boolean Sched_Schedule(void) {
       }
     }
   }
+  ExitCritical();
 
   return needSchedule;
 }
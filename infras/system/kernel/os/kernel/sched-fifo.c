@@ -205,7 +205,7 @@ void Sched_AddReady(TaskType TaskID) {
 
   Sched_SetReadyBit(priority);
 
-  if (priority > ReadyVar->priority) {
+  if ((NULL == ReadyVar) || (priority > ReadyVar->priority)) {
     ReadyVar = &TaskVarArray[fifo->pFIFO[SCHED_FIFO_HEAD(fifo)]];
   } else if (ReadyVar == RunningVar) {
     priority = Sched_GetReadyBit();
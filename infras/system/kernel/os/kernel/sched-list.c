@@ -93,7 +93,7 @@ void Sched_AddReady(TaskType TaskID) {
 
   Sched_SetReadyBit(priority);
 
-  if (priority > ReadyVar->priority) {
+  if ((NULL == ReadyVar) || (priority > ReadyVar->priority)) {
     ReadyVar = TAILQ_FIRST(&(ReadyList[priority]));
   } else if (ReadyVar == RunningVar) {
     priority = Sched_GetReadyBit();
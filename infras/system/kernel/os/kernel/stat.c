@@ -0,0 +1,256 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "kernel_internal.h"
+#include "Std_Debug.h"
+#ifdef OS_USE_TASK_STAT
+/* ================================ [ MACROS    ] ============================================== */
+/* the window must be shorter than half of the wrap period of the 32 bits cycle counter */
+#define OS_STAT_WINDOW_MAX 0x80000000ull
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+static Os_IsrStatType *lIsrList;
+static Os_IsrStatType *lIsrNest[CPU_CORE_NUMBER]; /* the innermost ISR of each core */
+static uint32_t lWindow;                          /* the sampling window in cycles */
+static uint32_t lWindowStart;
+static uint32_t lLastWindow; /* the length of the last full window */
+/* ================================ [ LOCALS    ] ============================================== */
+static void Os_StatUpdate(Os_StatType *stat, uint32_t elapsed) {
+  if ((0u == stat->count) || (elapsed < stat->min)) {
+    stat->min = elapsed;
+  }
+  if (elapsed > stat->max) {
+    stat->max = elapsed;
+  }
+  stat->sum += elapsed;
+  stat->count++;
+}
+
+static void Os_StatLatch(Os_StatType *stat) {
+  stat->load = stat->exec;
+  stat->exec = 0;
+}
+
+/* start a new window if the current one is over. The task running on the other cores are sampled
+ * without any sync with them, so their figures may be off by one switch or ISR. */
+static void Os_StatCheckWindow(uint32_t now) {
+  TaskVarType *pTaskVar;
+  Os_IsrStatType *isr;
+  int cpu;
+  uint32_t id;
+
+  if ((now - lWindowStart) >= lWindow) {
+    for (cpu = 0; cpu < CPU_CORE_NUMBER; cpu++) {
+#ifdef USE_SMP
+      pTaskVar = RunningVars[cpu];
+#else
+      pTaskVar = RunningVar;
+#endif
+      if ((NULL != pTaskVar) && (NULL == lIsrNest[cpu])) {
+        pTaskVar->stat.exec += now - pTaskVar->stat.start;
+        pTaskVar->stat.start = now;
+      }
+    }
+
+    for (id = 0; id < (TASK_NUM + OS_PTHREAD_NUM); id++) {
+      Os_StatLatch(&TaskVarArray[id].stat);
+    }
+
+    for (isr = lIsrList; NULL != isr; isr = isr->next) {
+      Os_StatLatch(&isr->stat);
+    }
+
+    lLastWindow = now - lWindowStart;
+    lWindowStart = now;
+  }
+}
+
+static void Os_StatSetWindow(uint32_t ms) {
+  uint64_t cycles = (uint64_t)ms * Os_PortCyclesPerSecond() / 1000u;
+
+  if (cycles >= OS_STAT_WINDOW_MAX) {
+    cycles = OS_STAT_WINDOW_MAX - 1u;
+  } else if (0u == cycles) {
+    cycles = 1u;
+  }
+
+  lWindow = (uint32_t)cycles;
+}
+
+#ifdef USE_SHELL
+static uint32_t Os_StatToUs(uint64_t cycles) {
+  return (uint32_t)(cycles * 1000000u / Os_PortCyclesPerSecond());
+}
+
+static void Os_StatPrint(const char *name, const Os_StatType *stat, uint32_t window) {
+  uint32_t permille = 0;
+
+  if (window > 0u) {
+    permille = (uint32_t)((uint64_t)stat->load * 1000u / window);
+  }
+
+  printf("%-16s %3u.%u %10u %10u %10u %10u %8u", name, permille / 10, permille % 10,
+         Os_StatToUs(stat->load), Os_StatToUs(stat->min),
+         (stat->count > 0u) ? Os_StatToUs(stat->sum / stat->count) : 0u, Os_StatToUs(stat->max),
+         stat->count);
+}
+
+static int Os_StatTop(int argc, const char *argv[]) {
+  TaskVarType *pTaskVar;
+  Os_IsrStatType *isr;
+  uint32_t id;
+  uint32_t pused;
+  uint32_t used;
+  uint32_t window;
+  int i;
+
+  EnterCritical();
+  for (i = 1; i < argc; i++) {
+    if ((0 == strcmp(argv[i], "-w")) && ((i + 1) < argc)) {
+      i++;
+      Os_StatSetWindow((uint32_t)strtoul(argv[i], NULL, 10));
+    } else if (0 == strcmp(argv[i], "-r")) {
+      for (id = 0; id < (TASK_NUM + OS_PTHREAD_NUM); id++) {
+        pTaskVar = &TaskVarArray[id];
+        pTaskVar->stat.count = 0;
+        pTaskVar->stat.sum = 0;
+        pTaskVar->stat.max = 0;
+      }
+      for (isr = lIsrList; NULL != isr; isr = isr->next) {
+        isr->stat.count = 0;
+        isr->stat.sum = 0;
+        isr->stat.max = 0;
+      }
+    } else {
+      /* unknown option, ignored */
+    }
+  }
+  Os_StatCheckWindow(Os_PortCycles());
+  window = lLastWindow;
+  ExitCritical();
+
+  printf("window %u us, %u cycles per second\n", Os_StatToUs(window), Os_PortCyclesPerSecond());
+  printf("Name             CPU%%    Exec(us)    Min(us)    Avg(us)    Max(us)    Count Stack\n");
+  for (id = 0; id < (TASK_NUM + OS_PTHREAD_NUM); id++) {
+    pTaskVar = &TaskVarArray[id];
+    if ((id >= TASK_NUM) && (pTaskVar->pConst <= (const TaskConstType *)1)) {
+      continue; /* the free pthread slot */
+    }
+    Os_StatPrint(pTaskVar->pConst->name, &pTaskVar->stat, window);
+    pused = Os_CheckStackUsage(pTaskVar->pConst, &used);
+    printf(" %2u%%(0x%04X)\n", pused, used);
+  }
+
+  for (isr = lIsrList; NULL != isr; isr = isr->next) {
+    Os_StatPrint(isr->name, &isr->stat, window);
+    printf(" ISR\n");
+  }
+
+  return 0;
+}
+
+SHELL_REGISTER(top,
+               "top [-w ms] [-r]\n"
+               "  Show the CPU load of the tasks and ISRs in the last sampling window, the\n"
+               "  response time and the stack high water mark, -w sets the window and -r\n"
+               "  resets the response time\n",
+               Os_StatTop);
+#endif
+/* ================================ [ FUNCTIONS ] ============================================== */
+FUNC(uint32_t, __weak) Os_PortCycles(void) {
+  return (uint32_t)OsTickCounter;
+}
+
+FUNC(uint32_t, __weak) Os_PortCyclesPerSecond(void) {
+  return OS_TICKS_PER_SECOND;
+}
+
+void Os_StatInit(void) {
+  int cpu;
+
+  lIsrList = NULL;
+  for (cpu = 0; cpu < CPU_CORE_NUMBER; cpu++) {
+    lIsrNest[cpu] = NULL;
+  }
+  Os_StatSetWindow(OS_STAT_WINDOW_MS);
+  lWindowStart = Os_PortCycles();
+  lLastWindow = 0;
+}
+
+void Os_StatActivate(TaskVarType *pTaskVar) {
+  pTaskVar->stat.began = Os_PortCycles();
+}
+
+void Os_StatTerminate(TaskVarType *pTaskVar) {
+  uint32_t now = Os_PortCycles();
+
+  Os_StatUpdate(&pTaskVar->stat, now - pTaskVar->stat.began);
+  /* the next queued activation is taken as activated right now */
+  pTaskVar->stat.began = now;
+}
+
+void Os_StatPreTask(void) {
+  uint32_t now = Os_PortCycles();
+  DECLARE_SMP_PROCESSOR_ID();
+
+  Os_StatCheckWindow(now);
+  RunningVar->stat.start = now;
+}
+
+void Os_StatPostTask(void) {
+  uint32_t now = Os_PortCycles();
+  DECLARE_SMP_PROCESSOR_ID();
+
+  RunningVar->stat.exec += now - RunningVar->stat.start;
+  RunningVar->stat.start = now;
+  Os_StatCheckWindow(now);
+}
+
+void Os_StatIsrEnter(Os_IsrStatType *isr) {
+  uint32_t now = Os_PortCycles();
+  Os_IsrStatType *prev;
+  DECLARE_SMP_PROCESSOR_ID();
+
+  prev = lIsrNest[SMP_PROCESSOR_ID()];
+  if (NULL != prev) {
+    prev->stat.exec += now - prev->stat.start;
+  } else if (NULL != RunningVar) {
+    RunningVar->stat.exec += now - RunningVar->stat.start;
+  } else {
+    /* the idle of the port */
+  }
+
+  if (FALSE == __atomic_exchange_n(&isr->linked, TRUE, __ATOMIC_RELAXED)) {
+    /* the ISRs of the other cores may be linked at the same time */
+    isr->next = __atomic_load_n(&lIsrList, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&lIsrList, &isr->next, isr, FALSE, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED)) {
+    }
+  }
+
+  isr->prev = prev;
+  lIsrNest[SMP_PROCESSOR_ID()] = isr;
+  isr->stat.start = now;
+  isr->stat.began = now;
+}
+
+void Os_StatIsrExit(Os_IsrStatType *isr) {
+  uint32_t now = Os_PortCycles();
+  DECLARE_SMP_PROCESSOR_ID();
+
+  isr->stat.exec += now - isr->stat.start;
+  Os_StatUpdate(&isr->stat, now - isr->stat.began);
+
+  lIsrNest[SMP_PROCESSOR_ID()] = isr->prev;
+  if (NULL != isr->prev) {
+    isr->prev->stat.start = now;
+  } else if (NULL != RunningVar) {
+    RunningVar->stat.start = now;
+  } else {
+    /* the idle of the port */
+  }
+}
+#endif /* OS_USE_TASK_STAT */
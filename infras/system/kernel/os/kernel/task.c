@@ -51,19 +51,6 @@ static const char *taskStateToString(TaskStateType state) {
 
   return p;
 }
-static uint32_t checkStackUsage(const TaskConstType *pTaskConst, uint32_t *used) {
-  uint32_t i;
-  uint32_t *pStack = pTaskConst->pStack;
-
-  for (i = 0; (i < pTaskConst->stackSize) && (0u == *pStack); i += sizeof(uint32_t), pStack++) {
-    /* do nothing */
-  }
-
-  *used = pTaskConst->stackSize - i;
-  /* round up */
-  return (*used + (pTaskConst->stackSize / 100 - 1)) * 100 / pTaskConst->stackSize;
-}
-
 static boolean isRunning(TaskVarType *pTaskVar) {
 #ifdef USE_SMP
   int cpuid;
@@ -82,6 +69,31 @@ static boolean isRunning(TaskVarType *pTaskVar) {
 }
 #endif
 /* ================================ [ FUNCTIONS ] ============================================== */
+void Os_StackFill(void *pStack, uint32_t stackSize) {
+  uint32_t i;
+  uint32_t *p = pStack;
+
+  for (i = 0; i < stackSize; i += sizeof(uint32_t), p++) {
+    *p = OS_STACK_FILL_PATTERN;
+  }
+}
+
+#ifdef USE_SHELL
+uint32_t Os_CheckStackUsage(const TaskConstType *pTaskConst, uint32_t *used) {
+  uint32_t i;
+  uint32_t *pStack = pTaskConst->pStack;
+
+  for (i = 0; (i < pTaskConst->stackSize) && (OS_STACK_FILL_PATTERN == *pStack);
+       i += sizeof(uint32_t), pStack++) {
+    /* do nothing */
+  }
+
+  *used = pTaskConst->stackSize - i;
+  /* round up */
+  return (*used + (pTaskConst->stackSize / 100 - 1)) * 100 / pTaskConst->stackSize;
+}
+#endif
+
 /* |------------------+------------------------------------------------------------| */
 /* | Syntax:          | StatusType ActivateTask ( TaskType <TaskID> )              | */
 /* |------------------+------------------------------------------------------------| */
@@ -128,6 +140,7 @@ StatusType ActivateTask(TaskType TaskID) {
 #endif
 
       OS_TRACE_TASK_ACTIVATION(pTaskVar);
+      OS_STAT_TASK_ACTIVATE(pTaskVar);
 
       Sched_AddReady(TaskID);
     } else {
@@ -211,6 +224,7 @@ StatusType TerminateTask(void) {
 
   if (E_OK == ercd) {
     EnterCritical();
+    OS_STAT_TASK_TERMINATE(RunningVar);
 #ifdef MULTIPLY_TASK_ACTIVATION
     asAssert(RunningVar->activation > 0);
     RunningVar->activation--;
@@ -304,6 +318,8 @@ StatusType ChainTask(TaskType TaskID) {
 
     if (pTaskVar == RunningVar) {
       EnterCritical();
+      OS_STAT_TASK_TERMINATE(RunningVar);
+      OS_STAT_TASK_ACTIVATE(RunningVar);
       InitContext(RunningVar);
       Sched_AddReady(TaskID);
       ExitCritical();
@@ -316,6 +332,7 @@ StatusType ChainTask(TaskType TaskID) {
         pTaskVar->activation = 1;
 #endif
 
+        OS_STAT_TASK_ACTIVATE(pTaskVar);
         Sched_AddReady(TaskID);
       } else {
 #ifdef MULTIPLY_TASK_ACTIVATION
@@ -334,6 +351,7 @@ StatusType ChainTask(TaskType TaskID) {
 
       if (ercd == E_OK) {
         EnterCritical();
+        OS_STAT_TASK_TERMINATE(RunningVar);
 #ifdef MULTIPLY_TASK_ACTIVATION
         asAssert(RunningVar->activation > 0);
         RunningVar->activation--;
@@ -525,6 +543,10 @@ void Os_TaskInit(AppModeType appMode) {
 #ifdef USE_SHELL
     pTaskVar->actCnt = 0;
 #endif
+#ifdef OS_USE_TASK_STAT
+    memset(&pTaskVar->stat, 0, sizeof(pTaskVar->stat));
+    Os_StackFill(pTaskConst->pStack, pTaskConst->stackSize);
+#endif
 
     if (pTaskConst->appModeMask & appMode) {
       (void)ActivateTask(id);
@@ -555,7 +577,7 @@ void statOsTask(void) {
   for (id = 0; id < TASK_NUM; id++) {
     pTaskConst = &TaskConstArray[id];
     pTaskVar = &TaskVarArray[id];
-    pused = checkStackUsage(pTaskConst, &used);
+    pused = Os_CheckStackUsage(pTaskConst, &used);
     printf("%-16s %-9s %3u  %3u   %3u     0x%08X 0x%08X %2d%%(0x%04X) ", pTaskConst->name,
            taskStateToString(pTaskVar->state), (uint32_t)pTaskVar->priority,
            (uint32_t)pTaskConst->initPriority, (uint32_t)pTaskConst->runPriority,
@@ -592,7 +614,7 @@ void statOsTask(void) {
     pTaskConst = pTaskVar->pConst;
     tid = (struct pthread *)pTaskConst;
     if (tid > (struct pthread *)1) {
-      pused = checkStackUsage(pTaskConst, &used);
+      pused = Os_CheckStackUsage(pTaskConst, &used);
       printf("pthread%-9u %-9s %3u  %3u   %3u     0x%08X 0x%08X %2d%%(0x%04X) %08X/%08X %3d/%-6d ",
              (uint32_t)id, taskStateToString(pTaskVar->state), (uint32_t)pTaskVar->priority,
              (uint32_t)pTaskConst->initPriority, (uint32_t)pTaskConst->runPriority,
@@ -21,6 +21,15 @@
 #include "Mcu.h"
 /* ================================ [ MACROS    ] ============================================== */
 #define AS_LOG_OS 0
+
+#ifdef OS_USE_TASK_STAT
+/* the DWT cycle counter, not all of the CMSIS versions know it */
+#define DEMCR (*(volatile uint32 *)0xE000EDFC)
+#define DEMCR_TRCENA (1u << 24)
+#define DWT_CTRL (*(volatile uint32 *)0xE0001000)
+#define DWT_CTRL_CYCCNTENA (1u << 0)
+#define DWT_CYCCNT (*(volatile uint32 *)0xE0001004)
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 /* ================================ [ DECLARES  ] ============================================== */
 extern void knl_activate(void);
@@ -32,7 +41,32 @@ extern const uint32 __vector_table[];
 extern const FP tisr_pc[ISR_NUM];
 #endif
 uint32 knl_dispatch_started;
+#ifdef OS_USE_TASK_STAT
+#if (ISR_NUM > 0)
+extern const char *const tisr_name[ISR_NUM];
+static Os_IsrStatType lIsrStats[ISR_NUM];
+#endif
+static OS_ISR_STAT(tick);
+#endif
 /* ================================ [ LOCALS    ] ============================================== */
+#ifdef OS_USE_TICKLESS
+static uint32 lCyclesPerTick;
+static uint32 lMaxTicks;   /* the max ticks that the 24 bits SysTick can count */
+static uint32 lBaseCycles; /* cycles from the reference point to the start of this SysTick period */
+
+/* cycles elapsed since the reference point, an expired period is accounted by the COUNTFLAG,
+ * which is cleared by the read, no matter whether the interrupt is handled or still pending */
+static uint32 Os_PortTicklessCycles(void) {
+  uint32 val = SysTick->VAL;
+
+  if (SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) {
+    lBaseCycles += SysTick->LOAD + 1;
+    val = SysTick->VAL;
+  }
+
+  return lBaseCycles + (SysTick->LOAD - val);
+}
+#endif
 /* ================================ [ FUNCTIONS ] ============================================== */
 void Os_PortActivate(void) {
   /* get internal resource or NON schedule */
@@ -51,6 +85,9 @@ void Os_PortActivate(void) {
 
 void Os_PortInit(void) {
   const uint32 *pSrc;
+#if defined(OS_USE_TASK_STAT) && (ISR_NUM > 0)
+  int i;
+#endif
   pSrc = __vector_table;
 
 #if defined(CHIP_AT91SAM3S)
@@ -69,11 +106,51 @@ void Os_PortInit(void) {
   ISR2Counter = 0;
   knl_dispatch_started = FALSE;
 
+#ifdef OS_USE_TASK_STAT
+  DEMCR |= DEMCR_TRCENA;
+  DWT_CYCCNT = 0;
+  DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+#if (ISR_NUM > 0)
+  for (i = 0; i < ISR_NUM; i++) {
+    lIsrStats[i].name = tisr_name[i];
+  }
+#endif
+#endif
+
   if (SysTick_Config(Mcu_GetSystemClock() / 1000)) { /* Capture error */
     while (1)
       ;
   }
+#ifdef OS_USE_TICKLESS
+  lCyclesPerTick = Mcu_GetSystemClock() / 1000;
+  lMaxTicks = (SysTick_LOAD_RELOAD_Msk + 1) / lCyclesPerTick;
+  lBaseCycles = 0;
+#endif
+}
+
+#ifdef OS_USE_TICKLESS
+TickType Os_PortTicklessElapsed(void) {
+  return Os_PortTicklessCycles() / lCyclesPerTick;
+}
+
+void Os_PortTicklessProgram(TickType advance, TickType next) {
+  /* keep the sub tick remainder so that the counter doesn't drift */
+  uint32 remainder = Os_PortTicklessCycles() - advance * lCyclesPerTick;
+
+  if ((0 == next) || (next > lMaxTicks)) {
+    next = lMaxTicks; /* wake up anyway to keep the counter in sync */
+  }
+  if ((next * lCyclesPerTick) <= remainder) {
+    next = (remainder / lCyclesPerTick) + 1;
+  }
+
+  SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+  SysTick->LOAD = next * lCyclesPerTick - remainder - 1;
+  SysTick->VAL = 0;
+  SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+  lBaseCycles = remainder;
 }
+#endif
 
 void Os_PortInitContext(TaskVarType *pTaskVar) {
   pTaskVar->context.sp = pTaskVar->pConst->pStack + pTaskVar->pConst->stackSize - 4;
@@ -102,10 +179,31 @@ void Os_PortStartDispatch(void) {
   asAssert(0);
 }
 
+#ifdef OS_USE_TASK_STAT
+uint32_t Os_PortCycles(void) {
+  return DWT_CYCCNT;
+}
+
+uint32_t Os_PortCyclesPerSecond(void) {
+  return Mcu_GetSystemClock();
+}
+#endif
+
 void knl_isr_handler(int intno) {
 #if (ISR_NUM > 0)
   if ((intno > 15) && (intno < (16 + ISR_NUM)) && (tisr_pc[intno - 16] != NULL)) {
+#ifdef OS_USE_TASK_STAT
+    /* the ISR runs with the interrupts enabled, see EnterISR */
+    __asm("cpsid   i");
+    Os_StatIsrEnter(&lIsrStats[intno - 16]);
+    __asm("cpsie   i");
+#endif
     tisr_pc[intno - 16]();
+#ifdef OS_USE_TASK_STAT
+    __asm("cpsid   i");
+    Os_StatIsrExit(&lIsrStats[intno - 16]);
+    __asm("cpsie   i");
+#endif
   } else
 #endif
   {
@@ -114,13 +212,27 @@ void knl_isr_handler(int intno) {
 }
 
 void knl_system_tick_handler(void) {
+#ifdef OS_USE_TASK_STAT
+  __asm("cpsid   i");
+  Os_StatIsrEnter(&OsIsrStat_tick);
+  __asm("cpsie   i");
+#endif
   if (knl_dispatch_started) {
+#ifdef OS_USE_TICKLESS
+    Os_CounterAdvance(OS_TICKLESS_COUNTER, Os_PortTicklessElapsed());
+#else
     OsTick();
     SignalCounter(0);
+#endif
   }
 #if defined(CHIP_AT91SAM3S)
   TimeTick_Increment();
 #endif
+#ifdef OS_USE_TASK_STAT
+  __asm("cpsid   i");
+  Os_StatIsrExit(&OsIsrStat_tick);
+  __asm("cpsie   i");
+#endif
 }
 
 int Os_PortInstallSignal(TaskVarType *pTaskVar, int sig, void *handler) {
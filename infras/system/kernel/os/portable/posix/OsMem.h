@@ -0,0 +1,18 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2025 Parai Wang <parai@foxmail.com>
+ */
+#ifndef OS_MEM_H_
+#define OS_MEM_H_
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <stdint.h>
+/* ================================ [ MACROS    ] ============================================== */
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+void Os_MemInit(void);
+void *Os_MemAlloc(uint32_t size);
+void Os_MemFree(void *buffer);
+#endif /* OS_MEM_H_ */
@@ -0,0 +1,373 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2025 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <signal.h>
+#include <time.h>
+#include <ucontext.h>
+#include <dlfcn.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "host.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define SIG_TICK SIGALRM
+#define SIG_SCHEDULE SIGUSR2
+#define SIG_HRTIMER SIGUSR1
+
+#define HOST_LOAD(v) __atomic_load_n(&(v), __ATOMIC_SEQ_CST)
+#define HOST_STORE(v, x) __atomic_store_n(&(v), (x), __ATOMIC_SEQ_CST)
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  int enabled;      /* the virtual interrupt flag */
+  uint32_t pending; /* the raised but not yet handled interrupts */
+  pid_t tid;
+  void (*entry)(void);
+} Os_PortHostCpuType;
+
+typedef int (*Os_PortHostThreadCreateType)(pthread_t *, const pthread_attr_t *,
+                                           void *(*)(void *), void *);
+typedef int (*Os_PortHostClockGetTimeType)(clockid_t, struct timespec *);
+/* ================================ [ DECLARES  ] ============================================== */
+typedef char Os_PortHostContextSizeCheck[(sizeof(ucontext_t) <= OS_PORT_HOST_CONTEXT_SIZE) ? 1
+                                                                                           : -1];
+/* ================================ [ DATAS     ] ============================================== */
+static Os_PortHostCpuType lCpus[OS_PORT_HOST_CPU_MAX];
+static void (*lIsrs[OS_PORT_HOST_IRQ_MAX])(void);
+static __thread int lCpuId;
+static int lTimerIds[OS_PORT_HOST_IRQ_MAX] = {-1, -1, -1};
+static const int lSignals[OS_PORT_HOST_IRQ_MAX] = {SIG_TICK, SIG_SCHEDULE, SIG_HRTIMER};
+static void *lFreeDeferred;
+static Os_PortHostClockGetTimeType lClockGetTime;
+/* ================================ [ LOCALS    ] ============================================== */
+/* The OS posix layer provides pthread_create, getpid and maybe the timer APIs which override the
+ * libc ones for the whole executable, so the host side goes to the kernel or to the next
+ * definition of the symbol directly. */
+static pid_t Os_PortHostGetTid(void) {
+  return (pid_t)syscall(SYS_gettid);
+}
+
+static int Os_PortHostClockGetTime(clockid_t clk, struct timespec *ts) {
+  return (int)syscall(SYS_clock_gettime, clk, ts);
+}
+
+static void Os_PortHostRaise(Os_PortHostCpuType *cpu, int irq) {
+  __atomic_or_fetch(&cpu->pending, (uint32_t)1 << irq, __ATOMIC_SEQ_CST);
+}
+
+/* called with the virtual interrupts disabled, an ISR may switch to another context and so this
+ * only takes one interrupt at a time, the rest is left pending for whoever enables next */
+static void Os_PortHostRunPending(Os_PortHostCpuType *cpu) {
+  uint32_t pending;
+  int irq;
+
+  while (0u != (pending = HOST_LOAD(cpu->pending))) {
+    irq = __builtin_ctz(pending);
+    __atomic_and_fetch(&cpu->pending, ~((uint32_t)1 << irq), __ATOMIC_SEQ_CST);
+    if (NULL != lIsrs[irq]) {
+      lIsrs[irq]();
+    }
+    cpu = &lCpus[lCpuId];
+  }
+}
+
+static void Os_PortHostEnable(void) {
+  Os_PortHostCpuType *cpu = &lCpus[lCpuId];
+
+  HOST_STORE(cpu->enabled, 1);
+  while (0u != HOST_LOAD(cpu->pending)) {
+    HOST_STORE(cpu->enabled, 0);
+    Os_PortHostRunPending(cpu);
+    cpu = &lCpus[lCpuId];
+    HOST_STORE(cpu->enabled, 1);
+  }
+}
+
+static void Os_PortHostSignal(int sig) {
+  Os_PortHostCpuType *cpu = &lCpus[lCpuId];
+  int irq;
+
+  for (irq = 0; (irq < OS_PORT_HOST_IRQ_MAX) && (lSignals[irq] != sig); irq++) {
+  }
+  assert(irq < OS_PORT_HOST_IRQ_MAX);
+  Os_PortHostRaise(cpu, irq);
+  if (HOST_LOAD(cpu->enabled)) {
+    HOST_STORE(cpu->enabled, 0);
+    Os_PortHostRunPending(cpu);
+    HOST_STORE(lCpus[lCpuId].enabled, 1);
+  }
+}
+
+static void Os_PortHostSigSet(sigset_t *set) {
+  int irq;
+
+  sigemptyset(set);
+  for (irq = 0; irq < OS_PORT_HOST_IRQ_MAX; irq++) {
+    sigaddset(set, lSignals[irq]);
+  }
+}
+
+static void Os_PortHostTimerCreate(int timer) {
+  struct sigevent sev;
+  int id;
+  long r;
+
+  memset(&sev, 0, sizeof(sev));
+  sev.sigev_notify = SIGEV_THREAD_ID;
+  sev.sigev_signo = lSignals[timer];
+#ifdef sigev_notify_thread_id
+  sev.sigev_notify_thread_id = lCpus[0].tid;
+#else
+  sev._sigev_un._tid = lCpus[0].tid;
+#endif
+  r = syscall(SYS_timer_create, CLOCK_MONOTONIC, &sev, &id);
+  assert(0 == r);
+  lTimerIds[timer] = id;
+}
+
+static void *Os_PortHostCpuMain(void *arg) {
+  Os_PortHostCpuType *cpu = (Os_PortHostCpuType *)arg;
+  sigset_t set;
+
+  lCpuId = (int)(cpu - lCpus);
+  cpu->tid = Os_PortHostGetTid();
+  /* the timers are always taken by CPU0 */
+  sigemptyset(&set);
+  sigaddset(&set, SIG_SCHEDULE);
+  sigprocmask(SIG_UNBLOCK, &set, NULL);
+
+  cpu->entry();
+
+  return NULL;
+}
+
+static int Os_PortHostOwnsStack(void *buffer) {
+  uint8_t *p = (uint8_t *)buffer;
+  uint8_t *sp = (uint8_t *)__builtin_frame_address(0);
+
+  return (sp >= p) && (sp < (p + malloc_usable_size(buffer)));
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+void Os_PortHostInit(void) {
+  struct sigaction sa;
+  sigset_t set;
+  int irq;
+
+  memset(lCpus, 0, sizeof(lCpus));
+  lCpuId = 0;
+  lCpus[0].tid = Os_PortHostGetTid();
+
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = Os_PortHostSignal;
+  Os_PortHostSigSet(&sa.sa_mask);
+  sa.sa_flags = SA_RESTART;
+  for (irq = 0; irq < OS_PORT_HOST_IRQ_MAX; irq++) {
+    sigaction(lSignals[irq], &sa, NULL);
+  }
+
+  Os_PortHostTimerCreate(OS_PORT_HOST_TIMER_TICK);
+  Os_PortHostTimerCreate(OS_PORT_HOST_TIMER_HRTIMER);
+
+  Os_PortHostSigSet(&set);
+  sigprocmask(SIG_UNBLOCK, &set, NULL);
+}
+
+void Os_PortHostInstall(int irq, void (*handler)(void)) {
+  assert(irq < OS_PORT_HOST_IRQ_MAX);
+  lIsrs[irq] = handler;
+}
+
+void Os_PortHostContextInit(void *context, void *stack, uint32_t size, void (*entry)(void)) {
+  ucontext_t *uc = (ucontext_t *)context;
+
+  getcontext(uc);
+  /* this may be called from an ISR, the new context always starts unmasked */
+  sigemptyset(&uc->uc_sigmask);
+  uc->uc_stack.ss_sp = stack;
+  uc->uc_stack.ss_size = size;
+  uc->uc_link = NULL;
+  makecontext(uc, entry, 0);
+}
+
+void Os_PortHostContextSwitch(void *from, const void *to) {
+  swapcontext((ucontext_t *)from, (const ucontext_t *)to);
+}
+
+void Os_PortHostContextJump(const void *to) {
+  setcontext((const ucontext_t *)to);
+  assert(0);
+}
+
+void Os_PortHostStartCpu(int cpu, void (*entry)(void)) {
+  static Os_PortHostThreadCreateType threadCreate;
+  pthread_t thread;
+  sigset_t set, old;
+  int r;
+
+  assert(cpu < OS_PORT_HOST_CPU_MAX);
+  if (NULL == threadCreate) {
+    threadCreate = (Os_PortHostThreadCreateType)dlsym(RTLD_NEXT, "pthread_create");
+    if (NULL == threadCreate) {
+      threadCreate = pthread_create;
+    }
+  }
+
+  lCpus[cpu].entry = entry;
+  /* the new thread inherits the mask, it unblocks what it takes itself */
+  Os_PortHostSigSet(&set);
+  sigprocmask(SIG_BLOCK, &set, &old);
+  r = threadCreate(&thread, NULL, Os_PortHostCpuMain, &lCpus[cpu]);
+  assert(0 == r);
+  sigprocmask(SIG_SETMASK, &old, NULL);
+  while (0 == HOST_LOAD(lCpus[cpu].tid)) {
+    sched_yield();
+  }
+}
+
+void Os_PortHostKick(int cpu) {
+  Os_PortHostCpuType *pCpu = &lCpus[cpu];
+
+  Os_PortHostRaise(pCpu, OS_PORT_HOST_IRQ_SCHEDULE);
+  syscall(SYS_tgkill, (pid_t)syscall(SYS_getpid), pCpu->tid, SIG_SCHEDULE);
+}
+
+void Os_PortHostRelax(void) {
+  sched_yield();
+}
+
+void Os_PortHostWait(void) {
+  sigset_t set, old;
+
+  Os_PortHostSigSet(&set);
+  sigprocmask(SIG_BLOCK, &set, &old);
+  if (0u == HOST_LOAD(lCpus[lCpuId].pending)) {
+    sigsuspend(&old);
+  }
+  sigprocmask(SIG_SETMASK, &old, NULL);
+}
+
+uint64_t Os_PortHostTimeNs(void) {
+  struct timespec ts;
+
+  if (NULL == lClockGetTime) {
+    /* the vDSO one of the libc if it is there, it is much faster than the syscall */
+    lClockGetTime = (Os_PortHostClockGetTimeType)dlsym(RTLD_NEXT, "clock_gettime");
+    if (NULL == lClockGetTime) {
+      lClockGetTime = Os_PortHostClockGetTime;
+    }
+  }
+  lClockGetTime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void Os_PortHostTimerProgram(int timer, uint64_t absNs, uint64_t periodNs) {
+  struct itimerspec its;
+
+  assert((OS_PORT_HOST_TIMER_TICK == timer) || (OS_PORT_HOST_TIMER_HRTIMER == timer));
+
+  its.it_value.tv_sec = (time_t)(absNs / 1000000000ull);
+  its.it_value.tv_nsec = (long)(absNs % 1000000000ull);
+  its.it_interval.tv_sec = (time_t)(periodNs / 1000000000ull);
+  its.it_interval.tv_nsec = (long)(periodNs % 1000000000ull);
+  syscall(SYS_timer_settime, lTimerIds[timer], TIMER_ABSTIME, &its, NULL);
+}
+
+int smp_processor_id(void) {
+  return lCpuId;
+}
+
+unsigned int Std_EnterCritical(void) {
+  Os_PortHostCpuType *cpu = &lCpus[lCpuId];
+  unsigned int imask = (unsigned int)HOST_LOAD(cpu->enabled);
+
+  HOST_STORE(cpu->enabled, 0);
+
+  return imask;
+}
+
+void Std_ExitCritical(unsigned int imask) {
+  if (imask) {
+    Os_PortHostEnable();
+  }
+}
+
+void EnableInterrupt(void) {
+  Os_PortHostEnable();
+}
+
+void DisableInterrupt(void) {
+  HOST_STORE(lCpus[lCpuId].enabled, 0);
+}
+
+void Os_MemInit(void) {
+  lFreeDeferred = NULL;
+}
+
+/* malloc takes a lock which is not recursive, so it must not be preempted by a task switch */
+void *Os_MemAlloc(uint32_t size) {
+  unsigned int imask = Std_EnterCritical();
+  void *buffer;
+
+  if (NULL != lFreeDeferred) {
+    free(lFreeDeferred);
+    lFreeDeferred = NULL;
+  }
+  buffer = malloc(size);
+  Std_ExitCritical(imask);
+
+  return buffer;
+}
+
+void Os_MemFree(void *buffer) {
+  unsigned int imask = Std_EnterCritical();
+
+  if (NULL != lFreeDeferred) {
+    free(lFreeDeferred);
+    lFreeDeferred = NULL;
+  }
+  /* a detached pthread frees its own stack before it is switched out, a big one may be
+   * unmapped right away, so keep it until the next call */
+  if ((NULL != buffer) && Os_PortHostOwnsStack(buffer)) {
+    lFreeDeferred = buffer;
+  } else {
+    free(buffer);
+  }
+  Std_ExitCritical(imask);
+}
+
+/* used by Std_Debug on the host, the real ones are in the utils library, but they take a
+ * std::mutex which is not safe to take from the tasks of the same host thread */
+int __attribute__((weak)) std_get_log_level(void) {
+  return 1; /* INFO */
+}
+
+int __attribute__((weak)) std_get_as_log_level(const char *name) {
+  int level = 0; /* DEBUG */
+  char envName[64];
+  const char *pValue;
+  size_t len = strlen(name);
+
+  snprintf(envName, sizeof(envName), "AS_LOG_%s", name);
+  pValue = getenv(envName);
+  if (NULL != pValue) {
+    level = atoi(pValue);
+  } else if (0 == strcmp(name, "INFO")) {
+    level = 1;
+  } else if (0 == strcmp(name, "WARN")) {
+    level = 2;
+  } else if ((len > 0) && ('E' == name[len - 1])) {
+    level = 3; /* ERROR and the xxxE error logs */
+  }
+
+  return level;
+}
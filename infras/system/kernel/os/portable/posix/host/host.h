@@ -0,0 +1,53 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2025 Parai Wang <parai@foxmail.com>
+ */
+#ifndef OS_PORT_HOST_H_
+#define OS_PORT_HOST_H_
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <stdint.h>
+/* ================================ [ MACROS    ] ============================================== */
+/* The host side of the posix port, it is built without the posix layer of the OS on the include
+ * path so that it sees the real libc. Each CPU is a host thread, the task contexts are ucontexts
+ * switched on that thread, the interrupts are signals which are only taken when the virtual
+ * interrupt flag of that CPU is enabled, else they are left pending until it is enabled again. */
+#define OS_PORT_HOST_CPU_MAX 4
+
+#define OS_PORT_HOST_IRQ_TICK 0     /* SIGALRM, always taken by CPU0 */
+#define OS_PORT_HOST_IRQ_SCHEDULE 1 /* SIGUSR2, the inter processor kick */
+#define OS_PORT_HOST_IRQ_HRTIMER 2  /* SIGUSR1, always taken by CPU0 */
+#define OS_PORT_HOST_IRQ_MAX 3
+
+/* the timers raise the interrupt of the same number */
+#define OS_PORT_HOST_TIMER_TICK OS_PORT_HOST_IRQ_TICK
+#define OS_PORT_HOST_TIMER_HRTIMER OS_PORT_HOST_IRQ_HRTIMER
+
+/* big enough for the ucontext_t of x86_64 and aarch64 Linux, checked by host.c */
+#define OS_PORT_HOST_CONTEXT_SIZE 4864
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+void Os_PortHostInit(void);
+void Os_PortHostInstall(int irq, void (*handler)(void));
+
+/* make a context that starts entry on the stack, with all signals unblocked */
+void Os_PortHostContextInit(void *context, void *stack, uint32_t size, void (*entry)(void));
+void Os_PortHostContextSwitch(void *from, const void *to);
+void Os_PortHostContextJump(const void *to);
+
+/* start the host thread of the secondary cpu, entry runs with the virtual interrupts disabled */
+void Os_PortHostStartCpu(int cpu, void (*entry)(void));
+void Os_PortHostKick(int cpu);
+/* give the host core away while spinning on another cpu */
+void Os_PortHostRelax(void);
+
+/* sleep the host thread until an interrupt is raised on this cpu */
+void Os_PortHostWait(void);
+
+/* CLOCK_MONOTONIC in ns */
+uint64_t Os_PortHostTimeNs(void);
+/* raise the interrupt of the timer at absNs and then every periodNs if not 0, absNs 0 disarms it */
+void Os_PortHostTimerProgram(int timer, uint64_t absNs, uint64_t periodNs);
+#endif /* OS_PORT_HOST_H_ */
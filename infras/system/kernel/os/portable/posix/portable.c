@@ -0,0 +1,358 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2025 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "kernel_internal.h"
+#include "Std_Debug.h"
+#include "smp.h"
+#ifdef USE_SMP
+#include "spinlock.h"
+#endif
+/* ================================ [ MACROS    ] ============================================== */
+#define AS_LOG_OS 0
+#define AS_LOG_OSE 1
+#define AS_LOG_SMP 0
+
+#define NS_PER_TICK (1000000000ull / OS_TICKS_PER_SECOND)
+
+#ifdef OS_USE_TASK_STAT
+#define OS_PORT_ISR_STAT(stat) (stat)
+#else
+#define OS_PORT_ISR_STAT(stat) NULL
+#endif
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+#ifdef USE_SMP
+extern void Os_RestoreKernelLock(void);
+#endif
+#ifdef OS_USE_PRETASK_HOOK
+extern void PreTaskHook(void);
+#endif
+#ifdef OS_USE_POSTTASK_HOOK
+extern void PostTaskHook(void);
+#endif
+void Os_PortIdle(void);
+/* ================================ [ DATAS     ] ============================================== */
+#ifdef USE_SMP
+boolean smpStarted = FALSE;
+static spinlock_t knlSpinlock;
+#endif
+#ifdef OS_USE_TICKLESS
+static uint64_t lTicklessBase; /* ns of the reference point */
+#endif
+#ifdef OS_USE_HRTIMER
+static uint64_t lHrTimerBase; /* host ns of the OS time 0 */
+#endif
+#ifdef OS_USE_TASK_STAT
+static OS_ISR_STAT(tick);
+#ifdef OS_USE_HRTIMER
+static OS_ISR_STAT(hrtimer);
+#endif
+static Os_IsrStatType lKickStats[CPU_CORE_NUMBER]; /* the kick is taken by each core */
+#endif
+/* ================================ [ LOCALS    ] ============================================== */
+/* The hooks around a switch are called raw, the switch is always done with the interrupts
+ * disabled and maybe the kernel spin lock held, the same as what the arm64 port does */
+static void Os_PortPreTaskHook(void) {
+#ifdef OS_USE_PRETASK_HOOK
+  unsigned int savedLevel;
+  DECLARE_SMP_PROCESSOR_ID();
+
+  savedLevel = CallLevel;
+  CallLevel = TCL_PREPOST;
+  PreTaskHook();
+  CallLevel = savedLevel;
+#endif
+}
+
+static void Os_PortPostTaskHook(void) {
+#ifdef OS_USE_POSTTASK_HOOK
+  unsigned int savedLevel;
+  DECLARE_SMP_PROCESSOR_ID();
+
+  savedLevel = CallLevel;
+  CallLevel = TCL_PREPOST;
+  PostTaskHook();
+  CallLevel = savedLevel;
+#endif
+}
+
+static void Os_PortActivate(void) {
+  DECLARE_SMP_PROCESSOR_ID();
+
+#ifdef USE_SMP
+  Os_RestoreKernelLock();
+#endif
+  Os_PortPreTaskHook();
+
+  /* get internal resource or NON schedule */
+  RunningVar->priority = RunningVar->pConst->runPriority;
+
+#ifdef USE_SMP
+  ASLOG(OS, ("%s(%d) is running on CPU %d\n", RunningVar->pConst->name,
+             RunningVar->pConst->initPriority, cpuid));
+#else
+  ASLOG(OS, ("%s(%d) is running\n", RunningVar->pConst->name, RunningVar->pConst->initPriority));
+#endif
+
+  CallLevel = TCL_TASK;
+  EnableInterrupt();
+
+  RunningVar->pConst->entry();
+
+  /* Should not return here */
+  TerminateTask();
+}
+
+/* save the RunningVar and switch to the ReadyVar, returns when the RunningVar is resumed */
+static void Os_PortSwitch(void) {
+  TaskVarType *pTaskVar;
+  DECLARE_SMP_PROCESSOR_ID();
+
+  pTaskVar = RunningVar;
+  Os_PortPostTaskHook();
+  RunningVar = ReadyVar;
+  Os_PortHostContextSwitch(pTaskVar->context.uc, RunningVar->context.uc);
+
+  /* a task that may run on any CPU may be resumed by another host thread */
+  GET_SMP_PROCESSOR_ID();
+#ifdef USE_SMP
+  Os_RestoreKernelLock();
+#endif
+  Os_PortPreTaskHook();
+}
+
+static void Os_PortIsr(void (*isr)(void), Os_IsrStatType *stat) {
+  unsigned int savedLevel;
+  DECLARE_SMP_PROCESSOR_ID();
+
+#ifdef OS_USE_TASK_STAT
+  Os_StatIsrEnter(stat);
+#endif
+  savedLevel = CallLevel;
+  CallLevel = TCL_ISR2;
+  isr();
+  CallLevel = savedLevel;
+#ifdef OS_USE_TASK_STAT
+  Os_StatIsrExit(stat);
+#endif
+
+  /* the ISR is only taken with the interrupts enabled, so the kernel lock is not held here */
+  if ((NULL != RunningVar) && (TCL_TASK == CallLevel)) {
+#ifdef USE_SMP
+    /* the same as the arm64 port, Sched_Schedule locks the kernel itself */
+    if (Sched_Schedule()) {
+      Os_PortSpinLock();
+      Os_PortSwitch();
+    }
+#else
+    if ((NULL != ReadyVar) && (ReadyVar != RunningVar) &&
+        (ReadyVar->priority > RunningVar->priority)) {
+      Sched_Preempt();
+      Os_PortSwitch();
+    }
+#endif
+  }
+}
+
+static void Os_PortTick(void) {
+#ifdef OS_USE_TICKLESS
+  Os_CounterAdvance(OS_TICKLESS_COUNTER, Os_PortTicklessElapsed());
+#else
+  OsTick();
+#if (COUNTER_NUM > 0)
+  SignalCounter(0);
+#endif
+#endif
+}
+
+static void Os_PortTickIsr(void) {
+  Os_PortIsr(Os_PortTick, OS_PORT_ISR_STAT(&OsIsrStat_tick));
+}
+
+#ifdef OS_USE_HRTIMER
+static void Os_PortHrTimerIsr(void) {
+  Os_PortIsr(Os_SleepExpire, OS_PORT_ISR_STAT(&OsIsrStat_hrtimer));
+}
+#endif
+
+static void Os_PortSchedule(void) {
+  /* the kick only asks for the schedule on the ISR exit */
+  ASLOG(SMP, ("Os_PortSchedule on CPU%d!\n", smp_processor_id()));
+}
+
+static void Os_PortScheduleIsr(void) {
+  Os_PortIsr(Os_PortSchedule, OS_PORT_ISR_STAT(&lKickStats[smp_processor_id()]));
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+void Os_PortInit(void) {
+#ifdef OS_USE_TASK_STAT
+  int cpu;
+
+  for (cpu = 0; cpu < CPU_CORE_NUMBER; cpu++) {
+    lKickStats[cpu].name = "kick";
+  }
+#endif
+  Os_PortHostInit();
+  Os_PortHostInstall(OS_PORT_HOST_IRQ_TICK, Os_PortTickIsr);
+  Os_PortHostInstall(OS_PORT_HOST_IRQ_SCHEDULE, Os_PortScheduleIsr);
+#ifdef OS_USE_HRTIMER
+  Os_PortHostInstall(OS_PORT_HOST_IRQ_HRTIMER, Os_PortHrTimerIsr);
+  lHrTimerBase = Os_PortHostTimeNs();
+#endif
+#ifdef OS_USE_TICKLESS
+  lTicklessBase = Os_PortHostTimeNs();
+#endif
+}
+
+#ifdef OS_USE_TASK_STAT
+uint32_t Os_PortCycles(void) {
+  return (uint32_t)Os_PortHostTimeNs();
+}
+
+uint32_t Os_PortCyclesPerSecond(void) {
+  return 1000000000u;
+}
+#endif
+
+#ifdef OS_USE_HRTIMER
+uint64_t Os_PortHrTime(void) {
+  return Os_PortHostTimeNs() - lHrTimerBase;
+}
+
+void Os_PortHrTimerProgram(uint64_t deadline) {
+  Os_PortHostTimerProgram(OS_PORT_HOST_TIMER_HRTIMER, (0 == deadline) ? 0 : lHrTimerBase + deadline,
+                          0);
+}
+#endif
+
+#ifdef OS_USE_TICKLESS
+TickType Os_PortTicklessElapsed(void) {
+  return (TickType)((Os_PortHostTimeNs() - lTicklessBase) / NS_PER_TICK);
+}
+
+void Os_PortTicklessProgram(TickType advance, TickType next) {
+  /* the base moves by whole ticks so that the counter doesn't drift */
+  lTicklessBase += (uint64_t)advance * NS_PER_TICK;
+
+  if (0 == next) {
+    Os_PortHostTimerProgram(OS_PORT_HOST_TIMER_TICK, 0, 0);
+  } else {
+    /* a deadline already passed fires right away */
+    Os_PortHostTimerProgram(OS_PORT_HOST_TIMER_TICK, lTicklessBase + (uint64_t)next * NS_PER_TICK,
+                            0);
+  }
+}
+#endif
+
+void Os_PortInitContext(TaskVarType *pTaskVar) {
+  Os_PortHostContextInit(pTaskVar->context.uc, pTaskVar->pConst->pStack,
+                         pTaskVar->pConst->stackSize, Os_PortActivate);
+}
+
+void EnterISR(void) {
+  /* do nothing */
+}
+
+void LeaveISR(void) {
+  /* do nothing */
+}
+
+void Os_PortDispatch(void) {
+  DECLARE_SMP_PROCESSOR_ID();
+
+  if (NULL == RunningVar) {
+    Os_PortStartDispatch();
+  } else if (NULL == ReadyVar) {
+    Os_PortIdle();
+  } else if (ReadyVar != RunningVar) {
+    Os_PortSwitch();
+  } else {
+    /* nothing to switch */
+  }
+}
+
+void Os_PortStartDispatch(void) {
+  DECLARE_SMP_PROCESSOR_ID();
+
+  if (NULL == ReadyVar) {
+    Os_PortIdle();
+  }
+
+  RunningVar = ReadyVar;
+  Os_PortHostContextJump(RunningVar->context.uc);
+  asAssert(0);
+}
+
+void Os_PortIdle(void) {
+#ifdef USE_SMP
+  ASLOG(OSE, ("!!!CPU%d enter PortIdle!!!\n", smp_processor_id()));
+#else
+  ASLOG(OSE, ("!!!enter PortIdle!!!\n"));
+#endif
+
+  asAssert(0);
+}
+
+#ifdef USE_SMP
+void Os_PortSpinLock(void) {
+  spin_lock(&knlSpinlock);
+}
+
+void Os_PortSpinUnLock(void) {
+  spin_unlock(&knlSpinlock);
+}
+
+static void secondary_main(void) {
+  ASLOG(SMP, ("!!!CPU%d is up!!!\n", smp_processor_id()));
+  Os_PortSpinLock();
+  Sched_GetReady();
+  Os_PortStartDispatch();
+  while (1)
+    ;
+}
+
+void Os_PortRequestSchedule(uint8 cpu) {
+  if (smpStarted) {
+    Os_PortHostKick((int)cpu);
+  }
+}
+#endif
+
+void Os_PortStartFirstDispatch(void) {
+#ifdef USE_SMP
+  int cpu;
+
+  ASLOG(SMP, ("!!!CPU%d is up!!!\n", smp_processor_id()));
+  for (cpu = 1; cpu < CPU_CORE_NUMBER; cpu++) {
+    Os_PortHostStartCpu(cpu, secondary_main);
+  }
+  smpStarted = TRUE;
+#endif
+#ifndef OS_USE_TICKLESS
+  Os_PortHostTimerProgram(OS_PORT_HOST_TIMER_TICK, Os_PortHostTimeNs() + NS_PER_TICK, NS_PER_TICK);
+#endif
+  Os_PortStartDispatch();
+}
+
+#if (OS_PTHREAD_NUM > 0)
+int Os_PortInstallSignal(TaskVarType *pTaskVar, int sig, void *handler) {
+  /* not supported, see portable.h */
+  return -1;
+}
+#endif
+
+FUNC(void, __weak) TaskMainTaskIdle0(void) {
+  while (1) {
+    Os_PortHostWait();
+  }
+}
+
+#ifdef USE_SMP
+FUNC(void, __weak) TaskMainTaskIdle1(void) {
+  while (1) {
+    Os_PortHostWait();
+  }
+}
+#endif
@@ -0,0 +1,45 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2025 Parai Wang <parai@foxmail.com>
+ */
+#ifndef PORTABLE_H_
+#define PORTABLE_H_
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "host/host.h"
+/* ================================ [ MACROS    ] ============================================== */
+/* the host libc and the signal frames need much more stack than an MCU */
+#ifndef OS_STK_SIZE_SCALER
+#define OS_STK_SIZE_SCALER 32
+#endif
+
+#ifndef PTHREAD_DEFAULT_STACK_SIZE
+#define PTHREAD_DEFAULT_STACK_SIZE (32 * 1024)
+#endif
+
+#ifdef USE_PTHREAD_SIGNAL
+#error "posix port: the pthread signal is not supported, it shadows the host signal APIs"
+#endif
+
+#if defined(USE_SMP) && (CPU_CORE_NUMBER > OS_PORT_HOST_CPU_MAX)
+#error "posix port: too much CPU cores"
+#endif
+
+#if defined(USE_SMP) && (OS_PTHREAD_NUM > 0)
+#error "posix port: pthread is not supported with SMP"
+#endif
+
+/* The pthread layer shadows the libc pthread and sigset_t types, the glibc only leaves them out
+ * up to POSIX.1b, so the OS and the application are then built with _POSIX_C_SOURCE=199309L */
+#if (OS_PTHREAD_NUM > 0) && defined(__USE_POSIX199506)
+#error "posix port: pthread needs _POSIX_C_SOURCE=199309L"
+#endif
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  /* the host ucontext_t, kept out of the task stack as a task may be restarted on its own stack */
+  uint8 uc[OS_PORT_HOST_CONTEXT_SIZE] __attribute__((aligned(16)));
+} TaskContextType;
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+#endif /* PORTABLE_H_ */
@@ -0,0 +1,16 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2025 Parai Wang <parai@foxmail.com>
+ */
+#ifndef SMP_H_
+#define SMP_H_
+/* ================================ [ INCLUDES  ] ============================================== */
+/* ================================ [ MACROS    ] ============================================== */
+/* ================================ [ TYPES     ] ============================================== */
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+/* the CPU that the calling host thread is */
+int smp_processor_id(void);
+#endif /* SMP_H_ */
@@ -0,0 +1,30 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2025 Parai Wang <parai@foxmail.com>
+ */
+#ifndef SPINLOCK_H_
+#define SPINLOCK_H_
+/* ================================ [ INCLUDES  ] ============================================== */
+#include "host/host.h"
+/* ================================ [ MACROS    ] ============================================== */
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  volatile int lock;
+} spinlock_t;
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+static inline void spin_lock(spinlock_t *lock) {
+  while (__atomic_exchange_n(&lock->lock, 1, __ATOMIC_ACQUIRE)) {
+    while (__atomic_load_n(&lock->lock, __ATOMIC_RELAXED)) {
+      /* the owner may be a host thread which is not running */
+      Os_PortHostRelax();
+    }
+  }
+}
+
+static inline void spin_unlock(spinlock_t *lock) {
+  __atomic_store_n(&lock->lock, 0, __ATOMIC_RELEASE);
+}
+#endif /* SPINLOCK_H_ */
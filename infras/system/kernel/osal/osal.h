@@ -14,10 +14,21 @@ extern "C" {
 /* ================================ [ MACROS    ] ============================================== */
 #define OSAL_MUTEX_NORMAL 0
 #define OSAL_MUTEX_RECURSIVE 1
+
+#define OSAL_SCHED_OTHER 0
+#define OSAL_SCHED_FIFO 1
+#define OSAL_SCHED_RR 2
 /* ================================ [ TYPES     ] ============================================== */
 typedef void (*OSAL_ThreadEntryType)(void *args);
 typedef void *OSAL_ThreadType;
 
+typedef struct {
+  int policy;         /* OSAL_SCHED_xxx */
+  int priority;       /* the real time priority, higher is more urgent, 1 - 99 */
+  uint32_t cpuMask;   /* bit n for the CPU n, 0 to run on any CPU */
+  uint32_t stackSize; /* in bytes, 0 for the default of the backend */
+} OSAL_ThreadAttrType;
+
 typedef struct {
   int type;
 } OSAL_MutexAttrType;
@@ -25,6 +36,8 @@ typedef struct {
 typedef void *OSAL_MutexType;
 
 typedef void *OSAL_SemType;
+
+typedef void *OSAL_TimerType;
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
@@ -33,6 +46,12 @@ OSAL_ThreadType OSAL_ThreadCreate(OSAL_ThreadEntryType entry, void *args);
 int OSAL_ThreadJoin(OSAL_ThreadType thread);
 int OSAL_ThreadDestory(OSAL_ThreadType thread);
 
+int OSAL_ThreadAttrInit(OSAL_ThreadAttrType *attr);
+/* the attributes that the backend doesn't support are ignored, but a real time policy or an
+ * affinity that is refused, such as for the lack of the privilege, fails the create */
+OSAL_ThreadType OSAL_ThreadCreateEx(OSAL_ThreadEntryType entry, void *args,
+                                    const OSAL_ThreadAttrType *attr);
+
 void OSAL_SleepUs(uint32_t us);
 void OSAL_Start(void);
 
@@ -50,6 +69,14 @@ int OSAL_SemaphoreTryWait(OSAL_SemType sem);
 int OSAL_SemaphoreTimedWait(OSAL_SemType sem, uint32_t timeoutMs);
 int OSAL_SemaphorePost(OSAL_SemType sem);
 int OSAL_SemaphoreDestory(OSAL_SemType sem);
+
+/* A periodic timer which expires at the absolute time start + n * period, so the wakeup latency
+ * of one period is not carried into the next one. The first expiration is one period after the
+ * create. OSAL_TimerWait blocks until the next expiration and returns the number of expirations
+ * since the last wait, more than 1 means periods were missed, or a negative error. */
+OSAL_TimerType OSAL_TimerCreate(uint32_t periodUs);
+int OSAL_TimerWait(OSAL_TimerType timer);
+int OSAL_TimerDestory(OSAL_TimerType timer);
 #ifdef __cplusplus
 }
 #endif
@@ -13,7 +13,13 @@
 #ifndef configMINIMAL_SECURE_STACK_SIZE
 #define configMINIMAL_SECURE_STACK_SIZE (configMINIMAL_STACK_SIZE * 2)
 #endif
+
+#define OSAL_US_PER_TICK (1000000 / configTICK_RATE_HZ)
 /* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  TickType_t last; /* the tick of the last expiration */
+  TickType_t period;
+} OSAL_Timer_t;
 /* ================================ [ DECLARES  ] ============================================== */
 void StartupHook(void);
 /* ================================ [ DATAS     ] ============================================== */
@@ -27,17 +33,57 @@ FUNC(void, __weak) vApplicationIdleHook(void) {
   TaskIdleHook();
 }
 
-OSAL_ThreadType OSAL_ThreadCreate(OSAL_ThreadEntryType entry, void *args) {
+int OSAL_ThreadAttrInit(OSAL_ThreadAttrType *attr) {
+  attr->policy = OSAL_SCHED_OTHER;
+  attr->priority = 0;
+  attr->cpuMask = 0;
+  attr->stackSize = 0;
+  return 0;
+}
+
+/* all the FreeRTOS tasks are preemptive by the priority, so FIFO and RR are the same here, the
+ * priority is clamped to the configMAX_PRIORITIES */
+OSAL_ThreadType OSAL_ThreadCreateEx(OSAL_ThreadEntryType entry, void *args,
+                                    const OSAL_ThreadAttrType *attr) {
   OSAL_ThreadType thread = NULL;
-  BaseType_t xReturn = xTaskCreate((TaskFunction_t)entry, NULL, configMINIMAL_SECURE_STACK_SIZE,
-                                   args, tskIDLE_PRIORITY + 1, (TaskHandle_t *)&thread);
+  configSTACK_DEPTH_TYPE depth = configMINIMAL_SECURE_STACK_SIZE;
+  UBaseType_t priority = tskIDLE_PRIORITY + 1;
+  BaseType_t xReturn;
+
+  if (NULL != attr) {
+    if (0u != attr->stackSize) {
+      depth = (configSTACK_DEPTH_TYPE)(attr->stackSize / sizeof(StackType_t));
+    }
+    if ((OSAL_SCHED_OTHER != attr->policy) && (attr->priority > (int)priority)) {
+      priority = (UBaseType_t)attr->priority;
+      if (priority >= configMAX_PRIORITIES) {
+        priority = configMAX_PRIORITIES - 1;
+      }
+    }
+  }
+
+#if defined(configUSE_CORE_AFFINITY) && (configUSE_CORE_AFFINITY == 1)
+  if ((NULL != attr) && (0u != attr->cpuMask)) {
+    xReturn = xTaskCreateAffinitySet((TaskFunction_t)entry, NULL, depth, args, priority,
+                                     (UBaseType_t)attr->cpuMask, (TaskHandle_t *)&thread);
+  } else
+#endif
+  {
+    xReturn = xTaskCreate((TaskFunction_t)entry, NULL, depth, args, priority,
+                          (TaskHandle_t *)&thread);
+  }
   if (pdPASS != xReturn) {
     ASLOG(ERROR, ("create thread over freertos failed: %d\n", xReturn));
+    thread = NULL;
   }
 
   return thread;
 }
 
+OSAL_ThreadType OSAL_ThreadCreate(OSAL_ThreadEntryType entry, void *args) {
+  return OSAL_ThreadCreateEx(entry, args, NULL);
+}
+
 int OSAL_ThreadJoin(OSAL_ThreadType thread) {
   eTaskState state;
 
@@ -60,6 +106,44 @@ void OSAL_SleepUs(uint32_t us) {
   vTaskDelay(ticks);
 }
 
+OSAL_TimerType OSAL_TimerCreate(uint32_t periodUs) {
+  OSAL_Timer_t *tmr = NULL;
+  TickType_t period = (periodUs + (OSAL_US_PER_TICK / 2)) / OSAL_US_PER_TICK;
+
+  if (periodUs > 0u) {
+    tmr = (OSAL_Timer_t *)pvPortMalloc(sizeof(OSAL_Timer_t));
+  }
+
+  if (NULL != tmr) {
+    /* the period is in ticks, so it is at least 1 tick */
+    tmr->period = (0u == period) ? 1u : period;
+    tmr->last = xTaskGetTickCount();
+  }
+
+  return (OSAL_TimerType)tmr;
+}
+
+int OSAL_TimerWait(OSAL_TimerType timer) {
+  OSAL_Timer_t *tmr = (OSAL_Timer_t *)timer;
+  TickType_t elapsed = xTaskGetTickCount() - tmr->last;
+  int expirations = 1;
+
+  if (elapsed < tmr->period) {
+    /* the wakeup time is last + period, not now + period, so the period doesn't drift */
+    vTaskDelayUntil(&tmr->last, tmr->period);
+  } else {
+    expirations = (int)(elapsed / tmr->period);
+    tmr->last += (TickType_t)expirations * tmr->period;
+  }
+
+  return expirations;
+}
+
+int OSAL_TimerDestory(OSAL_TimerType timer) {
+  vPortFree(timer);
+  return 0;
+}
+
 void OSAL_Start(void) {
   StartupHook();
   vTaskStartScheduler();
@@ -3,6 +3,9 @@
  * Copyright (C) 2022 Parai Wang <parai@foxmail.com>
  */
 /* ================================ [ INCLUDES  ] ============================================== */
+#if defined(linux) && !defined(USE_OS) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for the pthread_attr_setaffinity_np */
+#endif
 #include <sys/queue.h>
 #include "osal.h"
 #include "Std_Debug.h"
@@ -10,17 +13,36 @@
 #include <semaphore.h>
 #include <unistd.h>
 #include <stdlib.h>
+#include <time.h>
 #include "Std_Compiler.h"
 
 #ifdef USE_OS
 #include "kernel.h"
+#include "timerfd.h"
+#elif defined(linux)
+#include <sched.h>
+#include <sys/timerfd.h>
+#define OSAL_USE_TIMERFD
+#ifndef __ANDROID__
+#define OSAL_USE_AFFINITY
+#endif
 #endif
 /* ================================ [ MACROS    ] ============================================== */
 #ifndef USE_OS
 #define Os_MemAlloc malloc
 #define Os_MemFree free
 #endif
+
+#define OSAL_NS_PER_SECOND 1000000000ull
 /* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+#ifdef OSAL_USE_TIMERFD
+  int fd;
+#else
+  struct timespec next; /* the absolute time of the next expiration */
+  uint64_t period;      /* in ns */
+#endif
+} OSAL_Timer_t;
 /* ================================ [ DECLARES  ] ============================================== */
 #ifdef USE_OS
 uint8_t *Os_MemAlloc(uint32_t size);
@@ -32,13 +54,112 @@ void StartupHook(void);
 /* ================================ [ LOCALS    ] ============================================== */
 FUNC(void, __weak) StartupHook(void) {
 }
+
+static int OSAL_ThreadAttrApply(pthread_attr_t *pattr, const OSAL_ThreadAttrType *attr) {
+  int ret = 0;
+  struct sched_param param;
+#ifdef OSAL_USE_AFFINITY
+  cpu_set_t cpus;
+  int cpu;
+#endif
+
+  if (0u != attr->stackSize) {
+    ret = pthread_attr_setstacksize(pattr, attr->stackSize);
+  }
+
+  if ((0 == ret) && (OSAL_SCHED_OTHER != attr->policy)) {
+#ifndef USE_OS
+    /* or else the new thread just takes the policy of the creator */
+    ret = pthread_attr_setinheritsched(pattr, PTHREAD_EXPLICIT_SCHED);
+#endif
+    if (0 == ret) {
+      ret = pthread_attr_setschedpolicy(pattr,
+                                        (OSAL_SCHED_RR == attr->policy) ? SCHED_RR : SCHED_FIFO);
+    }
+    if (0 == ret) {
+      param.sched_priority = attr->priority;
+      ret = pthread_attr_setschedparam(pattr, &param);
+    }
+  }
+
+#ifdef OSAL_USE_AFFINITY
+  if ((0 == ret) && (0u != attr->cpuMask)) {
+    CPU_ZERO(&cpus);
+    for (cpu = 0; cpu < 32; cpu++) {
+      if (0u != (attr->cpuMask & (1u << cpu))) {
+        CPU_SET(cpu, &cpus);
+      }
+    }
+    ret = pthread_attr_setaffinity_np(pattr, sizeof(cpus), &cpus);
+  }
+#endif
+
+  return ret;
+}
+
+#ifdef OSAL_USE_TIMERFD
+static int OSAL_TimerStart(OSAL_Timer_t *tmr, uint32_t periodUs) {
+  int ret = 0;
+  struct itimerspec its;
+
+  tmr->fd = timerfd_create(CLOCK_MONOTONIC, 0);
+  if (tmr->fd < 0) {
+    ret = -errno;
+  } else {
+    its.it_interval.tv_sec = periodUs / 1000000u;
+    its.it_interval.tv_nsec = (periodUs % 1000000u) * 1000u;
+    /* the relative first expiration, the following ones are kept on the grid by the kernel */
+    its.it_value = its.it_interval;
+    if (0 != timerfd_settime(tmr->fd, 0, &its, NULL)) {
+      ret = -errno;
+      close(tmr->fd);
+    }
+  }
+
+  return ret;
+}
+#else
+static uint64_t OSAL_TimespecToNs(const struct timespec *ts) {
+  return (uint64_t)ts->tv_sec * OSAL_NS_PER_SECOND + (uint64_t)ts->tv_nsec;
+}
+
+static void OSAL_TimespecAdd(struct timespec *ts, uint64_t ns) {
+  ns += (uint64_t)ts->tv_nsec;
+  ts->tv_sec += (time_t)(ns / OSAL_NS_PER_SECOND);
+  ts->tv_nsec = (long)(ns % OSAL_NS_PER_SECOND);
+}
+
+static int OSAL_TimerStart(OSAL_Timer_t *tmr, uint32_t periodUs) {
+  tmr->period = (uint64_t)periodUs * 1000u;
+  clock_gettime(CLOCK_MONOTONIC, &tmr->next);
+  OSAL_TimespecAdd(&tmr->next, tmr->period);
+  return 0;
+}
+#endif
 /* ================================ [ FUNCTIONS ] ============================================== */
-OSAL_ThreadType OSAL_ThreadCreate(OSAL_ThreadEntryType entry, void *args) {
+int OSAL_ThreadAttrInit(OSAL_ThreadAttrType *attr) {
+  attr->policy = OSAL_SCHED_OTHER;
+  attr->priority = 0;
+  attr->cpuMask = 0;
+  attr->stackSize = 0;
+  return 0;
+}
+
+OSAL_ThreadType OSAL_ThreadCreateEx(OSAL_ThreadEntryType entry, void *args,
+                                    const OSAL_ThreadAttrType *attr) {
   int ret;
+  pthread_attr_t pattr;
   OSAL_ThreadType thread = Os_MemAlloc(sizeof(pthread_t));
 
   if (NULL != thread) {
-    ret = pthread_create((pthread_t *)thread, NULL, (void *(*)(void *))entry, args);
+    ret = pthread_attr_init(&pattr);
+    if ((0 == ret) && (NULL != attr)) {
+      ret = OSAL_ThreadAttrApply(&pattr, attr);
+    }
+    if (0 == ret) {
+      ret = pthread_create((pthread_t *)thread, &pattr, (void *(*)(void *))entry, args);
+    }
+    (void)pthread_attr_destroy(&pattr);
     if (0 != ret) {
       ASLOG(ERROR, ("create thread over pthread failed: %d\n", ret));
       Os_MemFree(thread);
@@ -49,6 +170,10 @@ OSAL_ThreadType OSAL_ThreadCreate(OSAL_ThreadEntryType entry, void *args) {
   return thread;
 }
 
+OSAL_ThreadType OSAL_ThreadCreate(OSAL_ThreadEntryType entry, void *args) {
+  return OSAL_ThreadCreateEx(entry, args, NULL);
+}
+
 int OSAL_ThreadJoin(OSAL_ThreadType thread) {
   return pthread_join(*(pthread_t *)thread, NULL);
 }
@@ -173,3 +298,74 @@ int OSAL_SemaphoreDestory(OSAL_SemType sem) {
   Os_MemFree(sem);
   return 0;
 }
+
+OSAL_TimerType OSAL_TimerCreate(uint32_t periodUs) {
+  int ret;
+  OSAL_Timer_t *tmr = NULL;
+
+  if (periodUs > 0u) {
+    tmr = (OSAL_Timer_t *)Os_MemAlloc(sizeof(OSAL_Timer_t));
+  }
+
+  if (NULL != tmr) {
+    ret = OSAL_TimerStart(tmr, periodUs);
+    if (0 != ret) {
+      ASLOG(ERROR, ("create timer failed: %d\n", ret));
+      Os_MemFree((uint8_t *)tmr);
+      tmr = NULL;
+    }
+  }
+
+  return (OSAL_TimerType)tmr;
+}
+
+#ifdef OSAL_USE_TIMERFD
+int OSAL_TimerWait(OSAL_TimerType timer) {
+  OSAL_Timer_t *tmr = (OSAL_Timer_t *)timer;
+  uint64_t expirations = 0;
+  ssize_t len;
+
+  do {
+    len = read(tmr->fd, &expirations, sizeof(expirations));
+  } while ((len < 0) && (EINTR == errno));
+
+  return (sizeof(expirations) == len) ? (int)expirations : -errno;
+}
+
+int OSAL_TimerDestory(OSAL_TimerType timer) {
+  OSAL_Timer_t *tmr = (OSAL_Timer_t *)timer;
+
+  close(tmr->fd);
+  Os_MemFree(tmr);
+  return 0;
+}
+#else
+int OSAL_TimerWait(OSAL_TimerType timer) {
+  OSAL_Timer_t *tmr = (OSAL_Timer_t *)timer;
+  struct timespec now;
+  uint64_t next = OSAL_TimespecToNs(&tmr->next);
+  uint64_t late;
+  int expirations = 1;
+  int ret;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  if (OSAL_TimespecToNs(&now) < next) {
+    do {
+      ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &tmr->next, NULL);
+    } while (EINTR == ret);
+  } else {
+    /* the periods fully passed since the deadline are missed */
+    late = OSAL_TimespecToNs(&now) - next;
+    expirations += (int)(late / tmr->period);
+  }
+
+  OSAL_TimespecAdd(&tmr->next, (uint64_t)expirations * tmr->period);
+
+  return expirations;
+}
+
+int OSAL_TimerDestory(OSAL_TimerType timer) {
+  Os_MemFree(timer);
+  return 0;
+}
+#endif
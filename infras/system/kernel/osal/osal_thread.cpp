@@ -8,18 +8,62 @@
 #include <stdlib.h>
 #include <thread>
 #include <assert.h>
+#include <windows.h>
 /* ================================ [ MACROS    ] ============================================== */
 /* ================================ [ TYPES     ] ============================================== */
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
+/* windows has no real time policy but only 7 levels of the thread priority, the real time
+ * priority 1 - 99 is mapped to the 3 levels above the normal */
+static int OSAL_ThreadPriority(int priority) {
+  int level = THREAD_PRIORITY_ABOVE_NORMAL;
+
+  if (priority >= 66) {
+    level = THREAD_PRIORITY_TIME_CRITICAL;
+  } else if (priority >= 33) {
+    level = THREAD_PRIORITY_HIGHEST;
+  }
+
+  return level;
+}
 /* ================================ [ FUNCTIONS ] ============================================== */
-OSAL_ThreadType OSAL_ThreadCreate(OSAL_ThreadEntryType entry, void *args) {
-  OSAL_ThreadType thread = NULL;
+int OSAL_ThreadAttrInit(OSAL_ThreadAttrType *attr) {
+  attr->policy = OSAL_SCHED_OTHER;
+  attr->priority = 0;
+  attr->cpuMask = 0;
+  attr->stackSize = 0;
+  return 0;
+}
 
-  thread = (OSAL_ThreadType) new std::thread(entry, args);
+/* the std::thread has no way to set the stack size, so it is ignored */
+OSAL_ThreadType OSAL_ThreadCreateEx(OSAL_ThreadEntryType entry, void *args,
+                                    const OSAL_ThreadAttrType *attr) {
+  std::thread *th = new std::thread(entry, args);
+  HANDLE handle = (HANDLE)th->native_handle();
+  BOOL ok = TRUE;
 
-  return thread;
+  if (NULL != attr) {
+    if (OSAL_SCHED_OTHER != attr->policy) {
+      ok = SetThreadPriority(handle, OSAL_ThreadPriority(attr->priority));
+    }
+    if (ok && (0u != attr->cpuMask)) {
+      ok = (0 != SetThreadAffinityMask(handle, (DWORD_PTR)attr->cpuMask));
+    }
+  }
+
+  if (FALSE == ok) {
+    /* the thread is already running, it is left detached as nobody can join it */
+    th->detach();
+    delete th;
+    th = NULL;
+  }
+
+  return (OSAL_ThreadType)th;
+}
+
+OSAL_ThreadType OSAL_ThreadCreate(OSAL_ThreadEntryType entry, void *args) {
+  return OSAL_ThreadCreateEx(entry, args, NULL);
 }
 
 int OSAL_ThreadJoin(OSAL_ThreadType thread) {
@@ -10,7 +10,16 @@
 #include <windows.h>
 #include <shlwapi.h>
 /* ================================ [ MACROS    ] ============================================== */
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
 /* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  HANDLE handle;
+  LONGLONG next;   /* the performance counter of the next expiration */
+  LONGLONG period; /* in the performance counter ticks */
+  LONGLONG freq;
+} OSAL_Timer_t;
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 /* ================================ [ LOCALS    ] ============================================== */
@@ -132,3 +141,73 @@ int OSAL_SemaphoreDestory(OSAL_SemType sem) {
   }
   return ret;
 }
+
+/* The waitable timer only takes an absolute time of the wall clock, so the deadline is kept on
+ * the performance counter and each wait is armed relative to it. The high resolution timer is
+ * there since windows 10 1803, the old one falls back to the 1 ms multimedia timer resolution */
+OSAL_TimerType OSAL_TimerCreate(uint32_t periodUs) {
+  OSAL_Timer_t *tmr = NULL;
+  LARGE_INTEGER li;
+
+  if (periodUs > 0u) {
+    tmr = (OSAL_Timer_t *)malloc(sizeof(OSAL_Timer_t));
+  }
+
+  if (NULL != tmr) {
+    tmr->handle = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                         TIMER_ALL_ACCESS);
+    if (NULL == tmr->handle) {
+      tmr->handle = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+    }
+    if (NULL != tmr->handle) {
+      QueryPerformanceFrequency(&li);
+      tmr->freq = li.QuadPart;
+      tmr->period = (LONGLONG)periodUs * tmr->freq / 1000000;
+      QueryPerformanceCounter(&li);
+      tmr->next = li.QuadPart + tmr->period;
+    } else {
+      free(tmr);
+      tmr = NULL;
+    }
+  }
+
+  return (OSAL_TimerType)tmr;
+}
+
+int OSAL_TimerWait(OSAL_TimerType timer) {
+  OSAL_Timer_t *tmr = (OSAL_Timer_t *)timer;
+  LARGE_INTEGER now;
+  LARGE_INTEGER due;
+  int expirations = 1;
+  int ret = 0;
+
+  QueryPerformanceCounter(&now);
+  if (now.QuadPart < tmr->next) {
+    /* negative for the relative time in 100 ns */
+    due.QuadPart = -((tmr->next - now.QuadPart) * 10000000 / tmr->freq);
+    if (SetWaitableTimer(tmr->handle, &due, 0, NULL, NULL, FALSE)) {
+      if (WAIT_OBJECT_0 != WaitForSingleObject(tmr->handle, INFINITE)) {
+        ret = -EFAULT;
+      }
+    } else {
+      ret = -EFAULT;
+    }
+  } else {
+    expirations += (int)((now.QuadPart - tmr->next) / tmr->period);
+  }
+
+  if (0 == ret) {
+    tmr->next += (LONGLONG)expirations * tmr->period;
+    ret = expirations;
+  }
+
+  return ret;
+}
+
+int OSAL_TimerDestory(OSAL_TimerType timer) {
+  OSAL_Timer_t *tmr = (OSAL_Timer_t *)timer;
+
+  CloseHandle(tmr->handle);
+  free(tmr);
+  return 0;
+}
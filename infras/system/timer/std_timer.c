@@ -16,9 +16,11 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #endif
 
 #include "StbM.h"
+#include "Std_Compiler.h"
 /* ================================ [ MACROS    ] ============================================== */
 #define STD_TIMER_STARTED 1
 #define STD_TIMER_SET_NO_OVERFLOW 2
@@ -28,15 +30,225 @@
 
 #if defined(_WIN32) || defined(linux)
 #define USE_STBM_DFT
+#define STD_TIMER_TLS __thread
+#else
+#define STD_TIMER_TLS
+#endif
+
+#ifdef USE_STBM_DFT
+#define AS_LOG_STBM 0
+#define AS_LOG_STBMI 2
+
+#ifndef STBM_DFT_TIME_BASE_NUM
+#define STBM_DFT_TIME_BASE_NUM 4
+#endif
+
+/* the bit of each time base which has the rate correction and the offset filter, the others are
+ * set to each sync as it is */
+#ifndef STBM_DFT_CORRECTION_MASK
+#define STBM_DFT_CORRECTION_MASK 0xFFFFFFFFul
+#endif
+
+/* a sync this far off is a time leap, the time is set to it at once */
+#ifndef STBM_DFT_OFFSET_JUMP_THRESHOLD_NS
+#define STBM_DFT_OFFSET_JUMP_THRESHOLD_NS 10000000ll
+#endif
+
+/* the offset filter, 1/n of the offset of each sync is corrected, so that the jitter of a sync is
+ * damped, the drift is left to the rate correction */
+#ifndef STBM_DFT_OFFSET_FILTER
+#define STBM_DFT_OFFSET_FILTER 4
+#endif
+
+/* the offset is corrected by adapting the rate over this interval, so the time doesn't jump */
+#ifndef STBM_DFT_OFFSET_ADAPTION_INTERVAL_NS
+#define STBM_DFT_OFFSET_ADAPTION_INTERVAL_NS 100000000ll
+#endif
+
+/* the rate is measured between 2 syncs at least this far apart, the longer the less the error of
+ * the time stamps counts */
+#ifndef STBM_DFT_RATE_MEASUREMENT_DURATION_NS
+#define STBM_DFT_RATE_MEASUREMENT_DURATION_NS 4000000000ll
+#endif
+
+/* the rate deviation moves 1/n of the way to each measurement */
+#ifndef STBM_DFT_RATE_FILTER
+#define STBM_DFT_RATE_FILTER 4
+#endif
+
+/* a measurement beyond it is an outlier, ppb */
+#ifndef STBM_DFT_RATE_DEVIATION_MAX
+#define STBM_DFT_RATE_DEVIATION_MAX 500000
+#endif
+
+#define STBM_DFT_NS_PER_SECOND 1000000000ll
+
+/* the time base 0 starts this much behind the virtual local time, the Windows simulation makes
+ * it 1 second slower so that the CanTSyn sync has something to correct */
+#ifndef STBM_DFT_TIME_BASE0_OFFSET_NS
+#if defined(_WIN32)
+#define STBM_DFT_TIME_BASE0_OFFSET_NS STBM_DFT_NS_PER_SECOND
+#else
+#define STBM_DFT_TIME_BASE0_OFFSET_NS 0
+#endif
+#endif
 #endif
 /* ================================ [ TYPES     ] ============================================== */
+#ifdef USE_STBM_DFT
+/* the global time is the globalRef at the localRef, and runs from there by the rate deviation plus
+ * the offset adaption for the first STBM_DFT_OFFSET_ADAPTION_INTERVAL_NS */
+typedef struct {
+  uint64_t localRef;
+  uint64_t globalRef;
+  StbM_RateDeviationType rateDeviation;
+  StbM_RateDeviationType offsetAdaption;
+  /* the sync the rate measurement starts from */
+  uint64_t rateLocal;
+  uint64_t rateGlobal;
+  StbM_TimeBaseStatusType timeBaseStatus;
+  uint8_t updateCounter;
+  boolean rateMeasured;
+} StbM_DftTimeBaseType;
+#endif
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
 #ifdef USE_STBM_DFT
-static std_time_t lTimeBase0 = 0;
-static std_time_t lGTP = 0;
+/* the virtual local time is the Std_GetTimeNs, each time base starts the same as it */
+static StbM_DftTimeBaseType lTimeBases[STBM_DFT_TIME_BASE_NUM];
+#endif
+
+/* the latch is per thread, each thread of a partitioned main loop has its own cycle */
+static STD_TIMER_TLS std_time_t lLatchedTime;
+static STD_TIMER_TLS bool lLatched = false;
+
+#if defined(linux) || defined(_WIN32)
+static bool lVirtual = false;
+static uint64_t lVirtualNs;
+/* moves the real clock ahead to where the virtual time is left, so that it stays monotonic */
+static uint64_t lRealOffsetNs = 0;
+#if defined(_WIN32)
+static LARGE_INTEGER lPerfFreq;
+#endif
 #endif
 /* ================================ [ LOCALS    ] ============================================== */
+#if defined(linux) || defined(_WIN32)
+static uint64_t Std_GetRealTimeNs(void) {
+#if defined(_WIN32)
+  LARGE_INTEGER counter;
+
+  if (0 == lPerfFreq.QuadPart) {
+    (void)QueryPerformanceFrequency(&lPerfFreq);
+  }
+  (void)QueryPerformanceCounter(&counter);
+
+  return (uint64_t)(counter.QuadPart / lPerfFreq.QuadPart) * 1000000000ull +
+         (uint64_t)(counter.QuadPart % lPerfFreq.QuadPart) * 1000000000ull /
+           (uint64_t)lPerfFreq.QuadPart +
+         lRealOffsetNs;
+#else
+  struct timespec ts;
+
+  /* served by the vDSO, no syscall */
+  (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec + lRealOffsetNs;
+#endif
+}
+#endif
+
+static std_time_t Std_GetTimerNow(void) {
+  return lLatched ? lLatchedTime : Std_GetTime();
+}
+
+#ifdef USE_STBM_DFT
+/* the ns * ppb, split so that it doesn't overflow for a long time without sync */
+static int64_t StbM_DftScale(int64_t ns, StbM_RateDeviationType ppb) {
+  return (ns / STBM_DFT_NS_PER_SECOND) * ppb +
+         (ns % STBM_DFT_NS_PER_SECOND) * ppb / STBM_DFT_NS_PER_SECOND;
+}
+
+static uint64_t StbM_DftGetGlobalTime(const StbM_DftTimeBaseType *tb, uint64_t local) {
+  int64_t elapsed = (int64_t)(local - tb->localRef);
+  int64_t adaption = elapsed;
+
+  if (adaption > STBM_DFT_OFFSET_ADAPTION_INTERVAL_NS) {
+    adaption = STBM_DFT_OFFSET_ADAPTION_INTERVAL_NS;
+  } else if (adaption < 0) {
+    adaption = 0;
+  } else {
+    /* in the adaption interval */
+  }
+
+  return tb->globalRef + (uint64_t)(elapsed + StbM_DftScale(elapsed, tb->rateDeviation) +
+                                    StbM_DftScale(adaption, tb->offsetAdaption));
+}
+
+/* moves the reference to the local time, so that a new rate starts from the time there */
+static void StbM_DftRebase(StbM_DftTimeBaseType *tb, uint64_t local) {
+  tb->globalRef = StbM_DftGetGlobalTime(tb, local);
+  tb->localRef = local;
+  tb->offsetAdaption = 0;
+}
+
+/* a time leap, which restarts the rate measurement as well */
+static void StbM_DftSetTime(StbM_DftTimeBaseType *tb, uint64_t global, uint64_t local) {
+  tb->globalRef = global;
+  tb->localRef = local;
+  tb->offsetAdaption = 0;
+  tb->rateLocal = local;
+  tb->rateGlobal = global;
+  tb->updateCounter++;
+}
+
+/* the rate of the global time against the local one between the syncs, which is apart from the
+ * offset correction, so it is the rate of the clock of the time master */
+static void StbM_DftMeasureRate(StbM_DftTimeBaseType *tb, uint64_t global, uint64_t local) {
+  int64_t duration = (int64_t)(local - tb->rateLocal);
+  int64_t measured;
+
+  if (duration > (8 * STBM_DFT_RATE_MEASUREMENT_DURATION_NS)) {
+    /* too long without sync, starts over */
+    tb->rateLocal = local;
+    tb->rateGlobal = global;
+  } else if (duration >= STBM_DFT_RATE_MEASUREMENT_DURATION_NS) {
+    measured = ((int64_t)(global - tb->rateGlobal) - duration) * STBM_DFT_NS_PER_SECOND / duration;
+    if ((measured <= STBM_DFT_RATE_DEVIATION_MAX) && (measured >= -STBM_DFT_RATE_DEVIATION_MAX)) {
+      if (tb->rateMeasured) {
+        tb->rateDeviation += (StbM_RateDeviationType)((measured - tb->rateDeviation) /
+                                                      STBM_DFT_RATE_FILTER);
+      } else {
+        tb->rateDeviation = (StbM_RateDeviationType)measured;
+        tb->rateMeasured = TRUE;
+      }
+    } else {
+      ASLOG(STBMI, ("rate deviation %d ppb is an outlier\n", (int)measured));
+    }
+    tb->rateLocal = local;
+    tb->rateGlobal = global;
+  } else {
+    /* not yet */
+  }
+}
+
+static uint64_t StbM_DftToNs(const StbM_TimeStampType *timeStamp) {
+  return (((uint64_t)timeStamp->secondsHi << 32) + timeStamp->seconds) * STBM_DFT_NS_PER_SECOND +
+         timeStamp->nanoseconds;
+}
+
+static void StbM_DftToTimeStamp(uint64_t ns, StbM_TimeStampType *timeStamp) {
+  uint64_t seconds = ns / STBM_DFT_NS_PER_SECOND;
+
+  timeStamp->secondsHi = (uint32_t)(seconds >> 32);
+  timeStamp->seconds = (uint32_t)(seconds & 0xFFFFFFFFul);
+  timeStamp->nanoseconds = (uint32_t)(ns % STBM_DFT_NS_PER_SECOND);
+}
+
+static void StbM_DftToLocalTime(uint64_t ns, StbM_VirtualLocalTimeType *localTimePtr) {
+  localTimePtr->nanosecondsHi = (uint32_t)(ns >> 32);
+  localTimePtr->nanosecondsLo = (uint32_t)(ns & 0xFFFFFFFFul);
+}
+#endif
+
 #if defined(_WIN32)
 static void __std_timer_deinit(void) {
   TIMECAPS xTimeCaps;
@@ -56,41 +268,117 @@ static void __attribute__((constructor)) __std_timer_init(void) {
   }
 
 #ifdef USE_STBM_DFT
-  lTimeBase0 = Std_GetTime();
-  lGTP = lTimeBase0 - 1000000; /* simulate time that is 1 second slower */
+  StbM_Init(NULL);
 #endif
 
 #ifdef USE_CANTSYN
-  ASLOG(INFO, ("GTP diff = %d\n", (int)(lTimeBase0 - lGTP)));
+  ASLOG(INFO, ("GTP diff = %d us\n",
+               (int)((lTimeBases[0].localRef - lTimeBases[0].globalRef) / STD_TIME_NS_PER_US)));
 #endif
 }
 #endif
 /* ================================ [ FUNCTIONS ] ============================================== */
 #if defined(linux) || defined(_WIN32)
-std_time_t Std_GetTime(void) {
-  struct timeval now;
-  std_time_t tm;
+uint64_t Std_GetTimeNs(void) {
+  uint64_t tm;
 
-  (void)gettimeofday(&now, NULL);
-  tm = (std_time_t)now.tv_sec * 1000000 + now.tv_usec;
+  if (lVirtual) {
+    tm = __atomic_load_n(&lVirtualNs, __ATOMIC_RELAXED);
+  } else {
+    tm = Std_GetRealTimeNs();
+  }
 
   return tm;
 }
+
+std_time_t Std_GetTime(void) {
+  return (std_time_t)(Std_GetTimeNs() / STD_TIME_NS_PER_US);
+}
+
+void Std_TimeSetVirtual(bool enable) {
+  uint64_t real;
+
+  if (enable && (false == lVirtual)) {
+    __atomic_store_n(&lVirtualNs, Std_GetRealTimeNs(), __ATOMIC_RELAXED);
+    lVirtual = true;
+  } else if ((false == enable) && lVirtual) {
+    real = Std_GetRealTimeNs();
+    if (lVirtualNs > real) {
+      lRealOffsetNs += lVirtualNs - real;
+    }
+    lVirtual = false;
+  } else {
+    /* nothing changed */
+  }
+}
+
+bool Std_TimeIsVirtual(void) {
+  return lVirtual;
+}
+
+void Std_TimeStep(uint64_t ns) {
+  if (lVirtual) {
+    (void)__atomic_add_fetch(&lVirtualNs, ns, __ATOMIC_RELAXED);
+  }
+}
+#else
+/* the platform provides Std_GetTime, it may provide a finer one */
+FUNC(uint64_t, __weak) Std_GetTimeNs(void) {
+  return (uint64_t)Std_GetTime() * STD_TIME_NS_PER_US;
+}
 #endif
 
+void Std_TimeLatch(void) {
+  lLatchedTime = Std_GetTime();
+  lLatched = true;
+}
+
+void Std_TimeUnlatch(void) {
+  lLatched = false;
+}
+
 #ifdef USE_STBM_DFT
+/* all the time bases start over the same as the virtual local time, but the time base 0 which is
+ * STBM_DFT_TIME_BASE0_OFFSET_NS behind */
+void StbM_Init(const StbM_ConfigType *ConfigPtr) {
+  (void)ConfigPtr;
+  memset(lTimeBases, 0, sizeof(lTimeBases));
+  lTimeBases[0].localRef = Std_GetTimeNs();
+  lTimeBases[0].globalRef = lTimeBases[0].localRef - STBM_DFT_TIME_BASE0_OFFSET_NS;
+}
+
 Std_ReturnType StbM_GetCurrentVirtualLocalTime(StbM_SynchronizedTimeBaseType timeBaseId,
                                                StbM_VirtualLocalTimeType *localTimePtr) {
-  Std_ReturnType ret = E_OK;
-  std_time_t tm;
-  if (0 == timeBaseId) {
-    /* a simulation of local time for CanSyn development */
-    tm = Std_GetTime() - lTimeBase0 + lGTP;
-    tm = tm * 1000;
-    localTimePtr->nanosecondsHi = (uint32_t)(tm >> 32);
-    localTimePtr->nanosecondsLo = (uint32_t)(tm & 0xFFFFFFFFul);
-  } else {
-    ret = E_NOT_OK;
+  Std_ReturnType ret = E_NOT_OK;
+
+  if ((timeBaseId < STBM_DFT_TIME_BASE_NUM) && (NULL != localTimePtr)) {
+    StbM_DftToLocalTime(Std_GetTimeNs(), localTimePtr);
+    ret = E_OK;
+  }
+
+  return ret;
+}
+
+Std_ReturnType StbM_BusGetCurrentTime(StbM_SynchronizedTimeBaseType timeBaseId,
+                                      StbM_TimeStampType *globalTimePtr,
+                                      StbM_VirtualLocalTimeType *localTimePtr,
+                                      StbM_UserDataType *userData) {
+  Std_ReturnType ret = E_NOT_OK;
+  StbM_DftTimeBaseType *tb;
+  uint64_t local;
+
+  if ((timeBaseId < STBM_DFT_TIME_BASE_NUM) && (NULL != globalTimePtr)) {
+    tb = &lTimeBases[timeBaseId];
+    local = Std_GetTimeNs();
+    StbM_DftToTimeStamp(StbM_DftGetGlobalTime(tb, local), globalTimePtr);
+    globalTimePtr->timeBaseStatus = tb->timeBaseStatus;
+    if (NULL != localTimePtr) {
+      StbM_DftToLocalTime(local, localTimePtr);
+    }
+    if (NULL != userData) {
+      userData->userDataLength = 0;
+    }
+    ret = E_OK;
   }
 
   return ret;
@@ -101,22 +389,100 @@ Std_ReturnType StbM_BusSetGlobalTime(StbM_SynchronizedTimeBaseType timeBaseId,
                                      const StbM_UserDataType *userDataPtr,
                                      const StbM_MeasurementType *measureDataPtr,
                                      const StbM_VirtualLocalTimeType *localTimePtr) {
-  Std_ReturnType ret = E_OK;
-  std_time_t tm;
-  if (0 == timeBaseId) {
-    lTimeBase0 = Std_GetTime();
-    tm = (((uint64_t)globalTimePtr->secondsHi << 32) + globalTimePtr->seconds) * 1000000 +
-         (globalTimePtr->nanoseconds / 1000);
-    lGTP = tm;
-    ASLOG(INFO, ("GTP diff = %d us\n", (int)(lTimeBase0 - lGTP)));
-  } else {
-    ret = E_NOT_OK;
+  Std_ReturnType ret = E_NOT_OK;
+  StbM_DftTimeBaseType *tb;
+  uint64_t global;
+  uint64_t local;
+  int64_t offset;
+
+  if ((timeBaseId < STBM_DFT_TIME_BASE_NUM) && (NULL != globalTimePtr)) {
+    tb = &lTimeBases[timeBaseId];
+    global = StbM_DftToNs(globalTimePtr);
+    if (NULL != localTimePtr) {
+      /* the virtual local time the global time was of, the rx time stamp of the bus */
+      local = ((uint64_t)localTimePtr->nanosecondsHi << 32) + localTimePtr->nanosecondsLo;
+    } else {
+      local = Std_GetTimeNs();
+    }
+    offset = (int64_t)(global - StbM_DftGetGlobalTime(tb, local));
+    if ((0 == (tb->timeBaseStatus & STBM_STATUS_GLOBAL_TIME_BASE)) ||
+        (offset > STBM_DFT_OFFSET_JUMP_THRESHOLD_NS) ||
+        (offset < -STBM_DFT_OFFSET_JUMP_THRESHOLD_NS)) {
+      ASLOG(STBMI, ("[%d] time leap %d us\n", timeBaseId, (int)(offset / STD_TIME_NS_PER_US)));
+      StbM_DftSetTime(tb, global, local);
+    } else if (0 == (((uint32_t)STBM_DFT_CORRECTION_MASK >> timeBaseId) & 1u)) {
+      StbM_DftSetTime(tb, global, local);
+    } else {
+      ASLOG(STBM, ("[%d] offset %d ns\n", timeBaseId, (int)offset));
+      StbM_DftRebase(tb, local);
+      StbM_DftMeasureRate(tb, global, local);
+      tb->offsetAdaption = (StbM_RateDeviationType)((offset / STBM_DFT_OFFSET_FILTER) *
+                                                    STBM_DFT_NS_PER_SECOND /
+                                                    STBM_DFT_OFFSET_ADAPTION_INTERVAL_NS);
+    }
+    tb->timeBaseStatus =
+      STBM_STATUS_GLOBAL_TIME_BASE | (globalTimePtr->timeBaseStatus & STBM_STATUS_SYNC_TO_GATEWAY);
+    ret = E_OK;
+  }
+  (void)userDataPtr;
+  (void)measureDataPtr;
+
+  return ret;
+}
+
+Std_ReturnType StbM_SetGlobalTime(StbM_SynchronizedTimeBaseType timeBaseId,
+                                  const StbM_TimeStampType *timeStamp,
+                                  const StbM_UserDataType *userData) {
+  Std_ReturnType ret = E_NOT_OK;
+  StbM_DftTimeBaseType *tb;
+
+  if ((timeBaseId < STBM_DFT_TIME_BASE_NUM) && (NULL != timeStamp)) {
+    tb = &lTimeBases[timeBaseId];
+    StbM_DftSetTime(tb, StbM_DftToNs(timeStamp), Std_GetTimeNs());
+    tb->timeBaseStatus = STBM_STATUS_GLOBAL_TIME_BASE;
+    ret = E_OK;
+  }
+  (void)userData;
+
+  return ret;
+}
+
+Std_ReturnType StbM_SetRateCorrection(StbM_SynchronizedTimeBaseType timeBaseId,
+                                      StbM_RateDeviationType rateDeviation) {
+  Std_ReturnType ret = E_NOT_OK;
+  StbM_DftTimeBaseType *tb;
+
+  if ((timeBaseId < STBM_DFT_TIME_BASE_NUM) && (rateDeviation <= STBM_DFT_RATE_DEVIATION_MAX) &&
+      (rateDeviation >= -STBM_DFT_RATE_DEVIATION_MAX)) {
+    tb = &lTimeBases[timeBaseId];
+    StbM_DftRebase(tb, Std_GetTimeNs());
+    tb->rateDeviation = rateDeviation;
+    ret = E_OK;
   }
+
+  return ret;
+}
+
+Std_ReturnType StbM_GetRateDeviation(StbM_SynchronizedTimeBaseType timeBaseId,
+                                     StbM_RateDeviationType *rateDeviation) {
+  Std_ReturnType ret = E_NOT_OK;
+
+  if ((timeBaseId < STBM_DFT_TIME_BASE_NUM) && (NULL != rateDeviation)) {
+    *rateDeviation = lTimeBases[timeBaseId].rateDeviation;
+    ret = E_OK;
+  }
+
   return ret;
 }
 
 uint8_t StbM_GetTimeBaseUpdateCounter(StbM_SynchronizedTimeBaseType timeBaseId) {
-  return 0;
+  uint8_t counter = 0;
+
+  if (timeBaseId < STBM_DFT_TIME_BASE_NUM) {
+    counter = lTimeBases[timeBaseId].updateCounter;
+  }
+
+  return counter;
 }
 #endif /* USE_STBM_DFT */
 
@@ -158,17 +524,21 @@ void Std_GetDateTime(char *ts, size_t sz) {
 
 #if defined(linux) || defined(_WIN32)
 void Std_Sleep(std_time_t time) {
+  if (lVirtual) {
+    Std_TimeStep((uint64_t)time * STD_TIME_NS_PER_US);
+  } else {
 #if defined(_WIN32)
-  Sleep(time / 1000);
+    Sleep(time / 1000);
 #else
-  usleep(time);
+    usleep(time);
 #endif
+  }
 }
 #endif
 
 void Std_TimerStart(Std_TimerType *timer) {
   timer->status = STD_TIMER_STARTED;
-  timer->time = Std_GetTime();
+  timer->time = Std_GetTimerNow();
 }
 
 void Std_TimerStop(Std_TimerType *timer) {
@@ -185,7 +555,7 @@ std_time_t Std_GetTimerElapsedTime(Std_TimerType *timer) {
   std_time_t elapsed = 0;
 
   if (timer->status) {
-    curTime = Std_GetTime();
+    curTime = Std_GetTimerNow();
     if (curTime > timer->time) {
       elapsed = curTime - timer->time;
     } else {
@@ -196,13 +566,20 @@ std_time_t Std_GetTimerElapsedTime(Std_TimerType *timer) {
   return elapsed;
 }
 
+void Std_TimerAdvance(Std_TimerType *timer, std_time_t time) {
+  if (timer->status) {
+    /* wraps around as the elapsed time does */
+    timer->time += time;
+  }
+}
+
 void Std_TimerSet(Std_TimerType *timer, std_time_t timeout) {
   std_time_t curTime;
 
   asAssert(timeout <= STD_TIMER_SET_MAX);
 
   if (0 == timer->status) {
-    curTime = Std_GetTime();
+    curTime = Std_GetTimerNow();
   } else {
     curTime = timer->time;
   }
@@ -218,7 +595,7 @@ void Std_TimerSet(Std_TimerType *timer, std_time_t timeout) {
 
 bool Std_IsTimerTimeout(Std_TimerType *timer) {
   bool r = false;
-  std_time_t curTime = Std_GetTime();
+  std_time_t curTime = Std_GetTimerNow();
   /* 0 -------- 1/4 -------- 1/2 -------- 3/4 -------- MAX */
   switch (timer->status) {
   case STD_TIMER_SET_NO_OVERFLOW:
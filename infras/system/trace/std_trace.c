@@ -5,10 +5,21 @@
 /* ================================ [ INCLUDES  ] ============================================== */
 #include "Std_Trace.h"
 #include "Std_Critical.h"
+#include "Std_Compiler.h"
+#include "Std_Types.h"
+#include "Std_Debug.h"
 #include <stdio.h>
+#include <string.h>
 #ifdef USE_VFS
 #include "vfs.h"
 #endif
+#include "Std_Timer.h"
+#if defined(linux)
+#include <unistd.h>
+#endif
+#if (defined(linux) || defined(_WIN32)) && !defined(USE_OS)
+#include <pthread.h>
+#endif
 #ifdef USE_CAN
 #include "Can.h"
 #ifdef USE_STARTUP_TRACE /* NOTE: do undef USE_CANSM to enable trace during startup */
@@ -18,23 +29,108 @@
 #include "CanSM.h"
 #endif
 #endif
+#ifdef TRACE_USE_SOAD
+#include "SoAd.h"
+#undef USE_CANSM /* the UDP stream doesn't depend on the CAN bus state */
+#endif
 /* ================================ [ MACROS    ] ============================================== */
 #ifndef TRACE_CAN_DLC
 #define TRACE_CAN_DLC 8
 #endif
-/* ================================ [ TYPES     ] ============================================== */
-#ifdef RB_PUSH_FAST
-RB_PUSH_FAST(TraceEvent, Std_TraceEventType)
+
+/* The stream frame of Std_TraceMain, all little endian:
+ *   [0]    sequence, +1 for each frame sent
+ *   [1]    the number of the events N
+ *   [2..3] the low 16 bits of the total events dropped by the rings and the lost ones
+ *   [4..]  N events
+ * The classic 8 bytes CAN frame carries the 2 events only by default, which is what the old
+ * receivers expect. The CAN-FD frame needs the header as the padding up to the next DL can't be
+ * told from the events. */
+#ifndef TRACE_STREAM_HEADER
+#if (TRACE_CAN_DLC > 8) || defined(TRACE_USE_SOAD)
+#define TRACE_STREAM_HEADER 1
+#else
+#define TRACE_STREAM_HEADER 0
+#endif
+#endif
+
+#if TRACE_STREAM_HEADER
+#define TRACE_STREAM_HEADER_SIZE 4
+#else
+#define TRACE_STREAM_HEADER_SIZE 0
 #endif
+
+#ifdef TRACE_USE_SOAD
+#ifndef TRACE_SOAD_TX_PDUID
+#error "TRACE_SOAD_TX_PDUID must be the SoAd tx PDU routed to the trace UDP socket"
+#endif
+/* one datagram carries all of the pending events */
+#define TRACE_FRAME_SIZE                                                                           \
+  (TRACE_STREAM_HEADER_SIZE + STD_TRACE_PENDING_MAX * sizeof(Std_TraceEventType))
+#ifndef TRACE_FRAME_OVERHEAD
+#define TRACE_FRAME_OVERHEAD 42 /* the ethernet, IPv4 and UDP headers */
+#endif
+#else
+#define TRACE_FRAME_SIZE TRACE_CAN_DLC
+#ifndef TRACE_FRAME_OVERHEAD
+#define TRACE_FRAME_OVERHEAD 8 /* about the arbitration, control, CRC and EOF fields */
+#endif
+#endif
+
+#define TRACE_FRAME_EVENTS ((TRACE_FRAME_SIZE - TRACE_STREAM_HEADER_SIZE) / sizeof(Std_TraceEventType))
+
+/* the frames at most sent by one Std_TraceMain call */
+#ifndef TRACE_FRAMES_PER_MAIN
+#if TRACE_STREAM_HEADER
+#define TRACE_FRAMES_PER_MAIN 8
+#else
+#define TRACE_FRAMES_PER_MAIN 1
+#endif
+#endif
+
+/* The bus load budget of Std_TraceMain in bytes per second, with TRACE_FRAME_OVERHEAD counted for
+ * each frame. The unused budget is saved up to one full call of TRACE_FRAMES_PER_MAIN frames.
+ * 0 means no limit other than TRACE_FRAMES_PER_MAIN. */
+#ifndef TRACE_BYTES_PER_SECOND
+#define TRACE_BYTES_PER_SECOND 0
+#endif
+
+#if (defined(linux) || defined(_WIN32)) && !defined(USE_OS)
+/* one ring per thread but the last one, nothing else may push to it, so no lock at all. The
+ * other threads share the last ring under the critical section, so with a single ring all of the
+ * threads are traced to it. The slot of a thread is given back when it exits. */
+#define STD_TRACE_PER_THREAD
+#ifndef STD_TRACE_MAX_THREADS
+#define STD_TRACE_MAX_THREADS 64
+#endif
+#else
+/* one ring per core, only the ISRs of the same core are kept out, the cores never wait */
+#define STD_TRACE_LOCAL_LOCK() imask_t imask = Std_EnterCritical()
+#define STD_TRACE_LOCAL_UNLOCK() Std_ExitCritical(imask)
+#endif
+
+#define STD_TRACE_LOAD(v) __atomic_load_n(&(v), __ATOMIC_ACQUIRE)
+#define STD_TRACE_STORE(v, x) __atomic_store_n(&(v), (x), __ATOMIC_RELEASE)
+/* the consumers of an area may run on different tasks or cores, the loser skips its turn */
+#define STD_TRACE_TRY_LOCK(v) (0u == __atomic_exchange_n(&(v), 1u, __ATOMIC_ACQUIRE))
+#define STD_TRACE_UNLOCK(v) __atomic_store_n(&(v), 0u, __ATOMIC_RELEASE)
+/* ================================ [ TYPES     ] ============================================== */
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
-#if TRACE_CAN_DLC > 8
+#if (TRACE_CAN_DLC > 8) && !defined(TRACE_USE_SOAD)
 static const uint8_t lLL_DLs[] = {8, 12, 16, 20, 24, 32, 48, 64};
 #else
 #define Std_TraceGetDlc(sz) sz
 #endif
+
+#ifdef STD_TRACE_PER_THREAD
+static uint8_t lThreadSlots[STD_TRACE_MAX_THREADS]; /* 1 if taken by a living thread */
+static pthread_once_t lThreadOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t lThreadKey;
+static __thread uint32_t lThreadContext = (uint32_t)-1;
+#endif
 /* ================================ [ LOCALS    ] ============================================== */
-#if TRACE_CAN_DLC > 8
+#if (TRACE_CAN_DLC > 8) && !defined(TRACE_USE_SOAD)
 static PduLengthType Std_TraceGetDlc(PduLengthType len) {
   PduLengthType dl = len;
   int i;
@@ -49,46 +145,202 @@ static PduLengthType Std_TraceGetDlc(PduLengthType len) {
   return dl;
 }
 #endif
-/* ================================ [ FUNCTIONS ] ============================================== */
-void Std_TraceEvent(const Std_TraceAreaType *area, Std_TraceEventType event) {
-  EnterCritical();
-#ifdef RB_PUSH_FAST
-  RB_PushTraceEvent(area->rb, &event);
+
+#ifdef STD_TRACE_PER_THREAD
+static void Std_TraceThreadExit(void *arg) {
+  /* the release makes the last events of the thread visible to the next owner of the slot */
+  __atomic_store_n(&lThreadSlots[(uintptr_t)arg - 1u], 0, __ATOMIC_RELEASE);
+}
+
+static void Std_TraceThreadInit(void) {
+  (void)pthread_key_create(&lThreadKey, Std_TraceThreadExit);
+}
+
+/* the lowest free slot, or STD_TRACE_MAX_THREADS which is always in the shared ring */
+static uint32_t Std_TraceContext(void) {
+  uint32_t slot;
+  uint8_t expected;
+
+  if ((uint32_t)-1 == lThreadContext) {
+    (void)pthread_once(&lThreadOnce, Std_TraceThreadInit);
+    lThreadContext = STD_TRACE_MAX_THREADS;
+    for (slot = 0; (slot < STD_TRACE_MAX_THREADS) && (STD_TRACE_MAX_THREADS == lThreadContext);
+         slot++) {
+      expected = 0;
+      if (__atomic_compare_exchange_n(&lThreadSlots[slot], &expected, 1, FALSE, __ATOMIC_ACQUIRE,
+                                      __ATOMIC_RELAXED)) {
+        lThreadContext = slot;
+        (void)pthread_setspecific(lThreadKey, (void *)(uintptr_t)(slot + 1u));
+      }
+    }
+  }
+
+  return lThreadContext;
+}
 #else
-  RB_Push(area->rb, &event, 1);
+static uint32_t Std_TraceContext(void) {
+  return Std_TraceGetContext();
+}
 #endif
-  ExitCritical();
+
+static void Std_TracePush(const Std_TraceAreaType *area, uint32_t context,
+                          Std_TraceEventType event) {
+  Std_TraceRingType *ring = &area->rings[context];
+  uint32_t head = ring->head;
+
+  if ((head - STD_TRACE_LOAD(ring->tail)) < area->size) {
+    area->buffer[context * area->size + (head & (area->size - 1))] = event;
+    STD_TRACE_STORE(ring->head, head + 1);
+  } else {
+    ring->drops++;
+  }
 }
 
-void Std_TraceDump(const Std_TraceAreaType *area) {
-#ifdef USE_VFS
-  VFS_FILE *fp;
-  rb_size_t r;
-  Std_TraceEventType event;
-  fp = vfs_fopen("share/.trace.bin", "wb");
-  if (NULL != fp) {
-    EnterCritical();
-    r = RB_Pop(area->rb, &event, 1);
-    while (r == 1) {
-      vfs_fwrite(&event, sizeof(Std_TraceEventType), 1, fp);
-      r = RB_Pop(area->rb, &event, 1);
+/* take the oldest event of all the rings, as the timestamps are truncated, the one which is the
+ * closest after the last taken one is the oldest */
+static boolean Std_TracePop(const Std_TraceAreaType *area, Std_TraceEventType *event) {
+  Std_TraceRingType *ring;
+  Std_TraceEventType ev;
+  uint32_t context;
+  uint32_t tail;
+  uint32_t delta;
+  uint32_t best = area->contexts;
+  uint32_t bestDelta = 0;
+
+  for (context = 0; context < area->contexts; context++) {
+    ring = &area->rings[context];
+    tail = ring->tail;
+    if (tail != STD_TRACE_LOAD(ring->head)) {
+      ev = area->buffer[context * area->size + (tail & (area->size - 1))];
+      delta = ((ev & area->tsMask) - area->var->last) & area->tsMask;
+      if ((best == area->contexts) || (delta < bestDelta)) {
+        best = context;
+        bestDelta = delta;
+        *event = ev;
+      }
     }
-    ExitCritical();
-    vfs_fclose(fp);
   }
-#endif
+
+  if (best < area->contexts) {
+    ring = &area->rings[best];
+    area->var->last = *event & area->tsMask;
+    STD_TRACE_STORE(ring->tail, ring->tail + 1);
+  }
+
+  return (boolean)(best < area->contexts);
 }
 
-#ifdef USE_CAN
-void Std_TraceMain(const Std_TraceAreaType *area) {
-  uint8_t data[TRACE_CAN_DLC];
-  rb_size_t sz;
-#if TRACE_CAN_DLC > 8
-  rb_size_t i;
+static uint32_t Std_TraceFillPending(const Std_TraceAreaType *area, uint32_t max) {
+  Std_TraceAreaVarType *var = area->var;
+
+  if (max > STD_TRACE_PENDING_MAX) {
+    max = STD_TRACE_PENDING_MAX;
+  }
+
+  while ((var->numOfPending < max) && Std_TracePop(area, &var->pending[var->numOfPending])) {
+    var->numOfPending++;
+  }
+
+  /* the events kept by a failed call of an other consumer may be more than max */
+  return (var->numOfPending < max) ? var->numOfPending : max;
+}
+
+static void Std_TraceConsume(Std_TraceAreaVarType *var, uint32_t num) {
+  var->numOfPending -= num;
+  if (var->numOfPending > 0u) {
+    memmove(&var->pending[0], &var->pending[num], var->numOfPending * sizeof(Std_TraceEventType));
+  }
+}
+
+static uint32_t Std_TraceDrain(const Std_TraceAreaType *area, Std_TraceSinkType sink, void *param,
+                               uint32_t max) {
+  Std_TraceAreaVarType *var = area->var;
+  uint32_t total = 0;
+  uint32_t num;
+  uint32_t size;
+  int r;
+
+  while (total < max) {
+    num = Std_TraceFillPending(area, max - total);
+    if (0u == num) {
+      break;
+    }
+    size = num * sizeof(Std_TraceEventType);
+    r = sink(param, var->pending, size);
+    if (r != (int)size) {
+      /* keep them for the next call, a partial write is not supported */
+      break;
+    }
+    total += num;
+    Std_TraceConsume(var, num);
+  }
+
+  return total;
+}
+
+#if defined(USE_CAN) || defined(TRACE_USE_SOAD)
+#if TRACE_STREAM_HEADER
+static uint32_t Std_TraceDrops(const Std_TraceAreaType *area) {
+  uint32_t drops = area->var->lost;
+  uint32_t context;
+
+  for (context = 0; context < area->contexts; context++) {
+    drops += area->rings[context].drops;
+  }
+
+  return drops;
+}
 #endif
+
+#if TRACE_BYTES_PER_SECOND > 0
+static void Std_TraceRefill(Std_TraceAreaVarType *var) {
+  uint32_t now = (uint32_t)Std_GetTime();
+  uint64_t credit;
+
+  credit = (uint64_t)(now - var->timestamp) * TRACE_BYTES_PER_SECOND / 1000000u + var->credit;
+  if (credit > (TRACE_FRAME_SIZE + TRACE_FRAME_OVERHEAD) * TRACE_FRAMES_PER_MAIN) {
+    credit = (TRACE_FRAME_SIZE + TRACE_FRAME_OVERHEAD) * TRACE_FRAMES_PER_MAIN;
+  }
+  var->credit = (uint32_t)credit;
+  var->timestamp = now;
+}
+#endif
+
+static Std_ReturnType Std_TraceTransmit(uint8_t *data, uint32_t length) {
   Std_ReturnType ret;
+#ifdef TRACE_USE_SOAD
+  PduInfoType PduInfo;
+
+  PduInfo.SduDataPtr = data;
+  PduInfo.SduLength = (PduLengthType)length;
+  PduInfo.MetaDataPtr = NULL;
+  ret = SoAd_IfTransmit(TRACE_SOAD_TX_PDUID, &PduInfo);
+#else
   Can_PduType PduInfo;
 
+  PduInfo.id = TRACE_TX_CANID;
+  PduInfo.length = (PduLengthType)length;
+  PduInfo.sdu = data;
+  PduInfo.swPduHandle = TRACE_TX_CAN_HANDLE;
+  ret = Can_Write(STDIO_TX_CAN_HTH, &PduInfo);
+#endif
+  return ret;
+}
+#endif
+
+#if defined(USE_CAN) || defined(TRACE_USE_SOAD)
+static void Std_TraceSend(const Std_TraceAreaType *area) {
+  Std_TraceAreaVarType *var = area->var;
+  uint8_t data[TRACE_FRAME_SIZE];
+  uint32_t frames;
+  uint32_t sz;
+  uint32_t length;
+  uint32_t i;
+#if TRACE_STREAM_HEADER
+  uint32_t drops;
+#endif
+  Std_ReturnType ret = E_OK;
+
 #ifdef USE_CANSM
   ComM_ModeType mode = COMM_NO_COMMUNICATION;
 #endif
@@ -97,24 +349,42 @@ void Std_TraceMain(const Std_TraceAreaType *area) {
   CanSM_GetCurrentComMode(0, &mode);
   if (CANSM_BSWM_FULL_COMMUNICATION == mode) {
 #endif
-    EnterCritical();
-    sz = RB_Poll(area->rb, data, TRACE_CAN_DLC / sizeof(Std_TraceEventType));
-    ExitCritical();
-    if (sz > 0) {
-      PduInfo.id = TRACE_TX_CANID;
-      PduInfo.length = Std_TraceGetDlc(sz * sizeof(Std_TraceEventType));
-      PduInfo.sdu = data;
-#if TRACE_CAN_DLC > 8
-      for (i = sz * sizeof(Std_TraceEventType); i < PduInfo.length; i++) {
-        data[i] = 0;
+#if TRACE_BYTES_PER_SECOND > 0
+    Std_TraceRefill(var);
+#endif
+#if TRACE_STREAM_HEADER
+    drops = Std_TraceDrops(area);
+#endif
+    for (frames = 0; (frames < TRACE_FRAMES_PER_MAIN) && (E_OK == ret); frames++) {
+      /* the frame not accepted by the last call is retried first */
+      sz = Std_TraceFillPending(area, TRACE_FRAME_EVENTS);
+      if (0u == sz) {
+        break;
+      }
+      length = Std_TraceGetDlc(TRACE_STREAM_HEADER_SIZE + sz * sizeof(Std_TraceEventType));
+#if TRACE_BYTES_PER_SECOND > 0
+      if (var->credit < (length + TRACE_FRAME_OVERHEAD)) {
+        break;
       }
 #endif
-      PduInfo.swPduHandle = TRACE_TX_CAN_HANDLE;
-      ret = Can_Write(STDIO_TX_CAN_HTH, &PduInfo);
+#if TRACE_STREAM_HEADER
+      data[0] = var->sequence;
+      data[1] = (uint8_t)sz;
+      data[2] = (uint8_t)drops;
+      data[3] = (uint8_t)(drops >> 8);
+#endif
+      asAssert(sz <= TRACE_FRAME_EVENTS);
+      memcpy(&data[TRACE_STREAM_HEADER_SIZE], var->pending, sz * sizeof(Std_TraceEventType));
+      for (i = TRACE_STREAM_HEADER_SIZE + sz * sizeof(Std_TraceEventType); i < length; i++) {
+        data[i] = 0;
+      }
+      ret = Std_TraceTransmit(data, length);
       if (E_OK == ret) {
-        EnterCritical();
-        (void)RB_Drop(area->rb, sz); /* consume it */
-        ExitCritical();
+        Std_TraceConsume(var, sz);
+        var->sequence++;
+#if TRACE_BYTES_PER_SECOND > 0
+        var->credit -= length + TRACE_FRAME_OVERHEAD;
+#endif
       }
     }
 #ifdef USE_CANSM
@@ -122,3 +392,100 @@ void Std_TraceMain(const Std_TraceAreaType *area) {
 #endif
 }
 #endif
+/* ================================ [ FUNCTIONS ] ============================================== */
+FUNC(uint32_t, __weak) Std_TraceGetContext(void) {
+  return 0;
+}
+
+void Std_TraceEvent(const Std_TraceAreaType *area, Std_TraceEventType event) {
+  uint32_t context;
+#ifdef STD_TRACE_PER_THREAD
+  imask_t imask;
+
+  context = Std_TraceContext();
+  if ((context + 1u) < area->contexts) {
+    Std_TracePush(area, context, event);
+  } else {
+    imask = Std_EnterCritical();
+    Std_TracePush(area, area->contexts - 1u, event);
+    Std_ExitCritical(imask);
+  }
+#else
+  STD_TRACE_LOCAL_LOCK();
+
+  context = Std_TraceContext();
+  if (context < area->contexts) {
+    Std_TracePush(area, context, event);
+  } else {
+    area->var->lost++;
+  }
+
+  STD_TRACE_LOCAL_UNLOCK();
+#endif
+}
+
+uint32_t Std_TraceStream(const Std_TraceAreaType *area, Std_TraceSinkType sink, void *param,
+                         uint32_t max) {
+  uint32_t total = 0;
+
+  if (STD_TRACE_TRY_LOCK(area->var->busy)) {
+    total = Std_TraceDrain(area, sink, param, max);
+    STD_TRACE_UNLOCK(area->var->busy);
+  }
+
+  return total;
+}
+
+void Std_TraceStat(const Std_TraceAreaType *area) {
+  Std_TraceRingType *ring;
+  uint32_t context;
+
+  printf("%-8s %8s %8s %8s\n", "context", "used", "size", "drops");
+  for (context = 0; context < area->contexts; context++) {
+    ring = &area->rings[context];
+    printf("%-8u %8u %8u %8u\n", context, STD_TRACE_LOAD(ring->head) - ring->tail, area->size,
+           ring->drops);
+  }
+  printf("lost %u events of the cores beyond %u\n", area->var->lost, area->contexts);
+}
+
+#ifdef USE_VFS
+int Std_TraceSinkVfs(void *param, const void *data, uint32_t size) {
+  return (int)vfs_fwrite(data, 1, size, (VFS_FILE *)param);
+}
+#endif
+
+#if defined(linux)
+int Std_TraceSinkFd(void *param, const void *data, uint32_t size) {
+  return (int)write((int)(intptr_t)param, data, size);
+}
+#endif
+
+void Std_TraceDump(const Std_TraceAreaType *area) {
+#ifdef USE_VFS
+  VFS_FILE *fp;
+#endif
+
+  if (STD_TRACE_TRY_LOCK(area->var->busy)) {
+#ifdef USE_VFS
+    fp = vfs_fopen("share/.trace.bin", "wb");
+    if (NULL != fp) {
+      (void)Std_TraceDrain(area, Std_TraceSinkVfs, fp, (uint32_t)-1);
+      vfs_fclose(fp);
+    }
+#endif
+    STD_TRACE_UNLOCK(area->var->busy);
+  } else {
+    printf("the trace is being drained by the live or stream mode\n");
+  }
+  Std_TraceStat(area);
+}
+
+#if defined(USE_CAN) || defined(TRACE_USE_SOAD)
+void Std_TraceMain(const Std_TraceAreaType *area) {
+  if (STD_TRACE_TRY_LOCK(area->var->busy)) {
+    Std_TraceSend(area);
+    STD_TRACE_UNLOCK(area->var->busy);
+  }
+}
+#endif
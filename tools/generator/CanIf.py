@@ -10,6 +10,56 @@ from .Com import get_messages
 
 __all__ = ["Gen"]
 
+CANIF_RX_FULL_MASK = 0x1FFFFFFF
+CANIF_RX_HASH_EMPTY = 0xFFFF
+
+
+def CanIf_RxHash(canid, size):
+    # the same as the CANIF_RX_HASH of CanIf_Priv.h
+    return (((canid * 0x9E3779B1) & 0xFFFFFFFF) >> 16) & (size - 1)
+
+
+def get_rx_groups(network):
+    # group the rx PDUs by the mask, the most specific mask first and each sorted by the canid
+    groups = {}
+    for pdu in network["RxPdus"]:
+        mask = toNum(pdu.get("mask", "0xFFFFFFFF")) & CANIF_RX_FULL_MASK
+        if mask not in groups:
+            groups[mask] = []
+        groups[mask].append(pdu)
+    masks = sorted(groups.keys(), key=lambda m: (-bin(m).count("1"), -m))
+    L = []
+    for mask in masks:
+        pdus = sorted(groups[mask], key=lambda x: toNum(x["id"]) & mask)
+        L.append((mask, pdus))
+    return L
+
+
+def get_rx_hash(network, groups):
+    # the open addressing table of the first group if it is the full CANID one
+    if len(groups) == 0 or groups[0][0] != CANIF_RX_FULL_MASK:
+        return None
+    pdus = groups[0][1]
+    if not network.get("RxHash", len(pdus) >= 32):
+        return None
+    size = 1
+    while size < 2 * len(pdus):
+        size *= 2
+    if size > 0x8000:
+        raise Exception("too much rx PDUs for the hash of %s" % (network["name"]))
+    table = [CANIF_RX_HASH_EMPTY] * size
+    ids = []
+    for index, pdu in enumerate(pdus):
+        canid = toNum(pdu["id"]) & CANIF_RX_FULL_MASK
+        if canid in ids:
+            continue  # the first one wins, the same as the search
+        ids.append(canid)
+        slot = CanIf_RxHash(canid, size)
+        while table[slot] != CANIF_RX_HASH_EMPTY:
+            slot = (slot + 1) & (size - 1)
+        table[slot] = index
+    return table
+
 
 def Gen_CanIf(cfg, dir):
     modules = []
@@ -84,8 +134,9 @@ def Gen_CanIf(cfg, dir):
                 C.write("void %s_TxConfirmation(PduIdType TxPduId, Std_ReturnType result);\n" % (pdu["up"]))
     C.write("/* ================================ [ DATAS     ] ============================================== */\n")
     for netId, network in enumerate(cfg["networks"]):
+        groups = get_rx_groups(network)
         C.write("static const CanIf_RxPduType CanIf_RxPdus_%s[] = {\n" % (network["name"]))
-        for pdu in network["RxPdus"]:
+        for mask, pdu in [(mask, pdu) for mask, pdus in groups for pdu in pdus]:
             C.write("  {\n")
             if pdu["up"] in ["PduR", "Xcp"]:
                 C.write("    %s_CanIfRxIndication,\n" % (pdu["up"]))
@@ -97,11 +148,24 @@ def Gen_CanIf(cfg, dir):
                 C.write("    CANIF_%s, /* rxPduId */\n" % (pdu["name"]))
             else:
                 C.write("    %s_%s,\n" % (pdu["up"].upper(), pdu["name"]))
-            C.write("    0x%x, /* canid */\n" % (toNum(pdu["id"]) & 0x1FFFFFFF))
-            C.write("    0x%x, /* mask */\n" % (toNum(pdu.get("mask", "0xFFFFFFFF")) & 0x1FFFFFFF))
+            C.write("    0x%x, /* canid */\n" % (toNum(pdu["id"]) & mask))
+            C.write("    0x%x, /* mask */\n" % (mask))
             C.write("    %s, /* hoh */\n" % (pdu.get("hoh", 0)))
             C.write("  },\n")
         C.write("};\n\n")
+        if len(groups) > 0:
+            C.write("static const CanIf_RxGroupType CanIf_RxGroups_%s[] = {\n" % (network["name"]))
+            start = 0
+            for mask, pdus in groups:
+                C.write("  {0x%x, %s, %s},\n" % (mask, start, len(pdus)))
+                start += len(pdus)
+            C.write("};\n\n")
+        table = get_rx_hash(network, groups)
+        if table != None:
+            C.write("static const uint16_t CanIf_RxHash_%s[] = {\n" % (network["name"]))
+            for i in range(0, len(table), 8):
+                C.write("  %s,\n" % (", ".join(["0x%x" % (v) for v in table[i : i + 8]])))
+            C.write("};\n\n")
     for netId, network in enumerate(cfg["networks"]):
         for pdu in network["TxPdus"]:
             if pdu.get("dynamic", False):
@@ -136,6 +200,19 @@ def Gen_CanIf(cfg, dir):
         C.write("  {\n")
         C.write("    CanIf_RxPdus_%s,\n" % (network["name"]))
         C.write("    ARRAY_SIZE(CanIf_RxPdus_%s),\n" % (network["name"]))
+        groups = get_rx_groups(network)
+        if len(groups) > 0:
+            C.write("    CanIf_RxGroups_%s,\n" % (network["name"]))
+            C.write("    ARRAY_SIZE(CanIf_RxGroups_%s),\n" % (network["name"]))
+        else:
+            C.write("    NULL,\n")
+            C.write("    0,\n")
+        if get_rx_hash(network, groups) != None:
+            C.write("    CanIf_RxHash_%s,\n" % (network["name"]))
+            C.write("    ARRAY_SIZE(CanIf_RxHash_%s),\n" % (network["name"]))
+        else:
+            C.write("    NULL,\n")
+            C.write("    0,\n")
         C.write("    #ifdef CANIF_USE_TX_TIMEOUT\n")
         C.write("    CANIF_CONVERT_MS_TO_MAIN_CYCLES(%s),\n" % (network.get("TxTimeout", 100)))
         C.write("    #endif\n")
@@ -26,6 +26,9 @@ def Gen_CanTp(cfg, dir):
         H.write("#endif\n")
     H.write("\n\n")
     H.write("%s#define CANTP_USE_TX_CONFIRMATION\n\n" % ("" if cfg.get("UseTxConfirmation", True) else "// "))
+    if cfg.get("HighRate", False):
+        H.write("#define CANTP_USE_HIGH_RATE\n")
+        H.write("#define CANTP_CF_BURST_MAX %s\n\n" % (cfg.get("CfBurst", 8)))
     if "zero_cost" in cfg:
         H.write("#define PDUR_%s_LINTP_ZERO_COST\n\n" % (cfg["zero_cost"].upper()))
     H.write("/* #define CANTP_USE_STD_TIMER */\n\n")
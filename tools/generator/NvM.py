@@ -206,9 +206,21 @@ def Gen_Fee(cfg, dir):
     if maxSize < 128:
         maxSize = 128
     maxSize = int((maxSize+31)/32)*32
+    # with checkpoint, the checkpoint data is a 12 bytes header, the address of each block and the
+    # CRC, and the bank admin grows with the FEE_CHECKPOINT_NUM references of the FEE_PAGE_SIZE, so
+    # the 3 bank admins are taken by sizeof(Fee_BankAdminType) of the build
+    numOfBlocks = sum([block.get('repeat', 1) for block in cfg['blocks']])
+    cpSize = max(maxSize, 12 + 4*numOfBlocks + 4)
+    cpSize = int((cpSize+31)/32)*32
     C.write('#ifndef FEE_WORKING_AREA_SIZE\n')
+    C.write('#ifdef FEE_USE_CHECKPOINT\n')
+    C.write('#define FEE_WORKING_AREA_SIZE \\\n')
+    C.write('  (((3 * sizeof(Fee_BankAdminType)) > %s) ? (3 * sizeof(Fee_BankAdminType)) : %s)\n' %
+            (cpSize, cpSize))
+    C.write('#else\n')
     C.write('#define FEE_WORKING_AREA_SIZE %s\n' % (maxSize))
     C.write('#endif\n')
+    C.write('#endif\n')
     C.write(
         '/* ================================ [ TYPES     ] ============================================== */\n')
     C.write(
@@ -64,8 +64,11 @@ def Gen_Os(cfg, dir):
     for hn1, hn2 in [('ErrorHook', 'ERROR_HOOK'), ('StartupHook', 'STARTUP_HOOK'),
                      ('ShutdownHook', 'SHUTDOWN_HOOK'), ('PreTaskHook', 'PRETASK_HOOK'),
                      ('PostTaskHook', 'POSTTASK_HOOK')]:
-        if cfg.get(hn1, False):
+        if cfg.get(hn1, False) or (cfg.get('TaskStat', False) and 'TaskHook' in hn1):
             H.write('#define OS_USE_%s\n' % (hn2))
+    if cfg.get('TaskStat', False):
+        # the statistics is collected by the generated PreTaskHook and PostTaskHook
+        H.write('#define OS_USE_TASK_STAT\n')
     if cfg.get('PTHREAD', 0) > 0:
         H.write('#define USE_PTHREAD\n')
     H.write('#define OS_PTHREAD_NUM %s\n' % (cfg.get('PTHREAD', 0)))
@@ -491,6 +494,17 @@ def Gen_Os(cfg, dir):
             C.write('  ISR_ADDR(%s), /* %s */\n' % (iname, iid))
         C.write('};\n\n')
         C.write('#ifdef __HIWARE__\n#pragma DATA_SEG DEFAULT\n#endif\n')
+        C.write('#ifdef OS_USE_TASK_STAT\n')
+        C.write('const char *const tisr_name[ %s ] = {\n' % (isr_num))
+        for iid in range(isr_num):
+            iname = 'default_isr_handle'
+            for isr in isr_list:
+                if (iid == isr['Vector']):
+                    iname = isr['name']
+                    break
+            C.write('  "%s",\n' % (iname))
+        C.write('};\n')
+        C.write('#endif\n')
     C.write('#ifdef USE_TRACE\n')
     C.write('static const Std_TraceEventType lOsTraceTask_B[] = {\n')
     idles = []
@@ -512,28 +526,49 @@ def Gen_Os(cfg, dir):
         '/* ================================ [ LOCALS    ] ============================================== */\n')
     C.write(
         '/* ================================ [ FUNCTIONS ] ============================================== */\n')
-    C.write('#ifdef USE_TRACE\n')
+    C.write('#if defined(USE_TRACE) || defined(OS_USE_TASK_STAT)\n')
     C.write('void PreTaskHook(void) {\n')
+    C.write('#ifdef USE_TRACE\n')
     C.write('  TaskType tid = 0;\n')
     C.write('  Std_TraceEventType ev;\n')
+    C.write('#endif\n')
+    C.write('#ifdef OS_USE_TASK_STAT\n')
+    C.write('  Os_StatPreTask();\n')
+    C.write('#endif\n')
+    C.write('#ifdef USE_TRACE\n')
     C.write('  GetTaskID(&tid);\n')
     if len(idles) > 0:
         C.write('  if ( %s ) { return; }\n' %
                 (' || '.join(['(TASK_ID_%s == tid)' % (task) for task in idles])))
     C.write('  ev = lOsTraceTask_B[tid];\n')
     C.write('  STD_TRACE_OS2(ev);\n')
+    C.write('#endif\n')
     C.write('}\n')
 
     C.write('void PostTaskHook(void) {\n')
+    C.write('#ifdef USE_TRACE\n')
     C.write('  TaskType tid = 0;\n')
     C.write('  Std_TraceEventType ev;\n')
+    C.write('#endif\n')
+    C.write('#ifdef OS_USE_TASK_STAT\n')
+    C.write('  Os_StatPostTask();\n')
+    C.write('#endif\n')
+    C.write('#ifdef USE_TRACE\n')
     C.write('  GetTaskID(&tid);\n')
     if len(idles) > 0:
         C.write('  if ( %s ) { return; }\n' %
                 (' || '.join(['(TASK_ID_%s == tid)' % (task) for task in idles])))
     C.write('  ev = lOsTraceTask_E[tid];\n')
     C.write('  STD_TRACE_OS2(ev);\n')
+    C.write('#endif\n')
     C.write('}\n')
+    C.write('#endif\n')
+    C.write('#ifdef USE_TRACE\n')
+    if CPU_CORE_NUMBER > 1:
+        C.write('/* one trace ring per core */\n')
+        C.write('uint32_t Std_TraceGetContext(void) {\n')
+        C.write('  return (uint32_t)smp_processor_id();\n')
+        C.write('}\n')
     C.write('#endif\n\n')
     C.close()
 
@@ -568,7 +603,7 @@ def fromOIL(pdir, cfg):
 def extract_trace(cfg, dir):
     from .Trace import Gen as TraceGen
     cfg_ = {'class': 'Trace', 'area': 'OS', 'size': cfg.get(
-        'trace_size', 1024), 'durations': [], 'events': []}
+        'trace_size', 1024), 'contexts': cfg.get('CPU_CORE_NUMBER', 1), 'durations': [], 'events': []}
     for tsk in cfg.get('TaskList', []):
         cfg_['durations'].append(tsk['name'])
         for ev in tsk.get('EventList', []):
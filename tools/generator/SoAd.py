@@ -57,6 +57,15 @@ def Gen_SoAd(cfg, dir):
         elif 'client' in sock:
             H.write('#define SOAD_TX_PID_%s %s\n' % (mn, ID))
             ID += 1
+    for sock in cfg['sockets']:
+        mn = toMacro(sock['name'])
+        for pdu in sock.get('PduHeader', {}).get('tx', []):
+            H.write('#define SOAD_TX_PID_%s_%s %s\n' % (mn, toMacro(pdu['name']), ID))
+            ID += 1
+    if any('PduHeader' in sock for sock in cfg['sockets']):
+        H.write('\n#define SOAD_MAIN_FUNCTION_PERIOD 10\n')
+        H.write('#define SOAD_CONVERT_MS_TO_MAIN_CYCLES(x) \\\n')
+        H.write('  ((x + SOAD_MAIN_FUNCTION_PERIOD - 1) / SOAD_MAIN_FUNCTION_PERIOD)\n')
     H.write(
         '/* ================================ [ TYPES     ] ============================================== */\n')
     H.write(
@@ -95,8 +104,21 @@ def Gen_SoAd(cfg, dir):
         '/* ================================ [ TYPES     ] ============================================== */\n')
     C.write(
         '/* ================================ [ DECLARES  ] ============================================== */\n')
+    for sock in cfg['sockets']:
+        if sock['up'] == 'If':
+            C.write('void %s(PduIdType RxPduId, const PduInfoType *PduInfoPtr);\n' % (sock['RxIndication']))
+            if 'TxConfirmation' in sock:
+                C.write('void %s(PduIdType TxPduId, Std_ReturnType result);\n' % (sock['TxConfirmation']))
     C.write(
         '/* ================================ [ DATAS     ] ============================================== */\n')
+    for sock in cfg['sockets']:
+        if sock['up'] == 'If':
+            C.write('static const SoAd_IfInterfaceType SoAd_%s_IF = {\n' % (toMacro(sock['name'])))
+            C.write('  %s,\n' % (sock['RxIndication']))
+            C.write('  NULL,\n')
+            C.write('  %s,\n' % (sock.get('TxConfirmation', 'NULL')))
+            C.write('};\n\n')
+
     if any(sock['up'] == 'DoIP' for sock in cfg['sockets']):
         C.write('static const SoAd_IfInterfaceType SoAd_DoIP_IF = {\n')
         C.write('  DoIP_SoAdIfRxIndication,\n')
@@ -166,6 +188,46 @@ def Gen_SoAd(cfg, dir):
     C.write(
         'static SoAd_SocketContextType SoAd_SocketContexts[ARRAY_SIZE(SoAd_SocketConnections)];\n\n')
 
+    for sock in cfg['sockets']:
+        if 'PduHeader' not in sock:
+            continue
+        if sock['protocol'] != 'UDP':
+            raise Exception('PDU header mode is for UDP only: %s' % (sock['name']))
+        mn = toMacro(sock['name'])
+        header = sock['PduHeader']
+        rxRoutes = header.get('rx', [])
+        if len(rxRoutes) > 0:
+            C.write('static const SoAd_SocketRouteType SoAd_RxRoutes_%s[] = {\n' % (mn))
+            for route in rxRoutes:
+                C.write('  {0x%X, %s},\n' % (route['id'], route['RxPduId']))
+            C.write('};\n\n')
+        txBufferSize = header.get('TxBufferSize', 1400)
+        C.write('static uint8_t SoAd_TxBuffer_%s[%s];\n\n' % (mn, txBufferSize))
+        # by default as many as the smallest PDUs that fill one datagram
+        txPdus = header.get('TxPdus', max(1, txBufferSize // 8))
+        C.write('static SoAd_PduHeaderTxType SoAd_TxPdus_%s[%s];\n\n' % (mn, txPdus))
+        C.write('static const SoAd_PduHeaderType SoAd_PduHeader_%s = {\n' % (mn))
+        if len(rxRoutes) > 0:
+            C.write('  SoAd_RxRoutes_%s,\n' % (mn))
+            C.write('  ARRAY_SIZE(SoAd_RxRoutes_%s),\n' % (mn))
+        else:
+            C.write('  NULL,\n')
+            C.write('  0,\n')
+        C.write('  SoAd_TxBuffer_%s,\n' % (mn))
+        C.write('  sizeof(SoAd_TxBuffer_%s),\n' % (mn))
+        C.write('  SOAD_CONVERT_MS_TO_MAIN_CYCLES(%s),\n' % (header.get('TxTimeout', 0)))
+        C.write('  SoAd_TxPdus_%s,\n' % (mn))
+        C.write('  ARRAY_SIZE(SoAd_TxPdus_%s),\n' % (mn))
+        C.write('};\n\n')
+
+    # the ring is SOAD_RX_RING_SIZE * SOAD_RX_SLOT_SIZE bytes of RAM per UDP socket, so it is only
+    # taken by the configs that opt in, mostly the hosts
+    numOfRxRings = 0
+    if cfg.get('RxRing', False):
+        numOfRxRings = len([sock for sock in cfg['sockets'] if sock['protocol'] == 'UDP'])
+    if numOfRxRings > 0:
+        C.write('static SoAd_RxRingType SoAd_RxRings[%s];\n\n' % (numOfRxRings))
+
     C.write(
         'static const SoAd_SocketConnectionGroupType SoAd_SocketConnectionGroups[] = {\n')
     for GID, sock in enumerate(cfg['sockets']):
@@ -202,6 +264,9 @@ def Gen_SoAd(cfg, dir):
         elif sock['up'] == 'UdpNm':
             SoConModeChgNotification = 'NULL'
             IF = 'SoAd_UdpNm_IF'
+        elif sock['up'] == 'If':  # a user module on the SoAd IF API, e.g. a PDU logger
+            SoConModeChgNotification = 'NULL'
+            IF = 'SoAd_%s_IF' % (mn)
         else:
             raise
         if 'ModeChg' in sock:
@@ -236,6 +301,10 @@ def Gen_SoAd(cfg, dir):
         C.write('    %s, /* AutomaticSoConSetup */\n'%(AutomaticSoConSetup))
         C.write('    %s, /* IsTP */\n' % (IsTP))
         C.write('    %s, /* IsMulitcast */\n' % (multicast))
+        if 'PduHeader' in sock:
+            C.write('    &SoAd_PduHeader_%s, /* PduHeader */\n' % (mn))
+        else:
+            C.write('    NULL, /* PduHeader */\n')
         C.write('  },\n')
     C.write('};\n\n')
 
@@ -249,15 +318,46 @@ def Gen_SoAd(cfg, dir):
                 C.write('  SOAD_SOCKID_%s_APT%s, /* SOAD_TX_PID_%s_APT%s */\n' % (mn, i, mn, i))
         else:
             C.write('  SOAD_SOCKID_%s, /* SOAD_TX_PID_%s */\n' % (mn, mn))
+    for sock in cfg['sockets']:
+        mn = toMacro(sock['name'])
+        for pdu in sock.get('PduHeader', {}).get('tx', []):
+            C.write('  SOAD_SOCKID_%s, /* SOAD_TX_PID_%s_%s */\n' % (mn, mn, toMacro(pdu['name'])))
     C.write('};\n\n')
+    if any('PduHeader' in sock for sock in cfg['sockets']):
+        C.write('static const uint32_t TxPduHeaderIds[] = {\n')
+        for sock in cfg['sockets']:
+            mn = toMacro(sock['name'])
+            id = sock.get('PduHeader', {}).get('id', 0)
+            if sock['protocol'] == 'UDP':
+                C.write('  0x%X, /* SOAD_TX_PID_%s */\n' % (id, mn))
+            elif 'server' in sock:
+                for i in range(sock['listen']):
+                    C.write('  0x%X, /* SOAD_TX_PID_%s_APT%s */\n' % (id, mn, i))
+            else:
+                C.write('  0x%X, /* SOAD_TX_PID_%s */\n' % (id, mn))
+        for sock in cfg['sockets']:
+            mn = toMacro(sock['name'])
+            for pdu in sock.get('PduHeader', {}).get('tx', []):
+                C.write('  0x%X, /* SOAD_TX_PID_%s_%s */\n' % (pdu['id'], mn, toMacro(pdu['name'])))
+        C.write('};\n\n')
     C.write('const SoAd_ConfigType SoAd_Config = {\n')
     C.write('  SoAd_SocketConnections,\n')
     C.write('  SoAd_SocketContexts,\n')
     C.write('  ARRAY_SIZE(SoAd_SocketConnections),\n')
     C.write('  TxPduIdToSoCondIdMap,\n')
+    if any('PduHeader' in sock for sock in cfg['sockets']):
+        C.write('  TxPduHeaderIds,\n')
+    else:
+        C.write('  NULL,\n')
     C.write('  ARRAY_SIZE(TxPduIdToSoCondIdMap),\n')
     C.write('  SoAd_SocketConnectionGroups,\n')
     C.write('  ARRAY_SIZE(SoAd_SocketConnectionGroups),\n')
+    if numOfRxRings > 0:
+        C.write('  SoAd_RxRings,\n')
+        C.write('  ARRAY_SIZE(SoAd_RxRings),\n')
+    else:
+        C.write('  NULL,\n')
+        C.write('  0,\n')
     C.write('};\n')
     C.write(
         '/* ================================ [ LOCALS    ] ============================================== */\n')
@@ -68,19 +68,43 @@ def Gen_Trace(cfg, dir):
     C.write("/* ================================ [ MACROS    ] ============================================== */\n")
     C.write("/* ================================ [ TYPES     ] ============================================== */\n")
     C.write("/* ================================ [ DECLARES  ] ============================================== */\n")
+    # the per context ring, size rounded up to a power of 2
+    size = 1
+    while size < cfg.get("size", 1024):
+        size = size << 1
+    C.write("#ifndef TRE_%s_CONTEXTS\n" % (area.upper()))
+    C.write("#define TRE_%s_CONTEXTS %s\n" % (area.upper(), cfg.get("contexts", 1)))
+    C.write("#endif\n")
+    C.write("#define TRE_%s_SIZE %s\n" % (area.upper(), size))
     C.write("/* ================================ [ DATAS     ] ============================================== */\n")
-    C.write("RB_DECLARE(TraceArea%s, Std_TraceEventType, %s);\n" % (area, cfg.get("size", 1024)))
+    C.write(
+        "static Std_TraceEventType lTraceBuffer_%s[TRE_%s_CONTEXTS * TRE_%s_SIZE];\n" % (area, area.upper(), area.upper())
+    )
+    C.write("static Std_TraceRingType lTraceRings_%s[TRE_%s_CONTEXTS];\n" % (area, area.upper()))
+    C.write("static Std_TraceAreaVarType lTraceVar_%s;\n" % (area))
     C.write("const Std_TraceAreaType Std_TraceArea_%s = {\n" % (area.upper()))
-    C.write("  &rb_TraceArea%s,\n" % (area))
+    C.write("  lTraceBuffer_%s,\n" % (area))
+    C.write("  lTraceRings_%s,\n" % (area))
+    C.write("  &lTraceVar_%s,\n" % (area))
+    C.write("  TRE_%s_SIZE,\n" % (area.upper()))
+    C.write("  %s,\n" % (hex((1 << (32 - nBits)) - 1)))
+    C.write("  TRE_%s_CONTEXTS,\n" % (area.upper()))
     C.write("};\n\n")
     C.write("/* ================================ [ LOCALS    ] ============================================== */\n")
     C.write("/* ================================ [ FUNCTIONS ] ============================================== */\n")
     C.write("#ifdef USE_SHELL\n")
     C.write("static int Shell_Trace%s(int argc, const char *argv[]) {\n" % (area))
-    C.write("  Std_TraceDump(&Std_TraceArea_%s);\n" % (area.upper()))
+    C.write('  if ((2 == argc) && (0 == strcmp(argv[1], "stat"))) {\n')
+    C.write("    Std_TraceStat(&Std_TraceArea_%s);\n" % (area.upper()))
+    C.write("  } else {\n")
+    C.write("    Std_TraceDump(&Std_TraceArea_%s);\n" % (area.upper()))
+    C.write("  }\n")
     C.write("  return 0;\n")
     C.write("}\n")
-    C.write('SHELL_REGISTER(trace_%s, "trace_%s\\n", Shell_Trace%s)\n' % (area.lower(), area.lower(), area))
+    C.write(
+        'SHELL_REGISTER(trace_%s, "trace_%s [stat]\\n  dump the trace or show the drop counters\\n", Shell_Trace%s)\n'
+        % (area.lower(), area.lower(), area)
+    )
     C.write("#endif\n")
     C.close()
 
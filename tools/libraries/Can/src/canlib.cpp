@@ -14,6 +14,7 @@
 #include "Std_Timer.h"
 #include "Std_Topic.h"
 #include "Log.hpp"
+#include "AsyncLog.hpp"
 
 using namespace as;
 /* ================================ [ MACROS    ] ============================================== */
@@ -101,6 +102,7 @@ static const Can_DeviceOpsType *canOps[] = {
   NULL,
 };
 static Logger *s_Logger = nullptr;
+static AsyncLogger *s_AsyncLogger = nullptr;
 static bool bPerfMode = false;
 /* ================================ [ LOCALS    ] ============================================== */
 static void freeQ(struct Can_PduQueue_s *l) {
@@ -358,7 +360,13 @@ static void logCan(boolean isRx, int busid, uint32_t canid, uint8_t dlc, const u
 
   STD_TOPIC_CAN(busid, isRx, canid, dlc, data);
 
-  if (NULL != s_Logger) {
+  if (NULL != s_AsyncLogger) {
+    /* only the raw frame is captured here, formatting is done by the writer thread */
+    ALOG_X(s_AsyncLogger, INFO,
+           "busid=%d %s canid=%08X dlc=%d data=[%H] timestamp=%" PRIu64 "\n", busid,
+           isRx ? "rx" : "tx", canid & (~CAN_ID_EXTENDED), dlc,
+           AsyncLogger::Bytes(data, (dlc < 8) ? 8 : dlc), timestamp);
+  } else if (NULL != s_Logger) {
     Std_GetDateTime(ts, sizeof(ts));
     std::lock_guard<std::recursive_mutex> lg(canbusH.q_lock);
     s_Logger->print("busid=%d %s canid=%08X dlc=%d data=[", busid, isRx ? "rx" : "tx",
@@ -394,7 +402,17 @@ public:
       canbusH.busidMask = 0;
       STAILQ_INIT(&canbusH.head);
       char *logName = getenv("CAN_LOG_NAME");
-      if (logName != NULL) {
+      char *logAsync = getenv("CAN_LOG_ASYNC"); /* "txt" or "bin" */
+      if ((logName != NULL) && (logAsync != NULL)) {
+        s_AsyncLogger = new AsyncLogger(logName, (std::string("bin") == logAsync)
+                                                   ? AsyncLogger::BINARY
+                                                   : AsyncLogger::TEXT);
+        char *logRate = getenv("CAN_LOG_RATE"); /* maximum frames per second */
+        if (logRate != NULL) {
+          s_AsyncLogger->setRateLimit(Logger::INFO, atoi(logRate), 100);
+        }
+        ASLOG(INFO, ("can trace async logger < %s > %s\n", logName, logAsync));
+      } else if (logName != NULL) {
         s_Logger = new Logger(logName);
         if (NULL != s_Logger) {
           Std_GetDateTime(ts, sizeof(ts));
@@ -423,6 +441,14 @@ public:
       if (NULL != s_Logger) {
         delete s_Logger;
       }
+
+      if (NULL != s_AsyncLogger) {
+        AsyncLogStats st = s_AsyncLogger->stats();
+        ASLOG(INFO, ("can trace async logger: %" PRIu64 " frames, %" PRIu64 " dropped, %" PRIu64
+                     " rate limited\n",
+                     st.records, st.ringDrops, st.rateDrops[Logger::INFO]));
+        delete s_AsyncLogger;
+      }
     }
   }
 };
@@ -451,6 +477,9 @@ int can_open(const char *device_name, uint32_t port, uint32_t baudrate) {
       if (s_Logger) {
         s_Logger->print("reopen %s:%d baudrate=%d, busid %d\n", b->device.device_name.c_str(),
                         b->device.port, b->device.baudrate, b->device.busid);
+      } else if (s_AsyncLogger) {
+        ALOG_X(s_AsyncLogger, INFO, "reopen %s:%d baudrate=%d, busid %d\n", b->device.device_name,
+               b->device.port, b->device.baudrate, b->device.busid);
       }
     } else {
       ASLOG(ERROR, ("can_open: device <%s:%d> already opened with baudrate %d!, can't reopen with "
@@ -484,6 +513,9 @@ int can_open(const char *device_name, uint32_t port, uint32_t baudrate) {
         if (s_Logger) {
           s_Logger->print("open %s:%d baudrate=%d as busid %d\n", b->device.device_name.c_str(),
                           b->device.port, b->device.baudrate, b->device.busid);
+        } else if (s_AsyncLogger) {
+          ALOG_X(s_AsyncLogger, INFO, "open %s:%d baudrate=%d as busid %d\n",
+                 b->device.device_name, b->device.port, b->device.baudrate, b->device.busid);
         }
       } else {
         if (NULL != b) {
@@ -15,6 +15,7 @@
 extern void Can_ReConfig(uint8_t Controller, const char *device, int port, uint32_t baudrate);
 /* ================================ [ DATAS     ] ============================================== */
 static CanIf_RxPduType CanIf_RxPdus[CANTP_MAX_CHANNELS][CANIF_MAX_RX_PDU];
+static CanIf_RxGroupType CanIf_RxGroups[CANTP_MAX_CHANNELS];
 static CanIf_TxPduType CanIf_TxPdus[CANTP_MAX_CHANNELS];
 static CanIf_CtrlContextType CanIf_CtrlContexts[CANTP_MAX_CHANNELS];
 static CanIf_CtrlConfigType CanIf_CtrlConfigs[CANTP_MAX_CHANNELS];
@@ -36,6 +37,12 @@ INITIALIZER(_isotp_canif_init) {
     for (j = 0; j < CANIF_MAX_RX_PDU; j++) {
       CanIf_RxPdus[i][j].mask = 0xFFFFFFFF;
     }
+    /* only the first one is used, see CanIf_CanTpReconfig */
+    CanIf_RxGroups[i].mask = CANIF_RX_FULL_MASK;
+    CanIf_RxGroups[i].start = 0;
+    CanIf_RxGroups[i].numOfRxPdus = 1;
+    CanIf_CtrlConfigs[i].rxGroups = &CanIf_RxGroups[i];
+    CanIf_CtrlConfigs[i].numOfRxGroups = 1;
   }
 }
 /* ================================ [ FUNCTIONS ] ============================================== */
@@ -15,6 +15,10 @@ extern "C" {
   ((x + CANTP_MAIN_FUNCTION_PERIOD - 1) / CANTP_MAIN_FUNCTION_PERIOD)
 
 // #define CANTP_USE_STD_TIMER
+
+/* the server thread runs the fast main function in a busy loop, so the CFs are sent back to back
+ * and the FC is answered without waiting for the 10 ms main function */
+#define CANTP_USE_HIGH_RATE
 /* ================================ [ TYPES     ] ============================================== */
 typedef struct {
   const char *device;
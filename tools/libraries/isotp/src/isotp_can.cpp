@@ -58,6 +58,7 @@ static void can_server_main(isotp_t *isotp) {
 
   Std_TimerSet(&timer10ms, 10000);
   Std_TimerStop(&isotp->timerErrorNotify);
+  Std_TimerStop(&isotp->timerSTmin);
 
   if (E_OK == ret) {
     isotp->result = 0;
@@ -83,6 +84,10 @@ static void can_server_main(isotp_t *isotp) {
 
     {
       std::lock_guard<std::mutex> lg(isotp->mutex);
+      if (Std_IsTimerStarted(&isotp->timerSTmin) && Std_IsTimerTimeout(&isotp->timerSTmin)) {
+        Std_TimerStop(&isotp->timerSTmin);
+        CanTp_STminExpired(Channel);
+      }
       CanTp_MainFunction_ChannelFast(Channel);
       if (Std_IsTimerStarted(&isotp->timerErrorNotify)) {
         if (Std_GetTimerElapsedTime(&isotp->timerErrorNotify) >= isotp->errorTimeout) {
@@ -269,6 +274,17 @@ void isotp_can_destory(isotp_t *isotp) {
   }
 }
 
+/* the STmin is kept by the server thread, which is always busy looping */
+extern "C" Std_ReturnType CanTp_PortStartTimer(PduIdType TxPduId, uint32_t us) {
+  Std_ReturnType ret = E_NOT_OK;
+  isotp_t *isotp = isotp_get(TxPduId);
+  if (NULL != isotp) {
+    Std_TimerSet(&isotp->timerSTmin, us);
+    ret = E_OK;
+  }
+  return ret;
+}
+
 extern "C" BufReq_ReturnType IsoTp_CanTpStartOfReception(PduIdType id, const PduInfoType *info,
                                                          PduLengthType TpSduLength,
                                                          PduLengthType *bufferSizePtr) {
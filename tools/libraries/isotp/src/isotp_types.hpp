@@ -19,10 +19,15 @@
 using namespace as;
 using namespace std::literals::chrono_literals;
 /* ================================ [ MACROS    ] ============================================== */
+/* big enough for the CAN-FD FF_DL escape sequence, which is above 4095 */
+#ifndef ISOTP_RX_BUFFER_SIZE
+#define ISOTP_RX_BUFFER_SIZE 65536
+#endif
 /* ================================ [ TYPES     ] ============================================== */
 struct isotp_s {
   uint8_t Channel;
   Std_TimerType timerErrorNotify;
+  Std_TimerType timerSTmin; /* the port timer of the CanTp */
   volatile uint32_t errorTimeout;
   struct {
     uint8_t *data;
@@ -31,7 +36,7 @@ struct isotp_s {
   } TX;
 
   struct {
-    uint8_t data[4096];
+    uint8_t data[ISOTP_RX_BUFFER_SIZE];
     size_t length;
     size_t index;
     boolean bInUse;
@@ -0,0 +1,191 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2026 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <stdio.h>
+#include <isotp.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "Std_Types.h"
+#include "Std_Timer.h"
+/* ================================ [ MACROS    ] ============================================== */
+#define ISOTP_PERF_MAX_SIZE 65535
+/* ================================ [ TYPES     ] ============================================== */
+typedef struct {
+  uint32_t received;
+  uint32_t errors;
+} IsoTpPerf_RxType;
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+static uint8_t lTxData[ISOTP_PERF_MAX_SIZE];
+static uint8_t lRxData[ISOTP_PERF_MAX_SIZE];
+/* ================================ [ LOCALS    ] ============================================== */
+static void usage(char *prog) {
+  printf("usage: %s -d device -p port -l LL_DL -s size -n count -S STmin\n"
+         "\tsend count messages of size from 0x731 to 0x732 over the device, which is received on\n"
+         "\tthe same bus by a child process, and report the throughput. device is\n"
+         "\t\"simulator_v2\" by default, STmin is the raw byte of the FC, 0xF1-0xF9 for 100-900 us\n",
+         prog);
+}
+
+static uint32_t toU32(const char *strV) {
+  return (uint32_t)strtoul(strV, NULL, 0);
+}
+
+/* the CAN device drops the frames sent by itself, so the receiver runs in another process, it
+ * reports back by the pipe: one byte once ready and then the result */
+static int receiver_main(isotp_parameter_t *params, uint32_t size, uint32_t count, int fd) {
+  IsoTpPerf_RxType rx;
+  isotp_t *isotp;
+  uint32_t i;
+  int r;
+
+  memset(&rx, 0, sizeof(rx));
+  params->U.CAN.RxCanId = 0x731;
+  params->U.CAN.TxCanId = 0x732;
+  isotp = isotp_create(params);
+  if (NULL == isotp) {
+    printf("failed to open %s:%d\n", params->device, params->port);
+    return -2;
+  }
+
+  (void)write(fd, "R", 1);
+  for (i = 0; i < count; i++) {
+    r = isotp_receive(isotp, lRxData, sizeof(lRxData));
+    if ((r == (int)size) && (0 == memcmp(lRxData, lTxData, size))) {
+      rx.received++;
+    } else {
+      printf("RX %u failed: %d\n", i, r);
+      rx.errors++;
+      if (r < 0) {
+        break;
+      }
+    }
+  }
+  (void)write(fd, &rx, sizeof(rx));
+  isotp_destory(isotp);
+
+  return 0;
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+int main(int argc, char *argv[]) {
+  int ch;
+  char *device = "simulator_v2";
+  int port = 0;
+  uint32_t ll_dl = 8;
+  uint32_t size = 4095;
+  uint32_t count = 10;
+  uint32_t STmin = 0;
+  isotp_parameter_t params;
+  isotp_t *tx = NULL;
+  IsoTpPerf_RxType rx;
+  int fds[2];
+  pid_t pid;
+  char ready = 0;
+  std_time_t start, elapsed;
+  uint32_t i;
+  int r = 0;
+
+  opterr = 0;
+  while ((ch = getopt(argc, argv, "d:l:n:p:s:S:h")) != -1) {
+    switch (ch) {
+    case 'd':
+      device = optarg;
+      break;
+    case 'l':
+      ll_dl = toU32(optarg);
+      break;
+    case 'n':
+      count = toU32(optarg);
+      break;
+    case 'p':
+      port = atoi(optarg);
+      break;
+    case 's':
+      size = toU32(optarg);
+      break;
+    case 'S':
+      STmin = toU32(optarg);
+      break;
+    case 'h':
+    default:
+      usage(argv[0]);
+      return 0;
+    }
+  }
+
+  if ((0 == size) || (size > ISOTP_PERF_MAX_SIZE) || (0 == count) || (STmin > 0xFF)) {
+    usage(argv[0]);
+    return -1;
+  }
+
+  for (i = 0; i < size; i++) {
+    lTxData[i] = (uint8_t)(i * 7 + (i >> 8));
+  }
+
+  memset(&params, 0, sizeof(params));
+  strncpy(params.device, device, sizeof(params.device) - 1);
+  params.port = port;
+  params.baudrate = 500000;
+  params.protocol = ISOTP_OVER_CAN;
+  params.ll_dl = ll_dl;
+  params.N_TA = 0xFFFF;
+  params.U.CAN.BlockSize = 8;
+  params.U.CAN.STmin = (uint8_t)STmin;
+
+  if (0 != pipe(fds)) {
+    printf("failed to create pipe\n");
+    return -1;
+  }
+
+  pid = fork();
+  if (0 == pid) {
+    close(fds[0]);
+    return receiver_main(&params, size, count, fds[1]);
+  }
+  close(fds[1]);
+
+  memset(&rx, 0, sizeof(rx));
+  params.U.CAN.RxCanId = 0x732;
+  params.U.CAN.TxCanId = 0x731;
+  tx = isotp_create(&params);
+
+  if ((pid < 0) || (NULL == tx) || (1 != read(fds[0], &ready, 1))) {
+    printf("failed to open %s:%d\n", device, port);
+    r = -2;
+  } else {
+    start = Std_GetTime();
+    for (i = 0; i < count; i++) {
+      r = isotp_transmit(tx, lTxData, size, NULL, 0);
+      if (r < 0) {
+        printf("TX %u failed: %d\n", i, r);
+        break;
+      }
+    }
+    if (sizeof(rx) != read(fds[0], &rx, sizeof(rx))) {
+      printf("receiver is dead\n");
+    }
+    elapsed = Std_GetTime() - start;
+
+    printf("LL_DL %u, STmin 0x%02X: %u/%u messages of %u bytes in %u ms, %.1f KB/s\n", ll_dl,
+           STmin, rx.received, count, size, (uint32_t)(elapsed / 1000),
+           (elapsed > 0) ? ((double)rx.received * size * 1000000.0 / 1024.0 / (double)elapsed)
+                         : 0.0);
+    if ((rx.received != count) && (0 == r)) {
+      r = -3;
+    }
+  }
+
+  if (NULL != tx) {
+    isotp_destory(tx);
+  }
+  if (pid > 0) {
+    waitpid(pid, NULL, 0);
+  }
+  close(fds[0]);
+
+  return (r < 0) ? r : 0;
+}
@@ -209,9 +209,16 @@ bool PyFee_Config(py::dict blocks, py::kwargs kwargs) {
   lDataPtr = new uint8_t[maxDataSize + 32];
 
   uint32_t workingAreaSize = maxDataSize + 32;
-  if (workingAreaSize < (bankSize * sizeof(Fee_BankAdminType))) {
-    workingAreaSize = bankSize * sizeof(Fee_BankAdminType);
+  /* the init reads the admin of all banks plus one working copy */
+  if (workingAreaSize < ((bankSize + 1) * sizeof(Fee_BankAdminType))) {
+    workingAreaSize = (bankSize + 1) * sizeof(Fee_BankAdminType);
   }
+#ifdef FEE_USE_CHECKPOINT
+  /* the checkpoint holds the address of all blocks */
+  if (workingAreaSize < (FEE_CHECKPOINT_SIZE(BlockNumber - 1) + 32)) {
+    workingAreaSize = FEE_CHECKPOINT_SIZE(BlockNumber - 1) + 32;
+  }
+#endif
   if (workingAreaSize < scratchSize) {
     workingAreaSize = scratchSize;
   }
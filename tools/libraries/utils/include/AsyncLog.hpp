@@ -0,0 +1,269 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2025 Parai Wang <parai@foxmail.com>
+ */
+#ifndef _ASYNC_LOG_HPP_
+#define _ASYNC_LOG_HPP_
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <string>
+#include <vector>
+#include <set>
+#include <type_traits>
+#include <algorithm>
+#include "Log.hpp"
+#include "PAL.h"
+
+namespace as {
+/* ================================ [ MACROS    ] ============================================== */
+/* The format string is registered once per call site, the hot path only copies the format id,
+ * a timestamp and the raw arguments into the per-thread ring of the logger. Besides the printf
+ * conversions, "%H" prints an AsyncLogger::Bytes argument as hex "XX,XX,...". */
+#define ALOG_X(logger, level, fmt, ...)                                                            \
+  do {                                                                                             \
+    static const uint16_t __fmtId = as::AsyncLogger::addFormat(#level ": " fmt);                   \
+    (logger)->log(as::Logger::level, __fmtId, ##__VA_ARGS__);                                      \
+  } while (0)
+
+#ifndef ASYNC_LOG_RING_SIZE
+#define ASYNC_LOG_RING_SIZE (256 * 1024)
+#endif
+
+#ifndef ASYNC_LOG_MAX_ARG_SIZE
+#define ASYNC_LOG_MAX_ARG_SIZE 256
+#endif
+/* ================================ [ TYPES     ] ============================================== */
+struct AsyncLogStats {
+  uint64_t records = 0;
+  uint64_t ringDrops = 0;    /* dropped as the ring of the thread was full */
+  uint64_t rateDrops[4] = {}; /* dropped by the per level rate limit */
+  uint32_t rings = 0;        /* number of threads that have logged */
+};
+
+class AsyncLogger {
+public:
+  enum Format {
+    TEXT,
+    BINARY
+  };
+
+  enum ArgType : uint8_t {
+    ARG_I32 = 1,
+    ARG_U32,
+    ARG_I64,
+    ARG_U64,
+    ARG_F64,
+    ARG_STR,
+    ARG_BYTES,
+    ARG_PTR
+  };
+
+  struct Bytes {
+    Bytes(const void *data, size_t size) : data(data), size(size) {
+    }
+    const void *data;
+    size_t size;
+  };
+
+  /* the record layout of both the ring and the binary log file, all little endian */
+  struct RecordHeader {
+    uint32_t size; /* total size including this header, 8 bytes aligned */
+    uint16_t fmtId;
+    uint8_t level;
+    uint8_t nArgs;
+    uint64_t timestamp; /* us since epoch */
+  };
+
+  static constexpr uint16_t FMT_ID_WRAP = 0xFFFF;   /* ring only: skip to the ring start */
+  static constexpr uint8_t LEVEL_FORMAT_DEF = 0xFF; /* file only: payload is the format string */
+
+  class Ring;
+
+public:
+  AsyncLogger(std::string name, Format format = TEXT, size_t ringSize = ASYNC_LOG_RING_SIZE);
+  ~AsyncLogger();
+
+  void setLogLevel(int level);
+  int getLogLevel();
+
+  /* at most perSecond records of this level, with bursts of up to burst records,
+   * perSecond 0 means no limit */
+  void setRateLimit(int level, uint32_t perSecond, uint32_t burst = 1);
+
+  AsyncLogStats stats();
+
+  /* block until everything logged so far is written out */
+  void flush();
+
+  template <typename... Args> void log(int level, uint16_t fmtId, const Args &...args) {
+    if ((level >= m_Level) && rateAllow(level)) {
+      size_t size = sizeof(RecordHeader) + argsSize(args...);
+      size = (size + 7) & ~(size_t)7;
+      Ring *ring = nullptr;
+      uint8_t *p = reserve(ring, size);
+      if (nullptr != p) {
+        RecordHeader *hdr = (RecordHeader *)p;
+        hdr->size = (uint32_t)size;
+        hdr->fmtId = fmtId;
+        hdr->level = (uint8_t)level;
+        hdr->nArgs = (uint8_t)sizeof...(args);
+        hdr->timestamp = PAL_Timestamp();
+        putArgs(p + sizeof(RecordHeader), args...);
+        commit(ring, size);
+      }
+    }
+  }
+
+public:
+  static uint16_t addFormat(const char *fmt);
+  static std::string getFormat(uint16_t fmtId);
+  /* render the arguments of a record with its format, used by the writer in TEXT mode */
+  static void format(std::string &out, const RecordHeader *hdr, const std::string &fmt);
+
+private:
+  static size_t argSize(const char *v) {
+    size_t len = (nullptr != v) ? strlen(v) : 0;
+    return 3 + std::min(len, (size_t)ASYNC_LOG_MAX_ARG_SIZE);
+  }
+  static size_t argSize(char *v) {
+    return argSize((const char *)v);
+  }
+  static size_t argSize(const std::string &v) {
+    return 3 + std::min(v.size(), (size_t)ASYNC_LOG_MAX_ARG_SIZE);
+  }
+  static size_t argSize(const Bytes &v) {
+    return 3 + std::min(v.size, (size_t)ASYNC_LOG_MAX_ARG_SIZE);
+  }
+  static size_t argSize(const void *) {
+    return 1 + 8;
+  }
+  template <typename T>
+  static typename std::enable_if<std::is_arithmetic<T>::value, size_t>::type argSize(T) {
+    return (sizeof(T) > 4 || std::is_floating_point<T>::value) ? 9 : 5;
+  }
+
+  static size_t argsSize() {
+    return 0;
+  }
+  template <typename T, typename... Args>
+  static size_t argsSize(const T &v, const Args &...args) {
+    return argSize(v) + argsSize(args...);
+  }
+
+  static uint8_t *putRaw(uint8_t *p, uint8_t type, const void *data, size_t size) {
+    *p++ = type;
+    memcpy(p, data, size);
+    return p + size;
+  }
+  static uint8_t *putVar(uint8_t *p, uint8_t type, const void *data, size_t size) {
+    uint16_t len = (uint16_t)std::min(size, (size_t)ASYNC_LOG_MAX_ARG_SIZE);
+    p = putRaw(p, type, &len, sizeof(len));
+    memcpy(p, data, len);
+    return p + len;
+  }
+  static uint8_t *putArg(uint8_t *p, const char *v) {
+    return putVar(p, ARG_STR, (nullptr != v) ? v : "", (nullptr != v) ? strlen(v) : 0);
+  }
+  static uint8_t *putArg(uint8_t *p, char *v) {
+    return putArg(p, (const char *)v);
+  }
+  static uint8_t *putArg(uint8_t *p, const std::string &v) {
+    return putVar(p, ARG_STR, v.data(), v.size());
+  }
+  static uint8_t *putArg(uint8_t *p, const Bytes &v) {
+    return putVar(p, ARG_BYTES, v.data, v.size);
+  }
+  static uint8_t *putArg(uint8_t *p, const void *v) {
+    uint64_t u64 = (uint64_t)(uintptr_t)v;
+    return putRaw(p, ARG_PTR, &u64, sizeof(u64));
+  }
+  template <typename T>
+  static typename std::enable_if<std::is_arithmetic<T>::value, uint8_t *>::type putArg(uint8_t *p,
+                                                                                       T v) {
+    if (std::is_floating_point<T>::value) {
+      double f64 = (double)v;
+      p = putRaw(p, ARG_F64, &f64, sizeof(f64));
+    } else if (sizeof(T) > 4) {
+      if (std::is_signed<T>::value) {
+        int64_t i64 = (int64_t)v;
+        p = putRaw(p, ARG_I64, &i64, sizeof(i64));
+      } else {
+        uint64_t u64 = (uint64_t)v;
+        p = putRaw(p, ARG_U64, &u64, sizeof(u64));
+      }
+    } else {
+      if (std::is_signed<T>::value) {
+        int32_t i32 = (int32_t)v;
+        p = putRaw(p, ARG_I32, &i32, sizeof(i32));
+      } else {
+        uint32_t u32 = (uint32_t)v;
+        p = putRaw(p, ARG_U32, &u32, sizeof(u32));
+      }
+    }
+    return p;
+  }
+
+  static void putArgs(uint8_t *) {
+  }
+  template <typename T, typename... Args>
+  static void putArgs(uint8_t *p, const T &v, const Args &...args) {
+    putArgs(putArg(p, v), args...);
+  }
+
+  bool rateAllow(int level);
+  uint8_t *reserve(Ring *&ring, size_t size);
+  void commit(Ring *ring, size_t size);
+  Ring *getRing();
+  void writer();
+  size_t drain();
+  void emit(const RecordHeader *hdr);
+  void writeFormatDef(uint16_t fmtId);
+  void writeOut();
+
+private:
+  std::string m_Name;
+  Format m_Format;
+  size_t m_RingSize;
+  uint32_t m_Id;
+  std::atomic<int> m_Level{Logger::INFO};
+
+  /* GCRA: theoretical arrival time and emission interval per level, in us */
+  std::atomic<uint64_t> m_Tat[4];
+  std::atomic<uint64_t> m_Interval[4];
+  std::atomic<uint64_t> m_Tolerance[4];
+  std::atomic<uint64_t> m_RateDrops[4];
+  std::atomic<uint64_t> m_RingDrops{0};
+  std::atomic<uint64_t> m_Records{0};
+
+  std::mutex m_RingsLock;
+  std::vector<std::shared_ptr<Ring>> m_Rings;
+
+  Logger m_Sink;
+  std::string m_Batch;
+  std::set<uint16_t> m_WrittenFormats;
+  std::vector<std::string> m_FormatCache;
+
+  std::mutex m_Lock;
+  std::condition_variable m_CondVar;
+  std::atomic<bool> m_Stop{false};
+  std::atomic<uint32_t> m_FlushReq{0};
+  std::atomic<uint32_t> m_FlushAck{0};
+  std::thread m_Thread;
+
+private:
+  static std::atomic<uint32_t> s_NextId;
+  static std::mutex s_FormatsLock;
+  static std::vector<std::string> s_Formats;
+};
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+} /* namespace as */
+#endif /* _ASYNC_LOG_HPP_ */
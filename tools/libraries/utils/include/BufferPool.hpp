@@ -11,60 +11,134 @@
 #include <atomic>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <mutex>
+#include <chrono>
+#include <condition_variable>
 
 namespace as {
 /* ================================ [ MACROS    ] ============================================== */
 /* ================================ [ TYPES     ] ============================================== */
+struct BufferPoolStats {
+  size_t inUse = 0;
+  size_t peakInUse = 0;
+  uint64_t gets = 0;
+  uint64_t waits = 0;       /* number of get that had to wait for a release */
+  uint64_t exhaustions = 0; /* number of get that found no free buffer */
+};
+
+/* Each size class keeps its free buffers in a lock-free stack, so get and release are O(1) and
+ * never take a lock, the mutex is only used to sleep when a blocking get found no free buffer. */
 class BufferPool {
-  struct BufferInfo {
-    Buffer *buffer = nullptr;
-    bool busy = false;
+public:
+  struct SizeClass {
+    size_t size;
+    size_t num;
+  };
+
+private:
+  /* Treiber stack of buffer indexes, the head carries a tag which is bumped on every change so
+   * that a stale head can't be swapped in (ABA) */
+  struct Class {
+    Class(size_t size, size_t num) : size(size), next(new std::atomic<uint32_t>[num]) {
+      head.store(EOL, std::memory_order_relaxed);
+    }
+
+    void push(uint32_t idx) {
+      uint64_t old = head.load(std::memory_order_relaxed);
+      uint64_t val;
+      do {
+        next[idx].store((uint32_t)old, std::memory_order_relaxed);
+        val = (((old >> 32) + 1) << 32) | idx;
+      } while (false == head.compare_exchange_weak(old, val, std::memory_order_release,
+                                                   std::memory_order_relaxed));
+    }
+
+    bool pop(uint32_t &idx) {
+      bool ret = false;
+      uint64_t old = head.load(std::memory_order_acquire);
+      uint64_t val;
+      while ((false == ret) && (EOL != (uint32_t)old)) {
+        idx = (uint32_t)old;
+        val = (((old >> 32) + 1) << 32) | next[idx].load(std::memory_order_relaxed);
+        ret = head.compare_exchange_weak(old, val, std::memory_order_acquire,
+                                         std::memory_order_acquire);
+      }
+      return ret;
+    }
+
+    static constexpr uint32_t EOL = UINT32_MAX;
+    size_t size;
+    std::vector<Buffer *> buffers;
+    std::atomic<uint64_t> head;
+    std::unique_ptr<std::atomic<uint32_t>[]> next;
   };
 
 public:
   BufferPool() {
   }
   ~BufferPool() {
-    for (size_t i = 0; i < m_BufferInfos.size(); i++) {
-      BufferInfo &bufferInfo = m_BufferInfos[i];
-      if (nullptr != bufferInfo.buffer) {
-        delete bufferInfo.buffer;
+    for (auto &cls : m_Classes) {
+      for (auto buffer : cls->buffers) {
+        delete buffer;
       }
     }
   }
 
   bool create(std::string name, size_t num, size_t size) {
+    return create(name, {{size, num}});
+  }
+
+  /* the size classes are sorted by size, a get falls back to a bigger class when the best fit
+   * one is exhausted */
+  bool create(std::string name, std::vector<SizeClass> sizeClasses) {
     bool ret = true;
     m_Name = name;
-    m_BufferInfos.resize(num);
-    m_Size = size;
-
-    for (size_t i = 0; (i < num) && (true == ret); i++) {
-      BufferInfo &bufferInfo = m_BufferInfos[i];
-      Buffer *buffer = new Buffer(size, i);
-      if ((nullptr == buffer) || (nullptr == buffer->data)) {
-        LOG(ERROR, "%s: OoM for buffer pool\n", m_Name.c_str());
-        ret = false;
-      } else {
-        bufferInfo.buffer = buffer;
+
+    std::sort(sizeClasses.begin(), sizeClasses.end(),
+              [](const SizeClass &a, const SizeClass &b) { return a.size < b.size; });
+    for (size_t i = 0; (i < sizeClasses.size()) && (true == ret); i++) {
+      std::unique_ptr<Class> cls(new Class(sizeClasses[i].size, sizeClasses[i].num));
+      for (size_t j = 0; (j < sizeClasses[i].num) && (true == ret); j++) {
+        Buffer *buffer = new Buffer(sizeClasses[i].size, j);
+        if ((nullptr == buffer) || (nullptr == buffer->data)) {
+          LOG(ERROR, "%s: OoM for buffer pool\n", m_Name.c_str());
+          delete buffer;
+          ret = false;
+        } else {
+          cls->buffers.push_back(buffer);
+          cls->push((uint32_t)j);
+        }
       }
+      m_Classes.push_back(std::move(cls));
     }
 
     return ret;
   }
 
   std::shared_ptr<Buffer> get() {
-    std::shared_ptr<Buffer> buffer = nullptr;
-    std::unique_lock<std::mutex> lck(m_Lock);
-    for (auto &bufferInfo : m_BufferInfos) {
-      if (false == bufferInfo.busy) {
-        bufferInfo.busy = true;
-        buffer = std::shared_ptr<Buffer>(bufferInfo.buffer, [&](Buffer *buffer) {
-          deleter(buffer);
-        });
-        buffer->size = m_Size;
-        break;
+    return get(0, 0);
+  }
+
+  /* get a buffer with at least size bytes, wait up to timeoutMs if all are busy */
+  std::shared_ptr<Buffer> get(size_t size, uint32_t timeoutMs = 0) {
+    std::shared_ptr<Buffer> buffer = tryGet(size);
+    m_Gets++;
+    if (nullptr == buffer) {
+      m_Exhaustions++;
+      if (0 != timeoutMs) {
+        m_Waits++;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        std::unique_lock<std::mutex> lck(m_Lock);
+        m_Waiters++;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while ((nullptr == (buffer = tryGet(size))) &&
+               (std::cv_status::timeout != m_CondVar.wait_until(lck, deadline))) {
+        }
+        if (nullptr == buffer) {
+          buffer = tryGet(size);
+        }
+        m_Waiters--;
       }
     }
     if (nullptr == buffer) {
@@ -73,12 +147,46 @@ public:
     return buffer;
   }
 
+  BufferPoolStats stats() const {
+    BufferPoolStats st;
+    st.inUse = m_InUse.load();
+    st.peakInUse = m_PeakInUse.load();
+    st.gets = m_Gets.load();
+    st.waits = m_Waits.load();
+    st.exhaustions = m_Exhaustions.load();
+    return st;
+  }
+
 private:
-  void deleter(Buffer *buffer) {
+  std::shared_ptr<Buffer> tryGet(size_t size) {
+    std::shared_ptr<Buffer> buffer = nullptr;
+    Buffer *b = nullptr;
+    uint32_t idx;
+    for (auto it = m_Classes.begin(); (it != m_Classes.end()) && (nullptr == b); it++) {
+      Class *cls = it->get();
+      if ((cls->size >= size) && cls->pop(idx)) {
+        b = cls->buffers[idx];
+        b->size = cls->size;
+        buffer = std::shared_ptr<Buffer>(b, [this, cls](Buffer *buffer) { release(cls, buffer); });
+        size_t inUse = ++m_InUse;
+        size_t peak = m_PeakInUse.load(std::memory_order_relaxed);
+        while ((inUse > peak) && (false == m_PeakInUse.compare_exchange_weak(peak, inUse))) {
+        }
+      }
+    }
+    return buffer;
+  }
+
+  void release(Class *cls, Buffer *buffer) {
     if (nullptr != buffer) {
-      if (buffer->idx < m_BufferInfos.size()) {
-        auto &bufferInfo = m_BufferInfos[buffer->idx];
-        bufferInfo.busy = false;
+      if (buffer->idx < cls->buffers.size()) {
+        cls->push((uint32_t)buffer->idx);
+        m_InUse--;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_Waiters.load() > 0) {
+          std::unique_lock<std::mutex> lck(m_Lock);
+          m_CondVar.notify_all(); /* waiters may want different sizes */
+        }
       } else {
         LOG(ERROR, "%s: index over flow\n", m_Name.c_str());
       }
@@ -89,9 +197,15 @@ private:
 
 private:
   std::string m_Name;
-  std::vector<BufferInfo> m_BufferInfos;
-  size_t m_Size;
+  std::vector<std::unique_ptr<Class>> m_Classes;
   std::mutex m_Lock;
+  std::condition_variable m_CondVar;
+  std::atomic<uint32_t> m_Waiters{0};
+  std::atomic<size_t> m_InUse{0};
+  std::atomic<size_t> m_PeakInUse{0};
+  std::atomic<uint64_t> m_Gets{0};
+  std::atomic<uint64_t> m_Waits{0};
+  std::atomic<uint64_t> m_Exhaustions{0};
 };
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
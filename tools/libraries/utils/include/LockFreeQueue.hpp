@@ -0,0 +1,151 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2025 Parai Wang <parai@foxmail.com>
+ */
+#ifndef _LOCK_FREE_QUEUE_HPP_
+#define _LOCK_FREE_QUEUE_HPP_
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace as {
+/* ================================ [ MACROS    ] ============================================== */
+#ifndef LOCK_FREE_QUEUE_CACHE_LINE_SIZE
+#define LOCK_FREE_QUEUE_CACHE_LINE_SIZE 64
+#endif
+/* ================================ [ TYPES     ] ============================================== */
+/* Bounded multi-producer multi-consumer queue, each cell carries a sequence number that tells
+ * whether it is ready for the next producer or the next consumer, so push and pop are a single
+ * CAS on the enqueue or dequeue position, no lock is involved.
+ * The capacity is rounded up to a power of 2. A push may transiently see the queue as full
+ * while a pop of the same cell is still in progress. */
+template <typename T> class LockFreeQueue {
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T data;
+  };
+
+public:
+  LockFreeQueue(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+      size = size << 1;
+    }
+    m_Mask = size - 1;
+    m_Cells.reset(new Cell[size]);
+    for (size_t i = 0; i < size; i++) {
+      m_Cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_EnqueuePos.store(0, std::memory_order_relaxed);
+    m_DequeuePos.store(0, std::memory_order_relaxed);
+  }
+
+  ~LockFreeQueue() {
+  }
+
+  LockFreeQueue(const LockFreeQueue &) = delete;
+  LockFreeQueue &operator=(const LockFreeQueue &) = delete;
+
+  bool push(T &&data) {
+    bool ret = false;
+    Cell *cell = nullptr;
+    size_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+    bool done = false;
+
+    while (false == done) {
+      cell = &m_Cells[pos & m_Mask];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+      if (0 == diff) {
+        if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          ret = true;
+          done = true;
+        }
+      } else if (diff < 0) {
+        done = true; /* full */
+      } else {
+        pos = m_EnqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+
+    if (ret) {
+      cell->data = std::move(data);
+      cell->sequence.store(pos + 1, std::memory_order_release);
+    }
+
+    return ret;
+  }
+
+  bool push(const T &data) {
+    T copy = data;
+    return push(std::move(copy));
+  }
+
+  bool pop(T &out) {
+    bool ret = false;
+    Cell *cell = nullptr;
+    size_t pos = m_DequeuePos.load(std::memory_order_relaxed);
+    bool done = false;
+
+    while (false == done) {
+      cell = &m_Cells[pos & m_Mask];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (0 == diff) {
+        if (m_DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          ret = true;
+          done = true;
+        }
+      } else if (diff < 0) {
+        done = true; /* empty */
+      } else {
+        pos = m_DequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+
+    if (ret) {
+      out = std::move(cell->data);
+      cell->data = T();
+      cell->sequence.store(pos + m_Mask + 1, std::memory_order_release);
+    }
+
+    return ret;
+  }
+
+  /* a snapshot, may be stale as soon as it returns */
+  size_t size() const {
+    size_t enq = m_EnqueuePos.load(std::memory_order_acquire);
+    size_t deq = m_DequeuePos.load(std::memory_order_acquire);
+    size_t sz = 0;
+    if (enq > deq) {
+      sz = enq - deq;
+    }
+    return sz;
+  }
+
+  bool empty() const {
+    return 0 == size();
+  }
+
+  size_t capacity() const {
+    return m_Mask + 1;
+  }
+
+private:
+  std::unique_ptr<Cell[]> m_Cells;
+  size_t m_Mask;
+  /* keep producers and consumers on different cache lines */
+  char m_Pad0[LOCK_FREE_QUEUE_CACHE_LINE_SIZE];
+  std::atomic<size_t> m_EnqueuePos;
+  char m_Pad1[LOCK_FREE_QUEUE_CACHE_LINE_SIZE];
+  std::atomic<size_t> m_DequeuePos;
+};
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+/* ================================ [ LOCALS    ] ============================================== */
+/* ================================ [ FUNCTIONS ] ============================================== */
+} /* namespace as */
+#endif /* _LOCK_FREE_QUEUE_HPP_ */
@@ -13,11 +13,30 @@
 #include <chrono>
 #include <string>
 #include <vector>
+#include <deque>
+#include <atomic>
 #include "Log.hpp"
+#include "LockFreeQueue.hpp"
 
 namespace as {
 /* ================================ [ MACROS    ] ============================================== */
 /* ================================ [ TYPES     ] ============================================== */
+enum class OverflowPolicy {
+  DROP_OLDEST, /* the oldest message is discarded to make room for the new one */
+  DROP_NEWEST, /* the new message is discarded */
+  BLOCK        /* the publisher waits for room, up to the block timeout */
+};
+
+struct MessageQueueStats {
+  size_t depth = 0;
+  size_t maxDepth = 0;
+  size_t capacity = 0;
+  uint64_t puts = 0;
+  uint64_t gets = 0;
+  uint64_t drops = 0;
+  uint64_t blocks = 0; /* number of times the publisher had to wait for room */
+};
+
 template <typename T> class MessageQueue {
 public:
   MessageQueue(std::string name, uint32_t capability = 0) : m_Name(name), m_Capability(capability) {
@@ -106,23 +125,255 @@ private:
   static std::map<std::string, std::shared_ptr<MessageQueue<T>>> s_MsgQueueMap;
 };
 
+/* Subscriber queue of immutable messages shared by all subscribers of a broker, the message is
+ * only referenced, never copied, on the publish path. With a capability it is a bounded
+ * lock-free queue and the mutex and condition variables are only taken on the slow path when a
+ * reader or writer has to wait. With the capability 0 it is unbounded as the MessageQueue, a
+ * deque under a lock, and the overflow policy is never applied. */
+template <typename T> class MessageRing {
+public:
+  using Message = std::shared_ptr<const T>;
+
+  MessageRing(std::string name, uint32_t capability = 0,
+              OverflowPolicy policy = OverflowPolicy::DROP_OLDEST, uint32_t blockTimeoutMs = 1000)
+    : m_Name(name), m_Policy(policy), m_BlockTimeoutMs(blockTimeoutMs) {
+    if (capability > 0) {
+      m_Queue = std::unique_ptr<LockFreeQueue<Message>>(new LockFreeQueue<Message>(capability));
+    }
+    LOG(DEBUG, "%s: MessageRing created with capability %d\n", m_Name.c_str(), (int)capacity());
+  }
+  ~MessageRing() {
+  }
+
+  /* return false if the message was dropped */
+  bool put(const Message &msg) {
+    bool ret = push(msg);
+    if (false == ret) {
+      switch (m_Policy) {
+      case OverflowPolicy::DROP_OLDEST:
+        ret = putDropOldest(msg);
+        break;
+      case OverflowPolicy::BLOCK:
+        ret = putBlock(msg);
+        break;
+      default:
+        break;
+      }
+    }
+
+    if (ret) {
+      m_Puts++;
+      updateMaxDepth();
+      notify(m_ReaderLock, m_NotEmpty, m_ReaderWaiters);
+    } else {
+      m_Drops++;
+    }
+
+    return ret;
+  }
+
+  bool get(Message &out, bool FIFO = true, uint32_t timeoutMs = 1000) {
+    bool ret = pop(out, FIFO);
+    if ((false == ret) && (0 != timeoutMs)) {
+      auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+      std::unique_lock<std::mutex> lck(m_ReaderLock);
+      m_ReaderWaiters++;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      while ((false == (ret = pop(out, FIFO))) &&
+             (std::cv_status::timeout != m_NotEmpty.wait_until(lck, deadline))) {
+      }
+      if (false == ret) {
+        ret = pop(out, FIFO);
+      }
+      m_ReaderWaiters--;
+      if (false == ret) {
+        LOG(DEBUG, "%s: MessageRing timeout\n", m_Name.c_str());
+      }
+    }
+
+    return ret;
+  }
+
+  size_t size(void) const {
+    size_t sz;
+    if (nullptr != m_Queue) {
+      sz = m_Queue->size();
+    } else {
+      std::unique_lock<std::mutex> lck(m_UnboundedLock);
+      sz = m_Unbounded.size();
+    }
+    return sz;
+  }
+
+  /* 0 if unbounded */
+  size_t capacity(void) const {
+    return (nullptr != m_Queue) ? m_Queue->capacity() : 0;
+  }
+
+  void clear() {
+    Message msg;
+    while (pop(msg)) {
+    }
+    notify(m_WriterLock, m_NotFull, m_WriterWaiters);
+  }
+
+  MessageQueueStats stats(void) const {
+    MessageQueueStats st;
+    st.depth = size();
+    st.maxDepth = m_MaxDepth.load();
+    st.capacity = capacity();
+    st.puts = m_Puts.load();
+    st.gets = m_Gets.load();
+    st.drops = m_Drops.load();
+    st.blocks = m_Blocks.load();
+    return st;
+  }
+
+  const std::string &name(void) const {
+    return m_Name;
+  }
+
+private:
+  bool push(const Message &msg) {
+    bool ret = true;
+    if (nullptr != m_Queue) {
+      ret = m_Queue->push(msg);
+    } else {
+      std::unique_lock<std::mutex> lck(m_UnboundedLock);
+      m_Unbounded.push_back(msg);
+    }
+    return ret;
+  }
+
+  bool pop(Message &out) {
+    bool ret = false;
+    if (nullptr != m_Queue) {
+      ret = m_Queue->pop(out);
+    } else {
+      std::unique_lock<std::mutex> lck(m_UnboundedLock);
+      if (false == m_Unbounded.empty()) {
+        out = std::move(m_Unbounded.front());
+        m_Unbounded.pop_front();
+        ret = true;
+      }
+    }
+    return ret;
+  }
+
+  bool pop(Message &out, bool FIFO) {
+    bool ret = pop(out);
+    if (ret) {
+      m_Gets++;
+      if (false == FIFO) { /* only the latest one is wanted */
+        Message msg;
+        while (pop(msg)) {
+          out = std::move(msg);
+          m_Gets++;
+        }
+      }
+      notify(m_WriterLock, m_NotFull, m_WriterWaiters);
+    }
+    return ret;
+  }
+
+  bool putDropOldest(const Message &msg) {
+    bool ret = false;
+    Message oldest;
+    /* bounded retries as other publishers may race for the freed cell */
+    for (int i = 0; (i < 8) && (false == ret); i++) {
+      if (pop(oldest)) {
+        m_Drops++;
+      }
+      ret = push(msg);
+    }
+    return ret;
+  }
+
+  bool putBlock(const Message &msg) {
+    bool ret = false;
+    auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(m_BlockTimeoutMs);
+    m_Blocks++;
+    std::unique_lock<std::mutex> lck(m_WriterLock);
+    m_WriterWaiters++;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while ((false == (ret = push(msg))) &&
+           (std::cv_status::timeout != m_NotFull.wait_until(lck, deadline))) {
+    }
+    if (false == ret) {
+      ret = push(msg);
+    }
+    m_WriterWaiters--;
+    if (false == ret) {
+      LOG(WARN, "%s: MessageRing full, block timeout\n", m_Name.c_str());
+    }
+    return ret;
+  }
+
+  void notify(std::mutex &lock, std::condition_variable &cv, std::atomic<uint32_t> &waiters) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load() > 0) {
+      std::unique_lock<std::mutex> lck(lock);
+      cv.notify_all();
+    }
+  }
+
+  void updateMaxDepth(void) {
+    size_t depth = size();
+    size_t maxDepth = m_MaxDepth.load(std::memory_order_relaxed);
+    while ((depth > maxDepth) && (false == m_MaxDepth.compare_exchange_weak(maxDepth, depth))) {
+    }
+  }
+
+private:
+  std::string m_Name;
+  std::unique_ptr<LockFreeQueue<Message>> m_Queue; /* nullptr if unbounded */
+  mutable std::mutex m_UnboundedLock;
+  std::deque<Message> m_Unbounded;
+  OverflowPolicy m_Policy;
+  uint32_t m_BlockTimeoutMs;
+  std::mutex m_ReaderLock;
+  std::mutex m_WriterLock;
+  std::condition_variable m_NotEmpty;
+  std::condition_variable m_NotFull;
+  std::atomic<uint32_t> m_ReaderWaiters{0};
+  std::atomic<uint32_t> m_WriterWaiters{0};
+  std::atomic<size_t> m_MaxDepth{0};
+  std::atomic<uint64_t> m_Puts{0};
+  std::atomic<uint64_t> m_Gets{0};
+  std::atomic<uint64_t> m_Drops{0};
+  std::atomic<uint64_t> m_Blocks{0};
+};
+
 /* DDS like messgae publish & subscribe */
 template <typename T> class MessageBroker {
+  using SubscriberList = std::vector<std::shared_ptr<MessageRing<T>>>;
+
 public:
   MessageBroker(std::string topicName) : m_Name(topicName) {
+    m_Subscribers = std::make_shared<const SubscriberList>();
     LOG(DEBUG, "%s: MessageBroker created\n", m_Name.c_str());
   }
   ~MessageBroker() {
   }
 
-  std::shared_ptr<MessageQueue<T>> create_subscriber(std::string subscriberName,
-                                                     uint32_t capability = 0) {
-    std::shared_ptr<MessageQueue<T>> sub = nullptr;
+  std::shared_ptr<MessageRing<T>>
+  create_subscriber(std::string subscriberName, uint32_t capability = 0,
+                    OverflowPolicy policy = OverflowPolicy::DROP_OLDEST,
+                    uint32_t blockTimeoutMs = 1000) {
+    std::shared_ptr<MessageRing<T>> sub = nullptr;
+    bool exists = false;
     std::unique_lock<std::mutex> lck(m_Lock);
-    auto it = m_MsgQueueMap.find(subscriberName);
-    if (it == m_MsgQueueMap.end()) {
-      sub = std::make_shared<MessageQueue<T>>(subscriberName, capability);
-      m_MsgQueueMap[subscriberName] = sub;
+    for (auto &it : *m_Subscribers) {
+      if (it->name() == subscriberName) {
+        exists = true;
+      }
+    }
+    if (false == exists) {
+      sub = std::make_shared<MessageRing<T>>(subscriberName, capability, policy, blockTimeoutMs);
+      auto subs = std::make_shared<SubscriberList>(*m_Subscribers);
+      subs->push_back(sub);
+      m_Subscribers = subs;
       LOG(DEBUG, "%s: subscriber %s created\n", m_Name.c_str(), subscriberName.c_str());
     } else {
       LOG(ERROR, "%s: subscriber %s already exists\n", m_Name.c_str(), subscriberName.c_str());
@@ -132,23 +383,52 @@ public:
 
   void remove_subscriber(std::string subscriberName) {
     std::unique_lock<std::mutex> lck(m_Lock);
-    auto it = m_MsgQueueMap.find(subscriberName);
-    if (it != m_MsgQueueMap.end()) {
-      m_MsgQueueMap.erase(it);
+    auto subs = std::make_shared<SubscriberList>();
+    for (auto &it : *m_Subscribers) {
+      if (it->name() != subscriberName) {
+        subs->push_back(it);
+      }
     }
+    m_Subscribers = subs;
   }
 
+  /* the message is copied once into an immutable payload shared by all subscribers */
   void put(T &msg) {
-    std::unique_lock<std::mutex> lck(m_Lock);
-    for (auto it : m_MsgQueueMap) {
-      it.second->put(msg);
+    put(std::make_shared<const T>(msg));
+  }
+
+  void put(T &&msg) {
+    put(std::make_shared<const T>(std::move(msg)));
+  }
+
+  void put(const std::shared_ptr<const T> &msg) {
+    auto subs = subscribers();
+    for (auto &it : *subs) {
+      (void)it->put(msg);
     }
   }
 
+  std::map<std::string, MessageQueueStats> stats(void) {
+    std::map<std::string, MessageQueueStats> st;
+    auto subs = subscribers();
+    for (auto &it : *subs) {
+      st[it->name()] = it->stats();
+    }
+    return st;
+  }
+
+private:
+  /* the subscriber list is copy-on-write, the lock is only held to take a snapshot of it, the
+   * fan-out to the subscribers is done without holding it */
+  std::shared_ptr<const SubscriberList> subscribers(void) {
+    std::unique_lock<std::mutex> lck(m_Lock);
+    return m_Subscribers;
+  }
+
 private:
   std::string m_Name;
   std::mutex m_Lock;
-  std::map<std::string, std::shared_ptr<MessageQueue<T>>> m_MsgQueueMap;
+  std::shared_ptr<const SubscriberList> m_Subscribers;
 
 public:
   static std::shared_ptr<MessageBroker<T>> add(std::string name);
@@ -182,6 +462,10 @@ public:
     m_Broker->put(msg);
   }
 
+  void put(const std::shared_ptr<const T> &msg) {
+    m_Broker->put(msg);
+  }
+
 private:
   std::string m_Name;
   std::shared_ptr<MessageBroker<T>> m_Broker = nullptr;
@@ -198,14 +482,15 @@ public:
     }
   }
 
-  bool create(std::string topicName, uint32_t capability = 0) {
+  bool create(std::string topicName, uint32_t capability = 0,
+              OverflowPolicy policy = OverflowPolicy::DROP_OLDEST, uint32_t blockTimeoutMs = 1000) {
     bool ret = true;
 
     m_Broker = MessageBroker<T>::add(topicName);
     if (nullptr == m_Broker) {
       ret = false;
     } else {
-      m_Sub = m_Broker->create_subscriber(m_Name, capability);
+      m_Sub = m_Broker->create_subscriber(m_Name, capability, policy, blockTimeoutMs);
       if (nullptr == m_Sub) {
         ret = false;
       }
@@ -215,6 +500,19 @@ public:
   }
 
   bool get(T &out, bool FIFO = true, uint32_t timeoutMs = 1000) {
+    bool ret = false;
+    std::shared_ptr<const T> msg;
+
+    ret = get(msg, FIFO, timeoutMs);
+    if (ret) {
+      out = *msg;
+    }
+
+    return ret;
+  }
+
+  /* zero copy, the payload is shared with the other subscribers */
+  bool get(std::shared_ptr<const T> &out, bool FIFO = true, uint32_t timeoutMs = 1000) {
     bool ret = true;
 
     if (nullptr != m_Sub) {
@@ -226,10 +524,18 @@ public:
     return ret;
   }
 
+  MessageQueueStats stats(void) {
+    MessageQueueStats st;
+    if (nullptr != m_Sub) {
+      st = m_Sub->stats();
+    }
+    return st;
+  }
+
 private:
   std::string m_Name;
   std::shared_ptr<MessageBroker<T>> m_Broker = nullptr;
-  std::shared_ptr<MessageQueue<T>> m_Sub = nullptr;
+  std::shared_ptr<MessageRing<T>> m_Sub = nullptr;
 };
 /* ================================ [ DECLARES  ] ============================================== */
 /* ================================ [ DATAS     ] ============================================== */
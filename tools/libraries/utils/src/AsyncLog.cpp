@@ -0,0 +1,576 @@
+/**
+ * SSAS - Simple Smart Automotive Software
+ * Copyright (C) 2025 Parai Wang <parai@foxmail.com>
+ */
+/* ================================ [ INCLUDES  ] ============================================== */
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <chrono>
+
+#include "AsyncLog.hpp"
+namespace as {
+/* ================================ [ MACROS    ] ============================================== */
+#define ASYNC_LOG_BATCH_SIZE (64 * 1024)
+#define ASYNC_LOG_IDLE_MS 10
+
+#define ASYNC_LOG_MAGIC "ASLOGB01"
+/* ================================ [ TYPES     ] ============================================== */
+/* Single producer (the logging thread) single consumer (the writer thread) byte ring, a record
+ * never wraps, a wrap marker tells the consumer to continue from the ring start. */
+class AsyncLogger::Ring {
+public:
+  Ring(size_t size) {
+    size_t sz = 1024;
+    while (sz < size) {
+      sz = sz << 1;
+    }
+    m_Size = sz;
+    m_Buffer.reset(new uint64_t[sz / sizeof(uint64_t)]);
+  }
+
+  uint8_t *reserve(size_t size) {
+    uint8_t *p = nullptr;
+    uint64_t head = m_Head.load(std::memory_order_relaxed);
+    uint64_t tail = m_Tail.load(std::memory_order_acquire);
+    size_t idx = head & (m_Size - 1);
+    size_t contig = m_Size - idx;
+    size_t need = size;
+    if (contig < size) {
+      need += contig;
+    }
+    if ((m_Size - (head - tail)) >= need) {
+      if (contig < size) {
+        RecordHeader *hdr = (RecordHeader *)(buffer() + idx);
+        hdr->size = (uint32_t)contig;
+        hdr->fmtId = FMT_ID_WRAP;
+        m_Head.store(head + contig, std::memory_order_release);
+        idx = 0;
+      }
+      p = buffer() + idx;
+    }
+    return p;
+  }
+
+  void commit(size_t size) {
+    m_Head.store(m_Head.load(std::memory_order_relaxed) + size, std::memory_order_release);
+  }
+
+  const RecordHeader *peek() {
+    const RecordHeader *hdr = nullptr;
+    uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+    while ((nullptr == hdr) && (tail != m_Head.load(std::memory_order_acquire))) {
+      hdr = (const RecordHeader *)(buffer() + (tail & (m_Size - 1)));
+      if (FMT_ID_WRAP == hdr->fmtId) {
+        tail += hdr->size;
+        m_Tail.store(tail, std::memory_order_release);
+        hdr = nullptr;
+      }
+    }
+    return hdr;
+  }
+
+  void pop(const RecordHeader *hdr) {
+    m_Tail.store(m_Tail.load(std::memory_order_relaxed) + hdr->size, std::memory_order_release);
+  }
+
+  void close() {
+    m_Closed = true;
+  }
+
+  bool isClosed() {
+    return m_Closed;
+  }
+
+private:
+  uint8_t *buffer() {
+    return (uint8_t *)m_Buffer.get();
+  }
+
+private:
+  size_t m_Size;
+  std::unique_ptr<uint64_t[]> m_Buffer;
+  std::atomic<uint64_t> m_Head{0};
+  std::atomic<uint64_t> m_Tail{0};
+  std::atomic<bool> m_Closed{false};
+};
+
+struct ThreadRings {
+  ~ThreadRings() {
+    for (auto &it : rings) {
+      it.second->close();
+    }
+  }
+  std::vector<std::pair<uint32_t, std::shared_ptr<AsyncLogger::Ring>>> rings;
+};
+
+struct ArgValue {
+  uint8_t type = 0;
+  int64_t i = 0;
+  uint64_t u = 0;
+  double f = 0;
+  const uint8_t *data = nullptr;
+  uint16_t len = 0;
+};
+/* ================================ [ DECLARES  ] ============================================== */
+/* ================================ [ DATAS     ] ============================================== */
+std::atomic<uint32_t> AsyncLogger::s_NextId{0};
+std::mutex AsyncLogger::s_FormatsLock;
+std::vector<std::string> AsyncLogger::s_Formats;
+
+static thread_local ThreadRings t_Rings;
+/* ================================ [ LOCALS    ] ============================================== */
+static const uint8_t *get_arg(const uint8_t *p, const uint8_t *end, ArgValue &arg) {
+  const uint8_t *next = nullptr;
+  if (p < end) {
+    arg.type = *p++;
+    switch (arg.type) {
+    case AsyncLogger::ARG_I32:
+    case AsyncLogger::ARG_U32:
+      if ((p + 4) <= end) {
+        uint32_t u32;
+        memcpy(&u32, p, 4);
+        arg.u = u32;
+        arg.i = (AsyncLogger::ARG_I32 == arg.type) ? (int64_t)(int32_t)u32 : (int64_t)u32;
+        arg.f = (AsyncLogger::ARG_I32 == arg.type) ? (double)arg.i : (double)arg.u;
+        next = p + 4;
+      }
+      break;
+    case AsyncLogger::ARG_I64:
+    case AsyncLogger::ARG_U64:
+    case AsyncLogger::ARG_F64:
+    case AsyncLogger::ARG_PTR:
+      if ((p + 8) <= end) {
+        memcpy(&arg.u, p, 8);
+        if (AsyncLogger::ARG_F64 == arg.type) {
+          memcpy(&arg.f, p, 8);
+          arg.i = (int64_t)arg.f;
+          arg.u = (uint64_t)arg.i;
+        } else {
+          arg.i = (int64_t)arg.u;
+          arg.f = (AsyncLogger::ARG_I64 == arg.type) ? (double)arg.i : (double)arg.u;
+        }
+        next = p + 8;
+      }
+      break;
+    case AsyncLogger::ARG_STR:
+    case AsyncLogger::ARG_BYTES:
+      if ((p + 2) <= end) {
+        memcpy(&arg.len, p, 2);
+        arg.data = p + 2;
+        if ((arg.data + arg.len) <= end) {
+          next = arg.data + arg.len;
+        }
+      }
+      break;
+    default:
+      break;
+    }
+  }
+  return next;
+}
+
+static void append_format(std::string &out, const char *fmt, ...) {
+  char buf[512];
+  va_list args;
+  va_start(args, fmt);
+  int len = vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  if (len > 0) {
+    out.append(buf, std::min((size_t)len, sizeof(buf) - 1));
+  }
+}
+
+static void append_time(std::string &out, uint64_t timestamp) {
+  time_t t = (time_t)(timestamp / 1000000);
+  struct tm lt;
+#if defined(_WIN32)
+  localtime_s(&lt, &t);
+#else
+  localtime_r(&t, &lt);
+#endif
+  append_format(out, "%d-%02d-%02d %02d:%02d:%02d.%06u ", 1900 + lt.tm_year, lt.tm_mon + 1,
+                lt.tm_mday, lt.tm_hour, lt.tm_min, lt.tm_sec, (uint32_t)(timestamp % 1000000));
+}
+/* ================================ [ FUNCTIONS ] ============================================== */
+AsyncLogger::AsyncLogger(std::string name, Format format, size_t ringSize)
+  : m_Name(name), m_Format(format), m_RingSize(ringSize), m_Id(s_NextId++),
+    m_Sink(name, (TEXT == format) ? "txt" : "bin") {
+  for (int i = 0; i < 4; i++) {
+    m_Tat[i] = 0;
+    m_Interval[i] = 0;
+    m_Tolerance[i] = 0;
+    m_RateDrops[i] = 0;
+  }
+  m_Batch.reserve(ASYNC_LOG_BATCH_SIZE * 2);
+  if (BINARY == m_Format) {
+    m_Batch.append(ASYNC_LOG_MAGIC);
+  }
+  m_Thread = std::thread(&AsyncLogger::writer, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+  {
+    std::unique_lock<std::mutex> lck(m_Lock);
+    m_Stop = true;
+    m_CondVar.notify_all();
+  }
+  if (m_Thread.joinable()) {
+    m_Thread.join();
+  }
+}
+
+void AsyncLogger::setLogLevel(int level) {
+  m_Level = level;
+}
+
+int AsyncLogger::getLogLevel() {
+  return m_Level;
+}
+
+void AsyncLogger::setRateLimit(int level, uint32_t perSecond, uint32_t burst) {
+  if ((level >= 0) && (level < 4)) {
+    if (0 == perSecond) {
+      m_Interval[level] = 0;
+    } else {
+      uint64_t interval = 1000000 / perSecond;
+      if (0 == interval) {
+        interval = 1;
+      }
+      m_Tolerance[level] = interval * ((burst > 0) ? (burst - 1) : 0);
+      m_Interval[level] = interval;
+    }
+  }
+}
+
+AsyncLogStats AsyncLogger::stats() {
+  AsyncLogStats st;
+  st.records = m_Records.load();
+  st.ringDrops = m_RingDrops.load();
+  for (int i = 0; i < 4; i++) {
+    st.rateDrops[i] = m_RateDrops[i].load();
+  }
+  std::unique_lock<std::mutex> lck(m_RingsLock);
+  st.rings = (uint32_t)m_Rings.size();
+  return st;
+}
+
+void AsyncLogger::flush() {
+  std::unique_lock<std::mutex> lck(m_Lock);
+  uint32_t req = ++m_FlushReq;
+  m_CondVar.notify_all();
+  m_CondVar.wait(lck, [this, req]() { return ((int32_t)(m_FlushAck - req) >= 0) || m_Stop; });
+}
+
+bool AsyncLogger::rateAllow(int level) {
+  bool ret = true;
+  if ((level >= 0) && (level < 4)) {
+    uint64_t interval = m_Interval[level].load(std::memory_order_relaxed);
+    if (interval > 0) {
+      uint64_t now = PAL_Timestamp();
+      uint64_t tolerance = m_Tolerance[level].load(std::memory_order_relaxed);
+      uint64_t tat = m_Tat[level].load(std::memory_order_relaxed);
+      bool done = false;
+      while (false == done) {
+        uint64_t start = std::max(tat, now);
+        if ((start - now) > tolerance) {
+          m_RateDrops[level]++;
+          ret = false;
+          done = true;
+        } else {
+          done = m_Tat[level].compare_exchange_weak(tat, start + interval);
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+AsyncLogger::Ring *AsyncLogger::getRing() {
+  Ring *ring = nullptr;
+  for (auto &it : t_Rings.rings) {
+    if (it.first == m_Id) {
+      ring = it.second.get();
+      break;
+    }
+  }
+
+  if (nullptr == ring) {
+    auto r = std::make_shared<Ring>(m_RingSize);
+    t_Rings.rings.push_back({m_Id, r});
+    std::unique_lock<std::mutex> lck(m_RingsLock);
+    m_Rings.push_back(r);
+    ring = r.get();
+  }
+
+  return ring;
+}
+
+uint8_t *AsyncLogger::reserve(Ring *&ring, size_t size) {
+  uint8_t *p = nullptr;
+  ring = getRing();
+  p = ring->reserve(size);
+  if (nullptr == p) {
+    m_RingDrops++;
+  }
+  return p;
+}
+
+void AsyncLogger::commit(Ring *ring, size_t size) {
+  ring->commit(size);
+}
+
+uint16_t AsyncLogger::addFormat(const char *fmt) {
+  uint16_t fmtId = FMT_ID_WRAP - 1;
+  std::unique_lock<std::mutex> lck(s_FormatsLock);
+  if (s_Formats.size() < (FMT_ID_WRAP - 1)) {
+    fmtId = (uint16_t)s_Formats.size();
+    s_Formats.push_back(fmt);
+  } else {
+    LOG(ERROR, "async log: too much formats\n");
+  }
+  return fmtId;
+}
+
+std::string AsyncLogger::getFormat(uint16_t fmtId) {
+  std::string fmt;
+  std::unique_lock<std::mutex> lck(s_FormatsLock);
+  if (fmtId < s_Formats.size()) {
+    fmt = s_Formats[fmtId];
+  }
+  return fmt;
+}
+
+void AsyncLogger::format(std::string &out, const RecordHeader *hdr, const std::string &fmt) {
+  const uint8_t *p = (const uint8_t *)hdr + sizeof(RecordHeader);
+  const uint8_t *end = (const uint8_t *)hdr + hdr->size;
+  const char *f = fmt.c_str();
+  int nArgs = hdr->nArgs;
+  std::string spec;
+  ArgValue arg;
+
+  if (fmt.empty()) {
+    append_format(out, "<unknown format %u>\n", (uint32_t)hdr->fmtId);
+  }
+
+  while ('\0' != *f) {
+    if ('%' != *f) {
+      out.push_back(*f++);
+    } else if ('%' == f[1]) {
+      out.push_back('%');
+      f += 2;
+    } else {
+      spec = "%";
+      f++;
+      while (('\0' != *f) && (nullptr != strchr("-+ #0", *f))) {
+        spec.push_back(*f++);
+      }
+      while (isdigit(*f)) {
+        spec.push_back(*f++);
+      }
+      if ('.' == *f) {
+        spec.push_back(*f++);
+        while (isdigit(*f)) {
+          spec.push_back(*f++);
+        }
+      }
+      /* the length modifiers are replaced by the one of the recorded type */
+      while (('\0' != *f) && (nullptr != strchr("hljztLqI", *f))) {
+        if ('I' == *f) { /* MSVC I64 or I32 */
+          f++;
+          while (isdigit(*f)) {
+            f++;
+          }
+        } else {
+          f++;
+        }
+      }
+      char conv = *f;
+      if ('\0' != conv) {
+        f++;
+      }
+      if ((nArgs > 0) && (nullptr != (p = get_arg(p, end, arg)))) {
+        nArgs--;
+        switch (conv) {
+        case 'd':
+        case 'i':
+          append_format(out, (spec + "lld").c_str(), (long long)arg.i);
+          break;
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+          append_format(out, (spec + "ll" + conv).c_str(), (unsigned long long)arg.u);
+          break;
+        case 'c':
+          append_format(out, (spec + "c").c_str(), (int)arg.i);
+          break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+          append_format(out, (spec + conv).c_str(), arg.f);
+          break;
+        case 's':
+          if (AsyncLogger::ARG_STR == arg.type) {
+            append_format(out, (spec + "s").c_str(),
+                          std::string((const char *)arg.data, arg.len).c_str());
+          } else {
+            out.append("<?>");
+          }
+          break;
+        case 'p':
+          append_format(out, (spec + "p").c_str(), (void *)(uintptr_t)arg.u);
+          break;
+        case 'H':
+          if ((AsyncLogger::ARG_BYTES == arg.type) || (AsyncLogger::ARG_STR == arg.type)) {
+            for (uint16_t i = 0; i < arg.len; i++) {
+              append_format(out, "%02X,", arg.data[i]);
+            }
+          } else {
+            out.append("<?>");
+          }
+          break;
+        default:
+          out.append("<?>");
+          break;
+        }
+      } else {
+        out.append("<?>");
+        p = end;
+      }
+    }
+  }
+}
+
+void AsyncLogger::writeFormatDef(uint16_t fmtId) {
+  RecordHeader hdr;
+  if (fmtId >= m_FormatCache.size()) {
+    std::unique_lock<std::mutex> lck(s_FormatsLock);
+    m_FormatCache = s_Formats;
+  }
+  if (fmtId < m_FormatCache.size()) {
+    const std::string &fmt = m_FormatCache[fmtId];
+    size_t size = sizeof(RecordHeader) + fmt.size() + 1;
+    size = (size + 7) & ~(size_t)7;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.size = (uint32_t)size;
+    hdr.fmtId = fmtId;
+    hdr.level = LEVEL_FORMAT_DEF;
+    m_Batch.append((const char *)&hdr, sizeof(hdr));
+    m_Batch.append(fmt);
+    m_Batch.append(size - sizeof(RecordHeader) - fmt.size(), '\0');
+  }
+  m_WrittenFormats.insert(fmtId);
+}
+
+void AsyncLogger::emit(const RecordHeader *hdr) {
+  if (TEXT == m_Format) {
+    if (hdr->fmtId >= m_FormatCache.size()) {
+      std::unique_lock<std::mutex> lck(s_FormatsLock);
+      m_FormatCache = s_Formats;
+    }
+    append_time(m_Batch, hdr->timestamp);
+    if (hdr->fmtId < m_FormatCache.size()) {
+      format(m_Batch, hdr, m_FormatCache[hdr->fmtId]);
+    } else {
+      format(m_Batch, hdr, std::string());
+    }
+  } else {
+    if (m_WrittenFormats.end() == m_WrittenFormats.find(hdr->fmtId)) {
+      writeFormatDef(hdr->fmtId);
+    }
+    m_Batch.append((const char *)hdr, hdr->size);
+  }
+  m_Records++;
+}
+
+void AsyncLogger::writeOut() {
+  if (false == m_Batch.empty()) {
+    FILE *fp = m_Sink.getFile();
+    (void)fwrite(m_Batch.data(), 1, m_Batch.size(), fp);
+    m_Batch.clear();
+    m_Sink.check();
+    if (m_Sink.getFile() != fp) { /* rotated to a new file */
+      if (BINARY == m_Format) {
+        m_Batch.append(ASYNC_LOG_MAGIC);
+        m_WrittenFormats.clear();
+      }
+    }
+  }
+}
+
+size_t AsyncLogger::drain() {
+  size_t num = 0;
+  std::vector<std::shared_ptr<Ring>> rings;
+  {
+    std::unique_lock<std::mutex> lck(m_RingsLock);
+    for (auto it = m_Rings.begin(); it != m_Rings.end();) {
+      if ((*it)->isClosed() && (nullptr == (*it)->peek())) {
+        it = m_Rings.erase(it);
+      } else {
+        rings.push_back(*it);
+        it++;
+      }
+    }
+  }
+
+  /* merge the per thread rings in timestamp order */
+  bool done = false;
+  while (false == done) {
+    Ring *oldest = nullptr;
+    const RecordHeader *hdr = nullptr;
+    for (auto &ring : rings) {
+      const RecordHeader *h = ring->peek();
+      if ((nullptr != h) && ((nullptr == hdr) || (h->timestamp < hdr->timestamp))) {
+        hdr = h;
+        oldest = ring.get();
+      }
+    }
+    if (nullptr != hdr) {
+      emit(hdr);
+      oldest->pop(hdr);
+      num++;
+      if (m_Batch.size() >= ASYNC_LOG_BATCH_SIZE) {
+        writeOut();
+      }
+    } else {
+      done = true;
+    }
+  }
+
+  return num;
+}
+
+void AsyncLogger::writer() {
+  while (false == m_Stop) {
+    uint32_t req = m_FlushReq.load();
+    size_t num = drain();
+    if (0 == num) {
+      writeOut();
+      fflush(m_Sink.getFile());
+      std::unique_lock<std::mutex> lck(m_Lock);
+      if (m_FlushAck != req) {
+        m_FlushAck = req;
+        m_CondVar.notify_all();
+      }
+      m_CondVar.wait_for(lck, std::chrono::milliseconds(ASYNC_LOG_IDLE_MS),
+                         [this, req]() { return m_Stop || (m_FlushReq != req); });
+    }
+  }
+
+  (void)drain();
+  writeOut();
+  fflush(m_Sink.getFile());
+  std::unique_lock<std::mutex> lck(m_Lock);
+  m_FlushAck = m_FlushReq.load();
+  m_CondVar.notify_all();
+}
+} /* namespace as */
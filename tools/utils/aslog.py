@@ -0,0 +1,134 @@
+import os
+import re
+import sys
+import struct
+import time
+
+# decoder of the binary log written by the AsyncLogger of tools/libraries/utils (AsyncLog.cpp)
+
+MAGIC = b'ASLOGB01'
+HEADER = struct.Struct('<IHBBQ')
+LEVEL_FORMAT_DEF = 0xFF
+
+ARG_I32 = 1
+ARG_U32 = 2
+ARG_I64 = 3
+ARG_U64 = 4
+ARG_F64 = 5
+ARG_STR = 6
+ARG_BYTES = 7
+ARG_PTR = 8
+
+reSpec = re.compile(r'%([-+ #0]*)(\d*)(\.\d*)?(hh|h|ll|l|j|z|t|L|q|I64|I32)?([diuxXocfFeEgGaAspH%])')
+
+
+def get_args(raw, offset, end, nArgs):
+    args = []
+    for i in range(nArgs):
+        if offset >= end:
+            break
+        tp = raw[offset]
+        offset += 1
+        if tp in (ARG_I32, ARG_U32):
+            v, = struct.unpack_from('<i' if tp == ARG_I32 else '<I', raw, offset)
+            offset += 4
+        elif tp in (ARG_I64, ARG_U64, ARG_PTR):
+            v, = struct.unpack_from('<q' if tp == ARG_I64 else '<Q', raw, offset)
+            offset += 8
+        elif tp == ARG_F64:
+            v, = struct.unpack_from('<d', raw, offset)
+            offset += 8
+        elif tp in (ARG_STR, ARG_BYTES):
+            ln, = struct.unpack_from('<H', raw, offset)
+            offset += 2
+            v = raw[offset:offset+ln]
+            offset += ln
+            if tp == ARG_STR:
+                v = v.decode('utf-8', 'replace')
+        else:
+            break
+        args.append((tp, v))
+    return args
+
+
+def format_record(fmt, args):
+    out = ''
+    pos = 0
+    argIdx = 0
+    for m in reSpec.finditer(fmt):
+        out += fmt[pos:m.start()]
+        pos = m.end()
+        flags, width, precision, _, conv = m.groups()
+        if conv == '%':
+            out += '%'
+            continue
+        if argIdx >= len(args):
+            out += '<?>'
+            continue
+        tp, v = args[argIdx]
+        argIdx += 1
+        spec = '%' + flags + width + (precision or '')
+        try:
+            if conv in 'di':
+                out += (spec + 'd') % (int(v))
+            elif conv in 'uxXo':
+                if type(v) is int and v < 0:
+                    v += 1 << (32 if tp == ARG_I32 else 64)
+                out += (spec + conv.replace('u', 'd')) % (int(v))
+            elif conv == 'c':
+                out += (spec + 'c') % (int(v))
+            elif conv in 'fFeEgGaA':
+                out += (spec + conv.replace('a', 'f').replace('A', 'F')) % (float(v))
+            elif conv == 's':
+                out += (spec + 's') % (v)
+            elif conv == 'p':
+                out += '0x%x' % (v)
+            elif conv == 'H':
+                if type(v) is str:
+                    v = v.encode('utf-8')
+                out += ''.join(['%02X,' % (b) for b in v])
+        except (TypeError, ValueError):
+            out += '<?>'
+    out += fmt[pos:]
+    return out
+
+
+def decode(path, output):
+    with open(path, 'rb') as f:
+        raw = f.read()
+    if raw[:len(MAGIC)] != MAGIC:
+        raise Exception('%s is not an async binary log' % (path))
+    formats = {}
+    offset = len(MAGIC)
+    while (offset + HEADER.size) <= len(raw):
+        size, fmtId, level, nArgs, timestamp = HEADER.unpack_from(raw, offset)
+        if size < HEADER.size:
+            break
+        end = offset + size
+        if level == LEVEL_FORMAT_DEF:
+            formats[fmtId] = raw[offset+HEADER.size:end].split(b'\0')[0].decode('utf-8', 'replace')
+        else:
+            args = get_args(raw, offset + HEADER.size, end, nArgs)
+            ts = time.strftime('%Y-%m-%d %H:%M:%S', time.localtime(timestamp // 1000000))
+            fmt = formats.get(fmtId, '<unknown format %d>\n' % (fmtId))
+            output.write('%s.%06d %s' % (ts, timestamp % 1000000, format_record(fmt, args)))
+        offset = end
+
+
+def main(args):
+    if args.output != None:
+        with open(args.output, 'w') as f:
+            decode(args.input, f)
+        print('saving %s done' % (args.output))
+    else:
+        decode(args.input, sys.stdout)
+
+
+if __name__ == '__main__':
+    import argparse
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-i', '--input', help='the input binary log', type=str, required=True)
+    parser.add_argument('-o', '--output', help='the output text log',
+                        default=None, type=str, required=False)
+    args = parser.parse_args()
+    main(args)
@@ -3,6 +3,7 @@ import sys
 import json
 import time
 import signal
+import socket
 
 CWD = os.path.abspath(os.path.dirname(__file__))
 sys.path.append(os.path.abspath('%s/../asone' % (CWD)))
@@ -90,6 +91,54 @@ def process(binOrPath, args):
         print('saving %s done' % (args.output))
 
 
+class Reassembler():
+    '''turn the frames of Std_TraceMain back into the events, see std_trace.c for the format'''
+
+    def __init__(self, header):
+        self.header = header
+        self.sequence = None
+        self.lost = 0  # the frames missed by the receiver
+        self.drops = 0  # the events dropped by the ECU, the low 16 bits
+
+    def feed(self, data):
+        if not self.header:
+            return bytes(data)
+        if len(data) < 4:
+            return bytes([])
+        sequence, num = data[0], data[1]
+        self.drops = data[2] + (data[3] << 8)
+        if self.sequence != None:
+            self.lost += (sequence - self.sequence) & 0xFF
+        self.sequence = (sequence + 1) & 0xFF
+        return bytes(data[4:4+num*4])
+
+
+class UdpNode():
+    def __init__(self, port):
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.bind(('0.0.0.0', port))
+        self.sock.settimeout(0.1)
+
+    def read(self):
+        try:
+            data, _ = self.sock.recvfrom(4096)
+            return True, data
+        except socket.timeout:
+            return False, None
+
+
+class CanNode():
+    def __init__(self, ins):
+        from one.AsPy import can as AsCan
+        device, port, baud, canid = ins.split(':')
+        self.node = AsCan(device, eval(port), eval(baud))
+        self.canid = eval(canid)
+
+    def read(self):
+        ercd, _, data = self.node.read(self.canid, 100)
+        return ercd, data
+
+
 lExit = False
 
 def main(args):
@@ -97,27 +146,33 @@ def main(args):
     if os.path.isfile(args.input):
         process(args.input, args)
     else:
-        from one.AsPy import can as AsCan
         ins = args.input
         if ins == 'default':
             ins = 'simulator_v2:0:500000:0x7FD'
-        device, port, baud, canid = ins.split(':')
-        port = eval(port)
-        baud = eval(baud)
-        canid = eval(canid)
-        node = AsCan(device, port, baud)
+        if ins.startswith('udp:'):
+            node = UdpNode(eval(ins[4:]))
+            stream = Reassembler(True)
+        else:
+            node = CanNode(ins)
+            stream = Reassembler(args.stream)
+        fp = open(args.bin, 'wb')
         start = time.time()
         prev = time.time()
         BIN = bytes([])
         while (False == lExit):
-            ercd, _, data = node.read(canid)
+            ercd, data = node.read()
             if (ercd):
-                BIN += data
+                events = stream.feed(data)
+                fp.write(events)
+                fp.flush()
+                BIN += events
             elapsed = time.time() - prev
             if elapsed > 1:
-                print('process %d events, duration %.2f s' % (len(BIN), time.time() - start))
+                print('process %d events, duration %.2f s, lost %d frames, ECU dropped %d events' % (
+                    len(BIN)//4, time.time() - start, stream.lost, stream.drops))
                 process(BIN, args)
                 prev = time.time()
+        fp.close()
 
 
 def safe_exit(signo, frame):
@@ -130,7 +185,12 @@ def safe_exit(signo, frame):
 if __name__ == '__main__':
     import argparse
     parser = argparse.ArgumentParser()
-    parser.add_argument('-i', '--input', help='the input trace bin', type=str, required=True)
+    parser.add_argument('-i', '--input', help='the input trace bin, "device:port:baud:canid" of the CAN'
+                        ' or "udp:port" for the live mode', type=str, required=True)
+    parser.add_argument('-b', '--bin', help='the trace bin reassembled by the live mode',
+                        default='.trace.bin', type=str, required=False)
+    parser.add_argument('--stream', help='the CAN frames carry the stream header, the CAN-FD default',
+                        default=False, action='store_true', required=False)
     parser.add_argument('-c', '--config', help='config json', type=str, required=True)
     parser.add_argument('-o', '--output', help='the output trace json',
                         default='.trace.json', type=str, required=False)